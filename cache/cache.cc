@@ -59,6 +59,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    enable_custom_split_merge),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"slab_size",
+         {offsetof(struct CompressedSecondaryCacheOptions, slab_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 namespace {
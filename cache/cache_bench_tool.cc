@@ -4,6 +4,10 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 #ifdef GFLAGS
+#ifndef OS_WIN
+#include <sys/resource.h>
+#endif  // !OS_WIN
+
 #include <cinttypes>
 #include <cstddef>
 #include <cstdio>
@@ -13,6 +17,7 @@
 #include <sstream>
 
 #include "cache/cache_key.h"
+#include "cache/compressed_secondary_cache.h"
 #include "cache/sharded_cache.h"
 #include "db/db_impl/db_impl.h"
 #include "monitoring/histogram.h"
@@ -119,6 +124,14 @@ DEFINE_uint32(seed, 0, "Hashing/random seed to use. 0 = choose at random");
 DEFINE_string(secondary_cache_uri, "",
               "Full URI for creating a custom secondary cache object");
 
+DEFINE_double(compressed_secondary_cache_ratio, 0.0,
+              "If greater than 0.0 and secondary_cache_uri is not set, use a "
+              "CompressedSecondaryCache with this many times the capacity of "
+              "the primary cache, e.g. 4 for a 4:1 capacity ratio.");
+
+DEFINE_uint64(compressed_secondary_cache_slab_size, 0,
+              "CompressedSecondaryCacheOptions::slab_size");
+
 DEFINE_string(cache_type, "hyper_clock_cache", "Type of block cache.");
 
 DEFINE_bool(use_jemalloc_no_dump_allocator, false,
@@ -132,6 +145,19 @@ DEFINE_bool(jemalloc_no_dump_allocator_limit_tcache_size,
             ROCKSDB_NAMESPACE::JemallocAllocatorOptions().limit_tcache_size,
             "JemallocNodumpAllocator::limit_tcache_size");
 
+DEFINE_bool(use_huge_page_slab_allocator, false,
+            "Whether to use HugePageSlabAllocator, with a capacity of twice "
+            "the cache size");
+
+DEFINE_uint64(huge_page_slab_allocator_huge_page_size,
+              ROCKSDB_NAMESPACE::HugePageSlabAllocatorOptions().huge_page_size,
+              "HugePageSlabAllocator::huge_page_size, which also raises "
+              "slab_size when larger");
+
+DEFINE_bool(huge_page_slab_allocator_mlock,
+            ROCKSDB_NAMESPACE::HugePageSlabAllocatorOptions().mlock,
+            "HugePageSlabAllocator::mlock");
+
 // ## BEGIN stress_cache_key sub-tool options ##
 // See class StressCacheKey below.
 DEFINE_bool(stress_cache_key, false,
@@ -194,6 +220,40 @@ namespace ROCKSDB_NAMESPACE {
 
 class CacheBench;
 namespace {
+// Minor page faults of the process so far, or -1 if unknown
+int64_t GetMinorPageFaultCount() {
+#ifdef RUSAGE_SELF
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return static_cast<int64_t>(usage.ru_minflt);
+  }
+#endif  // RUSAGE_SELF
+  return -1;
+}
+
+// The memory of the process backed by transparent and explicit huge pages,
+// from /proc/self/smaps_rollup if available. As TLB misses need perf to
+// measure, this at least shows whether the cache ended up on huge pages.
+std::string GetHugePageUsage() {
+  std::string smaps;
+  if (!ReadFileToString(Env::Default(), "/proc/self/smaps_rollup", &smaps)
+           .ok()) {
+    return "";
+  }
+  std::string usage;
+  for (const std::string& line : StringSplit(smaps, '\n')) {
+    if (StartsWith(line, "AnonHugePages:") ||
+        StartsWith(line, "Shared_Hugetlb:") ||
+        StartsWith(line, "Private_Hugetlb:")) {
+      std::string name = line.substr(0, line.find(':') + 1);
+      std::string value = line.substr(name.size());
+      value.erase(0, value.find_first_not_of(' '));
+      usage += (usage.empty() ? "" : ", ") + name + " " + value;
+    }
+  }
+  return usage;
+}
+
 // State shared by all concurrent executions of the same benchmark.
 class SharedState {
  public:
@@ -347,6 +407,11 @@ Cache::CacheItemHelper helper3_wos(CacheEntryRole::kFilterBlock, DeleteFn);
 Cache::CacheItemHelper helper3(CacheEntryRole::kFilterBlock, DeleteFn, SizeFn,
                                SaveToFn, CreateFn, &helper3_wos);
 
+bool UseSecondaryCache() {
+  return !FLAGS_secondary_cache_uri.empty() ||
+         FLAGS_compressed_secondary_cache_ratio > 0.0;
+}
+
 void ConfigureSecondaryCache(ShardedCacheOptions& opts) {
   if (!FLAGS_secondary_cache_uri.empty()) {
     std::shared_ptr<SecondaryCache> secondary_cache;
@@ -359,11 +424,18 @@ void ConfigureSecondaryCache(ShardedCacheOptions& opts) {
       exit(1);
     }
     opts.secondary_cache = secondary_cache;
+  } else if (FLAGS_compressed_secondary_cache_ratio > 0.0) {
+    CompressedSecondaryCacheOptions sec_opts;
+    sec_opts.capacity = static_cast<size_t>(
+        FLAGS_cache_size * FLAGS_compressed_secondary_cache_ratio);
+    sec_opts.slab_size =
+        static_cast<size_t>(FLAGS_compressed_secondary_cache_slab_size);
+    opts.secondary_cache = sec_opts.MakeSharedSecondaryCache();
   }
 }
 
 ShardedCacheBase* AsShardedCache(Cache* c) {
-  if (!FLAGS_secondary_cache_uri.empty()) {
+  if (UseSecondaryCache()) {
     c = static_cast_with_check<CacheWrapper>(c)->GetTarget().get();
   }
   return static_cast_with_check<ShardedCacheBase>(c);
@@ -392,12 +464,17 @@ class CacheBench {
       fprintf(stderr, "Percentages must add to 100.\n");
       exit(1);
     }
-    cache_ = MakeCache();
+    cache_ = MakeCache(&secondary_cache_);
+    if (UseSecondaryCache()) {
+      // For the latency of secondary cache lookups
+      stats_ = CreateDBStatistics();
+    }
   }
 
   ~CacheBench() = default;
 
-  static std::shared_ptr<Cache> MakeCache() {
+  static std::shared_ptr<Cache> MakeCache(
+      std::shared_ptr<SecondaryCache>* secondary_cache = nullptr) {
     std::shared_ptr<MemoryAllocator> allocator;
     if (FLAGS_use_jemalloc_no_dump_allocator) {
       JemallocAllocatorOptions opts;
@@ -407,6 +484,21 @@ class CacheBench {
       Status s = NewJemallocNodumpAllocator(opts, &allocator);
       assert(s.ok());
     }
+    if (FLAGS_use_huge_page_slab_allocator) {
+      HugePageSlabAllocatorOptions opts;
+      opts.huge_page_size =
+          static_cast<size_t>(FLAGS_huge_page_slab_allocator_huge_page_size);
+      opts.slab_size = std::max(opts.slab_size, opts.huge_page_size);
+      opts.capacity = std::max(static_cast<size_t>(FLAGS_cache_size) * 2,
+                               opts.slab_size);
+      opts.mlock = FLAGS_huge_page_slab_allocator_mlock;
+      Status s = NewHugePageSlabAllocator(opts, &allocator);
+      if (!s.ok()) {
+        fprintf(stderr, "Failed to create HugePageSlabAllocator: %s\n",
+                s.ToString().c_str());
+        exit(1);
+      }
+    }
     if (FLAGS_cache_type == "clock_cache") {
       fprintf(stderr, "Old clock cache implementation has been removed.\n");
       exit(1);
@@ -430,6 +522,9 @@ class CacheBench {
         exit(1);
       }
       ConfigureSecondaryCache(opts);
+      if (secondary_cache != nullptr) {
+        *secondary_cache = opts.secondary_cache;
+      }
       return opts.MakeSharedCache();
     } else if (FLAGS_cache_type == "lru_cache") {
       LRUCacheOptions opts(FLAGS_cache_size, FLAGS_num_shard_bits,
@@ -438,6 +533,9 @@ class CacheBench {
       opts.hash_seed = BitwiseAnd(FLAGS_seed, INT32_MAX);
       opts.memory_allocator = allocator;
       ConfigureSecondaryCache(opts);
+      if (secondary_cache != nullptr) {
+        *secondary_cache = opts.secondary_cache;
+      }
       return NewLRUCache(opts);
     } else {
       fprintf(stderr, "Cache type not supported.\n");
@@ -509,6 +607,7 @@ class CacheBench {
     std::thread stats_thread(StatsBody, &shared, &stats_hist, &stats_report);
 
     uint64_t start_time;
+    int64_t start_page_faults;
     {
       MutexLock l(shared.GetMutex());
       while (!shared.AllInitialized()) {
@@ -516,6 +615,7 @@ class CacheBench {
       }
       // Record start time
       start_time = clock->NowMicros();
+      start_page_faults = GetMinorPageFaultCount();
 
       // Start all threads
       shared.SetStart();
@@ -530,6 +630,7 @@ class CacheBench {
     // Stats gathering is considered background work. This time measurement
     // is for foreground work, and not really ideal for that. See below.
     uint64_t end_time = clock->NowMicros();
+    int64_t end_page_faults = GetMinorPageFaultCount();
     stats_thread.join();
 
     // Wall clock time - includes idle time if threads
@@ -551,12 +652,42 @@ class CacheBench {
 
     printf("Lookup hit ratio: %g\n", shared.GetLookupHitRatio());
 
+    if (start_page_faults >= 0 && end_page_faults >= 0) {
+      printf("Minor page faults: %" PRIi64 "\n",
+             end_page_faults - start_page_faults);
+    }
+    std::string huge_page_usage = GetHugePageUsage();
+    if (!huge_page_usage.empty()) {
+      printf("Huge page memory: %s\n", huge_page_usage.c_str());
+    }
+
     size_t occ = cache_->GetOccupancyCount();
     size_t slot = cache_->GetTableAddressCount();
     printf("Final load factor: %g (%zu / %zu)\n", 1.0 * occ / slot, occ, slot);
 
     printf("Final pinned count: %zu\n", shared.GetPinnedCount());
 
+    if (stats_) {
+      printf("Secondary cache hits: %" PRIu64 "\n",
+             stats_->getTickerCount(SECONDARY_CACHE_HITS));
+    }
+    if (secondary_cache_ != nullptr && FLAGS_secondary_cache_uri.empty()) {
+      CompressedSecondaryCache::SlabStats slab_stats =
+          static_cast_with_check<CompressedSecondaryCache>(
+              secondary_cache_.get())
+              ->GetSlabStats();
+      if (slab_stats.num_slabs > 0) {
+        printf("Secondary cache slabs: %zu (%s, %s live), fragmentation: %g\n",
+               slab_stats.num_slabs,
+               BytesToHumanString(slab_stats.slab_bytes).c_str(),
+               BytesToHumanString(slab_stats.live_bytes).c_str(),
+               slab_stats.Fragmentation());
+        printf("Secondary cache slab compactions: %" PRIu64 " (%s relocated)\n",
+               slab_stats.num_compactions,
+               BytesToHumanString(slab_stats.relocated_bytes).c_str());
+      }
+    }
+
     if (FLAGS_histograms) {
       printf("\nOperation latency (ns):\n");
       HistogramImpl combined;
@@ -569,6 +700,14 @@ class CacheBench {
         printf("\nGather stats latency (us):\n");
         printf("%s", stats_hist.ToString().c_str());
       }
+
+      if (stats_) {
+        printf("\nCompressed secondary cache promotion latency (us):\n");
+        printf("%s", stats_
+                         ->getHistogramString(
+                             COMPRESSED_SECONDARY_CACHE_PROMOTION_MICROS)
+                         .c_str());
+      }
     }
 
     if (FLAGS_report_problems) {
@@ -584,6 +723,8 @@ class CacheBench {
 
  private:
   std::shared_ptr<Cache> cache_;
+  std::shared_ptr<SecondaryCache> secondary_cache_;
+  std::shared_ptr<Statistics> stats_;
   const uint64_t max_key_;
   // Cumulative thresholds in the space of a random uint64_t
   const uint64_t lookup_insert_threshold_;
@@ -741,7 +882,7 @@ class CacheBench {
       if (random_op < lookup_insert_threshold_) {
         // do lookup
         auto handle = cache_->Lookup(key, &helper2, /*context*/ nullptr,
-                                     Cache::Priority::LOW);
+                                     Cache::Priority::LOW, stats_.get());
         if (handle) {
           ++lookup_hits;
           if (!FLAGS_lean) {
@@ -773,7 +914,7 @@ class CacheBench {
       } else if (random_op < lookup_threshold_) {
         // do lookup
         auto handle = cache_->Lookup(key, &helper2, /*context*/ nullptr,
-                                     Cache::Priority::LOW);
+                                     Cache::Priority::LOW, stats_.get());
         if (handle) {
           ++lookup_hits;
           if (!FLAGS_lean) {
@@ -840,6 +981,9 @@ class CacheBench {
     printf("Ops per thread      : %" PRIu64 "\n", FLAGS_ops_per_thread);
     printf("Cache size          : %s\n",
            BytesToHumanString(FLAGS_cache_size).c_str());
+    if (secondary_cache_ != nullptr) {
+      printf("Secondary cache     : %s\n", secondary_cache_->Name());
+    }
     printf("Num shard bits      : %d\n",
            AsShardedCache(cache_.get())->GetNumShardBits());
     printf("Max key             : %" PRIu64 "\n", max_key_);
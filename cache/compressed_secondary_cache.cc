@@ -9,15 +9,20 @@
 #include <cstdint>
 #include <memory>
 
+#include "cache/sharded_cache.h"
 #include "memory/memory_allocator_impl.h"
 #include "monitoring/perf_context_imp.h"
 #include "util/coding.h"
 #include "util/compression.h"
+#include "util/hash.h"
+#include "util/stop_watch.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace {
 // Format of values in CompressedSecondaryCache:
+// If slab_size > 0:
+//  * A CompressedSlabStore::Value holding a tagged value.
 // If enable_custom_split_merge:
 //  * A chain of CacheValueChunk representing the sequence of bytes for a tagged
 //    value. The overall length of the tagged value is determined by the chain
@@ -55,9 +60,23 @@ CompressedSecondaryCache::CompressedSecondaryCache(
                                    cache_options_.compression_type);
   decompressor_ =
       mgr->GetDecompressorOptimizeFor(cache_options_.compression_type);
+  if (cache_options_.slab_size > 0) {
+    // At least a few slabs per shard
+    slabs_ = std::make_unique<CompressedSlabStore>(
+        cache_options_.slab_size,
+        GetDefaultCacheShardBits(cache_options_.capacity,
+                                 16 * cache_options_.slab_size),
+        cache_options_.memory_allocator);
+    slab_reservation_key_ =
+        CacheKey::CreateUniqueForCacheLifetime(cache_.get());
+  }
 }
 
-CompressedSecondaryCache::~CompressedSecondaryCache() = default;
+CompressedSecondaryCache::~CompressedSecondaryCache() {
+  if (slab_reservation_handle_ != nullptr) {
+    cache_->Release(slab_reservation_handle_, /*erase_if_last_ref=*/true);
+  }
+}
 
 std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
     const Slice& key, const Cache::CacheItemHelper* helper,
@@ -82,9 +101,17 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
     return nullptr;
   }
 
+  StopWatch sw(SystemClock::Default().get(), stats,
+               COMPRESSED_SECONDARY_CACHE_PROMOTION_MICROS);
+  // Must be reset before releasing lru_handle
+  CompressedSlabStore::PinnedData pinned;
   std::string merged_value;
   Slice tagged_data;
-  if (cache_options_.enable_custom_split_merge) {
+  if (slabs_) {
+    // Read in place, the data is neither merged nor copied out of the slab
+    pinned.Pin(static_cast<CompressedSlabStore::Value*>(handle_value));
+    tagged_data = pinned.data();
+  } else if (cache_options_.enable_custom_split_merge) {
     CacheValueChunk* value_chunk_ptr =
         static_cast<CacheValueChunk*>(handle_value);
     merged_value = MergeChunksIntoValue(value_chunk_ptr);
@@ -111,6 +138,7 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
         s = decompressor_->DecompressBlock(args, uncompressed.get());
         assert(s.ok());  // in-memory data
       }
+      pinned.Reset();
       if (!s.ok()) {
         cache_->Release(lru_handle, /*erase_if_last_ref=*/true);
         return nullptr;
@@ -134,6 +162,7 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
   Status s = helper->create_cb(saved, type, source, create_context,
                                cache_options_.memory_allocator.get(),
                                &result_value, &result_charge);
+  pinned.Reset();
   if (!s.ok()) {
     cache_->Release(lru_handle, /*erase_if_last_ref=*/true);
     return nullptr;
@@ -142,11 +171,11 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
   if (advise_erase) {
     cache_->Release(lru_handle, /*erase_if_last_ref=*/true);
     // Insert a dummy handle.
-    cache_
-        ->Insert(key, /*obj=*/nullptr,
-                 GetHelper(cache_options_.enable_custom_split_merge),
-                 /*charge=*/0)
+    cache_->Insert(key, /*obj=*/nullptr, GetInternalHelper(), /*charge=*/0)
         .PermitUncheckedError();
+    if (slabs_) {
+      UpdateSlabReservation();
+    }
   } else {
     kept_in_sec_cache = true;
     cache_->Release(lru_handle, /*erase_if_last_ref=*/false);
@@ -158,7 +187,7 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
 }
 
 bool CompressedSecondaryCache::MaybeInsertDummy(const Slice& key) {
-  auto internal_helper = GetHelper(cache_options_.enable_custom_split_merge);
+  auto internal_helper = GetInternalHelper();
   Cache::Handle* lru_handle = cache_->Lookup(key);
   if (lru_handle == nullptr) {
     PERF_COUNTER_ADD(compressed_sec_cache_insert_dummy_count, 1);
@@ -177,8 +206,11 @@ Status CompressedSecondaryCache::InsertInternal(
     const Slice& key, Cache::ObjectPtr value,
     const Cache::CacheItemHelper* helper, CompressionType from_type,
     CacheTier source) {
-  bool enable_split_merge = cache_options_.enable_custom_split_merge;
-  const Cache::CacheItemHelper* internal_helper = GetHelper(enable_split_merge);
+  bool enable_split_merge =
+      slabs_ == nullptr && cache_options_.enable_custom_split_merge;
+  const Cache::CacheItemHelper* internal_helper = GetInternalHelper();
+  // Values copied into slabs need no length prefix either
+  bool no_length_prefix = enable_split_merge || slabs_ != nullptr;
 
   // TODO: variant of size_cb that also returns a pointer to the data if
   // already available. Saves an allocation if we keep the compressed version.
@@ -189,7 +221,7 @@ Status CompressedSecondaryCache::InsertInternal(
   // compression is insufficient. But we don't need the length prefix with
   // enable_split_merge. TODO: be smarter with CacheValueChunk to save an
   // allocation in the enable_split_merge case.
-  size_t header_size = GetHeaderSize(data_size_original, enable_split_merge);
+  size_t header_size = GetHeaderSize(data_size_original, no_length_prefix);
   CacheAllocationPtr allocation = AllocateBlock(
       header_size + data_size_original, cache_options_.memory_allocator.get());
   char* data_ptr = allocation.get() + header_size;
@@ -231,14 +263,14 @@ Status CompressedSecondaryCache::InsertInternal(
     } else {
       PERF_COUNTER_ADD(compressed_sec_cache_compressed_bytes,
                        data_size_compressed);
-      if (enable_split_merge) {
-        // Only need tagged_data for copying into CacheValueChunks.
+      if (no_length_prefix) {
+        // Only need tagged_data for copying into CacheValueChunks or slabs.
         tagged_data = Slice(tagged_compressed_data.get(),
                             data_size_compressed + kTagSize);
         allocation.reset();
       } else {
         // Replace allocation with compressed version, copied from string
-        header_size = GetHeaderSize(data_size_compressed, enable_split_merge);
+        header_size = GetHeaderSize(data_size_compressed, no_length_prefix);
         allocation = AllocateBlock(header_size + data_size_compressed,
                                    cache_options_.memory_allocator.get());
         data_ptr = allocation.get() + header_size;
@@ -260,7 +292,13 @@ Status CompressedSecondaryCache::InsertInternal(
   const_cast<char*>(tagged_data.data())[1] = lossless_cast<char>(
       source == CacheTier::kVolatileCompressedTier ? to_type : from_type);
 
-  if (enable_split_merge) {
+  if (slabs_) {
+    CompressedSlabStore::Value* slab_value =
+        slabs_->Add(tagged_data, GetSliceHash(key));
+    s = cache_->Insert(key, slab_value, internal_helper, tagged_data.size());
+    assert(s.ok());  // LRUCache::Insert() with handle==nullptr always OK
+    UpdateSlabReservation();
+  } else if (enable_split_merge) {
     size_t split_charge{0};
     CacheValueChunk* value_chunks_head =
         SplitValueIntoChunks(tagged_data, split_charge);
@@ -310,7 +348,7 @@ Status CompressedSecondaryCache::InsertSaved(
     // Not currently supported (why?)
     return Status::OK();
   }
-  if (cache_options_.enable_custom_split_merge) {
+  if (slabs_ == nullptr && cache_options_.enable_custom_split_merge) {
     // We don't support custom split/merge for the tiered case (why?)
     return Status::OK();
   }
@@ -325,13 +363,21 @@ Status CompressedSecondaryCache::InsertSaved(
       slice_helper, type, source);
 }
 
-void CompressedSecondaryCache::Erase(const Slice& key) { cache_->Erase(key); }
+void CompressedSecondaryCache::Erase(const Slice& key) {
+  cache_->Erase(key);
+  if (slabs_) {
+    UpdateSlabReservation();
+  }
+}
 
 Status CompressedSecondaryCache::SetCapacity(size_t capacity) {
   MutexLock l(&capacity_mutex_);
   cache_options_.capacity = capacity;
   cache_->SetCapacity(capacity);
   disable_cache_.StoreRelaxed(capacity == 0);
+  if (slabs_) {
+    UpdateSlabReservation();
+  }
   return Status::OK();
 }
 
@@ -350,6 +396,9 @@ std::string CompressedSecondaryCache::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "    compression_type : %s\n",
            CompressionTypeToString(cache_options_.compression_type).c_str());
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    slab_size : %" ROCKSDB_PRIszt "\n",
+           cache_options_.slab_size);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "    compression_opts : %s\n",
            CompressionOptionsToString(
                const_cast<CompressionOptions&>(cache_options_.compression_opts))
@@ -454,6 +503,63 @@ const Cache::CacheItemHelper* CompressedSecondaryCache::GetHelper(
   }
 }
 
+const Cache::CacheItemHelper* CompressedSecondaryCache::GetInternalHelper()
+    const {
+  if (slabs_) {
+    static const Cache::CacheItemHelper kHelper{
+        CacheEntryRole::kMisc,
+        [](Cache::ObjectPtr obj, MemoryAllocator* /*alloc*/) {
+          if (obj != nullptr) {
+            CompressedSlabStore::Free(
+                static_cast<CompressedSlabStore::Value*>(obj));
+          }
+        }};
+    return &kHelper;
+  }
+  return GetHelper(cache_options_.enable_custom_split_merge);
+}
+
+void CompressedSecondaryCache::UpdateSlabReservation() {
+  assert(slabs_);
+  MutexLock l(&slab_reservation_mutex_);
+  // Values evicted for a larger reservation leave more unused bytes in their
+  // slabs, until the slabs are compacted or released, so grow it until it
+  // covers them. That ends at the latest once every value is evicted.
+  for (;;) {
+    const size_t unused = slabs_->GetUnusedSlabBytes();
+    if (unused == slab_reservation_) {
+      return;
+    }
+    const bool shrink = unused < slab_reservation_;
+    if (slab_reservation_handle_ != nullptr) {
+      cache_->Release(slab_reservation_handle_, /*erase_if_last_ref=*/true);
+      slab_reservation_handle_ = nullptr;
+      slab_reservation_ = 0;
+    }
+    if (unused == 0) {
+      return;
+    }
+    // With strict_capacity_limit, fails if the pinned entries take the whole
+    // capacity
+    Status s = cache_->Insert(slab_reservation_key_.AsSlice(), /*obj=*/nullptr,
+                              GetInternalHelper(), unused,
+                              &slab_reservation_handle_);
+    if (!s.ok()) {
+      slab_reservation_handle_ = nullptr;
+      return;
+    }
+    slab_reservation_ = unused;
+    if (shrink) {
+      return;
+    }
+  }
+}
+
+CompressedSecondaryCache::SlabStats CompressedSecondaryCache::GetSlabStats()
+    const {
+  return slabs_ ? slabs_->GetStats() : SlabStats();
+}
+
 size_t CompressedSecondaryCache::TEST_GetCharge(const Slice& key) {
   Cache::Handle* lru_handle = cache_->Lookup(key);
   if (lru_handle == nullptr) {
@@ -9,7 +9,9 @@
 #include <cstddef>
 #include <memory>
 
+#include "cache/cache_key.h"
 #include "cache/cache_reservation_manager.h"
+#include "cache/compressed_slab_store.h"
 #include "memory/memory_allocator_impl.h"
 #include "rocksdb/advanced_compression.h"
 #include "rocksdb/secondary_cache.h"
@@ -105,6 +107,11 @@ class CompressedSecondaryCache : public SecondaryCache {
 
   size_t TEST_GetUsage() { return cache_->GetUsage(); }
 
+  using SlabStats = CompressedSlabStore::Stats;
+  // Returns the memory usage of the slabs, all zero unless
+  // CompressedSecondaryCacheOptions::slab_size is set.
+  SlabStats GetSlabStats() const;
+
  private:
   friend class CompressedSecondaryCacheTestBase;
   static constexpr std::array<uint16_t, 8> malloc_bin_sizes_{
@@ -137,6 +144,15 @@ class CompressedSecondaryCache : public SecondaryCache {
 
   // TODO: clean up to use cleaner interfaces in typed_cache.h
   const Cache::CacheItemHelper* GetHelper(bool enable_custom_split_merge) const;
+  // Helper of the values stored in cache_
+  const Cache::CacheItemHelper* GetInternalHelper() const;
+
+  // Charges the unused bytes of the slabs to cache_, which evicts values to
+  // keep the memory of the slabs within the capacity
+  void UpdateSlabReservation();
+
+  // Declared first to be destroyed after the values in cache_
+  std::unique_ptr<CompressedSlabStore> slabs_;
   std::shared_ptr<Cache> cache_;
   CompressedSecondaryCacheOptions cache_options_;
   std::unique_ptr<Compressor> compressor_;
@@ -144,6 +160,12 @@ class CompressedSecondaryCache : public SecondaryCache {
   mutable port::Mutex capacity_mutex_;
   std::shared_ptr<ConcurrentCacheReservationManager> cache_res_mgr_;
   RelaxedAtomic<bool> disable_cache_;
+
+  // A pinned entry of cache_ charged the unused bytes of the slabs
+  port::Mutex slab_reservation_mutex_;
+  CacheKey slab_reservation_key_;
+  Cache::Handle* slab_reservation_handle_ = nullptr;
+  size_t slab_reservation_ = 0;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -1008,6 +1008,151 @@ TEST_P(CompressedSecondaryCacheTestWithCompressionParam, EntryRoles) {
   }
 }
 
+TEST_P(CompressedSecondaryCacheTestWithCompressionParam,
+       BasicTestFromStringWithSlabs) {
+  // The unused bytes of the open slab are charged too
+  std::string sec_cache_uri =
+      "compressed_secondary_cache://"
+      "capacity=8192;num_shard_bits=0;slab_size=4096;compression_type=";
+  if (sec_cache_is_compressed_) {
+    if (!LZ4_Supported()) {
+      ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+      return;
+    }
+    sec_cache_uri += "kLZ4Compression";
+  } else {
+    sec_cache_uri += "kNoCompression";
+  }
+  std::shared_ptr<SecondaryCache> sec_cache;
+  ASSERT_OK(SecondaryCache::CreateFromString(ConfigOptions(), sec_cache_uri,
+                                             &sec_cache));
+  BasicTestHelper(sec_cache, sec_cache_is_compressed_);
+}
+
+TEST_P(CompressedSecondaryCacheTestWithCompressionParam, SlabCompaction) {
+  CompressedSecondaryCacheOptions opts;
+  opts.capacity = 64 << 10;
+  opts.num_shard_bits = 0;
+  opts.slab_size = 4096;
+  if (sec_cache_is_compressed_) {
+    if (!LZ4_Supported()) {
+      ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+      return;
+    }
+  } else {
+    opts.compression_type = CompressionType::kNoCompression;
+  }
+  std::shared_ptr<SecondaryCache> sec_cache = NewCompressedSecondaryCache(opts);
+  auto comp_sec_cache = static_cast<CompressedSecondaryCache*>(sec_cache.get());
+
+  // Values of various sizes, including some larger than a slab
+  Random rnd(301);
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  for (int i = 0; i < 400; ++i) {
+    keys.push_back("____    key" + std::to_string(10000 + i));
+    if (i % 50 == 0) {
+      values.push_back(rnd.RandomBinaryString(5000));
+    } else {
+      values.push_back(
+          test::CompressibleString(&rnd, 0.5, 200 + rnd.Uniform(1200)));
+    }
+    TestItem item(values.back().data(), values.back().size());
+    ASSERT_OK(sec_cache->Insert(keys.back(), &item, GetHelper(),
+                                /*force_insert=*/true));
+    // Erase some of the recent values, leaving holes in the slabs
+    if (i >= 10 && rnd.OneIn(3)) {
+      sec_cache->Erase(keys[i - rnd.Uniform(10)]);
+    }
+  }
+
+  CompressedSecondaryCache::SlabStats stats = comp_sec_cache->GetSlabStats();
+  ASSERT_GT(stats.num_compactions, 0);
+  ASSERT_GT(stats.relocated_bytes, 0);
+  ASSERT_GT(stats.live_bytes, 0);
+  ASSERT_LE(stats.live_bytes + stats.standalone_bytes, opts.capacity);
+  ASSERT_LE(stats.slab_bytes, 2 * stats.live_bytes + 4 * opts.slab_size);
+  ASSERT_LT(stats.Fragmentation(), 1.0);
+
+  // Whatever is still cached, relocated or not, reads back intact
+  size_t num_found = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    bool kept_in_sec_cache = false;
+    std::unique_ptr<SecondaryCacheResultHandle> handle = sec_cache->Lookup(
+        keys[i], GetHelper(), this, true, /*advise_erase=*/false,
+        /*stats=*/nullptr, kept_in_sec_cache);
+    if (handle == nullptr) {
+      continue;
+    }
+    ++num_found;
+    ASSERT_TRUE(kept_in_sec_cache);
+    std::unique_ptr<TestItem> val(static_cast<TestItem*>(handle->Value()));
+    ASSERT_EQ(val->ToString(), values[i]);
+  }
+  ASSERT_GT(num_found, 20U);
+
+  // Slabs are released once emptied
+  ASSERT_OK(sec_cache->SetCapacity(0));
+  stats = comp_sec_cache->GetSlabStats();
+  ASSERT_EQ(stats.live_bytes, 0);
+  ASSERT_EQ(stats.num_standalone_values, 0);
+  ASSERT_LE(stats.num_slabs, 1);
+}
+
+TEST_P(CompressedSecondaryCacheTestWithCompressionParam,
+       SlabMemoryWithinCapacity) {
+  CompressedSecondaryCacheOptions opts;
+  opts.capacity = 64 << 10;
+  opts.num_shard_bits = 0;
+  opts.slab_size = 4096;
+  if (sec_cache_is_compressed_) {
+    if (!LZ4_Supported()) {
+      ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+      return;
+    }
+  } else {
+    opts.compression_type = CompressionType::kNoCompression;
+  }
+  std::shared_ptr<SecondaryCache> sec_cache = NewCompressedSecondaryCache(opts);
+  auto comp_sec_cache = static_cast<CompressedSecondaryCache*>(sec_cache.get());
+
+  auto assert_within_capacity = [&]() {
+    CompressedSecondaryCache::SlabStats stats = comp_sec_cache->GetSlabStats();
+    ASSERT_LE(stats.slab_bytes + stats.standalone_bytes, opts.capacity);
+  };
+
+  Random rnd(301);
+  std::vector<std::string> keys;
+  auto insert = [&](int i) {
+    keys.push_back("____    key" + std::to_string(10000 + i));
+    std::string value =
+        test::CompressibleString(&rnd, 0.5, 200 + rnd.Uniform(1200));
+    TestItem item(value.data(), value.size());
+    ASSERT_OK(sec_cache->Insert(keys.back(), &item, GetHelper(),
+                                /*force_insert=*/true));
+  };
+
+  // Fill the cache
+  for (int i = 0; i < 300; ++i) {
+    insert(i);
+    assert_within_capacity();
+  }
+  // Erase every third value, which leaves the slabs too full to compact
+  for (size_t i = 0; i < keys.size(); i += 3) {
+    sec_cache->Erase(keys[i]);
+    assert_within_capacity();
+  }
+  // Refill the cache
+  for (int i = 300; i < 600; ++i) {
+    insert(i);
+    assert_within_capacity();
+  }
+
+  // The cache still holds values
+  CompressedSecondaryCache::SlabStats stats = comp_sec_cache->GetSlabStats();
+  ASSERT_GT(stats.live_bytes, opts.capacity / 4);
+}
+
 INSTANTIATE_TEST_CASE_P(CompressedSecCacheTests,
                         CompressedSecondaryCacheTestWithCompressionParam,
                         testing::Combine(testing::Bool(),
@@ -0,0 +1,250 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/compressed_slab_store.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct CompressedSlabStore::Value {
+  Shard* shard = nullptr;
+  char* data = nullptr;
+  size_t size = 0;
+  // kNoSlab for values stored in their own allocation
+  uint32_t slab = kNoSlab;
+  CacheAllocationPtr standalone;
+  // Links in the list of values of the slab
+  Value* prev = nullptr;
+  Value* next = nullptr;
+};
+
+void CompressedSlabStore::PinnedData::Pin(Value* value) {
+  assert(value);
+  Reset();
+  value_ = value;
+  MutexLock l(&value_->shard->mutex);
+  if (value_->slab != kNoSlab) {
+    ++value_->shard->slabs[value_->slab].pins;
+  }
+  data_ = Slice(value_->data, value_->size);
+}
+
+void CompressedSlabStore::PinnedData::Reset() {
+  if (value_ == nullptr) {
+    return;
+  }
+  Shard* shard = value_->shard;
+  MutexLock l(&shard->mutex);
+  if (value_->slab != kNoSlab) {
+    Slab& slab = shard->slabs[value_->slab];
+    assert(slab.pins > 0);
+    --slab.pins;
+  }
+  value_ = nullptr;
+  data_ = Slice();
+}
+
+CompressedSlabStore::CompressedSlabStore(
+    size_t slab_size, int num_shard_bits,
+    std::shared_ptr<MemoryAllocator> allocator)
+    : slab_size_(slab_size),
+      allocator_(std::move(allocator)),
+      shard_mask_((uint32_t{1} << num_shard_bits) - 1),
+      shards_(new Shard[shard_mask_ + 1]) {
+  assert(slab_size_ > 0);
+  for (uint32_t i = 0; i <= shard_mask_; ++i) {
+    shards_[i].store = this;
+  }
+}
+
+CompressedSlabStore::~CompressedSlabStore() {
+#ifndef NDEBUG
+  for (uint32_t i = 0; i <= shard_mask_; ++i) {
+    assert(shards_[i].live_bytes == 0);
+    assert(shards_[i].num_standalone_values == 0);
+  }
+#endif  // NDEBUG
+}
+
+CompressedSlabStore::Value* CompressedSlabStore::Add(const Slice& data,
+                                                     uint32_t hash) {
+  assert(!data.empty());
+  Shard* shard = &shards_[hash & shard_mask_];
+  std::unique_ptr<Value> value(new Value());
+  value->shard = shard;
+  value->size = data.size();
+
+  if (data.size() > slab_size_) {
+    value->standalone = AllocateBlock(data.size(), allocator_.get());
+    value->data = value->standalone.get();
+    std::memcpy(value->data, data.data(), data.size());
+    MutexLock l(&shard->mutex);
+    ++shard->num_standalone_values;
+    shard->standalone_bytes += data.size();
+    return value.release();
+  }
+
+  MutexLock l(&shard->mutex);
+  if (shard->open_slab == kNoSlab ||
+      shard->slabs[shard->open_slab].used + data.size() > slab_size_) {
+    uint32_t sealed = shard->open_slab;
+    shard->open_slab = OpenSlab(shard);
+    if (sealed != kNoSlab && shard->slabs[sealed].live_bytes == 0 &&
+        shard->slabs[sealed].pins == 0) {
+      ReleaseSlab(shard, sealed);
+    }
+    Compact(shard, data.size());
+  }
+
+  Slab& open = shard->slabs[shard->open_slab];
+  assert(open.used + data.size() <= slab_size_);
+  value->slab = shard->open_slab;
+  value->data = open.memory.get() + open.used;
+  std::memcpy(value->data, data.data(), data.size());
+  open.used += data.size();
+  open.live_bytes += data.size();
+  shard->live_bytes += data.size();
+  unused_slab_bytes_.FetchSubRelaxed(data.size());
+  LinkValue(&open, value.get());
+  return value.release();
+}
+
+void CompressedSlabStore::Free(Value* value) {
+  Shard* shard = value->shard;
+  {
+    MutexLock l(&shard->mutex);
+    if (value->slab == kNoSlab) {
+      --shard->num_standalone_values;
+      shard->standalone_bytes -= value->size;
+    } else {
+      Slab& slab = shard->slabs[value->slab];
+      UnlinkValue(&slab, value);
+      slab.live_bytes -= value->size;
+      shard->live_bytes -= value->size;
+      shard->store->unused_slab_bytes_.FetchAddRelaxed(value->size);
+      if (slab.live_bytes == 0 && slab.pins == 0 &&
+          value->slab != shard->open_slab) {
+        shard->store->ReleaseSlab(shard, value->slab);
+      }
+    }
+  }
+  delete value;
+}
+
+CompressedSlabStore::Stats CompressedSlabStore::GetStats() const {
+  Stats stats;
+  for (uint32_t i = 0; i <= shard_mask_; ++i) {
+    Shard& shard = shards_[i];
+    MutexLock l(&shard.mutex);
+    stats.num_slabs += shard.num_slabs;
+    stats.live_bytes += shard.live_bytes;
+    stats.num_standalone_values += shard.num_standalone_values;
+    stats.standalone_bytes += shard.standalone_bytes;
+    stats.num_compactions += shard.num_compactions;
+    stats.relocated_bytes += shard.relocated_bytes;
+  }
+  stats.slab_bytes = stats.num_slabs * slab_size_;
+  return stats;
+}
+
+uint32_t CompressedSlabStore::OpenSlab(Shard* shard) {
+  uint32_t index;
+  if (shard->released_slabs.empty()) {
+    index = static_cast<uint32_t>(shard->slabs.size());
+    shard->slabs.emplace_back();
+  } else {
+    index = shard->released_slabs.back();
+    shard->released_slabs.pop_back();
+  }
+  Slab& slab = shard->slabs[index];
+  assert(slab.memory == nullptr);
+  slab.memory = AllocateBlock(slab_size_, allocator_.get());
+  ++shard->num_slabs;
+  unused_slab_bytes_.FetchAddRelaxed(slab_size_);
+  return index;
+}
+
+void CompressedSlabStore::ReleaseSlab(Shard* shard, uint32_t index) {
+  Slab& slab = shard->slabs[index];
+  assert(slab.live_bytes == 0);
+  assert(slab.values == nullptr);
+  assert(slab.pins == 0);
+  slab.memory.reset();
+  slab.used = 0;
+  shard->released_slabs.push_back(index);
+  --shard->num_slabs;
+  unused_slab_bytes_.FetchSubRelaxed(slab_size_);
+}
+
+void CompressedSlabStore::Compact(Shard* shard, size_t reserved) {
+  Slab& open = shard->slabs[shard->open_slab];
+  for (;;) {
+    // Pick the sealed slab with the fewest live bytes
+    uint32_t victim = kNoSlab;
+    for (uint32_t i = 0; i < shard->slabs.size(); ++i) {
+      const Slab& slab = shard->slabs[i];
+      if (i == shard->open_slab || slab.memory == nullptr || slab.pins > 0) {
+        continue;
+      }
+      if (victim == kNoSlab ||
+          slab.live_bytes < shard->slabs[victim].live_bytes) {
+        victim = i;
+      }
+    }
+    if (victim == kNoSlab) {
+      return;
+    }
+    Slab& slab = shard->slabs[victim];
+    if (slab.live_bytes * 2 > slab_size_ ||
+        open.used + slab.live_bytes + reserved > slab_size_) {
+      return;
+    }
+
+    // Relocating a value leaves the unused bytes unchanged
+    while (slab.values != nullptr) {
+      Value* value = slab.values;
+      UnlinkValue(&slab, value);
+      std::memcpy(open.memory.get() + open.used, value->data, value->size);
+      value->data = open.memory.get() + open.used;
+      value->slab = shard->open_slab;
+      open.used += value->size;
+      open.live_bytes += value->size;
+      LinkValue(&open, value);
+    }
+    ++shard->num_compactions;
+    shard->relocated_bytes += slab.live_bytes;
+    slab.live_bytes = 0;
+    ReleaseSlab(shard, victim);
+  }
+}
+
+void CompressedSlabStore::LinkValue(Slab* slab, Value* value) {
+  value->prev = nullptr;
+  value->next = slab->values;
+  if (slab->values != nullptr) {
+    slab->values->prev = value;
+  }
+  slab->values = value;
+}
+
+void CompressedSlabStore::UnlinkValue(Slab* slab, Value* value) {
+  if (value->prev != nullptr) {
+    value->prev->next = value->next;
+  } else {
+    assert(slab->values == value);
+    slab->values = value->next;
+  }
+  if (value->next != nullptr) {
+    value->next->prev = value->prev;
+  }
+  value->prev = nullptr;
+  value->next = nullptr;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
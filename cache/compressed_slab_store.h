@@ -0,0 +1,144 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "memory/memory_allocator_impl.h"
+#include "port/port.h"
+#include "rocksdb/slice.h"
+#include "util/atomic.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Stores the values of a CompressedSecondaryCache in large slabs of a fixed
+// size, for CompressedSecondaryCacheOptions::slab_size, instead of in one
+// allocation (or chain of chunks) per value.
+//
+// Each shard appends values to its open slab, log structured. When the open
+// slab is full, the shard seals it and opens another one. A slab whose values
+// are all freed is released right away, and when a new slab is opened, the
+// sealed slabs with at most half of their bytes still live are compacted: their
+// live values are relocated into the new slab and the slabs are released. So
+// compaction copies at most one slab worth of data per slab filled, and the
+// memory of the slabs is not much more than twice the size of the live values.
+// The cache reserves the bytes of the slabs not holding live values (see
+// GetUnusedSlabBytes()), so that the slabs stay within its capacity.
+//
+// Values whose data is read must be pinned (see PinnedData), so that their
+// slab is not compacted in the meantime. Values larger than a slab are stored
+// in their own allocation.
+class CompressedSlabStore {
+ public:
+  struct Value;
+
+  struct Stats {
+    size_t num_slabs = 0;
+    // Memory of the slabs, and bytes of the live values in them
+    size_t slab_bytes = 0;
+    size_t live_bytes = 0;
+    // Values stored in their own allocation
+    size_t num_standalone_values = 0;
+    size_t standalone_bytes = 0;
+    uint64_t num_compactions = 0;
+    uint64_t relocated_bytes = 0;
+
+    // Share of the slab memory not holding live values
+    double Fragmentation() const {
+      return slab_bytes == 0 ? 0.0
+                             : 1.0 - static_cast<double>(live_bytes) /
+                                         static_cast<double>(slab_bytes);
+    }
+  };
+
+  // Keeps the data of a pinned value in place until destroyed or Reset(). The
+  // value must not be freed in the meantime.
+  class PinnedData {
+   public:
+    PinnedData() = default;
+    ~PinnedData() { Reset(); }
+
+    PinnedData(const PinnedData&) = delete;
+    PinnedData& operator=(const PinnedData&) = delete;
+
+    void Pin(Value* value);
+    const Slice& data() const { return data_; }
+    void Reset();
+
+   private:
+    Value* value_ = nullptr;
+    Slice data_;
+  };
+
+  CompressedSlabStore(size_t slab_size, int num_shard_bits,
+                      std::shared_ptr<MemoryAllocator> allocator);
+  // All values must have been freed
+  ~CompressedSlabStore();
+
+  CompressedSlabStore(const CompressedSlabStore&) = delete;
+  CompressedSlabStore& operator=(const CompressedSlabStore&) = delete;
+
+  // Copies `data` into the store, in the shard selected by `hash`. The
+  // returned value must be passed to Free().
+  Value* Add(const Slice& data, uint32_t hash);
+
+  static void Free(Value* value);
+
+  Stats GetStats() const;
+
+  // Bytes of the slabs not holding live values: freed values not compacted
+  // yet and the free end of the open slabs
+  size_t GetUnusedSlabBytes() const { return unused_slab_bytes_.LoadRelaxed(); }
+
+  size_t slab_size() const { return slab_size_; }
+
+ private:
+  static constexpr uint32_t kNoSlab = UINT32_MAX;
+
+  struct Slab {
+    CacheAllocationPtr memory;
+    // Bytes appended so far, and bytes of the values still in the slab
+    size_t used = 0;
+    size_t live_bytes = 0;
+    uint32_t pins = 0;
+    // Values in the slab, linked through Value::next
+    Value* values = nullptr;
+  };
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) Shard {
+    CompressedSlabStore* store = nullptr;
+    port::Mutex mutex;
+    // Released slabs keep their index, for reuse
+    std::vector<Slab> slabs;
+    std::vector<uint32_t> released_slabs;
+    uint32_t open_slab = kNoSlab;
+    size_t num_slabs = 0;
+    size_t live_bytes = 0;
+    size_t num_standalone_values = 0;
+    size_t standalone_bytes = 0;
+    uint64_t num_compactions = 0;
+    uint64_t relocated_bytes = 0;
+  };
+
+  // All of the following require the shard's mutex
+  uint32_t OpenSlab(Shard* shard);
+  void ReleaseSlab(Shard* shard, uint32_t slab);
+  // Compacts sealed slabs into the open slab, keeping `reserved` bytes free
+  void Compact(Shard* shard, size_t reserved);
+  static void LinkValue(Slab* slab, Value* value);
+  static void UnlinkValue(Slab* slab, Value* value);
+
+  const size_t slab_size_;
+  const std::shared_ptr<MemoryAllocator> allocator_;
+  const uint32_t shard_mask_;
+  std::unique_ptr<Shard[]> shards_;
+  RelaxedAtomic<size_t> unused_slab_bytes_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
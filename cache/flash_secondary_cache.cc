@@ -0,0 +1,659 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/flash_secondary_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#include "util/cast_util.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+#include "util/string_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// A record is laid out as:
+//  * 4 bytes of masked crc32c of the rest of the record
+//  * 1 byte for the "source" CacheTier
+//  * 1 byte for the CompressionType of the data
+//  * the key, length prefixed
+//  * the data
+constexpr size_t kRecordHeaderSize = 6;
+
+constexpr const char* kSegmentFileSuffix = ".fsc";
+
+std::string SegmentFileName(const std::string& path, uint64_t id) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "/%06" PRIu64 "%s", id, kSegmentFileSuffix);
+  return path + buf;
+}
+
+// Returns false if the record is corrupted or for another key
+bool ParseRecord(const Slice& record, const Slice& key, Slice* data,
+                 CompressionType* type, CacheTier* source) {
+  if (record.size() < kRecordHeaderSize) {
+    return false;
+  }
+  uint32_t expected = crc32c::Unmask(DecodeFixed32(record.data()));
+  if (crc32c::Value(record.data() + 4, record.size() - 4) != expected) {
+    return false;
+  }
+  *source = lossless_cast<CacheTier>(record[4]);
+  *type = lossless_cast<CompressionType>(record[5]);
+  Slice input(record.data() + kRecordHeaderSize,
+              record.size() - kRecordHeaderSize);
+  Slice record_key;
+  if (!GetLengthPrefixedSlice(&input, &record_key) || record_key != key) {
+    return false;
+  }
+  *data = input;
+  return true;
+}
+
+}  // namespace
+
+class FlashSecondaryCache::ResultHandle : public SecondaryCacheResultHandle {
+ public:
+  ResultHandle(FlashSecondaryCache* cache, const Slice& key,
+               const Cache::CacheItemHelper* helper,
+               Cache::CreateContext* create_context, size_t size)
+      : cache_(cache),
+        key_(key.ToString()),
+        helper_(helper),
+        create_context_(create_context),
+        size_(size),
+        scratch_(new char[size]) {}
+
+  ~ResultHandle() override {
+    if (io_handle_ != nullptr) {
+      if (!read_done_) {
+        std::vector<void*> io_handles{io_handle_};
+        cache_->fs_->AbortIO(io_handles).PermitUncheckedError();
+      }
+      del_fn_(io_handle_);
+    }
+    read_status_.PermitUncheckedError();
+  }
+
+  bool IsReady() override { return ready_; }
+
+  void Wait() override { cache_->WaitAll({this}); }
+
+  Cache::ObjectPtr Value() override { return value_; }
+
+  size_t Size() override { return charge_; }
+
+ private:
+  friend class FlashSecondaryCache;
+
+  static void OnReadDone(FSReadRequest& req, void* cb_arg) {
+    auto* handle = static_cast<ResultHandle*>(cb_arg);
+    handle->read_status_ = req.status;
+    handle->result_ = req.result;
+    handle->read_done_ = true;
+  }
+
+  // Creates the value from the record read, if any, and makes the handle
+  // ready.
+  void Complete() {
+    Slice data;
+    CompressionType type;
+    CacheTier source;
+    if (read_done_ && read_status_.ok() && result_.size() == size_ &&
+        ParseRecord(result_, key_, &data, &type, &source)) {
+      Status s = helper_->create_cb(data, type, source, create_context_,
+                                    /*allocator=*/nullptr, &value_, &charge_);
+      if (!s.ok()) {
+        value_ = nullptr;
+        charge_ = 0;
+      }
+    }
+    ready_ = true;
+    segment_.reset();
+    result_ = Slice();
+    scratch_.reset();
+  }
+
+  FlashSecondaryCache* const cache_;
+  const std::string key_;
+  const Cache::CacheItemHelper* const helper_;
+  Cache::CreateContext* const create_context_;
+  // Size of the record
+  const size_t size_;
+  std::unique_ptr<char[]> scratch_;
+  // Keeps the file open while reading
+  std::shared_ptr<Segment> segment_;
+
+  void* io_handle_ = nullptr;
+  IOHandleDeleter del_fn_;
+  bool read_done_ = false;
+  IOStatus read_status_;
+  Slice result_;
+
+  bool ready_ = false;
+  Cache::ObjectPtr value_ = nullptr;
+  size_t charge_ = 0;
+};
+
+FlashSecondaryCache::FlashSecondaryCache(const FlashSecondaryCacheOptions& opts)
+    : path_(opts.path),
+      fs_(opts.fs ? opts.fs : FileSystem::Default()),
+      segment_size_(std::min(opts.segment_size, size_t{UINT32_MAX})),
+      write_batch_size_(std::min(opts.write_batch_size, segment_size_)),
+      use_direct_io_(opts.use_direct_io),
+      index_(new IndexShard[size_t{1} << kNumIndexShardBits]),
+      write_cv_(&write_mutex_),
+      capacity_(opts.capacity),
+      max_segments_(std::max(size_t{2}, opts.capacity / segment_size_)) {}
+
+FlashSecondaryCache::~FlashSecondaryCache() {
+  {
+    MutexLock l(&write_mutex_);
+    stop_ = true;
+    write_cv_.SignalAll();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  for (const std::string& file_name : files_to_delete_) {
+    fs_->DeleteFile(file_name, IOOptions(), nullptr).PermitUncheckedError();
+  }
+  for (auto& segment : segments_) {
+    segment.second->writer.reset();
+    fs_->DeleteFile(segment.second->file_name, IOOptions(), nullptr)
+        .PermitUncheckedError();
+  }
+}
+
+Status FlashSecondaryCache::Open() {
+  if (path_.empty() || segment_size_ == 0 || write_batch_size_ == 0) {
+    return Status::InvalidArgument(
+        "FlashSecondaryCache needs a path and non-zero segment_size and "
+        "write_batch_size");
+  }
+  IOStatus s = fs_->CreateDirIfMissing(path_, IOOptions(), nullptr);
+  if (!s.ok()) {
+    return s;
+  }
+  std::vector<std::string> children;
+  s = fs_->GetChildren(path_, IOOptions(), &children, nullptr);
+  if (!s.ok()) {
+    return s;
+  }
+  for (const std::string& child : children) {
+    if (EndsWith(child, kSegmentFileSuffix)) {
+      s = fs_->DeleteFile(path_ + "/" + child, IOOptions(), nullptr);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+  }
+
+  MutexLock l(&write_mutex_);
+  OpenSegment();
+  // Create the first segment file right away, to report whether the file
+  // system supports the options
+  std::unique_ptr<RandomAccessFileReader> reader;
+  s = CreateSegmentFile(current_segment_.get(), &reader);
+  if (!s.ok()) {
+    return s;
+  }
+  current_segment_->reader = std::move(reader);
+  thread_ = port::Thread(&FlashSecondaryCache::WriteBatches, this);
+  return Status::OK();
+}
+
+Status FlashSecondaryCache::Insert(const Slice& key, Cache::ObjectPtr obj,
+                                   const Cache::CacheItemHelper* helper,
+                                   bool /*force_insert*/) {
+  if (!helper->IsSecondaryCacheCompatible()) {
+    return Status::OK();
+  }
+  size_t size = helper->size_cb(obj);
+  return AddRecord(
+      key, size,
+      [&](char* out) { return helper->saveto_cb(obj, 0, size, out); },
+      CompressionType::kNoCompression, CacheTier::kVolatileTier);
+}
+
+Status FlashSecondaryCache::InsertSaved(const Slice& key, const Slice& saved,
+                                        CompressionType type,
+                                        CacheTier source) {
+  return AddRecord(
+      key, saved.size(),
+      [&](char* out) {
+        std::memcpy(out, saved.data(), saved.size());
+        return Status::OK();
+      },
+      type, source);
+}
+
+Status FlashSecondaryCache::AddRecord(const Slice& key, size_t data_size,
+                                      const std::function<Status(char*)>& fill,
+                                      CompressionType type, CacheTier source) {
+  size_t record_size =
+      kRecordHeaderSize + VarintLength(key.size()) + key.size() + data_size;
+  if (record_size > segment_size_) {
+    // Not cached
+    return Status::OK();
+  }
+  std::string record;
+  record.reserve(record_size);
+  record.resize(kRecordHeaderSize);
+  record[4] = static_cast<char>(source);
+  record[5] = static_cast<char>(type);
+  PutLengthPrefixedSlice(&record, key);
+  size_t data_offset = record.size();
+  record.resize(record_size);
+  Status s = fill(&record[data_offset]);
+  if (!s.ok()) {
+    return s;
+  }
+  EncodeFixed32(&record[0], crc32c::Mask(crc32c::Value(record.data() + 4,
+                                                       record.size() - 4)));
+  uint64_t hash = GetSliceNPHash64(key);
+
+  std::vector<std::shared_ptr<Segment>> evicted;
+  {
+    MutexLock l(&write_mutex_);
+    if (current_segment_ == nullptr) {
+      // Not open
+      return Status::OK();
+    }
+    bool segment_full = current_segment_->size + record_size > segment_size_;
+    if (segment_full ||
+        active_batch_->data.size() + record_size > write_batch_size_) {
+      if (pending_batches_.size() >= kMaxPendingBatches) {
+        // The background thread is behind
+        return Status::OK();
+      }
+      SealBatch(/*last=*/segment_full);
+      if (segment_full) {
+        OpenSegment();
+        evicted = EvictSegments();
+      } else {
+        StartBatch();
+      }
+    }
+
+    Location location{current_segment_->id, current_segment_->size,
+                      static_cast<uint32_t>(record_size)};
+    active_batch_->data.append(record);
+    current_segment_->size += static_cast<uint32_t>(record_size);
+    current_segment_->hashes.push_back(hash);
+    IndexShard& shard = GetIndexShard(hash);
+    MutexLock index_lock(&shard.mutex);
+    shard.map[hash] = location;
+  }
+  for (const auto& segment : evicted) {
+    RemoveFromIndex(*segment);
+  }
+  return Status::OK();
+}
+
+bool FlashSecondaryCache::FindLocation(const Slice& key, Location* location) {
+  uint64_t hash = GetSliceNPHash64(key);
+  IndexShard& shard = GetIndexShard(hash);
+  MutexLock l(&shard.mutex);
+  auto it = shard.map.find(hash);
+  if (it == shard.map.end()) {
+    return false;
+  }
+  *location = it->second;
+  return true;
+}
+
+std::unique_ptr<SecondaryCacheResultHandle> FlashSecondaryCache::Lookup(
+    const Slice& key, const Cache::CacheItemHelper* helper,
+    Cache::CreateContext* create_context, bool wait, bool /*advise_erase*/,
+    Statistics* /*stats*/, bool& kept_in_sec_cache) {
+  assert(helper);
+  kept_in_sec_cache = false;
+  Location location;
+  if (!FindLocation(key, &location)) {
+    return nullptr;
+  }
+  std::unique_ptr<ResultHandle> handle(
+      new ResultHandle(this, key, helper, create_context, location.size));
+  {
+    MutexLock l(&write_mutex_);
+    const Batch* batch = FindBatch(location);
+    if (batch != nullptr) {
+      std::memcpy(handle->scratch_.get(),
+                  batch->data.data() + (location.offset - batch->offset),
+                  location.size);
+      handle->result_ = Slice(handle->scratch_.get(), location.size);
+      handle->read_done_ = true;
+    } else {
+      auto it = segments_.find(location.segment);
+      if (it == segments_.end() || it->second->failed ||
+          it->second->reader == nullptr) {
+        return nullptr;
+      }
+      handle->segment_ = it->second;
+    }
+  }
+
+  if (!handle->read_done_) {
+    RandomAccessFileReader* reader = handle->segment_->reader.get();
+    bool read_async = false;
+    if (!wait) {
+      int64_t supported_ops = 0;
+      fs_->SupportedOps(supported_ops);
+      read_async = (supported_ops & (1 << FSSupportedOps::kAsyncIO)) != 0;
+    }
+    if (read_async) {
+      FSReadRequest req;
+      req.offset = location.offset;
+      req.len = location.size;
+      req.scratch = handle->scratch_.get();
+      IOStatus s = reader->ReadAsync(
+          req, IOOptions(), &ResultHandle::OnReadDone, handle.get(),
+          &handle->io_handle_, &handle->del_fn_, /*aligned_buf=*/nullptr);
+      if (!s.ok()) {
+        // Read synchronously instead
+        s.PermitUncheckedError();
+        read_async = false;
+      } else if (!handle->read_done_) {
+        kept_in_sec_cache = true;
+        return handle;
+      }
+    }
+    if (!read_async) {
+      handle->read_status_ =
+          reader->Read(IOOptions(), location.offset, location.size,
+                       &handle->result_, handle->scratch_.get(),
+                       /*direct_io_buffer_context=*/nullptr);
+      handle->read_done_ = true;
+    }
+  }
+
+  if (handle->io_handle_ != nullptr) {
+    handle->del_fn_(handle->io_handle_);
+    handle->io_handle_ = nullptr;
+  }
+  handle->Complete();
+  if (handle->Value() == nullptr) {
+    return nullptr;
+  }
+  kept_in_sec_cache = true;
+  return handle;
+}
+
+void FlashSecondaryCache::Erase(const Slice& key) {
+  uint64_t hash = GetSliceNPHash64(key);
+  IndexShard& shard = GetIndexShard(hash);
+  MutexLock l(&shard.mutex);
+  shard.map.erase(hash);
+}
+
+void FlashSecondaryCache::WaitAll(
+    std::vector<SecondaryCacheResultHandle*> handles) {
+  std::vector<ResultHandle*> pending;
+  std::vector<void*> io_handles;
+  for (SecondaryCacheResultHandle* h : handles) {
+    auto* handle = static_cast<ResultHandle*>(h);
+    if (handle->IsReady()) {
+      continue;
+    }
+    pending.push_back(handle);
+    if (!handle->read_done_ && handle->io_handle_ != nullptr) {
+      io_handles.push_back(handle->io_handle_);
+    }
+  }
+  if (!io_handles.empty()) {
+    fs_->Poll(io_handles, io_handles.size()).PermitUncheckedError();
+  }
+  for (ResultHandle* handle : pending) {
+    if (handle->io_handle_ != nullptr) {
+      if (!handle->read_done_) {
+        std::vector<void*> to_abort{handle->io_handle_};
+        fs_->AbortIO(to_abort).PermitUncheckedError();
+      }
+      handle->del_fn_(handle->io_handle_);
+      handle->io_handle_ = nullptr;
+    }
+    handle->Complete();
+  }
+}
+
+Status FlashSecondaryCache::SetCapacity(size_t capacity) {
+  std::vector<std::shared_ptr<Segment>> evicted;
+  {
+    MutexLock l(&write_mutex_);
+    capacity_ = capacity;
+    max_segments_ = std::max(size_t{2}, capacity / segment_size_);
+    evicted = EvictSegments();
+  }
+  for (const auto& segment : evicted) {
+    RemoveFromIndex(*segment);
+  }
+  return Status::OK();
+}
+
+Status FlashSecondaryCache::GetCapacity(size_t& capacity) {
+  MutexLock l(&write_mutex_);
+  capacity = capacity_;
+  return Status::OK();
+}
+
+std::string FlashSecondaryCache::GetPrintableOptions() const {
+  std::string ret;
+  const int kBufferSize{200};
+  char buffer[kBufferSize];
+  snprintf(buffer, kBufferSize, "    path : %s\n", path_.c_str());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    segment_size : %" ROCKSDB_PRIszt "\n",
+           segment_size_);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    write_batch_size : %" ROCKSDB_PRIszt "\n",
+           write_batch_size_);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    use_direct_io : %d\n", use_direct_io_);
+  ret.append(buffer);
+  return ret;
+}
+
+void FlashSecondaryCache::TEST_WaitForPendingWrites() {
+  MutexLock l(&write_mutex_);
+  if (!active_batch_->data.empty()) {
+    SealBatch(/*last=*/false);
+    StartBatch();
+  }
+  while (busy_ || !pending_batches_.empty() || !files_to_delete_.empty()) {
+    write_cv_.Wait();
+  }
+}
+
+size_t FlashSecondaryCache::TEST_GetNumSegments() {
+  MutexLock l(&write_mutex_);
+  return segments_.size();
+}
+
+void FlashSecondaryCache::OpenSegment() {
+  write_mutex_.AssertHeld();
+  uint64_t id = next_segment_id_++;
+  auto segment = std::make_shared<Segment>();
+  segment->id = id;
+  segment->file_name = SegmentFileName(path_, id);
+  segments_[id] = segment;
+  current_segment_ = std::move(segment);
+  StartBatch();
+}
+
+void FlashSecondaryCache::SealBatch(bool last) {
+  write_mutex_.AssertHeld();
+  active_batch_->last = last;
+  pending_batches_.push_back(std::move(active_batch_));
+  write_cv_.SignalAll();
+}
+
+void FlashSecondaryCache::StartBatch() {
+  write_mutex_.AssertHeld();
+  active_batch_.reset(new Batch());
+  active_batch_->segment = current_segment_->id;
+  active_batch_->offset = current_segment_->size;
+  active_batch_->data.reserve(write_batch_size_);
+}
+
+std::vector<std::shared_ptr<FlashSecondaryCache::Segment>>
+FlashSecondaryCache::EvictSegments() {
+  write_mutex_.AssertHeld();
+  std::vector<std::shared_ptr<Segment>> evicted;
+  while (segments_.size() > max_segments_) {
+    auto it = segments_.begin();
+    assert(it->second != current_segment_);
+    // The background thread deletes the file, after any write to it
+    files_to_delete_.push_back(it->second->file_name);
+    evicted.push_back(std::move(it->second));
+    segments_.erase(it);
+  }
+  if (!evicted.empty()) {
+    write_cv_.SignalAll();
+  }
+  return evicted;
+}
+
+const FlashSecondaryCache::Batch* FlashSecondaryCache::FindBatch(
+    const Location& location) const {
+  write_mutex_.AssertHeld();
+  auto contains = [&location](const Batch& batch) {
+    return batch.segment == location.segment &&
+           location.offset >= batch.offset &&
+           location.offset - batch.offset < batch.data.size();
+  };
+  if (active_batch_ != nullptr && contains(*active_batch_)) {
+    return active_batch_.get();
+  }
+  for (const auto& batch : pending_batches_) {
+    if (contains(*batch)) {
+      return batch.get();
+    }
+  }
+  return nullptr;
+}
+
+void FlashSecondaryCache::RemoveFromIndex(const Segment& segment) {
+  // One pass per shard, to take each shard's mutex once
+  for (size_t i = 0; i < (size_t{1} << kNumIndexShardBits); ++i) {
+    IndexShard& shard = index_[i];
+    MutexLock l(&shard.mutex);
+    for (uint64_t hash : segment.hashes) {
+      if (&GetIndexShard(hash) != &shard) {
+        continue;
+      }
+      auto it = shard.map.find(hash);
+      // The key might have been inserted again since
+      if (it != shard.map.end() && it->second.segment == segment.id) {
+        shard.map.erase(it);
+      }
+    }
+  }
+}
+
+IOStatus FlashSecondaryCache::CreateSegmentFile(
+    Segment* segment, std::unique_ptr<RandomAccessFileReader>* reader) {
+  FileOptions write_opts;
+  write_opts.use_direct_writes = use_direct_io_;
+  IOStatus s = WritableFileWriter::Create(fs_, segment->file_name, write_opts,
+                                          &segment->writer, nullptr);
+  if (s.ok()) {
+    FileOptions read_opts;
+    read_opts.use_direct_reads = use_direct_io_;
+    s = RandomAccessFileReader::Create(fs_, segment->file_name, read_opts,
+                                       reader, nullptr);
+  }
+  return s;
+}
+
+void FlashSecondaryCache::WriteBatches() {
+  for (;;) {
+    std::vector<std::string> to_delete;
+    const Batch* batch = nullptr;
+    std::shared_ptr<Segment> segment;
+    {
+      MutexLock l(&write_mutex_);
+      while (!stop_ && pending_batches_.empty() && files_to_delete_.empty()) {
+        write_cv_.Wait();
+      }
+      if (stop_) {
+        return;
+      }
+      to_delete.swap(files_to_delete_);
+      busy_ = true;
+      if (!pending_batches_.empty()) {
+        batch = pending_batches_.front().get();
+        auto it = segments_.find(batch->segment);
+        // Batches of evicted or failed segments are dropped
+        if (it != segments_.end() && !it->second->failed) {
+          segment = it->second;
+        }
+      }
+    }
+
+    for (const std::string& file_name : to_delete) {
+      fs_->DeleteFile(file_name, IOOptions(), nullptr).PermitUncheckedError();
+    }
+    IOStatus s;
+    std::unique_ptr<RandomAccessFileReader> reader;
+    if (segment != nullptr) {
+      s = WriteToSegment(segment.get(), *batch, &reader);
+    }
+
+    MutexLock l(&write_mutex_);
+    if (segment != nullptr) {
+      if (!s.ok()) {
+        segment->failed = true;
+        segment->writer.reset();
+      } else if (reader != nullptr) {
+        segment->reader = std::move(reader);
+      }
+    }
+    s.PermitUncheckedError();
+    if (batch != nullptr) {
+      pending_batches_.pop_front();
+    }
+    busy_ = false;
+    write_cv_.SignalAll();
+  }
+}
+
+IOStatus FlashSecondaryCache::WriteToSegment(
+    Segment* segment, const Batch& batch,
+    std::unique_ptr<RandomAccessFileReader>* reader) {
+  IOStatus s;
+  if (segment->writer == nullptr) {
+    s = CreateSegmentFile(segment, reader);
+  }
+  if (s.ok() && !batch.data.empty()) {
+    s = segment->writer->Append(IOOptions(), batch.data);
+  }
+  if (s.ok()) {
+    s = segment->writer->Flush(IOOptions());
+  }
+  if (s.ok() && batch.last) {
+    s = segment->writer->Close(IOOptions());
+    segment->writer.reset();
+  }
+  return s;
+}
+
+Status FlashSecondaryCacheOptions::MakeSharedSecondaryCache(
+    std::shared_ptr<SecondaryCache>* result) const {
+  auto cache = std::make_shared<FlashSecondaryCache>(*this);
+  Status s = cache->Open();
+  if (s.ok()) {
+    *result = std::move(cache);
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
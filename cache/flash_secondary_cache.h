@@ -0,0 +1,190 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file/random_access_file_reader.h"
+#include "file/writable_file_writer.h"
+#include "port/port.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/file_system.h"
+#include "rocksdb/secondary_cache.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A SecondaryCache on local flash, for FlashSecondaryCacheOptions.
+//
+// The cache is log structured. Inserted values are appended, as records, to
+// an in-memory batch of write_batch_size bytes, and full batches are written
+// by a background thread to the end of the current segment file, with one
+// large (direct) write each. Each segment holds segment_size bytes, and when
+// a new segment would take the cache over its capacity, the oldest segment is
+// evicted as a whole, FIFO: its file is deleted and its keys are dropped from
+// the index. Nothing is ever overwritten in place, so the flash only sees
+// large sequential writes and whole-file deletes.
+//
+// An in-memory index maps the hash of each key to the location of its latest
+// record. Records carry their key and a checksum, so lookups of a colliding
+// hash or of a torn record are misses. Lookups of records still in memory are
+// served from the batches, and others read the record from its segment, with
+// an async read when the handle need not be ready right away, completed by
+// WaitAll().
+//
+// When the background thread falls behind, inserts are dropped rather than
+// buffered without bound. The cache starts empty: segments left by an earlier
+// instance in the same directory are deleted when opening.
+class FlashSecondaryCache : public SecondaryCache {
+ public:
+  explicit FlashSecondaryCache(const FlashSecondaryCacheOptions& opts);
+  // Drops the batches not written yet and deletes the segments
+  ~FlashSecondaryCache() override;
+
+  // Prepares the directory and starts the background thread
+  Status Open();
+
+  const char* Name() const override { return "FlashSecondaryCache"; }
+
+  Status Insert(const Slice& key, Cache::ObjectPtr obj,
+                const Cache::CacheItemHelper* helper,
+                bool force_insert) override;
+
+  Status InsertSaved(const Slice& key, const Slice& saved,
+                     CompressionType type = CompressionType::kNoCompression,
+                     CacheTier source = CacheTier::kVolatileTier) override;
+
+  std::unique_ptr<SecondaryCacheResultHandle> Lookup(
+      const Slice& key, const Cache::CacheItemHelper* helper,
+      Cache::CreateContext* create_context, bool wait, bool advise_erase,
+      Statistics* stats, bool& kept_in_sec_cache) override;
+
+  bool SupportForceErase() const override { return true; }
+
+  void Erase(const Slice& key) override;
+
+  void WaitAll(std::vector<SecondaryCacheResultHandle*> handles) override;
+
+  Status SetCapacity(size_t capacity) override;
+
+  Status GetCapacity(size_t& capacity) override;
+
+  std::string GetPrintableOptions() const override;
+
+  // Queues the active batch and waits for the queued batches to be written
+  void TEST_WaitForPendingWrites();
+  size_t TEST_GetNumSegments();
+
+ private:
+  class ResultHandle;
+
+  static constexpr int kNumIndexShardBits = 4;
+  // Inserts are dropped while this many batches wait for the background
+  // thread
+  static constexpr size_t kMaxPendingBatches = 2;
+
+  struct Location {
+    uint64_t segment;
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) IndexShard {
+    port::Mutex mutex;
+    std::unordered_map<uint64_t, Location> map;
+  };
+
+  struct Segment {
+    uint64_t id = 0;
+    std::string file_name;
+    // Hashes of the keys inserted in the segment, for evicting it
+    std::vector<uint64_t> hashes;
+    // Bytes appended so far, to the file or to batches not written yet
+    uint32_t size = 0;
+    // Only used by the background thread
+    std::unique_ptr<WritableFileWriter> writer;
+    // Set once the first batch is written, under write_mutex_
+    std::unique_ptr<RandomAccessFileReader> reader;
+    // A failed write leaves the segment unreadable
+    bool failed = false;
+  };
+
+  struct Batch {
+    uint64_t segment = 0;
+    // Offset of the batch in its segment
+    uint32_t offset = 0;
+    std::string data;
+    // The segment is complete after this batch
+    bool last = false;
+  };
+
+  IndexShard& GetIndexShard(uint64_t hash) {
+    return index_[hash & ((uint64_t{1} << kNumIndexShardBits) - 1)];
+  }
+
+  // Appends a record for `key` holding `data`, which is filled by `fill`.
+  Status AddRecord(const Slice& key, size_t data_size,
+                   const std::function<Status(char*)>& fill,
+                   CompressionType type, CacheTier source);
+
+  bool FindLocation(const Slice& key, Location* location);
+
+  // All of the following require write_mutex_
+  // Makes a new segment the current one
+  void OpenSegment();
+  // Queues the active batch for writing
+  void SealBatch(bool last);
+  // Starts a new active batch at the end of the current segment
+  void StartBatch();
+  // Returns the segments evicted to stay within max_segments_, to be removed
+  // from the index once unlocked
+  std::vector<std::shared_ptr<Segment>> EvictSegments();
+  const Batch* FindBatch(const Location& location) const;
+
+  void RemoveFromIndex(const Segment& segment);
+
+  // Creates the file of `segment` and a reader for it
+  IOStatus CreateSegmentFile(Segment* segment,
+                             std::unique_ptr<RandomAccessFileReader>* reader);
+
+  // Background thread
+  void WriteBatches();
+  IOStatus WriteToSegment(Segment* segment, const Batch& batch,
+                          std::unique_ptr<RandomAccessFileReader>* reader);
+
+  const std::string path_;
+  const std::shared_ptr<FileSystem> fs_;
+  const size_t segment_size_;
+  const size_t write_batch_size_;
+  const bool use_direct_io_;
+
+  std::unique_ptr<IndexShard[]> index_;
+
+  port::Mutex write_mutex_;
+  port::CondVar write_cv_;
+  size_t capacity_;
+  size_t max_segments_;
+  uint64_t next_segment_id_ = 1;
+  std::map<uint64_t, std::shared_ptr<Segment>> segments_;
+  std::shared_ptr<Segment> current_segment_;
+  std::unique_ptr<Batch> active_batch_;
+  // Batches queued for the background thread. A batch stays in the queue
+  // until written, so that lookups can read its records from memory.
+  std::deque<std::unique_ptr<Batch>> pending_batches_;
+  std::vector<std::string> files_to_delete_;
+  // The background thread is writing or deleting files
+  bool busy_ = false;
+  bool stop_ = false;
+  port::Thread thread_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
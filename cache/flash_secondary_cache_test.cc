@@ -0,0 +1,258 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/flash_secondary_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "file/file_util.h"
+#include "rocksdb/cache.h"
+#include "test_util/secondary_cache_test_util.h"
+#include "test_util/testharness.h"
+#include "test_util/testutil.h"
+#include "util/random.h"
+#include "util/string_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+using secondary_cache_test_util::WithCacheType;
+
+class FlashSecondaryCacheTest : public testing::Test, public WithCacheType {
+ public:
+  FlashSecondaryCacheTest()
+      : path_(test::PerThreadDBPath("flash_secondary_cache_test")) {
+    opts_.path = path_;
+    // The test directory might not support direct I/O
+    opts_.use_direct_io = false;
+    opts_.capacity = 1 << 20;
+    opts_.segment_size = 64 << 10;
+    opts_.write_batch_size = 16 << 10;
+  }
+
+  ~FlashSecondaryCacheTest() override {
+    cache_.reset();
+    EXPECT_OK(DestroyDir(Env::Default(), path_));
+  }
+
+  const std::string& Type() const override {
+    static const std::string type = kLRU;
+    return type;
+  }
+
+ protected:
+  void Open() {
+    std::shared_ptr<SecondaryCache> cache;
+    ASSERT_OK(opts_.MakeSharedSecondaryCache(&cache));
+    cache_ = std::static_pointer_cast<FlashSecondaryCache>(cache);
+  }
+
+  static std::string Key(int i) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "____key%09d", i);
+    return buf;
+  }
+
+  void Insert(const std::string& key, const std::string& value) {
+    TestItem item(value.data(), value.size());
+    ASSERT_OK(cache_->Insert(key, &item, GetHelper(), false));
+  }
+
+  // Returns the value found for `key`, or "NOT_FOUND"
+  std::string Lookup(const std::string& key) {
+    bool kept_in_sec_cache = false;
+    std::unique_ptr<SecondaryCacheResultHandle> handle =
+        cache_->Lookup(key, GetHelper(), this, /*wait=*/true,
+                       /*advise_erase=*/false, /*stats=*/nullptr,
+                       kept_in_sec_cache);
+    if (handle == nullptr) {
+      return "NOT_FOUND";
+    }
+    EXPECT_TRUE(handle->IsReady());
+    EXPECT_TRUE(kept_in_sec_cache);
+    std::unique_ptr<TestItem> item(static_cast<TestItem*>(handle->Value()));
+    EXPECT_EQ(handle->Size(), item->Size());
+    return item->ToString();
+  }
+
+  std::string path_;
+  FlashSecondaryCacheOptions opts_;
+  std::shared_ptr<FlashSecondaryCache> cache_;
+};
+
+TEST_F(FlashSecondaryCacheTest, BasicTest) {
+  Open();
+  Random rnd(301);
+  std::string value1 = rnd.RandomString(1000);
+  std::string value2 = rnd.RandomString(2000);
+
+  ASSERT_EQ(Lookup(Key(1)), "NOT_FOUND");
+
+  // Served from the active batch
+  Insert(Key(1), value1);
+  ASSERT_EQ(Lookup(Key(1)), value1);
+
+  // Served from the segment file
+  Insert(Key(2), value2);
+  cache_->TEST_WaitForPendingWrites();
+  ASSERT_EQ(Lookup(Key(1)), value1);
+  ASSERT_EQ(Lookup(Key(2)), value2);
+
+  // The latest value wins
+  Insert(Key(1), value2);
+  ASSERT_EQ(Lookup(Key(1)), value2);
+  cache_->TEST_WaitForPendingWrites();
+  ASSERT_EQ(Lookup(Key(1)), value2);
+
+  cache_->Erase(Key(1));
+  ASSERT_EQ(Lookup(Key(1)), "NOT_FOUND");
+  ASSERT_EQ(Lookup(Key(2)), value2);
+
+  // Values larger than a segment are not cached
+  Insert(Key(3), rnd.RandomString(static_cast<int>(opts_.segment_size)));
+  ASSERT_EQ(Lookup(Key(3)), "NOT_FOUND");
+
+  // Creation failures are misses
+  TestItem item(value1.data(), value1.size());
+  ASSERT_OK(cache_->Insert(Key(4), &item, GetHelper(), false));
+  SetFailCreate(true);
+  bool kept_in_sec_cache = false;
+  ASSERT_EQ(cache_->Lookup(Key(4), GetHelper(), this, /*wait=*/true,
+                           /*advise_erase=*/false, /*stats=*/nullptr,
+                           kept_in_sec_cache),
+            nullptr);
+  SetFailCreate(false);
+  ASSERT_EQ(Lookup(Key(4)), value1);
+}
+
+TEST_F(FlashSecondaryCacheTest, InsertSaved) {
+  Open();
+  Random rnd(301);
+  std::string value = rnd.RandomString(1000);
+  ASSERT_OK(cache_->InsertSaved(Key(1), value));
+  cache_->TEST_WaitForPendingWrites();
+  ASSERT_EQ(Lookup(Key(1)), value);
+}
+
+TEST_F(FlashSecondaryCacheTest, AsyncLookup) {
+  Open();
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < 10; ++i) {
+    values.push_back(rnd.RandomString(3000));
+    Insert(Key(i), values.back());
+    // Some records stay in memory
+    if (i == 7) {
+      cache_->TEST_WaitForPendingWrites();
+    }
+  }
+
+  std::vector<std::unique_ptr<SecondaryCacheResultHandle>> handles;
+  std::vector<SecondaryCacheResultHandle*> to_wait;
+  for (int i = 0; i < 11; ++i) {
+    bool kept_in_sec_cache = false;
+    handles.push_back(cache_->Lookup(Key(i), GetHelper(), this,
+                                     /*wait=*/false, /*advise_erase=*/false,
+                                     /*stats=*/nullptr, kept_in_sec_cache));
+    if (i == 10) {
+      ASSERT_EQ(handles.back(), nullptr);
+      handles.pop_back();
+    } else {
+      ASSERT_NE(handles.back(), nullptr);
+      to_wait.push_back(handles.back().get());
+    }
+  }
+  cache_->WaitAll(to_wait);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(handles[i]->IsReady());
+    std::unique_ptr<TestItem> item(static_cast<TestItem*>(handles[i]->Value()));
+    ASSERT_NE(item, nullptr);
+    ASSERT_EQ(item->ToString(), values[i]);
+  }
+
+  // Handles dropped without waiting
+  bool kept_in_sec_cache = false;
+  std::unique_ptr<SecondaryCacheResultHandle> handle =
+      cache_->Lookup(Key(0), GetHelper(), this, /*wait=*/false,
+                     /*advise_erase=*/false, /*stats=*/nullptr,
+                     kept_in_sec_cache);
+  ASSERT_NE(handle, nullptr);
+  handle->Wait();
+  ASSERT_TRUE(handle->IsReady());
+  std::unique_ptr<TestItem> item(static_cast<TestItem*>(handle->Value()));
+  ASSERT_EQ(item->ToString(), values[0]);
+  handle = cache_->Lookup(Key(1), GetHelper(), this, /*wait=*/false,
+                          /*advise_erase=*/false, /*stats=*/nullptr,
+                          kept_in_sec_cache);
+  if (handle != nullptr && handle->IsReady()) {
+    delete static_cast<TestItem*>(handle->Value());
+  }
+  handle.reset();
+}
+
+TEST_F(FlashSecondaryCacheTest, SegmentEviction) {
+  // Room for four segments
+  opts_.capacity = 4 * opts_.segment_size;
+  Open();
+  Random rnd(301);
+  const int kValueSize = 4000;
+  const int kNumKeys = 100;
+  for (int i = 0; i < kNumKeys; ++i) {
+    Insert(Key(i), rnd.RandomString(kValueSize));
+    // Keep the background thread from falling behind
+    cache_->TEST_WaitForPendingWrites();
+  }
+  ASSERT_EQ(cache_->TEST_GetNumSegments(), 4);
+  std::vector<std::string> children;
+  ASSERT_OK(Env::Default()->GetChildren(path_, &children));
+  size_t num_files = 0;
+  for (const std::string& child : children) {
+    if (EndsWith(child, ".fsc")) {
+      ++num_files;
+    }
+  }
+  ASSERT_EQ(num_files, 4);
+
+  // The oldest keys are gone with their segments
+  ASSERT_EQ(Lookup(Key(0)), "NOT_FOUND");
+  ASSERT_EQ(Lookup(Key(kNumKeys - 60)), "NOT_FOUND");
+  ASSERT_NE(Lookup(Key(kNumKeys - 1)), "NOT_FOUND");
+  ASSERT_NE(Lookup(Key(kNumKeys - 40)), "NOT_FOUND");
+
+  size_t capacity = 0;
+  ASSERT_OK(cache_->GetCapacity(capacity));
+  ASSERT_EQ(capacity, opts_.capacity);
+  ASSERT_OK(cache_->SetCapacity(2 * opts_.segment_size));
+  ASSERT_EQ(cache_->TEST_GetNumSegments(), 2);
+  ASSERT_EQ(Lookup(Key(kNumKeys - 40)), "NOT_FOUND");
+  ASSERT_NE(Lookup(Key(kNumKeys - 1)), "NOT_FOUND");
+}
+
+TEST_F(FlashSecondaryCacheTest, StaleSegmentsDeleted) {
+  // As if left by an instance that crashed
+  Env* env = Env::Default();
+  ASSERT_OK(env->CreateDirIfMissing(path_));
+  const std::string stale = path_ + "/000007.fsc";
+  const std::string other = path_ + "/other";
+  ASSERT_OK(WriteStringToFile(env, "stale", stale));
+  ASSERT_OK(WriteStringToFile(env, "other", other));
+  Open();
+  ASSERT_TRUE(env->FileExists(stale).IsNotFound());
+  ASSERT_OK(env->FileExists(other));
+
+  FlashSecondaryCacheOptions opts = opts_;
+  opts.path.clear();
+  std::shared_ptr<SecondaryCache> cache;
+  ASSERT_TRUE(opts.MakeSharedSecondaryCache(&cache).IsInvalidArgument());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
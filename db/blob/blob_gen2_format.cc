@@ -9,6 +9,7 @@
 #include <cstring>
 #include <string>
 
+#include "file/file_prefetch_buffer.h"
 #include "file/random_access_file_reader.h"
 #include "file/writable_file_writer.h"
 #include "rocksdb/options.h"
@@ -21,9 +22,10 @@ namespace ROCKSDB_NAMESPACE {
 
 Status ReadAndVerifySimpleGen2BlobRecord(
     const ReadOptions& read_options, RandomAccessFileReader* file,
-    uint64_t record_offset, size_t payload_size, size_t record_size,
-    ChecksumType checksum_type, uint32_t base_context_checksum,
-    CompressionType expected_compression, char* buf) {
+    FilePrefetchBuffer* prefetch_buffer, uint64_t record_offset,
+    size_t payload_size, size_t record_size, ChecksumType checksum_type,
+    uint32_t base_context_checksum, CompressionType expected_compression,
+    char* buf) {
   assert(file != nullptr);
   assert(buf != nullptr);
   assert(record_size == payload_size + kSimpleGen2BlobTrailerSize);
@@ -32,7 +34,13 @@ Status ReadAndVerifySimpleGen2BlobRecord(
   IOOptions opts;
   IODebugContext dbg;
   Status s = file->PrepareIOOptions(read_options, opts, &dbg);
-  if (s.ok()) {
+  bool prefetched = false;
+  if (s.ok() && prefetch_buffer != nullptr) {
+    prefetched = prefetch_buffer->TryReadFromCache(
+        opts, file, record_offset, record_size, &result, &s,
+        read_options.io_activity == Env::IOActivity::kCompaction);
+  }
+  if (s.ok() && !prefetched) {
     s = file->Read(opts, record_offset, record_size, &result, buf, nullptr,
                    &dbg);
   }
@@ -42,8 +50,9 @@ Status ReadAndVerifySimpleGen2BlobRecord(
   if (result.size() != record_size) {
     return Status::Corruption("Could not read complete blob record");
   }
-  // With mmap reads the data lands outside `buf`; copy it in so the caller can
-  // rely on `buf` owning the bytes (this is the only copy on the mmap path).
+  // With mmap reads, or when served from `prefetch_buffer`, the data lands
+  // outside `buf`; copy it in so the caller can rely on `buf` owning the bytes
+  // (this is the only copy on those paths).
   // TODO: fix this extra memcpy in the mmap case
   if (result.data() != buf) {
     memcpy(buf, result.data(), record_size);
@@ -18,6 +18,7 @@ namespace ROCKSDB_NAMESPACE {
 
 struct ReadOptions;
 struct WriteOptions;
+class FilePrefetchBuffer;
 class RandomAccessFileReader;
 class WritableFileWriter;
 class Slice;
@@ -65,13 +66,17 @@ inline CacheKey GetSimpleGen2BlobCacheKey(
 // the caller expects the record to carry (from the blob index); it must match
 // the record's marker, and currently must be kNoCompression.
 //
+// When `prefetch_buffer` is non-null, the record is served from it if
+// possible, possibly reading ahead of it into the buffer.
+//
 // On success, buf[0, payload_size) holds the verified, uncompressed payload
 // (the trailer remains at the tail of `buf` and can be ignored).
 Status ReadAndVerifySimpleGen2BlobRecord(
     const ReadOptions& read_options, RandomAccessFileReader* file,
-    uint64_t record_offset, size_t payload_size, size_t record_size,
-    ChecksumType checksum_type, uint32_t base_context_checksum,
-    CompressionType expected_compression, char* buf);
+    FilePrefetchBuffer* prefetch_buffer, uint64_t record_offset,
+    size_t payload_size, size_t record_size, ChecksumType checksum_type,
+    uint32_t base_context_checksum, CompressionType expected_compression,
+    char* buf);
 
 // Reads a byte sub-range [range_offset, range_offset + range_length) of an
 // *uncompressed* SimpleGen2Blob payload directly into `buf` (capacity >=
@@ -464,10 +464,10 @@ Status BlobSource::GetBlobRange(const ReadOptions& read_options,
 
 Status BlobSource::GetSimpleGen2Blob(
     const ReadOptions& read_options, const OffsetableCacheKey& base_cache_key,
-    RandomAccessFileReader* file, uint64_t record_offset, uint64_t payload_size,
-    ChecksumType checksum_type, uint32_t base_context_checksum,
-    CompressionType expected_compression, PinnableSlice* value,
-    uint64_t* bytes_read) {
+    RandomAccessFileReader* file, FilePrefetchBuffer* prefetch_buffer,
+    uint64_t record_offset, uint64_t payload_size, ChecksumType checksum_type,
+    uint32_t base_context_checksum, CompressionType expected_compression,
+    PinnableSlice* value, uint64_t* bytes_read) {
   assert(value);
   assert(file);
 
@@ -517,9 +517,9 @@ Status BlobSource::GetSimpleGen2Blob(
   CacheAllocationPtr buf =
       AllocateBlock(static_cast<size_t>(record_size), allocator);
   s = ReadAndVerifySimpleGen2BlobRecord(
-      read_options, file, record_offset, static_cast<size_t>(payload_size),
-      static_cast<size_t>(record_size), checksum_type, base_context_checksum,
-      expected_compression, buf.get());
+      read_options, file, prefetch_buffer, record_offset,
+      static_cast<size_t>(payload_size), static_cast<size_t>(record_size),
+      checksum_type, base_context_checksum, expected_compression, buf.get());
   if (!s.ok()) {
     return s;
   }
@@ -99,9 +99,9 @@ class BlobSource {
   // file_number). This keeps blob records collision-free with the file's data
   // blocks even when the blob cache and block cache are the same cache.
   //
-  // `file`, `record_offset`, `payload_size`, `checksum_type`,
-  // `base_context_checksum`, and `expected_compression` are the inputs to the
-  // SimpleGen2Blob reader used on a cache miss (see
+  // `file`, `prefetch_buffer` (optional), `record_offset`, `payload_size`,
+  // `checksum_type`, `base_context_checksum`, and `expected_compression` are
+  // the inputs to the SimpleGen2Blob reader used on a cache miss (see
   // ReadAndVerifySimpleGen2BlobRecord). The on-disk record size (payload +
   // trailer) is reported via `*bytes_read` (when non-null) and the
   // BLOB_DB_BLOB_FILE_BYTES_READ / blob_read_byte counters, consistently on
@@ -115,8 +115,10 @@ class BlobSource {
   // lookup/insert.
   Status GetSimpleGen2Blob(const ReadOptions& read_options,
                            const OffsetableCacheKey& base_cache_key,
-                           RandomAccessFileReader* file, uint64_t record_offset,
-                           uint64_t payload_size, ChecksumType checksum_type,
+                           RandomAccessFileReader* file,
+                           FilePrefetchBuffer* prefetch_buffer,
+                           uint64_t record_offset, uint64_t payload_size,
+                           ChecksumType checksum_type,
                            uint32_t base_context_checksum,
                            CompressionType expected_compression,
                            PinnableSlice* value, uint64_t* bytes_read);
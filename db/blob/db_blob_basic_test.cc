@@ -494,6 +494,64 @@ TEST_F(DBBlobBasicTest, IterateBlobsFromCachePinning) {
   }
 }
 
+TEST_F(DBBlobBasicTest, IterateBlobsWithReadahead) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+  options.disable_auto_compactions = true;
+
+  Reopen(options);
+
+  constexpr int kNumBlobs = 100;
+  Random rnd(301);
+  std::vector<std::string> keys;
+  std::vector<std::string> blobs;
+  for (int i = 0; i < kNumBlobs; ++i) {
+    char key[16];
+    snprintf(key, sizeof(key), "key%03d", i);
+    keys.emplace_back(key);
+    blobs.push_back(rnd.RandomString(100));
+    ASSERT_OK(Put(keys[i], blobs[i]));
+  }
+  ASSERT_OK(Flush());
+
+  size_t num_non_prefetch_reads = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlobFileReader::GetBlob:ReadFromFile",
+      [&num_non_prefetch_reads](void* /* arg */) { ++num_non_prefetch_reads; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  auto scan = [&](const ReadOptions& read_options, bool forward) {
+    num_non_prefetch_reads = 0;
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int i = forward ? 0 : kNumBlobs - 1;
+    for (forward ? iter->SeekToFirst() : iter->SeekToLast(); iter->Valid();
+         forward ? iter->Next() : iter->Prev()) {
+      ASSERT_EQ(iter->key(), keys[i]);
+      ASSERT_EQ(iter->value(), blobs[i]);
+      i += forward ? 1 : -1;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, forward ? kNumBlobs : -1);
+  };
+
+  ReadOptions read_options;
+  scan(read_options, /*forward=*/true);
+  ASSERT_EQ(num_non_prefetch_reads, kNumBlobs);
+
+  // All blobs are served by the readahead buffer
+  read_options.blob_readahead_size = 64 << 10;
+  scan(read_options, /*forward=*/true);
+  ASSERT_EQ(num_non_prefetch_reads, 0);
+
+  // No readahead backwards
+  scan(read_options, /*forward=*/false);
+  ASSERT_EQ(num_non_prefetch_reads, kNumBlobs);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBBlobBasicTest, IterateBlobsAllowUnpreparedValue) {
   Options options = GetDefaultOptions();
   options.enable_blob_files = true;
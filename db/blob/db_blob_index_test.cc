@@ -29,6 +29,7 @@
 #include "rocksdb/perf_context.h"
 #include "rocksdb/sst_file_writer.h"
 #include "rocksdb/table.h"
+#include "table/embedded_blob_sst.h"
 #include "util/string_util.h"
 #include "utilities/merge_operators.h"
 
@@ -1119,6 +1120,126 @@ TEST_F(DBBlobIndexTest, EmbeddedBlobWideColumnGetEntityCorruptionSurfaced) {
   ASSERT_TRUE(s.IsCorruption()) << s.ToString();
 }
 
+// With BlockBasedTableOptions::embedded_blob_min_size, flush and compaction
+// store large values as same-file blob records. A Seek() then reads only the
+// value it lands on, and a forward scan coalesces the reads of the values.
+TEST_F(DBBlobIndexTest, EmbeddedBlobsFromTableOptions) {
+  Options options = GetTestOptions();
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions bbto;
+  bbto.embedded_blob_min_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  DestroyAndReopen(options);
+
+  constexpr int kNumKeys = 50;
+  auto value_for = [](int i) {
+    // Every fifth value is small enough to stay in the data blocks
+    return std::string(i % 5 == 0 ? 16 : 2000,
+                       static_cast<char>('a' + i % 26));
+  };
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), value_for(i)));
+  }
+  ASSERT_OK(Flush());
+
+  Statistics* const stats = options.statistics.get();
+  SetPerfLevel(kEnableCount);
+  auto verify = [&]() {
+    TablePropertiesCollection props;
+    ASSERT_OK(db_->GetPropertiesOfAllTables(&props));
+    ASSERT_EQ(props.size(), 1U);
+    for (const auto& file_props : props) {
+      EXPECT_EQ(file_props.second->user_collected_properties.count(
+                    kEmbeddedBlobSstStatsPropertyName),
+                1U);
+    }
+
+    for (int i = 0; i < kNumKeys; ++i) {
+      ASSERT_EQ(Get(Key(i)), value_for(i));
+    }
+
+    get_perf_context()->Reset();
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+      iter->Seek(Key(kNumKeys / 2 + 1));
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->value(), value_for(kNumKeys / 2 + 1));
+    }
+    EXPECT_EQ(get_perf_context()->blob_read_count, 1);
+
+    ASSERT_OK(stats->Reset());
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+      int i = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+        ASSERT_EQ(iter->key(), Key(i));
+        ASSERT_EQ(iter->value(), value_for(i));
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(i, kNumKeys);
+    }
+    EXPECT_GT(stats->getTickerCount(BLOB_DB_BLOB_FILE_BYTES_READ), 0);
+    // All keys fit in one data block, so the prefetch hits are value reads
+    EXPECT_GT(stats->getTickerCount(PREFETCH_HITS), 0);
+  };
+
+  verify();
+
+  // Compaction rewrites the values as same-file blob records of its output.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  verify();
+  SetPerfLevel(kDisable);
+}
+
+// With allow_unprepared_value, a key-only scan reads no same-file blob
+// records; PrepareValue() reads the value of the current entry.
+TEST_F(DBBlobIndexTest, EmbeddedBlobsKeyOnlyScan) {
+  Options options = GetTestOptions();
+  BlockBasedTableOptions bbto;
+  bbto.embedded_blob_min_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  DestroyAndReopen(options);
+
+  constexpr int kNumKeys = 50;
+  auto value_for = [](int i) {
+    return std::string(2000, static_cast<char>('a' + i % 26));
+  };
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), value_for(i)));
+  }
+  ASSERT_OK(Flush());
+
+  SetPerfLevel(kEnableCount);
+  ReadOptions read_options;
+  read_options.allow_unprepared_value = true;
+  get_perf_context()->Reset();
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int i = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+      ASSERT_EQ(iter->key(), Key(i));
+      ASSERT_TRUE(iter->value().empty());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, kNumKeys);
+  }
+  EXPECT_EQ(get_perf_context()->blob_read_count, 0);
+
+  get_perf_context()->Reset();
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek(Key(kNumKeys / 2));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_TRUE(iter->PrepareValue());
+    ASSERT_EQ(iter->value(), value_for(kNumKeys / 2));
+    iter->Next();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), Key(kNumKeys / 2 + 1));
+  }
+  EXPECT_EQ(get_perf_context()->blob_read_count, 1);
+  SetPerfLevel(kDisable);
+}
+
 class PlainBlobValueFilterV3 : public CompactionFilter {
  public:
   PlainBlobValueFilterV3(std::atomic<int>* filter_call_count,
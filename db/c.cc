@@ -11192,6 +11192,16 @@ int rocksdb_ingestexternalfileoptions_get_file_opening_threads(
   return opt->rep.file_opening_threads;
 }
 
+void rocksdb_ingestexternalfileoptions_set_file_preparing_threads(
+    rocksdb_ingestexternalfileoptions_t* opt, int v) {
+  opt->rep.file_preparing_threads = v;
+}
+
+int rocksdb_ingestexternalfileoptions_get_file_preparing_threads(
+    rocksdb_ingestexternalfileoptions_t* opt) {
+  return opt->rep.file_preparing_threads;
+}
+
 /* OpenAndCompactOptions */
 
 unsigned char rocksdb_open_and_compact_options_get_allow_resumption(
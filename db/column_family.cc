@@ -29,6 +29,7 @@
 #include "db/job_context.h"
 #include "db/range_del_aggregator.h"
 #include "db/table_properties_collector.h"
+#include "db/user_key_row_cache.h"
 #include "db/version_set.h"
 #include "db/write_controller.h"
 #include "file/sst_file_manager_impl.h"
@@ -681,6 +682,10 @@ ColumnFamilyData::ColumnFamilyData(
     // Let the table cache route same-file ("embedded") blob reads through the
     // blob value cache + stats. Both objects share this CFD's lifetime.
     table_cache_->SetBlobSource(blob_source_.get());
+    if (ioptions_.user_key_row_cache != nullptr && !read_only) {
+      user_key_row_cache_.reset(
+          new UserKeyRowCache(ioptions_.user_key_row_cache, ioptions_.stats));
+    }
 
     if (ioptions_.compaction_style == kCompactionStyleLevel) {
       compaction_picker_.reset(
@@ -879,6 +884,11 @@ std::unique_ptr<WriteControllerToken> SetupDelay(
   uint64_t max_write_rate = write_controller->max_delayed_write_rate();
   uint64_t write_rate = write_controller->delayed_write_rate();
 
+  if (write_controller->feedback_control()) {
+    // The rate is owned by WriteController::UpdateFeedback()
+    return write_controller->GetDelayToken(write_rate);
+  }
+
   if (auto_compactions_disabled) {
     // When auto compaction is disabled, always use the value user gave.
     write_rate = max_write_rate;
@@ -998,6 +1008,31 @@ uint64_t GetPendingCompactionBytesForCompactionSpeedup(
   return std::min(size_threshold, slowdown_threshold);
 }
 
+// How close the column family is to its write slowdown triggers, as a
+// fraction: 1.0 means a slowdown trigger is reached. Only the compaction
+// related triggers are considered; memtable pressure is relieved by flushes
+// rather than compactions.
+double GetWritePressure(const MutableCFOptions& mutable_cf_options,
+                        const VersionStorageInfo* vstorage) {
+  if (mutable_cf_options.disable_auto_compactions) {
+    return 0;
+  }
+  double pressure = 0;
+  if (mutable_cf_options.level0_slowdown_writes_trigger > 0) {
+    pressure = std::max(
+        pressure, static_cast<double>(vstorage->l0_delay_trigger_count()) /
+                      mutable_cf_options.level0_slowdown_writes_trigger);
+  }
+  if (mutable_cf_options.soft_pending_compaction_bytes_limit > 0) {
+    pressure = std::max(
+        pressure,
+        static_cast<double>(vstorage->estimated_compaction_needed_bytes()) /
+            static_cast<double>(
+                mutable_cf_options.soft_pending_compaction_bytes_limit));
+  }
+  return pressure;
+}
+
 uint64_t GetMarkedFileCountForCompactionSpeedup() {
   // When just one file is marked, it is not clear that parallel compaction will
   // help the compaction that the user nicely requested to happen sooner. When
@@ -1202,7 +1237,7 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
       // If the DB recovers from delay conditions, we reward with reducing
       // double the slowdown ratio. This is to balance the long term slowdown
       // increase signal.
-      if (needed_delay) {
+      if (needed_delay && !write_controller->feedback_control()) {
         uint64_t write_rate = write_controller->delayed_write_rate();
         write_controller->set_delayed_write_rate(static_cast<uint64_t>(
             static_cast<double>(write_rate) * kDelayRecoverSlowdownRatio));
@@ -1215,6 +1250,26 @@ WriteStallCondition ColumnFamilyData::RecalculateWriteStallConditions(
       }
     }
     prev_compaction_needed_bytes_ = compaction_needed_bytes;
+
+    write_pressure_ = GetWritePressure(mutable_cf_options, vstorage);
+    if (write_controller->feedback_control()) {
+      WriteController::FeedbackSample sample;
+      for (auto cfd : *column_family_set_) {
+        if (cfd->IsDropped() || cfd->current() == nullptr) {
+          continue;
+        }
+        sample.pressure = std::max(sample.pressure, cfd->write_pressure_);
+        sample.compaction_debt_bytes +=
+            cfd->current()->storage_info()->estimated_compaction_needed_bytes();
+        uint64_t flushed_bytes = 0;
+        uint64_t compacted_bytes = 0;
+        cfd->internal_stats()->GetFlushAndCompactionBytesWritten(
+            &flushed_bytes, &compacted_bytes);
+        sample.flushed_bytes += flushed_bytes;
+        sample.compacted_bytes += compacted_bytes;
+      }
+      write_controller->UpdateFeedback(ioptions_.clock->NowMicros(), sample);
+    }
   }
   return write_stall_condition;
 }
@@ -1245,8 +1300,10 @@ uint64_t ColumnFamilyData::GetLiveSstFilesSize() const {
 
 MemTable* ColumnFamilyData::ConstructNewMemtable(
     const MutableCFOptions& mutable_cf_options, SequenceNumber earliest_seq) {
-  return new MemTable(internal_comparator_, ioptions_, mutable_cf_options,
-                      write_buffer_manager_, earliest_seq, id_);
+  auto* mem = new MemTable(internal_comparator_, ioptions_, mutable_cf_options,
+                           write_buffer_manager_, earliest_seq, id_);
+  mem->SetUserKeyRowCache(user_key_row_cache_.get());
+  return mem;
 }
 
 void ColumnFamilyData::CreateNewMemtable(SequenceNumber earliest_seq) {
@@ -1444,6 +1501,10 @@ void ColumnFamilyData::InstallSuperVersion(
                          : super_version_
                              ? super_version_->ShareSeqnoToTimeMapping()
                              : nullptr);
+  if (user_key_row_cache_ != nullptr) {
+    new_superversion->user_key_row_cache_prefix =
+        user_key_row_cache_->CurrentPrefixId();
+  }
   SuperVersion* old_superversion = super_version_;
   super_version_ = new_superversion;
   if (old_superversion == nullptr || old_superversion->current != current() ||
@@ -1542,6 +1603,25 @@ Status ColumnFamilyData::ValidateOptions(
 
   const auto* ucmp = cf_options.comparator;
   assert(ucmp);
+  if (cf_options.user_key_row_cache) {
+    if (cf_options.compaction_filter != nullptr ||
+        cf_options.compaction_filter_factory != nullptr) {
+      return Status::NotSupported(
+          "user_key_row_cache does not support compaction filters.");
+    }
+    if (cf_options.inplace_update_support) {
+      return Status::NotSupported(
+          "user_key_row_cache does not support inplace_update_support.");
+    }
+    if (db_options.unordered_write) {
+      return Status::NotSupported(
+          "user_key_row_cache does not support unordered writes.");
+    }
+    if (ucmp->timestamp_size() > 0) {
+      return Status::NotSupported(
+          "user_key_row_cache does not support user-defined timestamps.");
+    }
+  }
   if (cf_options.enable_blob_direct_write) {
     if (db_options.enable_pipelined_write) {
       return Status::NotSupported(
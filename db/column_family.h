@@ -52,6 +52,7 @@ struct SuperVersionContext;
 class BlobFileCache;
 class BlobFilePartitionManager;
 class BlobSource;
+class UserKeyRowCache;
 
 extern const double kIncSlowdownRatio;
 // This file contains a list of data structures for managing column family
@@ -224,6 +225,10 @@ struct SuperVersion {
   // enable UDT feature, this is an empty string.
   std::string full_history_ts_low;
 
+  // The cache key prefix of the column family's user_key_row_cache when this
+  // SuperVersion was installed, if it has one
+  uint64_t user_key_row_cache_prefix = 0;
+
   // An immutable snapshot of the DB's seqno to time mapping, usually shared
   // between SuperVersions.
   std::shared_ptr<const SeqnoToTimeMapping> seqno_to_time_mapping{nullptr};
@@ -417,6 +422,10 @@ class ColumnFamilyData {
   TableCache* table_cache() const { return table_cache_.get(); }
   BlobFileCache* blob_file_cache() const { return blob_file_cache_.get(); }
   BlobSource* blob_source() const { return blob_source_.get(); }
+  // Null unless AdvancedColumnFamilyOptions::user_key_row_cache is set
+  UserKeyRowCache* user_key_row_cache() const {
+    return user_key_row_cache_.get();
+  }
   // Returns the write-path blob partition manager for this CF, or null if BDW
   // is disabled.
   BlobFilePartitionManager* blob_partition_manager() const {
@@ -696,6 +705,7 @@ class ColumnFamilyData {
   std::unique_ptr<TableCache> table_cache_;
   std::unique_ptr<BlobFileCache> blob_file_cache_;
   std::unique_ptr<BlobSource> blob_source_;
+  std::unique_ptr<UserKeyRowCache> user_key_row_cache_;
   // Per-CF manager for write-path blob direct-write files.
   std::shared_ptr<BlobFilePartitionManager> blob_partition_manager_;
 
@@ -759,6 +769,9 @@ class ColumnFamilyData {
   int num_in_flight_compactions_{0};
 
   uint64_t prev_compaction_needed_bytes_;
+  // Normalized write pressure from the last RecalculateWriteStallConditions(),
+  // fed to the WriteController's feedback control. Protected by the DB mutex.
+  double write_pressure_ = 0;
 
   // if the database was opened with 2pc enabled
   bool allow_2pc_;
@@ -2811,6 +2811,66 @@ TEST_P(ColumnFamilyTest, WriteStallSingleColumnFamily) {
   ASSERT_EQ(kBaseRate / 1.25, GetDbDelayedWriteRate());
 }
 
+TEST_P(ColumnFamilyTest, WriteStallFeedbackControl) {
+  const uint64_t kBaseRate = 800000u;
+  db_options_.delayed_write_rate = kBaseRate;
+  db_options_.write_rate_feedback_control = true;
+
+  Open({"default"});
+  ColumnFamilyData* cfd =
+      static_cast<ColumnFamilyHandleImpl*>(db_->DefaultColumnFamily())->cfd();
+
+  VersionStorageInfo* vstorage = cfd->current()->storage_info();
+
+  MutableCFOptions mutable_cf_options(column_family_options_);
+
+  mutable_cf_options.level0_slowdown_writes_trigger = 20;
+  mutable_cf_options.level0_stop_writes_trigger = 10000;
+  mutable_cf_options.soft_pending_compaction_bytes_limit = 200;
+  mutable_cf_options.hard_pending_compaction_bytes_limit = 2000;
+  mutable_cf_options.disable_auto_compactions = false;
+
+  auto dbmu = dbfull()->TEST_Mutex();
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(80, dbmu);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_TRUE(!dbfull()->TEST_write_controler().NeedsDelay());
+
+  // Pacing starts before the soft limit is reached
+  vstorage->TEST_set_estimated_compaction_needed_bytes(120, dbmu);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_TRUE(dbfull()->TEST_write_controler().NeedsDelay());
+  ASSERT_EQ(kBaseRate, GetDbDelayedWriteRate());
+
+  // Beyond the soft limit the controller slows down further
+  vstorage->TEST_set_estimated_compaction_needed_bytes(400, dbmu);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_TRUE(dbfull()->TEST_write_controler().NeedsDelay());
+  ASSERT_LT(GetDbDelayedWriteRate(), kBaseRate);
+
+  // The hard limit still stops writes
+  vstorage->TEST_set_estimated_compaction_needed_bytes(2001, dbmu);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(IsDbWriteStopped());
+
+  vstorage->TEST_set_estimated_compaction_needed_bytes(50, dbmu);
+  RecalculateWriteStallConditions(cfd, mutable_cf_options);
+  ASSERT_TRUE(!IsDbWriteStopped());
+  ASSERT_TRUE(!dbfull()->TEST_write_controler().NeedsDelay());
+
+  std::string state;
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kWriteControllerState, &state));
+  ASSERT_NE(std::string::npos, state.find("enabled: 1"));
+  ASSERT_NE(std::string::npos, state.find("engaged: 0"));
+
+  ASSERT_OK(db_->SetDBOptions({{"write_rate_feedback_control", "false"}}));
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kWriteControllerState, &state));
+  ASSERT_NE(std::string::npos, state.find("enabled: 0"));
+}
+
 TEST_P(ColumnFamilyTest, CompactionSpeedupSingleColumnFamily) {
   db_options_.max_background_compactions = 6;
   Open({"default"});
@@ -59,6 +59,7 @@
 #include "table/unique_id_impl.h"
 #include "test_util/sync_point.h"
 #include "util/hash_containers.h"
+#include "util/multi_tenant_rate_limiter.h"
 #include "util/stop_watch.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -1935,6 +1936,7 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   uint64_t prev_cpu_micros = start_cpu_micros;
   const CompactionIOStatsSnapshot io_stats = InitializeIOStats();
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
+  IOTenantScope io_tenant_scope(&cfd->GetName());
   const CompactionFilter* compaction_filter;
   std::unique_ptr<CompactionFilter> compaction_filter_from_factory = nullptr;
   Status filter_status = SetupAndValidateCompactionFilter(
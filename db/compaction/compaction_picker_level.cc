@@ -9,12 +9,14 @@
 
 #include "db/compaction/compaction_picker_level.h"
 
+#include <cinttypes>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "db/version_edit.h"
 #include "logging/log_buffer.h"
+#include "logging/logging.h"
 #include "test_util/sync_point.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -911,6 +913,21 @@ bool LevelCompactionBuilder::PickFileToCompact() {
     }
 
     base_index_ = index;
+    if (ioptions_.compaction_pri == kCostBenefit) {
+      const auto& scores = vstorage_->FileCompactionScores(start_level_);
+      if (cmp_idx < scores.size()) {
+        ROCKS_LOG_BUFFER(log_buffer_,
+                         "[%s] Picked file #%" PRIu64
+                         " from level-%d by cost-benefit score %.3f: "
+                         "reads sampled %" PRIu64
+                         ", overwrite ratio %.3f, overlapping bytes %" PRIu64,
+                         cf_name_.c_str(), scores[cmp_idx].file_number,
+                         start_level_, scores[cmp_idx].score,
+                         scores[cmp_idx].reads_sampled,
+                         scores[cmp_idx].overwrite_ratio,
+                         scores[cmp_idx].overlapping_bytes);
+      }
+    }
     break;
   }
 
@@ -1203,6 +1203,102 @@ TEST_F(CompactionPickerTest, UniversalIncrementalSpace2) {
   ASSERT_EQ(15U, compaction->input(1, 0)->fd.GetNumber());
 }
 
+TEST_F(CompactionPickerTest, UniversalPartitionedSizeAmp) {
+  const uint64_t kFileSize = 100000;
+
+  // Partitions of two last level files each
+  mutable_cf_options_.max_compaction_bytes = 400000;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_cf_options_.compaction_options_universal
+      .partitioned_size_amp_compaction = true;
+  mutable_cf_options_.compaction_options_universal
+      .max_size_amplification_percent = 30;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(3, 5U, "110", "180", kFileSize / 2, 0, 200, 251);
+  Add(3, 6U, "610", "680", kFileSize * 2, 0, 200, 251);
+  Add(4, 10U, "101", "150", kFileSize, 0, 101, 150);
+  Add(4, 11U, "201", "250", kFileSize, 0, 101, 150);
+  Add(4, 12U, "301", "350", kFileSize, 0, 101, 150);
+  Add(4, 13U, "601", "650", kFileSize, 0, 101, 150);
+  Add(4, 14U, "701", "750", kFileSize, 0, 101, 150);
+  Add(4, 15U, "801", "850", kFileSize, 0, 101, 150);
+  UpdateVersionStorageInfo();
+
+  // The partition with the most newer data relative to its size goes first,
+  // leaving L0 and the rest of the key space alone.
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_,
+          /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+          vstorage_.get(), &log_buffer_, /*full_history_ts_low=*/""));
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kUniversalSizeAmplification,
+            compaction->compaction_reason());
+  ASSERT_EQ(4, compaction->output_level());
+  ASSERT_EQ(3, compaction->start_level());
+  ASSERT_EQ(2U, compaction->num_input_levels());
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(1U, compaction->num_input_files(1));
+  ASSERT_EQ(13U, compaction->input(1, 0)->fd.GetNumber());
+
+  // A disjoint partition can be compacted concurrently
+  std::unique_ptr<Compaction> compaction2(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_,
+          /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+          vstorage_.get(), &log_buffer_, /*full_history_ts_low=*/""));
+  ASSERT_TRUE(compaction2);
+  ASSERT_EQ(4, compaction2->output_level());
+  ASSERT_EQ(3, compaction2->start_level());
+  ASSERT_EQ(1U, compaction2->num_input_files(0));
+  ASSERT_EQ(5U, compaction2->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(1U, compaction2->num_input_files(1));
+  ASSERT_EQ(10U, compaction2->input(1, 0)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, UniversalPartitionedSizeAmpL0) {
+  const uint64_t kFileSize = 100000;
+
+  mutable_cf_options_.max_compaction_bytes = 400000;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_cf_options_.compaction_options_universal
+      .partitioned_size_amp_compaction = true;
+  mutable_cf_options_.compaction_options_universal
+      .max_size_amplification_percent = 30;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "610", "680", kFileSize, 0, 300, 350);
+  Add(4, 10U, "101", "150", kFileSize, 0, 101, 150);
+  Add(4, 11U, "201", "250", kFileSize, 0, 101, 150);
+  Add(4, 12U, "301", "350", kFileSize, 0, 101, 150);
+  Add(4, 13U, "601", "650", kFileSize, 0, 101, 150);
+  UpdateVersionStorageInfo();
+
+  // L0 can't be partitioned, so it is first compacted into the level above
+  // the last sorted run instead of into the last sorted run.
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_,
+          /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+          vstorage_.get(), &log_buffer_, /*full_history_ts_low=*/""));
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kUniversalSizeAmplification,
+            compaction->compaction_reason());
+  ASSERT_EQ(3, compaction->output_level());
+  ASSERT_EQ(0, compaction->start_level());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(0U, compaction->num_input_files(
+                    compaction->num_input_levels() - 1));
+}
+
 TEST_F(CompactionPickerTest, UniversalIncrementalSpace3) {
   // Test bottom level files falling between gaps between two upper level
   // files
@@ -1908,6 +2004,107 @@ TEST_F(CompactionPickerTest, CompactionPriMinOverlapping4) {
   ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
 }
 
+TEST_F(CompactionPickerTest, CompactionPriCostBenefit) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kCostBenefit;
+  mutable_cf_options_.target_file_size_base = 10000000;
+  mutable_cf_options_.target_file_size_multiplier = 10;
+  mutable_cf_options_.max_bytes_for_level_base = 10 * 1024 * 1024;
+
+  // Same shape as CompactionPriMinOverlapping2. Without any reads or
+  // overwrites, the cost-benefit order matches kMinOverlappingRatio.
+  Add(2, 6U, "150", "175", 60000000U);  // Overlaps with 26, 27: 521M
+  Add(2, 7U, "176", "200", 60000000U);  // Overlaps with 27, 28: 520M
+  Add(2, 8U, "201", "300", 60000000U);  // Overlaps with 28, 29: 521M
+
+  Add(3, 25U, "100", "110", 261000000U);
+  Add(3, 26U, "150", "170", 261000000U);
+  Add(3, 27U, "171", "179", 260000000U);
+  Add(3, 28U, "191", "220", 260000000U);
+  Add(3, 29U, "221", "300", 261000000U);
+  Add(3, 30U, "321", "400", 261000000U);
+  UpdateVersionStorageInfo();
+
+  const auto& scores = vstorage_->FileCompactionScores(2);
+  ASSERT_EQ(3U, scores.size());
+  ASSERT_EQ(7U, scores[0].file_number);
+  ASSERT_EQ(520000000U, scores[0].overlapping_bytes);
+  ASSERT_EQ(0U, scores[0].reads_sampled);
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_, /*full_history_ts_low=*/""));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(7U, compaction->input(0, 0)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, CompactionPriCostBenefitReadHeat) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kCostBenefit;
+  mutable_cf_options_.target_file_size_base = 10000000;
+  mutable_cf_options_.target_file_size_multiplier = 10;
+  mutable_cf_options_.max_bytes_for_level_base = 10 * 1024 * 1024;
+
+  Add(2, 6U, "150", "175", 60000000U);
+  Add(2, 7U, "176", "200", 60000000U);
+  Add(2, 8U, "201", "300", 60000000U);
+
+  Add(3, 25U, "100", "110", 261000000U);
+  Add(3, 26U, "150", "170", 261000000U);
+  Add(3, 27U, "171", "179", 260000000U);
+  Add(3, 28U, "191", "220", 260000000U);
+  Add(3, 29U, "221", "300", 261000000U);
+  Add(3, 30U, "321", "400", 261000000U);
+  // Reads concentrate on file 6's key range
+  file_map_[6U].first->stats.num_reads_sampled.store(1000000);
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_, /*full_history_ts_low=*/""));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(1000000U, vstorage_->FileCompactionScores(2)[0].reads_sampled);
+}
+
+TEST_F(CompactionPickerTest, CompactionPriCostBenefitOverwrites) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kCostBenefit;
+  mutable_cf_options_.target_file_size_base = 10000000;
+  mutable_cf_options_.target_file_size_multiplier = 10;
+  mutable_cf_options_.max_bytes_for_level_base = 10 * 1024 * 1024;
+
+  Add(2, 6U, "150", "175", 60000000U);
+  Add(2, 7U, "176", "200", 60000000U);
+  Add(2, 8U, "201", "300", 60000000U);
+
+  Add(3, 25U, "100", "110", 261000000U);
+  Add(3, 26U, "150", "170", 261000000U);
+  Add(3, 27U, "171", "179", 260000000U);
+  Add(3, 28U, "191", "220", 260000000U);
+  Add(3, 29U, "221", "300", 261000000U);
+  Add(3, 30U, "321", "400", 261000000U);
+  // Equally read, but most reads of file 8 hit deletions or merge operands
+  for (uint32_t file_number : {6U, 7U, 8U}) {
+    file_map_[file_number].first->stats.num_reads_sampled.store(100);
+  }
+  file_map_[8U].first->stats.num_collapsible_entry_reads_sampled.store(90);
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_, /*full_history_ts_low=*/""));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(8U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_DOUBLE_EQ(0.9, vstorage_->FileCompactionScores(2)[0].overwrite_ratio);
+}
+
 TEST_F(CompactionPickerTest, CompactionPriRoundRobin) {
   std::vector<InternalKey> test_cursors = {InternalKey("249", 100, kTypeValue),
                                            InternalKey("600", 100, kTypeValue),
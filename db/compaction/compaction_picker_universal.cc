@@ -9,8 +9,10 @@
 
 #include "db/compaction/compaction_picker_universal.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <queue>
 #include <string>
 #include <utility>
@@ -20,6 +22,7 @@
 #include "logging/log_buffer.h"
 #include "logging/logging.h"
 #include "monitoring/statistics_impl.h"
+#include "rocksdb/sst_partitioner.h"
 #include "test_util/sync_point.h"
 #include "util/random.h"
 #include "util/string_util.h"
@@ -305,6 +308,20 @@ class UniversalCompactionBuilder {
   //    total size of files to compact at other levels
   Compaction* PickIncrementalForReduceSizeAmp(double fanout_threshold);
 
+  // Try to pick a size amp compaction for a single key range partition of the
+  // last sorted run. See
+  // CompactionOptionsUniversal::partitioned_size_amp_compaction. Sets
+  // *fall_back if the sorted runs can't be partitioned, in which case the
+  // regular size amp compaction should be picked instead.
+  Compaction* PickPartitionedForReduceSizeAmp(bool* fall_back);
+
+  // Form a size amp compaction from files [start_idx, end_idx] of the second
+  // last sorted run, which must be a non-L0 level, the overlapping files of
+  // the last sorted run, and the files of upper non-L0 sorted runs falling
+  // within the range. Returns null if any of them are being compacted.
+  Compaction* BuildSizeAmpCompactionFromSecondLastLevel(int start_idx,
+                                                        int end_idx);
+
   Compaction* PickDeleteTriggeredCompaction();
 
   Compaction* PickReadTriggeredCompaction();
@@ -1144,6 +1161,16 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
 Compaction* UniversalCompactionBuilder::PickCompactionToReduceSizeAmp() {
   assert(!sorted_runs_.empty());
 
+  if (mutable_cf_options_.compaction_options_universal
+          .partitioned_size_amp_compaction &&
+      sorted_runs_.size() >= 2) {
+    bool fall_back = false;
+    Compaction* picked = PickPartitionedForReduceSizeAmp(&fall_back);
+    if (!fall_back) {
+      return picked;
+    }
+  }
+
   const size_t end_index = ShouldSkipLastSortedRunForSizeAmpCompaction()
                                ? sorted_runs_.size() - 2
                                : sorted_runs_.size() - 1;
@@ -1389,12 +1416,183 @@ Compaction* UniversalCompactionBuilder::PickIncrementalForReduceSizeAmp(
     return nullptr;
   }
 
+  return BuildSizeAmpCompactionFromSecondLastLevel(picked_start_idx,
+                                                   picked_end_idx);
+}
+
+Compaction* UniversalCompactionBuilder::PickPartitionedForReduceSizeAmp(
+    bool* fall_back) {
+  assert(sorted_runs_.size() >= 2);
+  *fall_back = false;
+  const SortedRun& last_sr = sorted_runs_.back();
+  if (last_sr.level == 0 || ShouldSkipLastSortedRunForSizeAmpCompaction()) {
+    *fall_back = true;
+    return nullptr;
+  }
+
+  // Size amplification is measured over all sorted runs, including those
+  // partially being compacted, so that more partitions can be picked while
+  // others are still being compacted.
+  uint64_t candidate_size = 0;
+  for (size_t i = 0; i + 1 < sorted_runs_.size(); i++) {
+    candidate_size += sorted_runs_[i].compensated_file_size;
+  }
+  const uint64_t ratio = mutable_cf_options_.compaction_options_universal
+                             .max_size_amplification_percent;
+  if (candidate_size * 100 < ratio * last_sr.size) {
+    ROCKS_LOG_BUFFER(log_buffer_,
+                     "[%s] Universal: partitioned size amp compaction not "
+                     "needed. newer-files-total-size %" PRIu64
+                     " earliest-file-size %" PRIu64,
+                     cf_name_.c_str(), candidate_size, last_sr.size);
+    return nullptr;
+  }
+
+  const size_t second_last_index = sorted_runs_.size() - 2;
+  if (sorted_runs_[second_last_index].level == 0) {
+    // All newer data is in L0, which can't be split by key range. Compact it
+    // into the level right above the last sorted run first.
+    if (last_sr.level <= 1) {
+      *fall_back = true;
+      return nullptr;
+    }
+    size_t start_index = second_last_index + 1;
+    while (start_index > 0) {
+      const SortedRun& sr = sorted_runs_[start_index - 1];
+      if (sr.being_compacted || sr.level_has_marked_standalone_rangedel) {
+        break;
+      }
+      --start_index;
+    }
+    if (start_index > second_last_index) {
+      return nullptr;
+    }
+    ROCKS_LOG_BUFFER(log_buffer_,
+                     "[%s] Universal: partitioned size amp compacting "
+                     "%" ROCKSDB_PRIszt " L0 sorted runs above L%d",
+                     cf_name_.c_str(), second_last_index + 1 - start_index,
+                     last_sr.level);
+    return PickCompactionWithSortedRunRange(
+        start_index, second_last_index,
+        CompactionReason::kUniversalSizeAmplification);
+  }
+
+  const int second_last_level = sorted_runs_[second_last_index].level;
+  const std::vector<FileMetaData*>& bottom_files =
+      vstorage_->LevelFiles(last_sr.level);
+  const std::vector<FileMetaData*>& files =
+      vstorage_->LevelFiles(second_last_level);
+  assert(!bottom_files.empty());
+  assert(!files.empty());
+
+  std::unique_ptr<SstPartitioner> partitioner;
+  if (ioptions_.sst_partitioner_factory) {
+    SstPartitioner::Context context;
+    context.is_full_compaction = false;
+    context.is_manual_compaction = false;
+    context.output_level = last_sr.level;
+    context.smallest_user_key = bottom_files.front()->smallest.user_key();
+    context.largest_user_key = bottom_files.back()->largest.user_key();
+    partitioner = ioptions_.sst_partitioner_factory->CreatePartitioner(context);
+  }
+
+  // Split the last sorted run into partitions of about half the target
+  // compaction size, at file boundaries the partitioner allows. Each file of
+  // the second last sorted run belongs to the partition its smallest key
+  // falls into.
+  struct Partition {
+    size_t bottom_start_idx = 0;
+    uint64_t bottom_size = 0;
+    int start_idx = 0;
+    int end_idx = -1;
+    uint64_t size = 0;
+  };
+  const uint64_t partition_size =
+      std::max<uint64_t>(mutable_cf_options_.max_compaction_bytes / 2, 1);
+  std::vector<Partition> partitions(1);
+  for (size_t i = 0; i < bottom_files.size(); i++) {
+    if (partitions.back().bottom_size >= partition_size) {
+      bool cut = true;
+      if (partitioner) {
+        const Slice prev_user_key = bottom_files[i - 1]->largest.user_key();
+        const Slice cur_user_key = bottom_files[i]->smallest.user_key();
+        cut = partitioner->ShouldPartition(PartitionerRequest(
+                  prev_user_key, cur_user_key,
+                  partitions.back().bottom_size)) == kRequired;
+      }
+      if (cut) {
+        partitions.emplace_back();
+        partitions.back().bottom_start_idx = i;
+      }
+    }
+    partitions.back().bottom_size += bottom_files[i]->fd.file_size;
+  }
+  const Comparator* ucmp = icmp_->user_comparator();
+  size_t partition_idx = 0;
+  for (int i = 0; i < static_cast<int>(files.size()); i++) {
+    while (partition_idx + 1 < partitions.size() &&
+           ucmp->Compare(files[i]->smallest.user_key(),
+                         bottom_files[partitions[partition_idx + 1]
+                                          .bottom_start_idx]
+                             ->smallest.user_key()) >= 0) {
+      partition_idx++;
+    }
+    Partition& p = partitions[partition_idx];
+    if (p.end_idx < p.start_idx) {
+      p.start_idx = i;
+    }
+    p.end_idx = i;
+    p.size += files[i]->fd.file_size;
+  }
+
+  // Try the partitions with the most newer data relative to their size first
+  std::vector<size_t> order;
+  for (size_t i = 0; i < partitions.size(); i++) {
+    if (partitions[i].end_idx >= partitions[i].start_idx) {
+      order.push_back(i);
+    }
+  }
+  auto score = [&](size_t i) {
+    const Partition& p = partitions[i];
+    return static_cast<double>(p.size) /
+           static_cast<double>(std::max<uint64_t>(p.bottom_size, 1));
+  };
+  std::sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return score(a) > score(b); });
+  for (size_t i : order) {
+    const Partition& p = partitions[i];
+    Compaction* c =
+        BuildSizeAmpCompactionFromSecondLastLevel(p.start_idx, p.end_idx);
+    if (c != nullptr) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] Universal: partitioned size amp picked "
+                       "partition %" ROCKSDB_PRIszt " of %" ROCKSDB_PRIszt
+                       " with newer-files-size %" PRIu64
+                       " earliest-files-size %" PRIu64,
+                       cf_name_.c_str(), i, partitions.size(), p.size,
+                       p.bottom_size);
+      return c;
+    }
+  }
+  return nullptr;
+}
+
+Compaction*
+UniversalCompactionBuilder::BuildSizeAmpCompactionFromSecondLastLevel(
+    int start_idx, int end_idx) {
+  assert(sorted_runs_.size() >= 2);
+  int second_last_level = sorted_runs_[sorted_runs_.size() - 2].level;
+  int output_level = sorted_runs_.back().level;
+  assert(second_last_level > 0);
+  const std::vector<FileMetaData*>& files =
+      vstorage_->LevelFiles(second_last_level);
+
   std::vector<CompactionInputFiles> inputs;
   CompactionInputFiles bottom_level_inputs;
   CompactionInputFiles second_last_level_inputs;
   second_last_level_inputs.level = second_last_level;
   bottom_level_inputs.level = output_level;
-  for (int i = picked_start_idx; i <= picked_end_idx; i++) {
+  for (int i = start_idx; i <= end_idx; i++) {
     if (files[i]->being_compacted) {
       return nullptr;
     }
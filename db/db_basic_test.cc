@@ -4326,6 +4326,147 @@ INSTANTIATE_TEST_CASE_P(DBMultiGetAsyncIOTest, DBMultiGetAsyncIOTest,
                         testing::Combine(testing::Bool(), testing::Bool()));
 #endif  // USE_COROUTINES
 
+TEST_F(DBBasicTest, MultiGetPlanIO) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 256;
+  table_options.block_cache = NewLRUCache(8 << 20);
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10, false));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  CreateAndReopenWithCF({"pikachu", "eevee"}, options);
+
+  // Every key in L2, a third of them overwritten in L1
+  const int kNumKeys = 200;
+  for (int cf = 0; cf < 3; ++cf) {
+    for (int i = 0; i < kNumKeys; ++i) {
+      ASSERT_OK(Put(cf, Key(i), "l2_" + std::to_string(cf) + Key(i)));
+    }
+    ASSERT_OK(Flush(cf));
+    MoveFilesToLevel(2, cf);
+    for (int i = 0; i < kNumKeys; i += 3) {
+      ASSERT_OK(Put(cf, Key(i), "l1_" + std::to_string(cf) + Key(i)));
+    }
+    ASSERT_OK(Flush(cf));
+    MoveFilesToLevel(1, cf);
+  }
+  // Drop the blocks read by the compactions, if any
+  table_options.block_cache->EraseUnRefEntries();
+
+  size_t num_jobs = 0;
+  uint64_t num_blocks = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "MultiGetIOPlan::Execute:Done", [&](void* arg) {
+        auto* plan = static_cast<MultiGetIOPlan*>(arg);
+        num_jobs = plan->GetNumJobs();
+        num_blocks = plan->GetNumBlocks();
+        // Only count the reads of the lookups
+        get_perf_context()->Reset();
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // Every other key of each column family, and some missing ones
+  std::vector<ColumnFamilyHandle*> cfs;
+  std::vector<std::string> key_strs;
+  for (int cf = 0; cf < 3; ++cf) {
+    for (int i = 0; i < kNumKeys + 20; i += 2) {
+      cfs.push_back(handles_[cf]);
+      key_strs.push_back(Key(i));
+    }
+  }
+  std::vector<Slice> keys(key_strs.begin(), key_strs.end());
+  std::vector<PinnableSlice> values(keys.size());
+  std::vector<Status> statuses(keys.size());
+  ReadOptions read_options;
+  read_options.plan_multiget_io = true;
+  SetPerfLevel(kEnableCount);
+  db_->MultiGet(read_options, keys.size(), cfs.data(), keys.data(),
+                values.data(), statuses.data());
+  SetPerfLevel(kDisable);
+
+  // Both levels of each column family, in one batch of reads
+  ASSERT_EQ(num_jobs, 6);
+  ASSERT_GT(num_blocks, 0);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    int cf = static_cast<int>(i / ((kNumKeys + 20) / 2));
+    int key = static_cast<int>(i % ((kNumKeys + 20) / 2)) * 2;
+    if (key >= kNumKeys) {
+      ASSERT_TRUE(statuses[i].IsNotFound());
+      continue;
+    }
+    ASSERT_OK(statuses[i]);
+    std::string level = key % 3 == 0 ? "l1_" : "l2_";
+    ASSERT_EQ(values[i], level + std::to_string(cf) + Key(key));
+  }
+  // The lookups found all of their data blocks in the block cache
+  ASSERT_EQ(get_perf_context()->block_read_count, 0);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(DBBasicTest, MultiGetPlanIOSkipsMemtableKeys) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 256;
+  table_options.block_cache = NewLRUCache(8 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  // Every key in L2, the even ones overwritten in the memtable
+  const int kNumKeys = 200;
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), "sst_" + Key(i)));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+  for (int i = 0; i < kNumKeys; i += 2) {
+    ASSERT_OK(Put(Key(i), "mem_" + Key(i)));
+  }
+  table_options.block_cache->EraseUnRefEntries();
+
+  uint64_t num_blocks = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "MultiGetIOPlan::Execute:Done", [&](void* arg) {
+        num_blocks = static_cast<MultiGetIOPlan*>(arg)->GetNumBlocks();
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  ReadOptions read_options;
+  read_options.plan_multiget_io = true;
+  for (int step : {2, 1}) {
+    std::vector<std::string> key_strs;
+    for (int i = 0; i < kNumKeys; i += step) {
+      key_strs.push_back(Key(i));
+    }
+    std::vector<Slice> keys(key_strs.begin(), key_strs.end());
+    std::vector<PinnableSlice> values(keys.size());
+    std::vector<Status> statuses(keys.size());
+    get_perf_context()->Reset();
+    SetPerfLevel(kEnableCount);
+    db_->MultiGet(read_options, db_->DefaultColumnFamily(), keys.size(),
+                  keys.data(), values.data(), statuses.data());
+    SetPerfLevel(kDisable);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      int key = static_cast<int>(i) * step;
+      ASSERT_OK(statuses[i]);
+      ASSERT_EQ(values[i], (key % 2 == 0 ? "mem_" : "sst_") + Key(key));
+    }
+    if (step == 2) {
+      // The memtable holds every key, so nothing is read from the SST file
+      ASSERT_EQ(num_blocks, 0);
+      ASSERT_EQ(get_perf_context()->block_read_count, 0);
+    } else {
+      // Only the blocks of the odd keys
+      ASSERT_GT(num_blocks, 0);
+    }
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBBasicTest, MultiGetStats) {
   Options options;
   options.create_if_missing = true;
@@ -11,6 +11,9 @@
 #include <cstdlib>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include "db/db_test_util.h"
 #include "db/read_callback.h"
@@ -1882,6 +1885,40 @@ TEST_F(DBTest2, TestPerfContextIterCpuTime) {
 }
 #endif  // OS_LINUX
 
+TEST_F(DBTest2, PinnedTableReadersSkipTableCache) {
+  Options options = CurrentOptions();
+  options.max_open_files = -1;
+  Reopen(options);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_OK(Put("k" + std::to_string(i), "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+  // Load and pin all table readers
+  Reopen(options);
+
+  std::atomic<int> table_cache_lookups{0};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "TableCache::FindTable:0",
+      [&](void* /*arg*/) { table_cache_lookups.fetch_add(1); });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  SetPerfLevel(PerfLevel::kEnableTimeExceptForMutex);
+  get_perf_context()->Reset();
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ("v" + std::to_string(i), Get("k" + std::to_string(i)));
+  }
+  ASSERT_EQ("NOT_FOUND", Get("k9"));
+  ASSERT_EQ(std::vector<std::string>({"v0", "v2", "NOT_FOUND"}),
+            MultiGet({"k0", "k2", "k9"}));
+  // Neither the table cache nor the table-finding timer is touched
+  ASSERT_EQ(0, table_cache_lookups.load());
+  ASSERT_EQ(0, get_perf_context()->find_table_nanos);
+
+  SetPerfLevel(PerfLevel::kDisable);
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 #if !defined OS_SOLARIS
 TEST_F(DBTest2, PersistentCache) {
   int num_iter = 80;
@@ -3858,6 +3895,84 @@ TEST_F(DBTest2, TraceAndReplay) {
   ASSERT_OK(DestroyDB(dbname2, options));
 }
 
+TEST_F(DBTest2, TraceAndReplayPreservingClientThreads) {
+  Options options = CurrentOptions();
+  DestroyAndReopen(options);
+  TraceOptions trace_opts;
+  trace_opts.record_client_thread_id = true;
+  EnvOptions env_opts;
+  std::string trace_filename = dbname_ + "/rocksdb.trace";
+  std::unique_ptr<TraceWriter> trace_writer;
+  ASSERT_OK(NewFileTraceWriter(env_, env_opts, trace_filename, &trace_writer));
+  ASSERT_OK(db_->StartTrace(trace_opts, std::move(trace_writer)));
+
+  // Each client overwrites its own key, so the final value after replay is
+  // only right if the per-client order is preserved.
+  constexpr int kNumClients = 3;
+  constexpr int kOpsPerClient = 20;
+  std::vector<port::Thread> clients;
+  for (int c = 0; c < kNumClients; ++c) {
+    clients.emplace_back([this, c]() {
+      std::string key = "client" + std::to_string(c);
+      for (int i = 0; i < kOpsPerClient; ++i) {
+        ASSERT_OK(Put(key, std::to_string(i)));
+        ASSERT_EQ(std::to_string(i), Get(key));
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  ASSERT_OK(db_->EndTrace());
+
+  std::string dbname2 = test::PerThreadDBPath(env_, "/db_replay");
+  ASSERT_OK(DestroyDB(dbname2, options));
+  options.create_if_missing = true;
+  std::unique_ptr<DB> db2;
+  ASSERT_OK(DB::Open(options, dbname2, &db2));
+
+  std::unique_ptr<TraceReader> trace_reader;
+  ASSERT_OK(NewFileTraceReader(env_, env_opts, trace_filename, &trace_reader));
+  std::unique_ptr<Replayer> replayer;
+  ASSERT_OK(db2->NewDefaultReplayer({db2->DefaultColumnFamily()},
+                                    std::move(trace_reader), &replayer));
+  ReplayReport report;
+  ASSERT_TRUE(replayer->GetReplayReport(&report).IsIncomplete());
+
+  std::mutex mutex;
+  std::set<std::thread::id> replay_threads;
+  auto res_cb = [&](Status exec_s, std::unique_ptr<TraceRecordResult>&&) {
+    ASSERT_OK(exec_s);
+    std::lock_guard<std::mutex> lock(mutex);
+    replay_threads.insert(std::this_thread::get_id());
+  };
+  ASSERT_OK(replayer->Prepare());
+  ReplayOptions replay_opts(1, 2.0);
+  replay_opts.preserve_client_threads = true;
+  ASSERT_OK(replayer->Replay(replay_opts, res_cb));
+  ASSERT_EQ(replay_threads.size(), kNumClients);
+
+  std::string value;
+  for (int c = 0; c < kNumClients; ++c) {
+    ASSERT_OK(db2->Get(ReadOptions(), "client" + std::to_string(c), &value));
+    ASSERT_EQ(std::to_string(kOpsPerClient - 1), value);
+  }
+
+  ASSERT_OK(replayer->GetReplayReport(&report));
+  ASSERT_GT(report.end_micros, 0);
+  ASSERT_GE(report.end_micros, report.start_micros);
+  ASSERT_EQ(report.latency_micros.size(), 2);
+  ASSERT_EQ(report.latency_micros[kTraceWrite].count,
+            kNumClients * kOpsPerClient);
+  ASSERT_EQ(report.latency_micros[kTraceGet].count,
+            kNumClients * kOpsPerClient);
+  ASSERT_EQ(report.schedule_lag_micros.count, 2 * kNumClients * kOpsPerClient);
+
+  replayer.reset();
+  db2.reset();
+  ASSERT_OK(DestroyDB(dbname2, options));
+}
+
 TEST_F(DBTest2, TraceAndManualReplay) {
   Options options = CurrentOptions();
   options.merge_operator = MergeOperators::CreatePutOperator();
@@ -60,6 +60,7 @@
 #include "db/range_tombstone_fragmenter.h"
 #include "db/table_cache.h"
 #include "db/table_properties_collector.h"
+#include "db/user_key_row_cache.h"
 #include "db/version_set.h"
 #include "db/wal_iterator_impl.h"
 #include "db/wide/lazy_wide_columns_helper.h"
@@ -124,6 +125,7 @@
 #include "util/defer.h"
 #include "util/distributed_mutex.h"
 #include "util/hash_containers.h"
+#include "util/multi_tenant_rate_limiter.h"
 #include "util/mutexlock.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
@@ -257,6 +259,11 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   // WriteUnprepared, which should use seq_per_batch_.
   assert(batch_per_txn_ || seq_per_batch_);
 
+  perf_context_sampler_.SetSampleRate(
+      mutable_db_options_.perf_context_sample_rate);
+  write_controller_.set_feedback_control(
+      mutable_db_options_.write_rate_feedback_control);
+
   // Reserve ten files or so for other uses and give the rest to TableCache.
   // Give a large number for setting of "infinite" open files.
   const int table_cache_size = (mutable_db_options_.max_open_files == -1)
@@ -1902,6 +1909,8 @@ Status DBImpl::SetDBOptions(
 
       write_controller_.set_max_delayed_write_rate(
           new_options.delayed_write_rate);
+      write_controller_.set_feedback_control(
+          new_options.write_rate_feedback_control);
       table_cache_.get()->SetCapacity(new_options.max_open_files == -1
                                           ? TableCache::kInfiniteCapacity
                                           : new_options.max_open_files - 10);
@@ -1919,6 +1928,8 @@ Status DBImpl::SetDBOptions(
                                  new_options.wal_bytes_per_sync;
       wal_size_option_changed = mutable_db_options_.max_total_wal_size !=
                                 new_options.max_total_wal_size;
+      perf_context_sampler_.SetSampleRate(
+          new_options.perf_context_sample_rate);
       mutable_db_options_ = new_options;
       file_options_for_compaction_ = FileOptions(new_db_options);
       file_options_for_compaction_ = fs_->OptimizeForCompactionTableWrite(
@@ -3630,6 +3641,16 @@ void DBImpl::MultiGetCommon(const ReadOptions& read_options,
                             PinnableSlice* values, PinnableWideColumns* columns,
                             std::string* timestamps, Status* statuses,
                             bool sorted_input) {
+  PerfContextSampleGuard perf_sample_guard(&perf_context_sampler_,
+                                           SampledOpType::kMultiGet,
+                                           immutable_db_options_.clock, stats_);
+  // Attribute rate limited reads to the column family's tenant
+  IOTenantScope io_tenant_scope(
+      read_options.rate_limiter_priority != Env::IO_TOTAL
+          ? &static_cast_with_check<ColumnFamilyHandleImpl>(column_family)
+                 ->cfd()
+                 ->GetName()
+          : nullptr);
   if (tracer_) {
     // TODO: This mutex should be removed later, to improve performance when
     // tracing is enabled.
@@ -3742,14 +3763,97 @@ void DBImpl::MultiGetWithCallbackImpl(
     read_callback = &timestamp_read_callback;
   }
 
+  std::unique_ptr<MultiGetIOPlan> io_plan;
+  MultiGetMemtableBatches memtable_batches;
+  if (read_options.plan_multiget_io) {
+    io_plan = std::make_unique<MultiGetIOPlan>();
+    PlanMultiGetIO(read_options, 0, num_keys, sorted_keys,
+                   cf_sv_pairs[0].super_version, consistent_seqnum,
+                   read_callback, /*use_coro_read=*/false, &memtable_batches,
+                   io_plan.get());
+    io_plan->Execute();
+  }
   s = MultiGetImpl(read_options, 0, num_keys, sorted_keys,
                    cf_sv_pairs[0].super_version, consistent_seqnum,
-                   read_callback);
+                   read_callback, io_plan ? &memtable_batches : nullptr);
+  // Unpins the blocks and tables before the SuperVersion
+  io_plan.reset();
+  memtable_batches.clear();
   assert(s.ok() || s.IsTimedOut() || s.IsAborted());
   ReturnAndCleanupSuperVersion(cf_sv_pairs[0].cfd,
                                cf_sv_pairs[0].super_version);
 }
 
+bool DBImpl::MultiGetFromMemtables(const ReadOptions& read_options,
+                                   SuperVersion* sv, ReadCallback* callback,
+                                   const BlobFetcher* memtable_blob_fetcher,
+                                   MultiGetRange* range) {
+  for (auto mget_iter = range->begin(); mget_iter != range->end();
+       ++mget_iter) {
+    // Clear the timestamps for returning results so that we can distinguish
+    // between tombstone or key that has never been written
+    if (mget_iter->timestamp) {
+      mget_iter->timestamp->clear();
+    }
+    mget_iter->merge_context.Clear();
+    *mget_iter->s = Status::OK();
+  }
+
+  // First look in the memtable, then in the immutable memtable (if any).
+  // s is both in/out. When in, s could either be OK or MergeInProgress.
+  // merge_operands will contain the sequence of merges in the latter case.
+  bool skip_memtable =
+      (read_options.read_tier == kPersistedTier &&
+       has_unpersisted_data_.load(std::memory_order_relaxed));
+  if (skip_memtable) {
+    return true;
+  }
+  sv->mem->MultiGet(read_options, range, callback,
+                    false /* immutable_memtable */, memtable_blob_fetcher);
+  if (!range->empty()) {
+    sv->imm->MultiGet(read_options, range, callback, memtable_blob_fetcher);
+  }
+  if (range->empty()) {
+    return false;
+  }
+  RecordTick(stats_, MEMTABLE_MISS, range->KeysLeft());
+  return true;
+}
+
+void DBImpl::PlanMultiGetIO(
+    const ReadOptions& read_options, size_t start_key, size_t num_keys,
+    autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
+    SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback,
+    bool use_coro_read, MultiGetMemtableBatches* memtable_batches,
+    MultiGetIOPlan* plan) {
+  assert(memtable_batches->empty());
+  auto* cfh = static_cast_with_check<ColumnFamilyHandleImpl>(
+      (*sorted_keys)[start_key]->column_family);
+  std::optional<VersionBlobFetcher> memtable_blob_fetcher;
+  if (cfh->cfd()->blob_partition_manager() != nullptr) {
+    memtable_blob_fetcher.emplace(sv->current, read_options,
+                                  cfh->cfd()->blob_file_cache(),
+                                  /*allow_write_path_fallback=*/true);
+  }
+  // The same batches as MultiGetImpl(), which then looks up the keys left in
+  // the SST files, so that keys found in the memtables are not planned
+  for (size_t i = 0; i < num_keys; i += MultiGetContext::MAX_BATCH_SIZE) {
+    size_t batch_size =
+        std::min(num_keys - i, size_t{MultiGetContext::MAX_BATCH_SIZE});
+    memtable_batches->emplace_back(std::make_unique<MultiGetContext>(
+        sorted_keys, start_key + i, batch_size, snap_seqnum, read_options,
+        GetFileSystem(), stats_, use_coro_read));
+    MultiGetRange range = memtable_batches->back()->GetMultiGetRange();
+    bool lookup_current = MultiGetFromMemtables(
+        read_options, sv, callback,
+        memtable_blob_fetcher ? &*memtable_blob_fetcher : nullptr, &range);
+    // No IO allowed with kBlockCacheTier
+    if (lookup_current && read_options.read_tier != kBlockCacheTier) {
+      sv->current->PlanMultiGetIO(read_options, &range, plan);
+    }
+  }
+}
+
 void DBImpl::MultiGetEntity(const ReadOptions& _read_options, size_t num_keys,
                             ColumnFamilyHandle** column_families,
                             const Slice* keys, PinnableWideColumns* results,
@@ -5138,6 +5242,19 @@ bool DBImpl::GetPropertyHandleOptionsStatistics(std::string* value) {
   return true;
 }
 
+bool DBImpl::GetPropertyHandlePerfContextSamples(std::string* value) {
+  assert(value != nullptr);
+  *value = perf_context_sampler_.ToString();
+  return true;
+}
+
+bool DBImpl::GetPropertyHandleWriteControllerState(std::string* value) {
+  assert(value != nullptr);
+  mutex_.AssertHeld();
+  *value = write_controller_.FeedbackStateToString();
+  return true;
+}
+
 Status DBImpl::ResetStats() {
   InstrumentedMutexLock l(&mutex_);
   for (auto* cfd : *versions_->GetColumnFamilySet()) {
@@ -5526,6 +5643,9 @@ Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
     status = versions_->LogAndApply(cfd, read_options, write_options, &edit,
                                     &mutex_, directories_.GetDbDir());
     if (status.ok()) {
+      if (cfd->user_key_row_cache() != nullptr) {
+        cfd->user_key_row_cache()->InvalidateAll();
+      }
       InstallSuperVersionAndScheduleWork(
           cfd, job_context.superversion_contexts.data());
     }
@@ -6580,38 +6700,56 @@ Status DBImpl::PrepareFileIngestion(
                                 io_tracer_);
   }
 
-  // TODO(yanqin) maybe make jobs run in parallel
-  uint64_t start_file_number = next_file_number;
-  for (size_t i = 1; i != num_cfs; ++i) {
-    start_file_number += args[i - 1].external_files.size();
-    SuperVersion* super_version =
+  // The jobs of all column families, and the files within each job, are
+  // prepared on threads shared by the whole ingestion.
+  int file_preparing_threads = 1;
+  for (const auto& job : ingestion_jobs) {
+    file_preparing_threads =
+        std::max(file_preparing_threads, job.file_preparing_threads());
+  }
+  IngestionPrepareThreads prepare_threads(file_preparing_threads);
+  std::vector<uint64_t> start_file_numbers(num_cfs, next_file_number);
+  std::vector<SuperVersion*> super_versions(num_cfs);
+  for (size_t i = 0; i != num_cfs; ++i) {
+    if (i > 0) {
+      start_file_numbers[i] =
+          start_file_numbers[i - 1] + args[i - 1].external_files.size();
+    }
+    super_versions[i] =
         ingestion_jobs[i].GetColumnFamilyData()->GetReferencedSuperVersion(
             this);
-    Status es = ingestion_jobs[i].Prepare(
+  }
+  auto prepare_job = [&](size_t i) {
+    return ingestion_jobs[i].Prepare(
         args[i].external_files, args[i].files_checksums,
         args[i].files_checksum_func_names, args[i].file_infos,
         args[i].atomic_replace_range, args[i].file_temperature,
-        start_file_number, super_version);
-    // capture first error only
-    if (!es.ok() && status.ok()) {
-      status = es;
-    }
-    CleanupSuperVersion(super_version);
-  }
+        start_file_numbers[i], super_versions[i], &prepare_threads);
+  };
+  // Every job is prepared even when another one fails, and Run() returns
+  // once all of them are done, so that the cleanup below finds all the jobs
+  // in the same state
+  std::vector<Status> job_statuses(num_cfs);
+  Status run_status = prepare_threads.Run(num_cfs - 1, [&](size_t i) {
+    job_statuses[i + 1] = prepare_job(i + 1);
+    return Status::OK();
+  });
+  assert(run_status.ok());
+  run_status.PermitUncheckedError();
   TEST_SYNC_POINT("DBImpl::IngestExternalFiles:BeforeLastJobPrepare:0");
   TEST_SYNC_POINT("DBImpl::IngestExternalFiles:BeforeLastJobPrepare:1");
-  {
-    SuperVersion* super_version =
-        ingestion_jobs[0].GetColumnFamilyData()->GetReferencedSuperVersion(
-            this);
-    Status es = ingestion_jobs[0].Prepare(
-        args[0].external_files, args[0].files_checksums,
-        args[0].files_checksum_func_names, args[0].file_infos,
-        args[0].atomic_replace_range, args[0].file_temperature,
-        next_file_number, super_version);
-    if (!es.ok()) {
-      status = es;
+  job_statuses[0] = prepare_job(0);
+  // capture first error only, with the error of the first job taking
+  // precedence
+  for (size_t i = 1; i != num_cfs; ++i) {
+    if (!job_statuses[i].ok() && status.ok()) {
+      status = job_statuses[i];
     }
+  }
+  if (!job_statuses[0].ok()) {
+    status = job_statuses[0];
+  }
+  for (SuperVersion* super_version : super_versions) {
     CleanupSuperVersion(super_version);
   }
   if (!status.ok()) {
@@ -6889,6 +7027,10 @@ Status DBImpl::CommitFileIngestionHandles(
       for (size_t i = 0; i != num_jobs; ++i) {
         auto* cfd = ingestion_jobs[i]->GetColumnFamilyData();
         assert(!cfd->IsDropped());
+        if (cfd->user_key_row_cache() != nullptr) {
+          // Readers of the new SuperVersion take the new cache key prefix
+          cfd->user_key_row_cache()->InvalidateAll();
+        }
         InstallSuperVersionAndScheduleWork(cfd, &sv_ctxs[i]);
 #ifndef NDEBUG
         if (0 == i && num_jobs > 1) {
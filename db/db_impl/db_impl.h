@@ -53,6 +53,7 @@
 #include "logging/event_logger.h"
 #include "memtable/wbwi_memtable.h"
 #include "monitoring/instrumented_mutex.h"
+#include "monitoring/perf_context_sampler.h"
 #include "options/db_options.h"
 #include "options/options_helper.h"
 #include "port/port.h"
@@ -1537,6 +1538,9 @@ class DBImpl : public DB
   FileSystemPtr fs_;
   MutableDBOptions mutable_db_options_;
   Statistics* stats_;
+  // Samples Get / MultiGet / Write with a detailed PerfContext breakdown, per
+  // mutable_db_options_.perf_context_sample_rate.
+  PerfContextSampler perf_context_sampler_;
   RecoveredTransactionMap recovered_transactions_;
   std::unique_ptr<Tracer> tracer_;
   InstrumentedMutex trace_mutex_;
@@ -2476,6 +2480,7 @@ class DBImpl : public DB
                              bool* const old_log_record,
                              Status* const reporter_status,
                              DBOpenLogRecordReadReporter* reporter,
+                             log::Reader::Reporter* read_reporter,
                              std::unique_ptr<log::Reader>& reader);
   Status ProcessLogRecord(
       Slice record, const std::unique_ptr<log::Reader>& reader,
@@ -2488,6 +2493,19 @@ class DBImpl : public DB
       bool* stop_replay_by_wal_filter,
       std::unordered_map<int, VersionEdit>* version_edits, bool* flushed);
 
+  // Applies a log record whose write batch was set up by
+  // InitializeWriteBatchForLogRecord(), with `decode_status` as result. The
+  // batch is not set up for records too small to hold a batch header.
+  Status ProcessDecodedLogRecord(
+      size_t record_size, const Status& decode_status, WriteBatch* batch_to_use,
+      uint64_t wal_number, const std::string& fname, bool read_only, int job_id,
+      const std::function<void()>& logFileDropped,
+      DBOpenLogRecordReadReporter* reporter,
+      SequenceNumber* last_seqno_observed, SequenceNumber* next_sequence,
+      bool* stop_replay_for_corruption, Status* status,
+      bool* stop_replay_by_wal_filter,
+      std::unordered_map<int, VersionEdit>* version_edits, bool* flushed);
+
   Status InitializeWriteBatchForLogRecord(
       Slice record, const std::unique_ptr<log::Reader>& reader,
       const UnorderedMap<uint32_t, size_t>& running_ts_sz, WriteBatch* batch,
@@ -2996,6 +3014,9 @@ class DBImpl : public DB
                               bool is_locked, uint64_t* value);
   bool GetPropertyHandleOptionsStatistics(std::string* value);
 
+  bool GetPropertyHandlePerfContextSamples(std::string* value);
+  bool GetPropertyHandleWriteControllerState(std::string* value);
+
   bool HasPendingManualCompaction();
   bool HasExclusiveManualCompaction();
   void AddManualCompaction(ManualCompactionState* m);
@@ -3187,15 +3208,40 @@ class DBImpl : public DB
                          bool extra_sv_ref, SequenceNumber* snapshot,
                          bool* sv_from_thread_local);
 
+  // The batches of keys of one column family, in order, looked up in the
+  // memtables by PlanMultiGetIO() ahead of the SST files
+  using MultiGetMemtableBatches = std::vector<std::unique_ptr<MultiGetContext>>;
+
   // The actual implementation of the batching MultiGet. The caller is expected
   // to have acquired the SuperVersion and pass in a snapshot sequence number
   // in order to construct the LookupKeys. The start_key and num_keys specify
   // the range of keys in the sorted_keys vector for a single column family.
+  // With `memtable_batches` from PlanMultiGetIO(), only the keys left after
+  // the memtables are looked up.
   DECLARE_SYNC_AND_ASYNC(
       Status, MultiGetImpl, const ReadOptions& read_options, size_t start_key,
       size_t num_keys,
       autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
-      SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback);
+      SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback,
+      MultiGetMemtableBatches* memtable_batches = nullptr);
+
+  // Looks up the keys of `range` in the memtables of `sv` (unless skipped
+  // for kPersistedTier), and returns whether keys are left for the SST files.
+  bool MultiGetFromMemtables(const ReadOptions& read_options, SuperVersion* sv,
+                             ReadCallback* callback,
+                             const BlobFetcher* memtable_blob_fetcher,
+                             MultiGetRange* range);
+
+  // For ReadOptions::plan_multiget_io, looks up the keys in the range of
+  // sorted_keys of one column family, given as for MultiGetImpl(), in the
+  // memtables into `memtable_batches`, and adds to `plan` the data blocks
+  // which may hold the keys left.
+  void PlanMultiGetIO(
+      const ReadOptions& read_options, size_t start_key, size_t num_keys,
+      autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
+      SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback,
+      bool use_coro_read, MultiGetMemtableBatches* memtable_batches,
+      MultiGetIOPlan* plan);
 
   void MultiGetWithCallbackImpl(
       const ReadOptions& read_options, ColumnFamilyHandle* column_family,
@@ -16,6 +16,7 @@
 #include "db/db_impl/db_impl.h"
 #include "db/error_handler.h"
 #include "db/event_helpers.h"
+#include "db/user_key_row_cache.h"
 #include "file/file_util.h"
 #include "file/sst_file_manager_impl.h"
 #include "logging/logging.h"
@@ -4675,6 +4676,10 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
           compaction_released = true;
         });
     io_s = versions_->io_status();
+    if (c->column_family_data()->user_key_row_cache() != nullptr) {
+      // The dropped files may hold cached rows
+      c->column_family_data()->user_key_row_cache()->InvalidateAll();
+    }
     InstallSuperVersionAndScheduleWork(
         c->column_family_data(), job_context->superversion_contexts.data());
     ROCKS_LOG_BUFFER(log_buffer, "[%s] Deleted %d files\n",
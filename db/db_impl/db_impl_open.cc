@@ -14,6 +14,7 @@
 #include "db/error_handler.h"
 #include "db/periodic_task_scheduler.h"
 #include "db/version_util.h"
+#include "db/wal_record_prefetcher.h"
 #include "env/composite_env_wrapper.h"
 #include "file/filename.h"
 #include "file/read_write_util.h"
@@ -1355,9 +1356,25 @@ Status DBImpl::ProcessLogFile(
     return status;
   }
 
+  // With pipelined WAL recovery, records are read and decoded by the
+  // prefetcher, which is destroyed before `reader`.
+  std::unique_ptr<WalRecordPrefetcher> prefetcher;
+  if (immutable_db_options_.pipelined_wal_recovery) {
+    prefetcher.reset(new WalRecordPrefetcher(
+        immutable_db_options_.wal_recovery_mode,
+        [&](const Slice& prefetched, WalRecordPrefetcher::Record* out) {
+          if (prefetched.size() >= WriteBatchInternal::kHeader) {
+            out->decode_status = InitializeWriteBatchForLogRecord(
+                prefetched, reader, running_ts_sz, &out->batch,
+                out->new_batch, out->batch_to_use, &out->checksum);
+          }
+        }));
+  }
+
   Status init_status = InitializeLogReader(
       wal_number, is_retry, fname, *stop_replay_for_corruption, min_wal_number,
-      predecessor_wal_info, &old_log_record, &status, &reporter, reader);
+      predecessor_wal_info, &old_log_record, &status, &reporter,
+      prefetcher.get(), reader);
 
   // FIXME(hx235): Consolidate `!init_status.ok()` and `reader == nullptr` cases
   if (!init_status.ok()) {
@@ -1374,14 +1391,25 @@ Status DBImpl::ProcessLogFile(
 
   TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
                            /*cb_arg=*/nullptr);
+  if (prefetcher) {
+    prefetcher->Start(reader.get());
+  }
   while (true) {
     if (*stop_replay_by_wal_filter) {
       break;
     }
 
-    bool read_record = reader->ReadRecord(
-        &record, &scratch, immutable_db_options_.wal_recovery_mode,
-        &record_checksum);
+    bool read_record;
+    std::unique_ptr<WalRecordPrefetcher::Record> prefetched;
+    if (prefetcher) {
+      prefetched = prefetcher->Next();
+      prefetched->ReplayReports(&reporter);
+      read_record = prefetched->read;
+    } else {
+      read_record = reader->ReadRecord(
+          &record, &scratch, immutable_db_options_.wal_recovery_mode,
+          &record_checksum);
+    }
 
     // `reader->ReadRecord` will change `status` through reporter in `reader`
     // when a corruption is encountered
@@ -1392,11 +1420,21 @@ Status DBImpl::ProcessLogFile(
 
     // FIXME(hx235): consolidate `process_status` and `status`
     SequenceNumber prev_next_sequence = *next_sequence;
-    Status process_status = ProcessLogRecord(
-        record, reader, running_ts_sz, wal_number, fname, read_only, job_id,
-        logFileDropped, &reporter, &record_checksum, &last_seqno_observed,
-        next_sequence, stop_replay_for_corruption, &status,
-        stop_replay_by_wal_filter, version_edits, flushed);
+    Status process_status;
+    if (prefetched) {
+      process_status = ProcessDecodedLogRecord(
+          prefetched->size, prefetched->decode_status,
+          prefetched->batch_to_use, wal_number, fname, read_only, job_id,
+          logFileDropped, &reporter, &last_seqno_observed, next_sequence,
+          stop_replay_for_corruption, &status, stop_replay_by_wal_filter,
+          version_edits, flushed);
+    } else {
+      process_status = ProcessLogRecord(
+          record, reader, running_ts_sz, wal_number, fname, read_only, job_id,
+          logFileDropped, &reporter, &record_checksum, &last_seqno_observed,
+          next_sequence, stop_replay_for_corruption, &status,
+          stop_replay_by_wal_filter, version_edits, flushed);
+    }
 
     if (!process_status.ok()) {
       return process_status;
@@ -1447,6 +1485,7 @@ Status DBImpl::InitializeLogReader(
     bool stop_replay_for_corruption, uint64_t min_wal_number,
     const PredecessorWALInfo& predecessor_wal_info, bool* const old_log_record,
     Status* const reporter_status, DBOpenLogRecordReadReporter* reporter,
+    log::Reader::Reporter* read_reporter,
     std::unique_ptr<log::Reader>& reader) {
   assert(old_log_record);
   assert(reporter_status);
@@ -1484,9 +1523,11 @@ Status DBImpl::InitializeLogReader(
   // We intentially make log::Reader do checksumming even if
   // paranoid_checks==false so that corruptions cause entire commits
   // to be skipped instead of propagating bad information (like overly
-  // large sequence numbers).
+  // large sequence numbers). A `read_reporter` forwards what it is told to
+  // `reporter`.
   reader.reset(new log::Reader(
-      immutable_db_options_.info_log, std::move(file_reader), reporter,
+      immutable_db_options_.info_log, std::move(file_reader),
+      read_reporter != nullptr ? read_reporter : reporter,
       true /*checksum*/, wal_number,
       immutable_db_options_.track_and_verify_wals, stop_replay_for_corruption,
       min_wal_number, predecessor_wal_info));
@@ -1509,24 +1550,51 @@ Status DBImpl::ProcessLogRecord(
   assert(status);
   assert(stop_replay_by_wal_filter);
 
-  Status process_status;
-  bool has_valid_writes = false;
+  Status decode_status;
   WriteBatch batch;
   std::unique_ptr<WriteBatch> new_batch;
   WriteBatch* batch_to_use = nullptr;
 
-  if (record.size() < WriteBatchInternal::kHeader) {
-    reporter->Corruption(record.size(),
+  if (record.size() >= WriteBatchInternal::kHeader) {
+    decode_status = InitializeWriteBatchForLogRecord(
+        record, reader, running_ts_sz, &batch, new_batch, batch_to_use,
+        record_checksum);
+  }
+
+  return ProcessDecodedLogRecord(
+      record.size(), decode_status, batch_to_use, wal_number, fname, read_only,
+      job_id, logFileDropped, reporter, last_seqno_observed, next_sequence,
+      stop_replay_for_corruption, status, stop_replay_by_wal_filter,
+      version_edits, flushed);
+}
+
+Status DBImpl::ProcessDecodedLogRecord(
+    size_t record_size, const Status& decode_status, WriteBatch* batch_to_use,
+    uint64_t wal_number, const std::string& fname, bool read_only, int job_id,
+    const std::function<void()>& logFileDropped,
+    DBOpenLogRecordReadReporter* reporter, SequenceNumber* last_seqno_observed,
+    SequenceNumber* next_sequence, bool* stop_replay_for_corruption,
+    Status* status, bool* stop_replay_by_wal_filter,
+    std::unordered_map<int, VersionEdit>* version_edits, bool* flushed) {
+  assert(reporter);
+  assert(last_seqno_observed);
+  assert(stop_replay_for_corruption);
+  assert(status);
+  assert(stop_replay_by_wal_filter);
+
+  Status process_status;
+  bool has_valid_writes = false;
+
+  if (record_size < WriteBatchInternal::kHeader) {
+    decode_status.PermitUncheckedError();
+    reporter->Corruption(record_size,
                          Status::Corruption("log record too small"));
     assert(process_status.ok());
     return process_status;
   }
 
-  process_status = InitializeWriteBatchForLogRecord(
-      record, reader, running_ts_sz, &batch, new_batch, batch_to_use,
-      record_checksum);
-  if (!process_status.ok()) {
-    return process_status;
+  if (!decode_status.ok()) {
+    return decode_status;
   }
   assert(batch_to_use);
 
@@ -1534,7 +1602,7 @@ Status DBImpl::ProcessLogRecord(
 
   if (*last_seqno_observed > kMaxSequenceNumber) {
     reporter->Corruption(
-        record.size(),
+        record_size,
         Status::Corruption("sequence " + std::to_string(*last_seqno_observed) +
                            " is too large"));
     assert(process_status.ok());
@@ -1571,7 +1639,7 @@ Status DBImpl::ProcessLogRecord(
   if (!process_status.ok()) {
     // FIXME(hx235): `reporter->Corruption()` will override the non-ok status
     // set in `InvokeWalFilterIfNeededOnWalRecord` through passing `*status`
-    reporter->Corruption(record.size(), process_status);
+    reporter->Corruption(record_size, process_status);
     process_status = Status::OK();
     return process_status;
   }
@@ -69,7 +69,23 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
 
   assert(get_impl_options.column_family);
 
-  if (read_options.timestamp) {
+  auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(
+      get_impl_options.column_family);
+  auto cfd = cfh->cfd();
+  const Comparator* ucmp = cfd->user_comparator();
+  assert(ucmp);
+  // Value reads of a column family without merge operator or user-defined
+  // timestamps, and without read callback, skip the timestamp checks, the
+  // timestamp read callback and the merge operand bookkeeping below
+  const bool plain_read = get_impl_options.get_value &&
+                          get_impl_options.callback == nullptr &&
+                          read_options.timestamp == nullptr &&
+                          ucmp->timestamp_size() == 0 &&
+                          cfd->ioptions().merge_operator == nullptr;
+
+  if (plain_read) {
+    // Nothing to check
+  } else if (read_options.timestamp) {
     const Status s = FailIfTsMismatchCf(get_impl_options.column_family,
                                         *(read_options.timestamp));
     if (!s.ok()) {
@@ -88,17 +104,19 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
     get_impl_options.timestamp->clear();
   }
 
-  GetWithTimestampReadCallback read_cb(0);  // Will call Refresh
-
 #if defined(WITHOUT_COROUTINES)
+  PerfContextSampleGuard perf_sample_guard(&perf_context_sampler_,
+                                           SampledOpType::kGet,
+                                           immutable_db_options_.clock, stats_);
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, immutable_db_options_.clock);
 #endif
   StopWatch sw(immutable_db_options_.clock, stats_, DB_GET);
   PERF_TIMER_GUARD(get_snapshot_time);
 
-  auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(
-      get_impl_options.column_family);
-  auto cfd = cfh->cfd();
+  // Attribute rate limited reads to the column family's tenant
+  IOTenantScope io_tenant_scope(
+      read_options.rate_limiter_priority != Env::IO_TOTAL ? &cfd->GetName()
+                                                          : nullptr);
 
   if (tracer_) {
     // TODO: This mutex should be removed later, to improve performance when
@@ -118,6 +136,21 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
     }
   }
 
+  // Only plain reads of a value through all tiers use the user key row
+  // cache
+  UserKeyRowCache* row_cache = cfd->user_key_row_cache();
+  if (row_cache != nullptr &&
+      (!get_impl_options.get_value || get_impl_options.value == nullptr ||
+       get_impl_options.columns != nullptr ||
+       get_impl_options.callback != nullptr ||
+       get_impl_options.is_blob_index != nullptr ||
+       get_impl_options.value_found != nullptr ||
+       get_impl_options.lazy_columns_pin != nullptr ||
+       read_options.read_tier != kReadAllTier ||
+       read_options.ignore_range_deletions ||
+       read_options.merge_operand_count_threshold.has_value())) {
+    row_cache = nullptr;
+  }
   // Acquire SuperVersion
 #if defined(WITH_COROUTINES)
   SuperVersion* sv = cfd->GetReferencedSuperVersion(this);
@@ -134,6 +167,12 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
     }
   }
 
+  std::string row_cache_key;
+  if (row_cache != nullptr) {
+    row_cache->InitCacheKey(sv->user_key_row_cache_prefix, key,
+                            &row_cache_key);
+  }
+
   TEST_SYNC_POINT_CALLBACK("DBImpl::GetImpl:AfterAcquireSv", nullptr);
   TEST_SYNC_POINT("DBImpl::GetImpl:1");
   TEST_SYNC_POINT("DBImpl::GetImpl:2");
@@ -176,19 +215,32 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
   // If timestamp is used, we use read callback to ensure <key,t,s> is returned
   // only if t <= read_opts.timestamp and s <= snapshot.
   // HACK: temporarily overwrite input struct field but restore
-  SaveAndRestore<ReadCallback*> restore_callback(&get_impl_options.callback);
-  const Comparator* ucmp = get_impl_options.column_family->GetComparator();
-  assert(ucmp);
+  std::optional<GetWithTimestampReadCallback> read_cb;
+  std::optional<SaveAndRestore<ReadCallback*>> restore_callback;
   if (ucmp->timestamp_size() > 0) {
     assert(!get_impl_options
                 .callback);  // timestamp with callback is not supported
-    read_cb.Refresh(snapshot);
-    get_impl_options.callback = &read_cb;
+    read_cb.emplace(snapshot);
+    restore_callback.emplace(&get_impl_options.callback, &*read_cb);
   }
   TEST_SYNC_POINT("DBImpl::GetImpl:3");
   TEST_SYNC_POINT("DBImpl::GetImpl:4");
 
-  // Prepare to store a list of merge operations if merge occurs.
+  if (row_cache != nullptr) {
+    bool found = false;
+    if (row_cache->Lookup(row_cache_key, snapshot, get_impl_options.value,
+                          &found)) {
+      size_t size = found ? get_impl_options.value->size() : 0;
+      RecordTick(stats_, NUMBER_KEYS_READ);
+      RecordTick(stats_, BYTES_READ, size);
+      PERF_COUNTER_ADD(get_read_bytes, size);
+      RecordInHistogram(stats_, BYTES_PER_READ, size);
+      CO_RETURN found ? Status::OK() : Status::NotFound();
+    }
+  }
+
+  // Prepare to store a list of merge operations if merge occurs. Only
+  // allocates once merge operands are found.
   MergeContext merge_context;
   merge_context.get_merge_operands_options =
       get_impl_options.get_merge_operands_options;
@@ -198,6 +250,7 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
   // First look in the memtable, then in the immutable memtable (if any).
   // s is both in/out. When in, s could either be OK or MergeInProgress.
   // merge_operands will contain the sequence of merges in the latter case.
+  // The key is encoded on the stack unless it is long.
   LookupKey lkey(key, snapshot, read_options.timestamp);
   PERF_TIMER_STOP(get_snapshot_time);
 
@@ -323,7 +376,7 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
     size_t size = 0;
     if (s.ok()) {
       const auto& merge_threshold = read_options.merge_operand_count_threshold;
-      if (merge_threshold.has_value() &&
+      if (!plain_read && merge_threshold.has_value() &&
           merge_context.GetNumOperands() > merge_threshold.value()) {
         s = Status::OkMergeOperandThresholdExceeded();
       }
@@ -418,6 +471,10 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
     }
     RecordInHistogram(stats_, BYTES_PER_READ, size);
   }
+  if (row_cache != nullptr && (s.ok() || s.IsNotFound())) {
+    row_cache->Insert(row_cache_key, key, snapshot,
+                      s.ok() ? get_impl_options.value : nullptr);
+  }
   CO_RETURN s;
 }
 
@@ -433,7 +490,8 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::GetImpl)
 DEFINE_SYNC_AND_ASYNC(Status, DBImpl::MultiGetImpl)
 (const ReadOptions& read_options, size_t start_key, size_t num_keys,
  autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
- SuperVersion* super_version, SequenceNumber snapshot, ReadCallback* callback) {
+ SuperVersion* super_version, SequenceNumber snapshot, ReadCallback* callback,
+ MultiGetMemtableBatches* memtable_batches) {
 #if defined(WITHOUT_COROUTINES)
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, immutable_db_options_.clock);
 #endif  // defined(WITHOUT_COROUTINES)
@@ -463,19 +521,8 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::MultiGetImpl)
   constexpr bool kUseCoroRead = false;
 #endif
 
-  // Clear the timestamps for returning results so that we can distinguish
-  // between tombstone or key that has never been written
-  for (size_t i = start_key; i < start_key + num_keys; ++i) {
-    KeyContext* kctx = (*sorted_keys)[i];
-    if (kctx->timestamp) {
-      kctx->timestamp->clear();
-    }
-  }
-
   // For each of the given keys, apply the entire "get" process as follows:
-  // First look in the memtable, then in the immutable memtable (if any).
-  // s is both in/out. When in, s could either be OK or MergeInProgress.
-  // merge_operands will contain the sequence of merges in the latter case.
+  // First look in the memtables, then in the SST files.
   size_t keys_left = num_keys;
   Status s;
   uint64_t curr_value_size = 0;
@@ -490,37 +537,30 @@ DEFINE_SYNC_AND_ASYNC(Status, DBImpl::MultiGetImpl)
     size_t batch_size = (keys_left > MultiGetContext::MAX_BATCH_SIZE)
                             ? MultiGetContext::MAX_BATCH_SIZE
                             : keys_left;
-    MultiGetContext ctx(sorted_keys, start_key + num_keys - keys_left,
-                        batch_size, snapshot, read_options, GetFileSystem(),
-                        stats_, kUseCoroRead);
-    MultiGetRange range = ctx.GetMultiGetRange();
+    const size_t batch_start = start_key + num_keys - keys_left;
+    std::optional<MultiGetContext> local_ctx;
+    MultiGetContext* ctx;
+    if (memtable_batches != nullptr) {
+      ctx = (*memtable_batches)[(batch_start - start_key) /
+                                MultiGetContext::MAX_BATCH_SIZE]
+                .get();
+    } else {
+      local_ctx.emplace(sorted_keys, batch_start, batch_size, snapshot,
+                        read_options, GetFileSystem(), stats_, kUseCoroRead);
+      ctx = &*local_ctx;
+    }
+    MultiGetRange range = ctx->GetMultiGetRange();
     range.AddValueSize(curr_value_size);
-    bool lookup_current = true;
 
     keys_left -= batch_size;
-    for (auto mget_iter = range.begin(); mget_iter != range.end();
-         ++mget_iter) {
-      mget_iter->merge_context.Clear();
-      *mget_iter->s = Status::OK();
-    }
-
-    bool skip_memtable =
-        (read_options.read_tier == kPersistedTier &&
-         has_unpersisted_data_.load(std::memory_order_relaxed));
-    if (!skip_memtable) {
-      super_version->mem->MultiGet(read_options, &range, callback,
-                                   false /* immutable_memtable */,
-                                   memtable_blob_fetcher_ptr);
-      if (!range.empty()) {
-        super_version->imm->MultiGet(read_options, &range, callback,
-                                     memtable_blob_fetcher_ptr);
-      }
-      if (!range.empty()) {
-        uint64_t left = range.KeysLeft();
-        RecordTick(stats_, MEMTABLE_MISS, left);
-      } else {
-        lookup_current = false;
-      }
+    bool lookup_current;
+    if (memtable_batches != nullptr) {
+      // Already looked up in the memtables
+      lookup_current = !range.empty();
+    } else {
+      lookup_current =
+          MultiGetFromMemtables(read_options, super_version, callback,
+                                memtable_blob_fetcher_ptr, &range);
     }
     if (lookup_current) {
       PERF_TIMER_GUARD(get_from_output_files_time);
@@ -760,20 +800,45 @@ DEFINE_SYNC_AND_ASYNC(void, DBImpl::MultiGetCommon)
   }
 
   assert(key_range_per_cf.size() == cf_sv_pairs.size());
+  std::unique_ptr<MultiGetIOPlan> io_plan;
+  std::vector<MultiGetMemtableBatches> memtable_batches;
+  if (read_options.plan_multiget_io) {
+#ifdef WITH_COROUTINES
+    constexpr bool kUseCoroRead = true;
+#else
+    constexpr bool kUseCoroRead = false;
+#endif
+    // All the column families in one batch of reads
+    io_plan = std::make_unique<MultiGetIOPlan>();
+    memtable_batches.resize(key_range_per_cf.size());
+    for (size_t i = 0; i < key_range_per_cf.size(); ++i) {
+      PlanMultiGetIO(read_options, key_range_per_cf[i].start,
+                     key_range_per_cf[i].num_keys, &sorted_keys,
+                     cf_sv_pairs[i].super_version, consistent_seqnum,
+                     read_callback, kUseCoroRead, &memtable_batches[i],
+                     io_plan.get());
+    }
+    io_plan->Execute();
+  }
   auto key_range_per_cf_iter = key_range_per_cf.begin();
   auto cf_sv_pair_iter = cf_sv_pairs.begin();
   while (key_range_per_cf_iter != key_range_per_cf.end() &&
          cf_sv_pair_iter != cf_sv_pairs.end()) {
+    size_t cf_index = key_range_per_cf_iter - key_range_per_cf.begin();
     s = CO_AWAIT(MultiGetImpl, read_options, key_range_per_cf_iter->start,
                  key_range_per_cf_iter->num_keys, &sorted_keys,
                  cf_sv_pair_iter->super_version, consistent_seqnum,
-                 read_callback);
+                 read_callback,
+                 io_plan ? &memtable_batches[cf_index] : nullptr);
     if (!s.ok()) {
       break;
     }
     ++key_range_per_cf_iter;
     ++cf_sv_pair_iter;
   }
+  // Unpins the blocks and tables before the SuperVersions
+  io_plan.reset();
+  memtable_batches.clear();
   if (!s.ok()) {
     assert(s.IsTimedOut() || s.IsAborted());
     for (++key_range_per_cf_iter;
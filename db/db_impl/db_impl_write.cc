@@ -15,6 +15,7 @@
 #include "db/db_impl/db_impl.h"
 #include "db/error_handler.h"
 #include "db/event_helpers.h"
+#include "db/user_key_row_cache.h"
 #include "db/wide/wide_columns_helper.h"
 #include "file/filename.h"
 #include "logging/logging.h"
@@ -345,6 +346,11 @@ Status DBImpl::IngestWBWIAsMemtable(
                          &cfd->GetLatestMutableCFOptions(), stat);
     wbwi_memtable->Ref();
     wbwi_memtable->AssignSequenceNumbers(assigned_seqno);
+    if (cfd->user_key_row_cache() != nullptr) {
+      // The ingested memtable does not go through MemTable::Add()
+      cfd->user_key_row_cache()->InvalidateSnapshotsBefore(
+          assigned_seqno.upper_bound);
+    }
     // This is needed to keep the WAL that contains Prepare alive until
     // committed data in this memtable is persisted.
     wbwi_memtable->SetMinPrepLog(min_prep_log);
@@ -874,6 +880,9 @@ Status DBImpl::WriteImpl(
     std::shared_ptr<WriteBatchWithIndex> wbwi, WriteBatch* trace_batch_override,
     bool skip_blob_direct_write_transform,
     const DBImpl::DeferredPutEntityBatch* deferred_put_entities) {
+  PerfContextSampleGuard perf_sample_guard(&perf_context_sampler_,
+                                           SampledOpType::kWrite,
+                                           immutable_db_options_.clock, stats_);
   assert(!seq_per_batch_ || batch_cnt != 0);
   assert(my_batch == nullptr || my_batch->Count() == 0 ||
          write_options.protection_bytes_per_key == 0 ||
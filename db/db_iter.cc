@@ -130,6 +130,9 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
               : 0),
       expose_blob_index_(expose_blob_index),
       allow_unprepared_value_(read_options.allow_unprepared_value),
+      scan_predicate_(expose_blob_index || timestamp_lb_ != nullptr
+                          ? nullptr
+                          : read_options.scan_predicate),
       arena_mode_(arena_mode) {
   RecordTick(statistics_, NO_ITERATOR_CREATED);
   if (pin_thru_lifetime_) {
@@ -180,6 +183,9 @@ Status DBIter::GetProperty(std::string prop_name, std::string* prop) {
     }
     return Status::OK();
   } else if (prop_name == "rocksdb.iterator.is-value-pinned") {
+    if (valid_ && blob_state_->lazy_value && !PrepareValue()) {
+      return status();
+    }
     if (valid_) {
       *prop = (pin_thru_lifetime_ && iter_.Valid() &&
                iter_.value().data() == value_columns_state_->value().data())
@@ -193,6 +199,9 @@ Status DBIter::GetProperty(std::string prop_name, std::string* prop) {
     *prop = saved_key_.GetUserKey().ToString();
     return Status::OK();
   } else if (prop_name == "rocksdb.iterator.write-time") {
+    if (valid_ && blob_state_->lazy_value && !PrepareValue()) {
+      return status();
+    }
     PutFixed64(prop, saved_write_unix_time_);
     return Status::OK();
   }
@@ -259,7 +268,8 @@ void DBIter::Next() {
 }
 
 Status DBIter::BlobReader::RetrieveAndSetBlobValue(const Slice& user_key,
-                                                   const Slice& blob_index) {
+                                                   const Slice& blob_index,
+                                                   bool forward) {
   assert(blob_value_.empty());
 
   if (!blob_fetcher_.CanResolve()) {
@@ -267,16 +277,31 @@ Status DBIter::BlobReader::RetrieveAndSetBlobValue(const Slice& user_key,
   }
 
   // TODO: plumb Env::IOPriority
-  constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
   constexpr uint64_t* bytes_read = nullptr;
-  return blob_fetcher_.FetchBlob(user_key, blob_index, prefetch_buffer,
+  if (prefetch_buffers_ == nullptr || !forward) {
+    constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
+    return blob_fetcher_.FetchBlob(user_key, blob_index, prefetch_buffer,
+                                   &blob_value_, bytes_read);
+  }
+
+  BlobIndex decoded_blob_index;
+  Status s = decoded_blob_index.DecodeFrom(blob_index);
+  if (!s.ok()) {
+    return s;
+  }
+  FilePrefetchBuffer* prefetch_buffer = nullptr;
+  if (!decoded_blob_index.IsInlined() && !decoded_blob_index.IsSameFile()) {
+    prefetch_buffer = prefetch_buffers_->GetOrCreatePrefetchBuffer(
+        decoded_blob_index.file_number());
+  }
+  return blob_fetcher_.FetchBlob(user_key, decoded_blob_index, prefetch_buffer,
                                  &blob_value_, bytes_read);
 }
 
 bool DBIter::SetValueAndColumnsFromBlobImpl(const Slice& user_key,
                                             const Slice& blob_index) {
-  const Status s =
-      blob_state_.mut()->reader.RetrieveAndSetBlobValue(user_key, blob_index);
+  const Status s = blob_state_.mut()->reader.RetrieveAndSetBlobValue(
+      user_key, blob_index, direction_ == kForward);
   if (!s.ok()) {
     status_ = s;
     valid_ = false;
@@ -445,6 +470,19 @@ bool DBIter::SetValueAndColumnsFromMergeResult(const Status& merge_status,
 bool DBIter::PrepareValue() {
   assert(valid_);
 
+  if (blob_state_->lazy_value) {
+    assert(allow_unprepared_value_);
+    assert(direction_ == kForward);
+    blob_state_.mut()->lazy_value = false;
+    if (!PrepareValueInternal()) {
+      return false;
+    }
+    assert(ikey_.type == kTypeValue);
+    saved_write_unix_time_ = iter_.write_unix_time();
+    SetValueAndColumnsFromPlain(iter_.value());
+    return true;
+  }
+
   if (blob_state_->lazy_blob_index.empty()) {
     return true;
   }
@@ -475,7 +513,45 @@ bool DBIter::PrepareValue() {
 // more entry for the prefix can be found.
 bool DBIter::FindNextUserEntry(bool skipping_saved_key) {
   PERF_TIMER_GUARD(find_next_user_entry_time);
-  return FindNextUserEntryInternal(skipping_saved_key);
+  bool ok = FindNextUserEntryInternal(skipping_saved_key);
+  while (ok && valid_ && scan_predicate_ != nullptr &&
+         !MatchesScanPredicate()) {
+    if (!valid_) {
+      return false;
+    }
+    ok = SkipNonMatchingUserEntry();
+  }
+  return ok;
+}
+
+bool DBIter::MatchesScanPredicate() {
+  assert(valid_);
+  assert(scan_predicate_ != nullptr);
+  if (!PrepareValue()) {
+    return false;
+  }
+  return scan_predicate_->Matches(key(), columns());
+}
+
+bool DBIter::SkipNonMatchingUserEntry() {
+  assert(direction_ == kForward);
+  local_stats_.scan_predicate_skip_count_++;
+  ReleaseTempPinnedData();
+  ResetBlobData();
+  ResetValueAndColumns();
+  valid_ = false;
+  if (!current_entry_is_merged_) {
+    // As in Next(), iter_ is still at the entry unless it was merged
+    assert(iter_.Valid());
+    iter_.Next();
+    PERF_COUNTER_ADD(internal_key_skipped_count, 1);
+  }
+  if (!iter_.Valid()) {
+    is_key_seqnum_zero_ = false;
+    return iter_.status().ok();
+  }
+  ClearSavedValue();
+  return FindNextUserEntryInternal(true /* skipping the current user key */);
 }
 
 // Actual implementation of DBIter::FindNextUserEntry()
@@ -605,8 +681,13 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key) {
           case kTypeValue:
           case kTypeValuePreferredSeqno:
           case kTypeBlobIndex:
-          case kTypeWideColumnEntity:
-            if (!PrepareValueInternal()) {
+          case kTypeWideColumnEntity: {
+            // iter_ stays on a plain entry until the next repositioning, so
+            // PrepareValue() can read its value later
+            const bool lazy_value = allow_unprepared_value_ &&
+                                    !expose_blob_index_ &&
+                                    ikey_.type == kTypeValue;
+            if (!lazy_value && !PrepareValueInternal()) {
               return false;
             }
             FlushPendingTombstoneRun(ikey_.user_key);
@@ -618,7 +699,9 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key) {
                                       !iter_.iter()->IsKeyPinned() /* copy */);
             }
 
-            if (ikey_.type == kTypeBlobIndex) {
+            if (lazy_value) {
+              blob_state_.mut()->lazy_value = true;
+            } else if (ikey_.type == kTypeBlobIndex) {
               if (!SetValueAndColumnsFromBlob(ikey_.user_key, iter_.value())) {
                 return false;
               }
@@ -639,6 +722,7 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key) {
 
             valid_ = true;
             return true;
+          }
           case kTypeMerge:
             if (!PrepareValueInternal()) {
               return false;
@@ -1083,8 +1167,19 @@ void DBIter::PrevInternal() {
     }
 
     if (valid_) {
-      // Found the value.
-      return;
+      if (scan_predicate_ == nullptr || MatchesScanPredicate()) {
+        // Found the value.
+        return;
+      }
+      if (!status_.ok()) {
+        return;
+      }
+      local_stats_.scan_predicate_skip_count_++;
+      ReleaseTempPinnedData();
+      ResetBlobData();
+      ResetValueAndColumns();
+      ClearSavedValue();
+      valid_ = false;
     }
 
     if (TooManyInternalKeysSkipped(false)) {
@@ -1586,8 +1681,8 @@ bool DBIter::MergeWithBlobBaseValue(const Slice& blob_index,
     return false;
   }
 
-  const Status s =
-      blob_state_.mut()->reader.RetrieveAndSetBlobValue(user_key, blob_index);
+  const Status s = blob_state_.mut()->reader.RetrieveAndSetBlobValue(
+      user_key, blob_index, direction_ == kForward);
   if (!s.ok()) {
     status_ = s;
     valid_ = false;
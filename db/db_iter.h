@@ -17,6 +17,7 @@
 
 #include "db/blob/blob_fetcher.h"
 #include "db/blob/blob_index.h"
+#include "db/blob/prefetch_buffer_collection.h"
 #include "db/db_impl/db_impl.h"
 #include "db/wide/read_path_blob_resolver.h"
 #include "db/wide/wide_columns_helper.h"
@@ -24,6 +25,7 @@
 #include "options/cf_options.h"
 #include "rocksdb/db.h"
 #include "rocksdb/iterator.h"
+#include "rocksdb/scan_predicate.h"
 #include "rocksdb/wide_columns.h"
 #include "table/iterator_wrapper.h"
 #include "util/autovector.h"
@@ -131,6 +133,7 @@ class DBIter final : public Iterator {
       prev_found_count_ = 0;
       bytes_read_ = 0;
       skip_count_ = 0;
+      scan_predicate_skip_count_ = 0;
     }
 
     void BumpGlobalStatistics(Statistics* global_statistics) {
@@ -140,6 +143,8 @@ class DBIter final : public Iterator {
       RecordTick(global_statistics, NUMBER_DB_PREV_FOUND, prev_found_count_);
       RecordTick(global_statistics, ITER_BYTES_READ, bytes_read_);
       RecordTick(global_statistics, NUMBER_ITER_SKIP, skip_count_);
+      RecordTick(global_statistics, SCAN_PREDICATE_ENTRIES_SKIPPED,
+                 scan_predicate_skip_count_);
       PERF_COUNTER_ADD(iter_read_bytes, bytes_read_);
       ResetCounters();
     }
@@ -156,6 +161,8 @@ class DBIter final : public Iterator {
     uint64_t bytes_read_;
     // Map to Tickers::NUMBER_ITER_SKIP
     uint64_t skip_count_;
+    // Map to Tickers::SCAN_PREDICATE_ENTRIES_SKIPPED
+    uint64_t scan_predicate_skip_count_;
   };
 
   // No copying allowed
@@ -279,11 +286,18 @@ class DBIter final : public Iterator {
     BlobReader(const Version* version, const ReadOptions& read_options,
                BlobFileCache* blob_file_cache, bool allow_write_path_fallback)
         : blob_fetcher_(version, ReadOptions(read_options), blob_file_cache,
-                        allow_write_path_fallback) {}
+                        allow_write_path_fallback),
+          prefetch_buffers_(
+              read_options.blob_readahead_size > 0
+                  ? std::make_unique<PrefetchBufferCollection>(
+                        read_options.blob_readahead_size)
+                  : nullptr) {}
 
     const Slice& GetBlobValue() const { return blob_value_; }
+    // `forward` enables ReadOptions::blob_readahead_size, which only helps
+    // when moving forward through the blob files.
     Status RetrieveAndSetBlobValue(const Slice& user_key,
-                                   const Slice& blob_index);
+                                   const Slice& blob_index, bool forward);
     void ResetBlobValue() { blob_value_.Reset(); }
     // The blob fetcher backing this reader, for resolving wide-column entity
     // blob references (the merge path). Valid for this BlobReader's lifetime.
@@ -292,10 +306,17 @@ class DBIter final : public Iterator {
    private:
     PinnableSlice blob_value_;
     OwningVersionBlobFetcher blob_fetcher_;
+    // One readahead buffer per blob file, if blob_readahead_size is set
+    std::unique_ptr<PrefetchBufferCollection> prefetch_buffers_;
   };
   struct BlobState {
     BlobReader reader;
     Slice lazy_blob_index;
+    // With allow_unprepared_value, the value of the current plain entry is
+    // only read by PrepareValue(), which saves reading a value the SST file
+    // stores outside of its data blocks (embedded_blob_min_size) for
+    // key-only scans
+    bool lazy_value = false;
     bool is_blob = false;
 
     template <typename... Args>
@@ -304,6 +325,7 @@ class DBIter final : public Iterator {
     void Reset() {
       reader.ResetBlobValue();
       lazy_blob_index.clear();
+      lazy_value = false;
       is_blob = false;
     }
   };
@@ -466,6 +488,13 @@ class DBIter final : public Iterator {
   bool FindNextUserEntry(bool skipping_saved_key);
   // Internal implementation of FindNextUserEntry().
   bool FindNextUserEntryInternal(bool skipping_saved_key);
+  // PRE: valid_
+  // Returns whether the current entry matches scan_predicate_. Returns false
+  // with valid_ = false and status() non-ok if its value cannot be read.
+  bool MatchesScanPredicate();
+  // Moves past the current entry, which did not match scan_predicate_, to the
+  // next user entry. Same return value as FindNextUserEntry().
+  bool SkipNonMatchingUserEntry();
   bool ParseKey(ParsedInternalKey* key);
   bool MergeValuesNewToOld();
 
@@ -743,6 +772,8 @@ class DBIter final : public Iterator {
   // the stacked BlobDB implementation is used, false otherwise.
   bool expose_blob_index_;
   bool allow_unprepared_value_;
+  // ReadOptions::scan_predicate, or nullptr when it does not apply
+  const ScanPredicate* const scan_predicate_;
   bool arena_mode_;
 
   IterKey range_tomb_first_key_;
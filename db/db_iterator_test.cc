@@ -24,6 +24,7 @@
 #include "rocksdb/io_dispatcher.h"
 #include "rocksdb/iostats_context.h"
 #include "rocksdb/perf_context.h"
+#include "rocksdb/scan_predicate.h"
 #include "table/block_based/flush_block_policy_impl.h"
 #include "test_util/testutil.h"
 #include "util/random.h"
@@ -4308,6 +4309,97 @@ TEST_F(DBIteratorTest, IteratorsConsistentViewExplicitSnapshot) {
   }
 }
 
+TEST_F(DBIteratorTest, ScanPredicate) {
+  Options options = CurrentOptions();
+  options.statistics = CreateDBStatistics();
+  options.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 256;
+  table_options.data_block_value_stats = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // Values of the first half of the keys start with "a", the others with "b"
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(Key(i), std::string(i < 50 ? "a" : "b") + Key(i) +
+                              std::string(20, 'x')));
+  }
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+
+  // Newer versions that must win over the skipped ones
+  ASSERT_OK(Put(Key(10), "b_overwritten"));
+  ASSERT_OK(Delete(Key(60)));
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                           Key(20), {{"col", "v1"}}));
+
+  std::unique_ptr<ScanPredicate> predicate =
+      NewValuePrefixPredicate({"b", "c"});
+  ReadOptions read_options;
+  read_options.scan_predicate = predicate.get();
+  std::vector<std::string> expected;
+  expected.push_back(Key(10));
+  for (int i = 50; i < 100; ++i) {
+    if (i != 60) {
+      expected.push_back(Key(i));
+    }
+  }
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    std::vector<std::string> found;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->value()[0], 'b');
+      found.push_back(iter->key().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(found, expected);
+
+    found.clear();
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      found.push_back(iter->key().ToString());
+    }
+    ASSERT_OK(iter->status());
+    std::reverse(found.begin(), found.end());
+    ASSERT_EQ(found, expected);
+
+    iter->Seek(Key(30));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), Key(50));
+  }
+  // Blocks holding only "a" values were not read
+  ASSERT_GT(TestGetTickerCount(options, SCAN_PREDICATE_DATA_BLOCKS_SKIPPED),
+            0U);
+  ASSERT_GT(TestGetTickerCount(options, SCAN_PREDICATE_ENTRIES_SKIPPED), 0U);
+
+  std::unique_ptr<ScanPredicate> range_predicate =
+      NewValueRangePredicate("akey000040", "akey000045");
+  read_options.scan_predicate = range_predicate.get();
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->key(), Key(40 + count));
+      ++count;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, 5);
+  }
+
+  std::unique_ptr<ScanPredicate> column_predicate =
+      NewWideColumnEqualsPredicate("col", "v1");
+  read_options.scan_predicate = column_predicate.get();
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), Key(20));
+    iter->Next();
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+  }
+}
+
 TEST_P(DBIteratorTest, MemtableOpsScanFlushTriggerWithSeek) {
   // Tests that option memtable_op_scan_flush_trigger works when the limit
   // is reached during a Seek() operation.
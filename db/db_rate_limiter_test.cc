@@ -348,6 +348,45 @@ TEST_F(DBRateLimiterOnWriteTest, Compact) {
             options_.rate_limiter->GetTotalRequests(Env::IO_LOW));
 }
 
+TEST_F(DBRateLimiterOnWriteTest, MultiTenantAttribution) {
+  MultiTenantRateLimiterOptions limiter_options;
+  limiter_options.rate_bytes_per_sec = 1 << 20;
+  limiter_options.tenant_weights = {{"pikachu", 2}};
+  auto limiter = std::shared_ptr<MultiTenantRateLimiter>(
+      NewMultiTenantRateLimiter(limiter_options));
+  Options options = GetOptions();
+  options.rate_limiter = limiter;
+  CreateAndReopenWithCF({"pikachu"}, options);
+
+  ASSERT_OK(Put(1, kStartKey, "v1"));
+  ASSERT_OK(Flush(1));
+  ASSERT_OK(Put(1, kEndKey, "v2"));
+  ASSERT_OK(Flush(1));
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), handles_[1], nullptr,
+                              nullptr));
+
+  // Flush and compaction writes are attributed to the column family
+  auto stats = limiter->GetTenantStats();
+  ASSERT_EQ(1U, stats.count("pikachu"));
+  EXPECT_EQ(2U, stats["pikachu"].weight);
+  EXPECT_EQ(3U, stats["pikachu"].requests);
+  EXPECT_EQ(0U, stats["pikachu"].foreground_requests);
+  EXPECT_GT(stats["pikachu"].bytes, 0U);
+  EXPECT_EQ(static_cast<uint64_t>(limiter->GetTotalRequests()),
+            stats["pikachu"].requests);
+
+  // Tags are per thread, so one set by the caller does not apply to the
+  // background flush
+  SetThreadIOTenant("tag");
+  ASSERT_OK(Put(0, kStartKey, "v3"));
+  ASSERT_OK(Flush(0));
+  SetThreadIOTenant("");
+  stats = limiter->GetTenantStats();
+  ASSERT_EQ(1U, stats.count("default"));
+  EXPECT_EQ(1U, stats["default"].requests);
+  EXPECT_EQ(0U, stats.count("tag"));
+}
+
 class DBRateLimiterOnWriteWALTest
     : public DBRateLimiterOnWriteTest,
       public ::testing::WithParamInterface<std::tuple<
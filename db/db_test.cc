@@ -7470,6 +7470,123 @@ TEST_F(DBTest, ReusePinnableSlice) {
             1);
 }
 
+TEST_F(DBTest, UserKeyRowCache) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.user_key_row_cache = NewLRUCache(1 << 20);
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+
+  ASSERT_EQ(Get("foo"), "v1");
+  ASSERT_EQ(TestGetTickerCount(options, USER_KEY_ROW_CACHE_MISS), 1);
+  ASSERT_EQ(Get("foo"), "v1");
+  ASSERT_EQ(TestGetTickerCount(options, USER_KEY_ROW_CACHE_HIT), 1);
+
+  // "Not found" is cached too
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, USER_KEY_ROW_CACHE_HIT), 2);
+  ASSERT_EQ(TestGetTickerCount(options, USER_KEY_ROW_CACHE_NEGATIVE_HIT), 1);
+
+  // Entries survive compactions
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(Get("foo"), "v1");
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, USER_KEY_ROW_CACHE_HIT), 4);
+
+  // Writes invalidate entries, but older snapshots still read older values
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(Put("foo", "v2"));
+  ASSERT_OK(Put("bar", "v2"));
+  ASSERT_EQ(Get("foo"), "v2");
+  ASSERT_EQ(Get("bar"), "v2");
+  ASSERT_EQ(Get("foo", snapshot), "v1");
+  ASSERT_EQ(Get("bar", snapshot), "NOT_FOUND");
+  db_->ReleaseSnapshot(snapshot);
+  ASSERT_EQ(Get("foo"), "v2");
+  ASSERT_EQ(TestGetTickerCount(options, USER_KEY_ROW_CACHE_HIT), 5);
+
+  ASSERT_OK(Merge("foo", "v3"));
+  ASSERT_EQ(Get("foo"), "v2,v3");
+  ASSERT_OK(Delete("bar"));
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+
+  // Range deletions invalidate all entries
+  ASSERT_OK(Put("foo", "v4"));
+  ASSERT_EQ(Get("foo"), "v4");
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "a",
+                             "z"));
+  ASSERT_EQ(Get("foo"), "NOT_FOUND");
+
+  // So do file ingestions
+  std::string sst_file = dbname_ + "/user_key_row_cache.sst";
+  SstFileWriter sst_file_writer(EnvOptions(), options);
+  ASSERT_OK(sst_file_writer.Open(sst_file));
+  ASSERT_OK(sst_file_writer.Put("foo", "v5"));
+  ASSERT_OK(sst_file_writer.Finish());
+  ASSERT_OK(db_->IngestExternalFile({sst_file}, IngestExternalFileOptions()));
+  ASSERT_EQ(Get("foo"), "v5");
+
+  // A write that races with a read must not leave the read's result cached
+  ASSERT_OK(Put("foo", "v6"));
+  ASSERT_OK(Flush());
+  bool write_during_read = true;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::GetImpl:PostMemTableGet:0", [&](void*) {
+        if (write_during_read) {
+          write_during_read = false;
+          ASSERT_OK(Put("foo", "v7"));
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_EQ(Get("foo"), "v6");
+  ASSERT_EQ(Get("foo"), "v7");
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Options that can change results without writes are rejected
+  options.compaction_filter_factory = std::make_shared<KeepFilterFactory>();
+  ASSERT_TRUE(TryReopen(options).IsNotSupported());
+}
+
+TEST_F(DBTest, UserKeyRowCacheFIFODrop) {
+  Options options;
+  options.compaction_style = kCompactionStyleFIFO;
+  options.write_buffer_size = 20 << 10;  // 20K
+  options.arena_block_size = 4096;
+  options.compaction_options_fifo.max_table_files_size = 150 << 10;  // 150KB
+  options.compression = kNoCompression;
+  options.create_if_missing = true;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.user_key_row_cache = NewLRUCache(1 << 20);
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("key", "value"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(Get("key"), "value");
+  ASSERT_EQ(Get("key"), "value");
+  ASSERT_EQ(TestGetTickerCount(options, USER_KEY_ROW_CACHE_HIT), 1);
+
+  // FIFO compaction drops the oldest file, without any write to "key"
+  Random rnd(301);
+  for (int i = 0; i < 20; i++) {
+    // Generate and flush a file about 20KB.
+    for (int j = 0; j < 20; j++) {
+      ASSERT_OK(Put(std::to_string(i * 20 + j), rnd.RandomString(980)));
+    }
+    ASSERT_OK(Flush());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  }
+  ASSERT_LE(SizeAtLevel(0),
+            options.compaction_options_fifo.max_table_files_size);
+  ASSERT_EQ(Get("key"), "NOT_FOUND");
+}
+
 TEST_F(DBTest, DeletingOldWalAfterDrop) {
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->LoadDependency(
       {{"Test:AllowFlushes", "DBImpl::BGWorkFlush"},
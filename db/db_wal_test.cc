@@ -2752,6 +2752,54 @@ TEST_P(DBWALTestWithParamsVaryingRecoveryMode,
   ASSERT_EQ(data, actual_data);
 }
 
+// Test scope:
+// - Pipelined WAL recovery recovers the same data as sequential recovery, and
+//   fails in the same cases, under every recovery mode
+TEST_P(DBWALTestWithParamsVaryingRecoveryMode, PipelinedRecovery) {
+  bool trunc = std::get<0>(GetParam());  // Corruption style
+  // Corruption offset position
+  int corrupt_offset = std::get<1>(GetParam());
+  int wal_file_id = std::get<2>(GetParam());  // WAL file
+
+  Options options = CurrentOptions();
+  options.wal_recovery_mode = std::get<3>(GetParam());
+  options.wal_compression = std::get<4>(GetParam());
+  RecoveryTestHelper::FillData(this, &options);
+  RecoveryTestHelper::CorruptWAL(this, options, corrupt_offset * .3,
+                                 /*len%=*/.1, wal_file_id, trunc);
+  options.create_if_missing = false;
+
+  // Read-only opens leave the WALs in place for the next open
+  auto recover = [&](bool pipelined, std::vector<std::string>* found) {
+    options.pipelined_wal_recovery = pipelined;
+    Status s = ReadOnlyReopen(options);
+    if (s.ok()) {
+      for (int i = 0; i < RecoveryTestHelper::kWALFilesCount *
+                              RecoveryTestHelper::kKeysPerWALFile;
+           i++) {
+        std::string key = "key" + std::to_string(i);
+        if (Get(key) != "NOT_FOUND") {
+          found->push_back(key);
+        }
+      }
+    }
+    Close();
+    return s;
+  };
+  std::vector<std::string> expected;
+  Status expected_status = recover(/*pipelined=*/false, &expected);
+  std::vector<std::string> actual;
+  Status actual_status = recover(/*pipelined=*/true, &actual);
+  ASSERT_EQ(expected_status.ToString(), actual_status.ToString());
+  ASSERT_EQ(expected, actual);
+
+  if (expected_status.ok()) {
+    options.pipelined_wal_recovery = true;
+    ASSERT_OK(TryReopen(options));
+    ASSERT_EQ(expected.size(), RecoveryTestHelper::GetData(this));
+  }
+}
+
 // Tests that total log size is recovered if we set
 // avoid_flush_during_recovery=true.
 // Flush should trigger if max_total_wal_size is reached.
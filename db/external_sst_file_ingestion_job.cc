@@ -24,10 +24,62 @@
 #include "table/table_builder.h"
 #include "table/unique_id_impl.h"
 #include "test_util/sync_point.h"
+#include "util/mutexlock.h"
 #include "util/udt_util.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+Status IngestionPrepareThreads::Run(
+    size_t n, const std::function<Status(size_t)>& func) {
+  // Take as many of the available threads as there is work for
+  int num_threads = 0;
+  int available = available_.load(std::memory_order_relaxed);
+  while (available > 0 && n > 1) {
+    num_threads = static_cast<int>(
+        std::min(static_cast<size_t>(available), n - 1));
+    if (available_.compare_exchange_weak(available, available - num_threads)) {
+      break;
+    }
+    num_threads = 0;
+  }
+
+  std::atomic<size_t> next_index(0);
+  std::atomic<bool> has_error(false);
+  port::Mutex error_mutex;
+  size_t error_index = n;
+  Status error;
+  std::function<void()> run_func([&]() {
+    while (!has_error.load(std::memory_order_relaxed)) {
+      size_t i = next_index.fetch_add(1);
+      if (i >= n) {
+        break;
+      }
+      Status s = func(i);
+      if (!s.ok()) {
+        MutexLock l(&error_mutex);
+        if (i < error_index) {
+          error_index = i;
+          error.PermitUncheckedError();
+          error = s;
+        }
+        has_error.store(true, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  std::vector<port::Thread> threads;
+  threads.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back(run_func);
+  }
+  run_func();
+  for (auto& t : threads) {
+    t.join();
+  }
+  available_.fetch_add(num_threads);
+  return error;
+}
+
 Status ExternalSstFileIngestionJob::Prepare(
     const std::vector<std::string>& external_files_paths,
     const std::vector<std::string>& files_checksums,
@@ -35,26 +87,28 @@ Status ExternalSstFileIngestionJob::Prepare(
     const std::vector<const PreparedFileInfo*>& file_infos,
     const std::optional<RangeOpt>& atomic_replace_range,
     const Temperature& file_temperature, uint64_t next_file_number,
-    SuperVersion* sv) {
+    SuperVersion* sv, IngestionPrepareThreads* prepare_threads) {
+  assert(prepare_threads);
   Status status;
 
   // Read the information of files we are ingesting.
-  for (size_t i = 0; i < external_files_paths.size(); i++) {
+  std::vector<IngestedFileInfo> files_info(external_files_paths.size());
+  status = prepare_threads->Run(files_info.size(), [&](size_t i) -> Status {
     const std::string& file_path = external_files_paths[i];
-    IngestedFileInfo file_to_ingest;
+    IngestedFileInfo& file_to_ingest = files_info[i];
     // For temperature, first assume it matches provided hint
     file_to_ingest.file_temperature = file_temperature;
     file_to_ingest.prefetch_lmax_index_and_filter_blocks =
         ingestion_options_.prefetch_lmax_index_and_filter_blocks;
     const PreparedFileInfo* prepared_file_info =
         file_infos.empty() ? nullptr : file_infos[i];
-    status = GetIngestedFileInfo(file_path, next_file_number++,
-                                 prepared_file_info, &file_to_ingest, sv);
-    if (!status.ok()) {
+    Status s = GetIngestedFileInfo(file_path, next_file_number + i,
+                                   prepared_file_info, &file_to_ingest, sv);
+    if (!s.ok()) {
       ROCKS_LOG_WARN(db_options_.info_log,
                      "Failed to get ingested file info: %s: %s",
-                     file_path.c_str(), status.ToString().c_str());
-      return status;
+                     file_path.c_str(), s.ToString().c_str());
+      return s;
     }
 
     // Files generated in another DB or CF may have a different column family
@@ -76,7 +130,12 @@ Status ExternalSstFileIngestionJob::Prepare(
         !file_to_ingest.largest_internal_key.Valid()) {
       return Status::Corruption("Generated table have corrupted keys");
     }
-
+    return Status::OK();
+  });
+  if (!status.ok()) {
+    return status;
+  }
+  for (IngestedFileInfo& file_to_ingest : files_info) {
     files_to_ingest_.emplace_back(std::move(file_to_ingest));
   }
 
@@ -146,47 +205,48 @@ Status ExternalSstFileIngestionJob::Prepare(
   }
 
   // Copy/Move external files into DB
-  std::unordered_set<size_t> ingestion_path_ids;
-  for (IngestedFileInfo& f : files_to_ingest_) {
+  status = prepare_threads->Run(num_files, [&](size_t i) -> Status {
+    IngestedFileInfo& f = files_to_ingest_[i];
+    Status s;
     f.copy_file = false;
     const std::string path_outside_db = f.external_file_path;
     const std::string path_inside_db = TableFileName(
         cfd_->ioptions().cf_paths, f.fd.GetNumber(), f.fd.GetPathId());
     if (ingestion_options_.move_files || ingestion_options_.link_files) {
-      status =
-          fs_->LinkFile(path_outside_db, path_inside_db, IOOptions(), nullptr);
-      if (status.ok()) {
+      s = fs_->LinkFile(path_outside_db, path_inside_db, IOOptions(), nullptr);
+      if (s.ok()) {
         // It is unsafe to assume application had sync the file and file
         // directory before ingest the file. For integrity of RocksDB we need
         // to sync the file.
         TEST_SYNC_POINT("ExternalSstFileIngestionJob::BeforeSyncIngestedFile");
-        Status s = fs_->SyncFile(path_inside_db, env_options_, IOOptions(),
-                                 db_options_.use_fsync, nullptr);
+        Status sync_s = fs_->SyncFile(path_inside_db, env_options_,
+                                      IOOptions(), db_options_.use_fsync,
+                                      nullptr);
         TEST_SYNC_POINT("ExternalSstFileIngestionJob::AfterSyncIngestedFile");
         TEST_SYNC_POINT_CALLBACK(
-            "ExternalSstFileIngestionJob::CheckSyncReturnCode", &s);
+            "ExternalSstFileIngestionJob::CheckSyncReturnCode", &sync_s);
         // Some file systems (especially remote/distributed) don't support
         // explicitly syncing the file and don't require it. Ignore the
         // NotSupported error in that case.
-        if (!s.IsNotSupported()) {
-          status = s;
-          if (!status.ok()) {
+        if (!sync_s.IsNotSupported()) {
+          s = sync_s;
+          if (!s.ok()) {
             ROCKS_LOG_WARN(db_options_.info_log,
                            "Failed to sync ingested file %s: %s",
-                           path_inside_db.c_str(), status.ToString().c_str());
+                           path_inside_db.c_str(), s.ToString().c_str());
           }
         }
-      } else if (status.IsNotSupported() &&
+      } else if (s.IsNotSupported() &&
                  ingestion_options_.failed_move_fall_back_to_copy) {
         // Original file is on a different FS, use copy instead of hard linking.
         f.copy_file = true;
         ROCKS_LOG_INFO(db_options_.info_log,
                        "Tried to link file %s but it's not supported : %s",
-                       path_outside_db.c_str(), status.ToString().c_str());
+                       path_outside_db.c_str(), s.ToString().c_str());
       } else {
         ROCKS_LOG_WARN(db_options_.info_log, "Failed to link file %s to %s: %s",
                        path_outside_db.c_str(), path_inside_db.c_str(),
-                       status.ToString().c_str());
+                       s.ToString().c_str());
       }
     } else {
       f.copy_file = true;
@@ -206,34 +266,38 @@ Status ExternalSstFileIngestionJob::Prepare(
               ? sv->mutable_cf_options.last_level_temperature
               : sv->mutable_cf_options.default_write_temperature;
       // Note: CopyFile also syncs the new file.
-      status = CopyFile(fs_.get(), path_outside_db, f.file_temperature,
-                        path_inside_db, dst_temp, 0, db_options_.use_fsync,
-                        io_tracer_);
+      s = CopyFile(fs_.get(), path_outside_db, f.file_temperature,
+                   path_inside_db, dst_temp, 0, db_options_.use_fsync,
+                   io_tracer_);
       // The destination of the copy will be ingested
       f.file_temperature = dst_temp;
 
-      if (!status.ok()) {
+      if (!s.ok()) {
         ROCKS_LOG_WARN(db_options_.info_log, "Failed to copy file %s to %s: %s",
                        path_outside_db.c_str(), path_inside_db.c_str(),
-                       status.ToString().c_str());
+                       s.ToString().c_str());
       }
     } else {
       // Note: we currently assume that linking files does not cross
       // temperatures, so no need to change f.file_temperature
     }
     TEST_SYNC_POINT("ExternalSstFileIngestionJob::Prepare:FileAdded");
-    if (!status.ok()) {
-      break;
+    if (!s.ok()) {
+      return s;
     }
     f.internal_file_path = path_inside_db;
     // Initialize the checksum information of ingested files.
     f.file_checksum = kUnknownFileChecksum;
     f.file_checksum_func_name = kUnknownFileChecksumFuncName;
-    ingestion_path_ids.insert(f.fd.GetPathId());
-  }
+    return s;
+  });
 
   TEST_SYNC_POINT("ExternalSstFileIngestionJob::BeforeSyncDir");
   if (status.ok()) {
+    std::unordered_set<size_t> ingestion_path_ids;
+    for (const IngestedFileInfo& f : files_to_ingest_) {
+      ingestion_path_ids.insert(f.fd.GetPathId());
+    }
     for (auto path_id : ingestion_path_ids) {
       status = directories_->GetDataDir(path_id)->FsyncWithDirOptions(
           IOOptions(), nullptr,
@@ -271,9 +335,12 @@ Status ExternalSstFileIngestionJob::Prepare(
     std::vector<std::string> generated_checksum_func_names;
     // Step 1: generate the checksum for ingested sst file.
     if (need_generate_file_checksum_) {
-      for (size_t i = 0; i < files_to_ingest_.size(); i++) {
-        std::string generated_checksum;
-        std::string generated_checksum_func_name;
+      generated_checksums.resize(files_to_ingest_.size());
+      generated_checksum_func_names.resize(files_to_ingest_.size());
+      auto generate_checksum = [&](size_t i) -> Status {
+        std::string& generated_checksum = generated_checksums[i];
+        std::string& generated_checksum_func_name =
+            generated_checksum_func_names[i];
         std::string requested_checksum_func_name =
             i < files_checksum_func_names.size() ? files_checksum_func_names[i]
                                                  : "";
@@ -303,21 +370,20 @@ Status ExternalSstFileIngestionJob::Prepare(
             db_options_.rate_limiter.get(), ro, db_options_.stats,
             db_options_.clock, fopts);
         if (!io_s.ok()) {
-          status = io_s;
           ROCKS_LOG_WARN(db_options_.info_log,
                          "Sst file checksum generation of file: %s failed: %s",
                          files_to_ingest_[i].internal_file_path.c_str(),
-                         status.ToString().c_str());
-          break;
+                         io_s.ToString().c_str());
+          return io_s;
         }
         if (ingestion_options_.write_global_seqno == false) {
           files_to_ingest_[i].file_checksum = generated_checksum;
           files_to_ingest_[i].file_checksum_func_name =
               generated_checksum_func_name;
         }
-        generated_checksums.push_back(generated_checksum);
-        generated_checksum_func_names.push_back(generated_checksum_func_name);
-      }
+        return Status::OK();
+      };
+      status = prepare_threads->Run(files_to_ingest_.size(), generate_checksum);
     }
 
     // Step 2: based on the verify_file_checksum and ingested checksum
@@ -4,6 +4,9 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -212,6 +215,26 @@ struct FileBatchInfo : public KeyRangeInfo {
       : track_batch_range(_track_batch_range) {}
 };
 
+// Threads preparing the files of one DB::IngestExternalFiles() call, shared by
+// the jobs of all its column families. At most
+// IngestExternalFileOptions::file_preparing_threads threads run at a time,
+// including the calling threads.
+class IngestionPrepareThreads {
+ public:
+  explicit IngestionPrepareThreads(int max_threads)
+      : available_(std::max(max_threads, 1) - 1) {}
+
+  // Calls `func` for each index in [0, n), on the calling thread and on as many
+  // other threads as are available. Indexes not started when a call fails are
+  // skipped. Returns the failure of the lowest index, which is the one a loop
+  // stopping at the first failure would have returned.
+  Status Run(size_t n, const std::function<Status(size_t)>& func);
+
+ private:
+  // Threads that may be started in addition to the calling threads
+  std::atomic<int> available_;
+};
+
 class ExternalSstFileIngestionJob {
  public:
   ExternalSstFileIngestionJob(
@@ -247,14 +270,15 @@ class ExternalSstFileIngestionJob {
 
   ColumnFamilyData* GetColumnFamilyData() const { return cfd_; }
 
-  // Prepare the job by copying external files into the DB.
+  // Prepare the job by copying external files into the DB. The files are
+  // read, copied or linked, and checksummed on `prepare_threads`.
   Status Prepare(const std::vector<std::string>& external_files_paths,
                  const std::vector<std::string>& files_checksums,
                  const std::vector<std::string>& files_checksum_func_names,
                  const std::vector<const PreparedFileInfo*>& file_infos,
                  const std::optional<RangeOpt>& atomic_replace_range,
                  const Temperature& file_temperature, uint64_t next_file_number,
-                 SuperVersion* sv);
+                 SuperVersion* sv, IngestionPrepareThreads* prepare_threads);
 
   // Check if we need to flush the memtable before running the ingestion job
   // This will be true if the files we are ingesting are overlapping with any
@@ -311,6 +335,12 @@ class ExternalSstFileIngestionJob {
     return ingestion_options_.file_opening_threads;
   }
 
+  // Max threads requested for preparing this job's files, from the per-CF
+  // IngestExternalFileOptions.
+  int file_preparing_threads() const {
+    return ingestion_options_.file_preparing_threads;
+  }
+
   // Merge another already-Prepare()d job for the SAME column family into this
   // one so both sets of files are committed by a single Run(). The other job's
   // files are appended after this job's, so for any overlapping keys the other
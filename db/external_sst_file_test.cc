@@ -467,6 +467,121 @@ TEST_F(ExternalSSTFileTest, ParallelFileOpenWithFileOpeningThreads) {
   }
 }
 
+TEST_F(ExternalSSTFileTest, PrepareFailureInOneColumnFamily) {
+  // A failure to prepare the second of three column families still prepares
+  // the others, and their copied files are then all removed.
+  Options options = CurrentOptions();
+  CreateAndReopenWithCF({"cf1", "cf2"}, options);
+
+  constexpr int kNumCfs = 3;
+  constexpr int kNumFiles = 4;
+  std::vector<IngestExternalFileArg> args(kNumCfs);
+  for (int cf = 0; cf < kNumCfs; cf++) {
+    args[cf].column_family = handles_[cf];
+    for (int f = 0; f < kNumFiles; f++) {
+      std::string file_path;
+      ASSERT_OK(GenerateExternalFileOnly(
+          options, {{Key(f), "val" + std::to_string(cf)}}, &file_path));
+      args[cf].external_files.push_back(file_path);
+    }
+  }
+
+  std::atomic<int> files_added{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "ExternalSstFileIngestionJob::Prepare:FileAdded",
+      [&](void*) { files_added++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  auto count_sst_files = [&]() {
+    std::vector<std::string> children;
+    EXPECT_OK(env_->GetChildren(dbname_, &children));
+    return std::count_if(
+        children.begin(), children.end(), [](const std::string& name) {
+          return name.size() > 4 && name.substr(name.size() - 4) == ".sst";
+        });
+  };
+  const auto num_sst_files = count_sst_files();
+
+  for (int threads : {1, 4}) {
+    files_added = 0;
+    std::vector<IngestExternalFileArg> failing_args = args;
+    for (auto& arg : failing_args) {
+      arg.options.file_preparing_threads = threads;
+    }
+    failing_args[1].external_files[0] += ".missing";
+    Status s = db_->IngestExternalFiles(failing_args);
+    ASSERT_NOK(s);
+    ASSERT_NE(s.ToString().find(".missing"), std::string::npos);
+    // The files of the first and the last column families were copied
+    ASSERT_EQ(files_added, 2 * kNumFiles);
+    ASSERT_EQ(count_sst_files(), num_sst_files);
+    for (int cf = 0; cf < kNumCfs; cf++) {
+      ASSERT_EQ("NOT_FOUND", Get(cf, Key(0)));
+    }
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  ASSERT_OK(db_->IngestExternalFiles(args));
+  for (int cf = 0; cf < kNumCfs; cf++) {
+    ASSERT_EQ("val" + std::to_string(cf), Get(cf, Key(0)));
+  }
+}
+
+TEST_F(ExternalSSTFileTest, ParallelPrepareWithFilePreparingThreads) {
+  // Ingest many files into several column families with
+  // file_preparing_threads > 1, so that the files are read, copied and
+  // checksummed by multiple threads.
+  Options options = CurrentOptions();
+  options.file_checksum_gen_factory = GetFileChecksumGenCrc32cFactory();
+  CreateAndReopenWithCF({"cf1", "cf2"}, options);
+
+  constexpr int kNumCfs = 3;
+  constexpr int kNumFiles = 16;
+  constexpr int kKeysPerFile = 20;
+  std::vector<IngestExternalFileArg> args(kNumCfs);
+  for (int cf = 0; cf < kNumCfs; cf++) {
+    args[cf].column_family = handles_[cf];
+    args[cf].options.file_preparing_threads = 4;
+    for (int f = 0; f < kNumFiles; f++) {
+      std::vector<std::pair<std::string, std::string>> data;
+      for (int k = 0; k < kKeysPerFile; k++) {
+        const int key = f * kKeysPerFile + k;
+        data.emplace_back(Key(key), "val" + std::to_string(cf * key));
+      }
+      std::string file_path;
+      ASSERT_OK(GenerateExternalFileOnly(options, data, &file_path));
+      args[cf].external_files.push_back(file_path);
+    }
+  }
+
+  // A missing file fails the ingestion, with the error of the first failing
+  // file, and without ingesting anything.
+  IngestExternalFileArg missing_file_arg = args[1];
+  missing_file_arg.external_files[kNumFiles / 2] += ".missing";
+  missing_file_arg.external_files[kNumFiles - 1] += ".missing2";
+  Status s = db_->IngestExternalFiles({args[0], missing_file_arg, args[2]});
+  ASSERT_NOK(s);
+  ASSERT_NE(s.ToString().find(".missing"), std::string::npos);
+  ASSERT_EQ(s.ToString().find(".missing2"), std::string::npos);
+  for (int cf = 0; cf < kNumCfs; cf++) {
+    ASSERT_EQ("NOT_FOUND", Get(cf, Key(0)));
+  }
+
+  ASSERT_OK(db_->IngestExternalFiles(args));
+  for (int cf = 0; cf < kNumCfs; cf++) {
+    for (int key = 0; key < kNumFiles * kKeysPerFile; key++) {
+      ASSERT_EQ("val" + std::to_string(cf * key), Get(cf, Key(key)));
+    }
+  }
+  std::vector<LiveFileMetaData> live_files;
+  db_->GetLiveFilesMetaData(&live_files);
+  ASSERT_EQ(kNumCfs * kNumFiles, live_files.size());
+  for (const auto& file : live_files) {
+    ASSERT_EQ(kStandardDbFileChecksumFuncName, file.file_checksum_func_name);
+  }
+}
+
 TEST_F(ExternalSSTFileTest, LmaxPrefetchSkipDoesNotDisableL0Prefetch) {
   LRUCacheOptions co;
   co.capacity = 32 << 20;
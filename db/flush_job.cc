@@ -46,6 +46,7 @@
 #include "table/two_level_iterator.h"
 #include "test_util/sync_point.h"
 #include "util/coding.h"
+#include "util/multi_tenant_rate_limiter.h"
 #include "util/mutexlock.h"
 #include "util/stop_watch.h"
 
@@ -877,6 +878,7 @@ bool FlushJob::MemPurgeDecider(double threshold) {
 Status FlushJob::WriteLevel0Table() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_FLUSH_WRITE_L0);
+  IOTenantScope io_tenant_scope(&cfd_->GetName());
   db_mutex_->AssertHeld();
   const uint64_t start_micros = clock_->NowMicros();
   const uint64_t start_cpu_micros = clock_->CPUMicros();
@@ -259,6 +259,7 @@ static const std::string cf_write_stall_stats = "cf-write-stall-stats";
 static const std::string dbstats = "dbstats";
 static const std::string db_write_stall_stats = "db-write-stall-stats";
 static const std::string levelstats = "levelstats";
+static const std::string compaction_file_scores = "compaction-file-scores";
 static const std::string block_cache_entry_stats = "block-cache-entry-stats";
 static const std::string fast_block_cache_entry_stats =
     "fast-block-cache-entry-stats";
@@ -321,11 +322,13 @@ static const std::string num_running_flushes = "num-running-flushes";
 static const std::string actual_delayed_write_rate =
     "actual-delayed-write-rate";
 static const std::string is_write_stopped = "is-write-stopped";
+static const std::string write_controller_state = "write-controller-state";
 static const std::string estimate_oldest_key_time = "estimate-oldest-key-time";
 static const std::string block_cache_capacity = "block-cache-capacity";
 static const std::string block_cache_usage = "block-cache-usage";
 static const std::string block_cache_pinned_usage = "block-cache-pinned-usage";
 static const std::string options_statistics = "options-statistics";
+static const std::string perf_context_samples = "perf-context-samples";
 static const std::string num_blob_files = "num-blob-files";
 static const std::string blob_stats = "blob-stats";
 static const std::string total_blob_file_size = "total-blob-file-size";
@@ -353,6 +356,8 @@ const std::string DB::Properties::kDBWriteStallStats =
     rocksdb_prefix + db_write_stall_stats;
 const std::string DB::Properties::kDBStats = rocksdb_prefix + dbstats;
 const std::string DB::Properties::kLevelStats = rocksdb_prefix + levelstats;
+const std::string DB::Properties::kCompactionFileScores =
+    rocksdb_prefix + compaction_file_scores;
 const std::string DB::Properties::kBlockCacheEntryStats =
     rocksdb_prefix + block_cache_entry_stats;
 const std::string DB::Properties::kFastBlockCacheEntryStats =
@@ -434,6 +439,8 @@ const std::string DB::Properties::kActualDelayedWriteRate =
     rocksdb_prefix + actual_delayed_write_rate;
 const std::string DB::Properties::kIsWriteStopped =
     rocksdb_prefix + is_write_stopped;
+const std::string DB::Properties::kWriteControllerState =
+    rocksdb_prefix + write_controller_state;
 const std::string DB::Properties::kEstimateOldestKeyTime =
     rocksdb_prefix + estimate_oldest_key_time;
 const std::string DB::Properties::kBlockCacheCapacity =
@@ -444,6 +451,8 @@ const std::string DB::Properties::kBlockCachePinnedUsage =
     rocksdb_prefix + block_cache_pinned_usage;
 const std::string DB::Properties::kOptionsStatistics =
     rocksdb_prefix + options_statistics;
+const std::string DB::Properties::kPerfContextSamples =
+    rocksdb_prefix + perf_context_samples;
 const std::string DB::Properties::kLiveSstFilesSizeAtTemperature =
     rocksdb_prefix + live_sst_files_size_at_temperature;
 const std::string DB::Properties::kNumBlobFiles =
@@ -476,6 +485,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
           nullptr, nullptr}},
         {DB::Properties::kLevelStats,
          {false, &InternalStats::HandleLevelStats, nullptr, nullptr, nullptr}},
+        {DB::Properties::kCompactionFileScores,
+         {false, &InternalStats::HandleCompactionFileScores, nullptr, nullptr,
+          nullptr}},
         {DB::Properties::kStats,
          {false, &InternalStats::HandleStats, nullptr, nullptr, nullptr}},
         {DB::Properties::kCFStats,
@@ -627,6 +639,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kIsWriteStopped,
          {false, nullptr, &InternalStats::HandleIsWriteStopped, nullptr,
           nullptr}},
+        {DB::Properties::kWriteControllerState,
+         {false, nullptr, nullptr, nullptr,
+          &DBImpl::GetPropertyHandleWriteControllerState}},
         {DB::Properties::kEstimateOldestKeyTime,
          {false, nullptr, &InternalStats::HandleEstimateOldestKeyTime, nullptr,
           nullptr}},
@@ -642,6 +657,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kOptionsStatistics,
          {true, nullptr, nullptr, nullptr,
           &DBImpl::GetPropertyHandleOptionsStatistics}},
+        {DB::Properties::kPerfContextSamples,
+         {true, nullptr, nullptr, nullptr,
+          &DBImpl::GetPropertyHandlePerfContextSamples}},
         {DB::Properties::kNumBlobFiles,
          {false, nullptr, &InternalStats::HandleNumBlobFiles, nullptr,
           nullptr}},
@@ -1088,6 +1106,25 @@ bool InternalStats::HandleLevelStats(std::string* value, Slice /*suffix*/) {
   return true;
 }
 
+bool InternalStats::HandleCompactionFileScores(std::string* value,
+                                               Slice /*suffix*/) {
+  char buf[1000];
+  const auto* vstorage = cfd_->current()->storage_info();
+  snprintf(buf, sizeof(buf), "%5s %10s %10s %12s %9s %14s\n", "Level",
+           "File", "Score", "ReadsSampled", "Overwrite", "Overlap(MB)");
+  value->append(buf);
+  for (int level = 0; level < number_levels_; level++) {
+    for (const auto& fs : vstorage->FileCompactionScores(level)) {
+      snprintf(buf, sizeof(buf), "%5d %10" PRIu64 " %10.3f %12" PRIu64
+               " %9.3f %14.1f\n",
+               level, fs.file_number, fs.score, fs.reads_sampled,
+               fs.overwrite_ratio, fs.overlapping_bytes / kMB);
+      value->append(buf);
+    }
+  }
+  return true;
+}
+
 bool InternalStats::HandleStats(std::string* value, Slice suffix) {
   if (!HandleCFStats(value, suffix)) {
     return false;
@@ -580,6 +580,24 @@ class InternalStats {
     }
   }
 
+  // Table and blob bytes written by flushes and intra-L0 compactions
+  // (`*flushed_bytes`) and by compactions into the other levels
+  // (`*compacted_bytes`) since the stats were last reset.
+  void GetFlushAndCompactionBytesWritten(uint64_t* flushed_bytes,
+                                         uint64_t* compacted_bytes) const {
+    *flushed_bytes = 0;
+    *compacted_bytes = 0;
+    for (size_t level = 0; level < comp_stats_.size(); ++level) {
+      const uint64_t written = comp_stats_[level].bytes_written +
+                               comp_stats_[level].bytes_written_blob;
+      if (level == 0) {
+        *flushed_bytes += written;
+      } else {
+        *compacted_bytes += written;
+      }
+    }
+  }
+
   void IncBytesMoved(int level, uint64_t amount) {
     comp_stats_[level].bytes_moved += amount;
   }
@@ -817,6 +835,7 @@ class InternalStats {
   bool HandleNumFilesAtLevel(std::string* value, Slice suffix);
   bool HandleCompressionRatioAtLevelPrefix(std::string* value, Slice suffix);
   bool HandleLevelStats(std::string* value, Slice suffix);
+  bool HandleCompactionFileScores(std::string* value, Slice suffix);
   bool HandleStats(std::string* value, Slice suffix);
   bool HandleCFMapStats(std::map<std::string, std::string>* compaction_stats,
                         Slice suffix);
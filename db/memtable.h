@@ -46,6 +46,7 @@ class Mutex;
 class MemTableIterator;
 class MergeContext;
 class SystemClock;
+class UserKeyRowCache;
 
 struct ImmutableMemTableOptions {
   explicit ImmutableMemTableOptions(const ImmutableOptions& ioptions,
@@ -684,6 +685,12 @@ class MemTable final : public ReadOnlyMemTable {
              MemTablePostProcessInfo* post_process_info = nullptr,
              void** hint = nullptr);
 
+  // Makes Add() invalidate the entries of `user_key_row_cache` that the added
+  // entries supersede. Must be set before the first Add().
+  void SetUserKeyRowCache(UserKeyRowCache* user_key_row_cache) {
+    user_key_row_cache_ = user_key_row_cache;
+  }
+
   using ReadOnlyMemTable::Get;
   bool Get(const LookupKey& key, std::string* value,
            PinnableWideColumns* columns, std::string* timestamp, Status* s,
@@ -989,6 +996,9 @@ class MemTable final : public ReadOnlyMemTable {
   // tombstone inserts from the read path can safely update it via CAS.
   Atomic<const char*> newest_udt_data_{nullptr};
 
+  // The column family's user_key_row_cache, if any
+  UserKeyRowCache* user_key_row_cache_ = nullptr;
+
   // Updates flush_state_ using ShouldFlushNow()
   void UpdateFlushState();
 
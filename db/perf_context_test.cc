@@ -15,6 +15,7 @@
 #include "monitoring/histogram.h"
 #include "monitoring/instrumented_mutex.h"
 #include "monitoring/perf_context_imp.h"
+#include "monitoring/perf_context_sampler.h"
 #include "monitoring/thread_status_util.h"
 #include "port/port.h"
 #include "rocksdb/db.h"
@@ -25,6 +26,7 @@
 #include "rocksdb/slice_transform.h"
 #include "rocksdb/system_clock.h"
 #include "test_util/mock_time_env.h"
+#include "test_util/sync_point.h"
 #include "test_util/testharness.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
@@ -1417,6 +1419,93 @@ TEST_F(PerfContextTest, WriteMemtableTimePerfLevel) {
   ASSERT_EQ(perf_context.write_memtable_time, 0);
 }
 
+TEST_F(PerfContextTest, SampledPerfContext) {
+  ASSERT_OK(DestroyDB(kDbName, Options()));
+  Options options;
+  options.create_if_missing = true;
+  options.statistics = CreateDBStatistics();
+  options.perf_context_sample_rate = 2;
+  std::unique_ptr<DB> db;
+  ASSERT_OK(DB::Open(options, kDbName, &db));
+
+  // Sampling works without the application enabling PerfContext, and the
+  // thread's PerfLevel is restored after each sampled operation
+  SetPerfLevel(PerfLevel::kDisable);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(db->Put(WriteOptions(), "k" + std::to_string(i), "v"));
+  }
+  ASSERT_EQ(GetPerfLevel(), PerfLevel::kDisable);
+  ASSERT_OK(db->Flush(FlushOptions()));
+  std::string value;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(db->Get(ReadOptions(), "k" + std::to_string(i), &value));
+  }
+  std::vector<Slice> keys = {"k1", "k2", "k3"};
+  std::vector<PinnableSlice> values(keys.size());
+  std::vector<Status> statuses(keys.size());
+  for (int i = 0; i < 2; ++i) {
+    db->MultiGet(ReadOptions(), db->DefaultColumnFamily(), keys.size(),
+                 keys.data(), values.data(), statuses.data());
+  }
+  ASSERT_EQ(GetPerfLevel(), PerfLevel::kDisable);
+
+  std::string samples;
+  ASSERT_TRUE(
+      db->GetProperty(DB::Properties::kPerfContextSamples, &samples));
+  ASSERT_NE(samples.find("** Get: 5 samples **"), std::string::npos);
+  ASSERT_NE(samples.find("** MultiGet: 1 samples **"), std::string::npos);
+  ASSERT_NE(samples.find("** Write: 5 samples **"), std::string::npos);
+  ASSERT_NE(samples.find("get_from_output_files_time"), std::string::npos);
+  ASSERT_NE(samples.find("write_memtable_time"), std::string::npos);
+  ASSERT_EQ(options.statistics->getTickerCount(PERF_CONTEXT_SAMPLES), 11);
+
+  // Disabling at runtime stops sampling
+  ASSERT_OK(db->SetDBOptions({{"perf_context_sample_rate", "0"}}));
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(db->Get(ReadOptions(), "k" + std::to_string(i), &value));
+  }
+  ASSERT_EQ(options.statistics->getTickerCount(PERF_CONTEXT_SAMPLES), 11);
+}
+
+TEST_F(PerfContextTest, SampledPerfContextLappingWriter) {
+  // With a ring of one slot, a sample recorded while an earlier one is still
+  // being written laps it, and must neither mix its values into the slot nor
+  // hold up draining
+  PerfContextSampler sampler(/*ring_capacity=*/1);
+  PerfContextSampler::MetricValues first;
+  first.fill(1);
+  PerfContextSampler::MetricValues second;
+  second.fill(1000);
+  bool lapped = false;
+  SyncPoint::GetInstance()->SetCallBack(
+      "PerfContextSampler::Record:Claimed", [&](void*) {
+        if (!lapped) {
+          lapped = true;
+          sampler.Record(SampledOpType::kGet, second);
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  sampler.Record(SampledOpType::kGet, first);
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_TRUE(lapped);
+
+  // The first sample counts as overwritten, and the second as skipped
+  HistogramData data;
+  ASSERT_EQ(sampler.GetAggregated(SampledOpType::kGet,
+                                  PerfContextSampler::kTotalNanos, &data),
+            0);
+  ASSERT_EQ(sampler.GetDroppedSamples(), 2);
+
+  // Draining goes on with later samples
+  sampler.Record(SampledOpType::kGet, second);
+  ASSERT_EQ(sampler.GetAggregated(SampledOpType::kGet,
+                                  PerfContextSampler::kTotalNanos, &data),
+            1);
+  ASSERT_EQ(data.max, 1000);
+  ASSERT_EQ(sampler.GetDroppedSamples(), 2);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
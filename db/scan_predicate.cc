@@ -0,0 +1,128 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/scan_predicate.h"
+
+#include <algorithm>
+
+#include "db/wide/wide_columns_helper.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+Slice Truncate(const Slice& s, size_t len) {
+  return Slice(s.data(), std::min(s.size(), len));
+}
+
+// Matches entries with a column in [lower, upper); an empty upper means no
+// upper bound.
+class ColumnRangePredicate : public ScanPredicate {
+ public:
+  ColumnRangePredicate(const char* name, const std::string& column,
+                       const std::string& lower, const std::string& upper)
+      : name_(name), column_(column), lower_(lower), upper_(upper) {}
+
+  const char* Name() const override { return name_; }
+
+  bool Matches(const Slice& /*key*/,
+               const WideColumns& columns) const override {
+    auto it = WideColumnsHelper::Find(columns.cbegin(), columns.cend(),
+                                      Slice(column_));
+    if (it == columns.cend()) {
+      return false;
+    }
+    const Slice& value = it->value();
+    return value.compare(lower_) >= 0 &&
+           (upper_.empty() || value.compare(upper_) < 0);
+  }
+
+  bool MayMatchValuePrefixRange(const Slice& smallest, const Slice& largest,
+                                size_t prefix_len) const override {
+    if (!column_.empty()) {
+      // Plain values only have the anonymous column
+      return false;
+    }
+    // Truncation to a prefix preserves order, so every value v in the range
+    // has v >= smallest and Truncate(v) <= largest.
+    if (largest.compare(Truncate(lower_, prefix_len)) < 0) {
+      return false;
+    }
+    if (!upper_.empty() && smallest.compare(upper_) >= 0) {
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  const char* const name_;
+  const std::string column_;
+  const std::string lower_;
+  const std::string upper_;
+};
+
+class ValuePrefixPredicate : public ScanPredicate {
+ public:
+  explicit ValuePrefixPredicate(const std::vector<std::string>& prefixes)
+      : prefixes_(prefixes) {}
+
+  const char* Name() const override { return "ValuePrefixPredicate"; }
+
+  bool Matches(const Slice& /*key*/,
+               const WideColumns& columns) const override {
+    if (!WideColumnsHelper::HasDefaultColumn(columns)) {
+      return false;
+    }
+    const Slice& value = WideColumnsHelper::GetDefaultColumn(columns);
+    for (const auto& prefix : prefixes_) {
+      if (value.starts_with(prefix)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool MayMatchValuePrefixRange(const Slice& smallest, const Slice& largest,
+                                size_t prefix_len) const override {
+    for (const auto& prefix : prefixes_) {
+      const Slice truncated = Truncate(prefix, prefix_len);
+      if (largest.compare(truncated) >= 0 &&
+          Truncate(smallest, truncated.size()).compare(truncated) <= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  const std::vector<std::string> prefixes_;
+};
+}  // namespace
+
+std::unique_ptr<ScanPredicate> NewValueRangePredicate(
+    const std::string& lower, const std::string& upper) {
+  return std::make_unique<ColumnRangePredicate>(
+      "ValueRangePredicate", kDefaultWideColumnName.ToString(), lower, upper);
+}
+
+std::unique_ptr<ScanPredicate> NewValuePrefixPredicate(
+    const std::vector<std::string>& prefixes) {
+  return std::make_unique<ValuePrefixPredicate>(prefixes);
+}
+
+std::unique_ptr<ScanPredicate> NewWideColumnEqualsPredicate(
+    const std::string& column, const std::string& value) {
+  // The only value in [value, value + '\0') is value itself
+  return std::make_unique<ColumnRangePredicate>(
+      "WideColumnEqualsPredicate", column, value, value + '\0');
+}
+
+std::unique_ptr<ScanPredicate> NewWideColumnRangePredicate(
+    const std::string& column, const std::string& lower,
+    const std::string& upper) {
+  return std::make_unique<ColumnRangePredicate>("WideColumnRangePredicate",
+                                                column, lower, upper);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -226,6 +226,20 @@ Status TableCache::FindTable(
   // fresh_table_reader_owner is where we return it. The two must agree.
   assert(open_options.open_ephemeral_table_reader ==
          (fresh_table_reader_owner != nullptr));
+
+  // Fast path: if table reader is already pinned, return it directly without a
+  // cache lookup, and without the timer so that a pinned lookup costs no more
+  // than an atomic load.
+  TableReader* pinned_reader = nullptr;
+  if (fresh_table_reader_owner == nullptr) {
+    pinned_reader = file_meta.fd.pinned_reader.Get();
+    if (pinned_reader != nullptr) {
+      *handle = nullptr;
+      *out_table_reader = pinned_reader;
+      return Status::OK();
+    }
+  }
+
   PERF_TIMER_GUARD_WITH_CLOCK(find_table_nanos, ioptions_.clock);
 
   // Bypass path: open a fresh TableReader, skipping the pinned-reader fast path
@@ -264,15 +278,6 @@ Status TableCache::FindTable(
     return s;
   }
 
-  // Fast path: if table reader is already pinned, return it directly without a
-  // cache lookup.
-  auto pinned_reader = file_meta.fd.pinned_reader.Get();
-  if (pinned_reader != nullptr) {
-    *handle = nullptr;
-    *out_table_reader = pinned_reader;
-    return Status::OK();
-  }
-
   uint64_t number = file_meta.fd.GetNumber();
   // NOTE: sharing same Cache with BlobFileCache
   Slice key = GetSliceForFileNumber(&number);
@@ -634,17 +639,21 @@ Status TableCache::MultiGetFilter(
     return Status::NotSupported();
   }
   Status s;
-  TableReader* t = nullptr;
   MultiGetContext::Range tombstone_range(*mget_range, mget_range->begin(),
                                          mget_range->end());
-  s = FindTable(options, file_options_, internal_comparator, file_meta, handle,
-                mutable_cf_options, &t,
-                options.read_tier == kBlockCacheTier /* no_io */,
-                file_read_hist,
-                /*skip_filters=*/false, level,
-                true /* prefetch_index_and_filter_in_cache */,
-                /*max_file_size_for_l0_meta_pin=*/0, file_meta.temperature,
-                should_pin_table_handles_);
+  // With a pinned table reader (e.g. max_open_files == -1) there is no need to
+  // go through FindTable() at all.
+  TableReader* t = file_meta.fd.pinned_reader.Get();
+  if (t == nullptr) {
+    s = FindTable(options, file_options_, internal_comparator, file_meta,
+                  handle, mutable_cf_options, &t,
+                  options.read_tier == kBlockCacheTier /* no_io */,
+                  file_read_hist,
+                  /*skip_filters=*/false, level,
+                  true /* prefetch_index_and_filter_in_cache */,
+                  /*max_file_size_for_l0_meta_pin=*/0, file_meta.temperature,
+                  should_pin_table_handles_);
+  }
   if (s.ok()) {
     s = t->MultiGetFilter(options, mutable_cf_options.prefix_extractor.get(),
                           mget_range);
@@ -37,16 +37,20 @@ DEFINE_SYNC_AND_ASYNC(Status, TableCache::Get)
   }
   TEST_SYNC_POINT_CALLBACK("TableCache::Get::BeforeFindTable",
                            const_cast<FileDescriptor*>(&fd));
-  TableReader* t = nullptr;
+  // With max_open_files == -1 every live file has a pinned table reader, so
+  // the point lookup path never needs to hash and probe the table cache.
+  TableReader* t = fd.pinned_reader.Get();
   TypedHandle* handle = nullptr;
   if (s.ok() && !done) {
-    s = FindTable(options, file_options_, internal_comparator, file_meta,
-                  &handle, mutable_cf_options, &t,
-                  options.read_tier == kBlockCacheTier /* no_io */,
-                  file_read_hist, skip_filters, level,
-                  true /* prefetch_index_and_filter_in_cache */,
-                  max_file_size_for_l0_meta_pin, file_meta.temperature,
-                  should_pin_table_handles_);
+    if (t == nullptr) {
+      s = FindTable(options, file_options_, internal_comparator, file_meta,
+                    &handle, mutable_cf_options, &t,
+                    options.read_tier == kBlockCacheTier /* no_io */,
+                    file_read_hist, skip_filters, level,
+                    true /* prefetch_index_and_filter_in_cache */,
+                    max_file_size_for_l0_meta_pin, file_meta.temperature,
+                    should_pin_table_handles_);
+    }
     SequenceNumber* max_covering_tombstone_seq =
         get_context->max_covering_tombstone_seq();
     if (s.ok() && max_covering_tombstone_seq != nullptr &&
@@ -0,0 +1,138 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/user_key_row_cache.h"
+
+#include "monitoring/statistics_impl.h"
+#include "rocksdb/cleanable.h"
+#include "util/coding.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Entry format: fixed64 snapshot, one byte "found" flag, then the value
+constexpr size_t kEntryHeaderSize = sizeof(uint64_t) + 1;
+
+void UpdateMax(std::atomic<SequenceNumber>* seq, SequenceNumber value) {
+  SequenceNumber current = seq->load();
+  while (current < value && !seq->compare_exchange_weak(current, value)) {
+  }
+}
+}  // namespace
+
+UserKeyRowCache::UserKeyRowCache(const std::shared_ptr<Cache>& cache,
+                                 Statistics* stats)
+    : cache_(cache), stats_(stats), prefix_id_(cache->NewId()) {}
+
+void UserKeyRowCache::InitCacheKey(uint64_t prefix_id, const Slice& user_key,
+                                   std::string* cache_key) const {
+  cache_key->clear();
+  PutVarint64(cache_key, prefix_id);
+  cache_key->append(user_key.data(), user_key.size());
+}
+
+bool UserKeyRowCache::HasCurrentPrefix(const std::string& cache_key) const {
+  Slice key_prefix(cache_key);
+  uint64_t key_prefix_id = 0;
+  return GetVarint64(&key_prefix, &key_prefix_id) &&
+         key_prefix_id == prefix_id_.load();
+}
+
+std::atomic<SequenceNumber>& UserKeyRowCache::StripeFor(
+    const Slice& user_key) {
+  return stripe_seqs_[GetSliceNPHash64(user_key) % kNumStripes];
+}
+
+bool UserKeyRowCache::Lookup(const std::string& cache_key,
+                             SequenceNumber snapshot, PinnableSlice* value,
+                             bool* found) {
+  // The SuperVersion of a reader with an older prefix misses changes that
+  // writes after the prefix switch no longer erase from the cache
+  auto* handle =
+      HasCurrentPrefix(cache_key) ? cache_.Lookup(cache_key) : nullptr;
+  if (handle != nullptr) {
+    const std::string& entry = *cache_.Value(handle);
+    assert(entry.size() >= kEntryHeaderSize);
+    const SequenceNumber entry_snapshot = DecodeFixed64(entry.data());
+    if (snapshot >= entry_snapshot &&
+        invalidated_before_seq_.load() <= entry_snapshot) {
+      *found = entry[sizeof(uint64_t)] != 0;
+      if (*found) {
+        Cleanable value_pinner;
+        cache_.RegisterReleaseAsCleanup(handle, value_pinner);
+        value->PinSlice(Slice(entry.data() + kEntryHeaderSize,
+                              entry.size() - kEntryHeaderSize),
+                        &value_pinner);
+      } else {
+        cache_.Release(handle);
+        RecordTick(stats_, USER_KEY_ROW_CACHE_NEGATIVE_HIT);
+      }
+      RecordTick(stats_, USER_KEY_ROW_CACHE_HIT);
+      return true;
+    }
+    // Not visible to this snapshot, or invalidated
+    cache_.Release(handle);
+  }
+  RecordTick(stats_, USER_KEY_ROW_CACHE_MISS);
+  return false;
+}
+
+bool UserKeyRowCache::WrittenAfter(
+    const std::atomic<SequenceNumber>& stripe_seq,
+    SequenceNumber snapshot) const {
+  return stripe_seq.load() > snapshot ||
+         invalidated_before_seq_.load() > snapshot;
+}
+
+void UserKeyRowCache::Insert(const std::string& cache_key,
+                             const Slice& user_key, SequenceNumber snapshot,
+                             const Slice* value) {
+  std::atomic<SequenceNumber>& stripe_seq = StripeFor(user_key);
+  if (WrittenAfter(stripe_seq, snapshot) || !HasCurrentPrefix(cache_key)) {
+    // Already stale
+    return;
+  }
+  auto* entry = new std::string();
+  entry->reserve(kEntryHeaderSize + (value != nullptr ? value->size() : 0));
+  PutFixed64(entry, snapshot);
+  entry->push_back(value != nullptr ? 1 : 0);
+  if (value != nullptr) {
+    entry->append(value->data(), value->size());
+  }
+  size_t charge = cache_key.size() + entry->capacity() + sizeof(std::string);
+  // If the cache is full, it's OK.
+  if (!cache_.Insert(cache_key, entry, charge).ok()) {
+    return;
+  }
+  // A write to the key may have been added to the memtable after this
+  // snapshot was taken and before the entry was inserted, in which case its
+  // erase missed the entry.
+  if (WrittenAfter(stripe_seq, snapshot)) {
+    cache_.get()->Erase(cache_key);
+  }
+}
+
+void UserKeyRowCache::OnMemTableAdd(ValueType type, const Slice& user_key,
+                                    SequenceNumber seq) {
+  if (type == kTypeRangeDeletion) {
+    InvalidateSnapshotsBefore(seq);
+    return;
+  }
+  UpdateMax(&StripeFor(user_key), seq);
+  std::string cache_key;
+  InitCacheKey(CurrentPrefixId(), user_key, &cache_key);
+  cache_.get()->Erase(cache_key);
+}
+
+void UserKeyRowCache::InvalidateSnapshotsBefore(SequenceNumber seq) {
+  UpdateMax(&invalidated_before_seq_, seq);
+}
+
+void UserKeyRowCache::InvalidateAll() {
+  prefix_id_.store(cache_.get()->NewId());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,100 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "cache/typed_cache.h"
+#include "db/dbformat.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/statistics.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Caches the results of point lookups in a column family, including "not
+// found", keyed by user key (see AdvancedColumnFamilyOptions::
+// user_key_row_cache). Unlike the table-file keyed DBOptions::row_cache, an
+// entry stays valid when its key is compacted between levels; it is instead
+// invalidated by writes.
+//
+// An entry records the result of a read at snapshot S, and serves reads at
+// snapshots >= S for as long as it is valid:
+// * A point write erases the entry of its key when it is added to the
+//   memtable, which is before it is published to readers.
+// * A reader that inserts its result re-checks, after inserting, that no
+//   write to the key with a sequence number above S raced with its read. For
+//   that, each point write raises the latest sequence number of one of
+//   kNumStripes stripes of the key space.
+// * A range deletion invalidates every entry with S below its sequence
+//   number.
+// * Changes to the LSM tree that do not go through the memtable (file
+//   ingestion, DeleteFilesInRange(), FIFO compaction dropping files) switch
+//   to a new cache key prefix before installing their SuperVersion, which
+//   makes all older entries unreachable. Each SuperVersion records the prefix
+//   current when it was installed, so that a reader never uses the prefix of
+//   a newer or older state of the LSM tree than the one it reads.
+class UserKeyRowCache {
+ public:
+  UserKeyRowCache(const std::shared_ptr<Cache>& cache, Statistics* stats);
+
+  UserKeyRowCache(const UserKeyRowCache&) = delete;
+  UserKeyRowCache& operator=(const UserKeyRowCache&) = delete;
+
+  // The cache key prefix, to record in a SuperVersion being installed
+  uint64_t CurrentPrefixId() const { return prefix_id_.load(); }
+
+  // Sets `*cache_key` to the cache key of `user_key` for a reader of a
+  // SuperVersion with the cache key prefix `prefix_id`
+  void InitCacheKey(uint64_t prefix_id, const Slice& user_key,
+                    std::string* cache_key) const;
+
+  // Returns true if the cache holds a result that is valid at `snapshot`,
+  // setting `*found` and, when found, pinning the value into `value`.
+  bool Lookup(const std::string& cache_key, SequenceNumber snapshot,
+              PinnableSlice* value, bool* found);
+
+  // Caches the result of a read of `user_key` at `snapshot`: `value`, or
+  // "not found" if it is nullptr.
+  void Insert(const std::string& cache_key, const Slice& user_key,
+              SequenceNumber snapshot, const Slice* value);
+
+  // Called for every entry added to the memtables of the column family.
+  void OnMemTableAdd(ValueType type, const Slice& user_key,
+                     SequenceNumber seq);
+
+  // Invalidates the entries of reads at snapshots before `seq`, for writes at
+  // `seq` whose keys are not known.
+  void InvalidateSnapshotsBefore(SequenceNumber seq);
+
+  // Invalidates every entry. Must be called before installing the
+  // SuperVersion with the change, under the DB mutex.
+  void InvalidateAll();
+
+ private:
+  static constexpr size_t kNumStripes = 4096;
+
+  using CacheInterface =
+      BasicTypedSharedCacheInterface<std::string, CacheEntryRole::kMisc>;
+
+  std::atomic<SequenceNumber>& StripeFor(const Slice& user_key);
+  // Whether `cache_key` has the current prefix
+  bool HasCurrentPrefix(const std::string& cache_key) const;
+  // Whether a key of `stripe_seq` may have been written after `snapshot`
+  bool WrittenAfter(const std::atomic<SequenceNumber>& stripe_seq,
+                    SequenceNumber snapshot) const;
+
+  CacheInterface cache_;
+  Statistics* const stats_;
+  std::atomic<uint64_t> prefix_id_;
+  std::atomic<SequenceNumber> invalidated_before_seq_{0};
+  std::array<std::atomic<SequenceNumber>, kNumStripes> stripe_seqs_{};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -57,6 +57,8 @@
 #include "rocksdb/env.h"
 #include "rocksdb/merge_operator.h"
 #include "rocksdb/write_buffer_manager.h"
+#include "table/block_based/block.h"
+#include "table/block_based/cachable_entry.h"
 #include "table/compaction_merging_iterator.h"
 #include "table/format.h"
 #include "table/get_context.h"
@@ -2686,6 +2688,7 @@ VersionStorageInfo::VersionStorageInfo(
       lowest_unnecessary_level_(-1),
       level_multiplier_(0.0),
       files_by_compaction_pri_(num_levels_),
+      file_compaction_scores_(num_levels_),
       level0_non_overlapping_(false),
       next_file_to_compact_by_size_(num_levels_),
       compaction_score_(num_levels_),
@@ -2929,6 +2932,121 @@ void Version::MultiGetBlob(
   }
 }
 
+MultiGetIOPlan::MultiGetIOPlan() = default;
+
+MultiGetIOPlan::~MultiGetIOPlan() {
+  // The blocks and read sets refer to the tables
+  blocks_.clear();
+  read_sets_.clear();
+  for (auto& entry : jobs_) {
+    if (entry.second.handle != nullptr) {
+      entry.second.table_cache->get_cache().Release(entry.second.handle);
+    }
+  }
+}
+
+std::shared_ptr<IOJob>* MultiGetIOPlan::GetJob(
+    const FileMetaData* file_meta, TableCache* table_cache,
+    TableCache::TypedHandle* handle) {
+  TableJob& table_job = jobs_[file_meta];
+  if (table_job.table_cache == nullptr) {
+    table_job.table_cache = table_cache;
+    table_job.handle = handle;
+  } else if (handle != nullptr) {
+    // Already held from an earlier batch of keys
+    table_cache->get_cache().Release(handle);
+  }
+  return &table_job.job;
+}
+
+void MultiGetIOPlan::Execute() {
+  assert(dispatcher_ == nullptr);
+  dispatcher_.reset(NewIODispatcher());
+  std::vector<size_t> num_read_set_blocks;
+  for (auto& entry : jobs_) {
+    const std::shared_ptr<IOJob>& job = entry.second.job;
+    if (job == nullptr || job->block_handles.empty()) {
+      continue;
+    }
+    // Planned a batch of keys at a time
+    std::vector<BlockHandle>& handles = job->block_handles;
+    std::sort(handles.begin(), handles.end(),
+              [](const BlockHandle& lhs, const BlockHandle& rhs) {
+                return lhs.offset() < rhs.offset();
+              });
+    handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+    job->job_options.block_handles_are_sorted = true;
+
+    std::shared_ptr<ReadSet> read_set;
+    Status s = dispatcher_->SubmitJob(job, &read_set);
+    if (s.ok()) {
+      num_blocks_ += handles.size();
+      num_read_set_blocks.push_back(handles.size());
+      read_sets_.push_back(std::move(read_set));
+    } else {
+      s.PermitUncheckedError();
+    }
+  }
+  blocks_.reserve(static_cast<size_t>(num_blocks_));
+  for (size_t r = 0; r < read_sets_.size(); ++r) {
+    for (size_t i = 0; i < num_read_set_blocks[r]; ++i) {
+      // Completes the async read of the block, if any
+      blocks_.emplace_back();
+      read_sets_[r]->ReadIndex(i, &blocks_.back()).PermitUncheckedError();
+    }
+  }
+  TEST_SYNC_POINT_CALLBACK("MultiGetIOPlan::Execute:Done", this);
+}
+
+void Version::PlanMultiGetIO(const ReadOptions& read_options,
+                             MultiGetRange* range, MultiGetIOPlan* plan) {
+  MultiGetRange file_picker_range(*range, range->begin(), range->end());
+  FilePickerMultiGet fp(&file_picker_range, &storage_info_.level_files_brief_,
+                        storage_info_.num_non_empty_levels_,
+                        &storage_info_.file_indexer_, user_comparator(),
+                        internal_comparator());
+  FdWithKeyRange* f = fp.GetNextFileInLevel();
+  while (!fp.IsSearchEnded()) {
+    if (f != nullptr) {
+      int level = static_cast<int>(fp.GetHitFileLevel());
+      MultiGetRange file_range = fp.CurrentFileRange();
+      bool skip_filters = IsFilterSkipped(level, fp.IsHitFileLastInLevel());
+      const FileMetaData& file_meta = *f->file_metadata;
+      TableCache::TypedHandle* handle = nullptr;
+      TableReader* table = file_meta.fd.pinned_reader.Get();
+      Status s;
+      if (table == nullptr) {
+        s = table_cache_->FindTable(
+            read_options, file_options_, *internal_comparator(), file_meta,
+            &handle, mutable_cf_options_, &table,
+            /*no_io=*/false, cfd_->internal_stats()->GetFileReadHist(level),
+            skip_filters, level,
+            /*prefetch_index_and_filter_in_cache=*/true,
+            /*max_file_size_for_l0_meta_pin=*/0, file_meta.temperature);
+      }
+      if (s.ok()) {
+        std::shared_ptr<IOJob>* job =
+            plan->GetJob(&file_meta, table_cache_, handle);
+        // NotSupported and errors are left to the lookups
+        table
+            ->PlanMultiGetIO(read_options,
+                             mutable_cf_options_.prefix_extractor.get(),
+                             skip_filters, &file_range, job)
+            .PermitUncheckedError();
+      } else {
+        s.PermitUncheckedError();
+      }
+      f = fp.GetNextFileInLevel();
+    }
+    if (f == nullptr) {
+      fp.PrepareNextLevelForSearch();
+      if (!fp.IsSearchEnded()) {
+        f = fp.GetNextFileInLevel();
+      }
+    }
+  }
+}
+
 #ifdef USE_COROUTINES
 Status Version::ProcessBatch(
     const ReadOptions& read_options, FilePickerMultiGet* batch,
@@ -4113,25 +4231,14 @@ void VersionStorageInfo::UpdateNumNonEmptyLevels() {
 }
 
 namespace {
-// Sort `temp` based on ratio of overlapping size over file size
-void SortFileByOverlappingRatio(
+// Returns the bytes in `next_level_files` overlapping each of `files`, in the
+// order of `files`. Both must be sorted and non-overlapping within themselves.
+std::vector<uint64_t> GetOverlappingBytes(
     const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
-    const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
-    int level, int num_non_empty_levels, uint64_t ttl,
-    std::vector<Fsize>* temp) {
-  std::unordered_map<uint64_t, uint64_t> file_to_order;
+    const std::vector<FileMetaData*>& next_level_files) {
+  std::vector<uint64_t> result;
+  result.reserve(files.size());
   auto next_level_it = next_level_files.begin();
-
-  int64_t curr_time;
-  Status status = clock->GetCurrentTime(&curr_time);
-  if (!status.ok()) {
-    // If we can't get time, disable TTL.
-    ttl = 0;
-  }
-
-  FileTtlBooster ttl_booster(static_cast<uint64_t>(curr_time), ttl,
-                             num_non_empty_levels, level);
-
   for (auto& file : files) {
     uint64_t overlapping_bytes = 0;
     // Skip files in next level that is smaller than current file
@@ -4150,6 +4257,34 @@ void SortFileByOverlappingRatio(
       }
       next_level_it++;
     }
+    result.push_back(overlapping_bytes);
+  }
+  return result;
+}
+
+// Sort `temp` based on ratio of overlapping size over file size
+void SortFileByOverlappingRatio(
+    const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
+    const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
+    int level, int num_non_empty_levels, uint64_t ttl,
+    std::vector<Fsize>* temp) {
+  std::unordered_map<uint64_t, uint64_t> file_to_order;
+
+  int64_t curr_time;
+  Status status = clock->GetCurrentTime(&curr_time);
+  if (!status.ok()) {
+    // If we can't get time, disable TTL.
+    ttl = 0;
+  }
+
+  FileTtlBooster ttl_booster(static_cast<uint64_t>(curr_time), ttl,
+                             num_non_empty_levels, level);
+
+  const std::vector<uint64_t> overlapping =
+      GetOverlappingBytes(icmp, files, next_level_files);
+  for (size_t i = 0; i < files.size(); ++i) {
+    FileMetaData* file = files[i];
+    uint64_t overlapping_bytes = overlapping[i];
 
     uint64_t ttl_boost_score = (ttl > 0) ? ttl_booster.GetBoostScore(file) : 1;
     assert(ttl_boost_score > 0);
@@ -4238,6 +4373,81 @@ void SortFileByRoundRobin(const InternalKeyComparator& icmp,
     }
   }
 }
+
+// Sort `temp` by expected benefit per byte written, and record the scores of
+// the sorted prefix in `scores`. See CompactionPri::kCostBenefit.
+void SortFileByCostBenefit(
+    const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
+    const std::vector<FileMetaData*>& next_level_files,
+    std::vector<Fsize>* temp,
+    std::vector<VersionStorageInfo::FileCompactionScore>* scores) {
+  // Value of saving one sampled read a level of lookups, in bytes: roughly
+  // one data block read
+  const double kBytesPerRead = 4096;
+
+  const std::vector<uint64_t> overlapping =
+      GetOverlappingBytes(icmp, files, next_level_files);
+  std::vector<VersionStorageInfo::FileCompactionScore> file_scores(
+      files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    const FileMetaData* file = files[i];
+    auto& fs = file_scores[i];
+    fs.file_number = file->fd.GetNumber();
+    fs.overlapping_bytes = overlapping[i];
+    fs.reads_sampled =
+        file->stats.num_reads_sampled.load(std::memory_order_relaxed);
+    const uint64_t collapsible_reads =
+        file->stats.num_collapsible_entry_reads_sampled.load(
+            std::memory_order_relaxed);
+    if (fs.reads_sampled > 0) {
+      fs.overwrite_ratio = static_cast<double>(collapsible_reads) /
+                           static_cast<double>(fs.reads_sampled);
+    }
+    if (file->num_entries > 0) {
+      fs.overwrite_ratio =
+          std::max(fs.overwrite_ratio,
+                   static_cast<double>(file->num_deletions) /
+                       static_cast<double>(file->num_entries));
+    }
+    fs.overwrite_ratio = std::min(fs.overwrite_ratio, 1.0);
+
+    assert(file->compensated_file_size != 0);
+    const double file_size = static_cast<double>(file->compensated_file_size);
+    const double overlapping_bytes =
+        static_cast<double>(fs.overlapping_bytes);
+    // Moving the file down is worth its own size; reads in its range skip a
+    // level; shadowed entries are dropped from the next level.
+    const double benefit =
+        file_size + static_cast<double>(fs.reads_sampled) * kBytesPerRead +
+        fs.overwrite_ratio * std::min(file_size, overlapping_bytes);
+    fs.score = benefit / (file_size + overlapping_bytes);
+  }
+
+  size_t num_to_sort = temp->size() > VersionStorageInfo::kNumberFilesToSort
+                           ? VersionStorageInfo::kNumberFilesToSort
+                           : temp->size();
+
+  std::partial_sort(
+      temp->begin(), temp->begin() + num_to_sort, temp->end(),
+      [&](const Fsize& f1, const Fsize& f2) -> bool {
+        if (f1.file->marked_for_compaction != f2.file->marked_for_compaction) {
+          return f1.file->marked_for_compaction >
+                 f2.file->marked_for_compaction;
+        }
+        const double score1 = file_scores[f1.index].score;
+        const double score2 = file_scores[f2.index].score;
+        if (score1 == score2) {
+          return icmp.Compare(f1.file->smallest, f2.file->smallest) < 0;
+        }
+        return score1 > score2;
+      });
+
+  scores->clear();
+  scores->reserve(num_to_sort);
+  for (size_t i = 0; i < num_to_sort; ++i) {
+    scores->push_back(file_scores[(*temp)[i].index]);
+  }
+}
 }  // anonymous namespace
 
 void VersionStorageInfo::UpdateFilesByCompactionPri(
@@ -4294,6 +4504,11 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
         SortFileByRoundRobin(*internal_comparator_, &compact_cursor_,
                              level0_non_overlapping_, level, &temp);
         break;
+      case kCostBenefit:
+        SortFileByCostBenefit(*internal_comparator_, files_[level],
+                              files_[level + 1], &temp,
+                              &file_compaction_scores_[level]);
+        break;
       default:
         assert(false);
     }
@@ -54,6 +54,7 @@
 #include "port/port.h"
 #include "rocksdb/env.h"
 #include "rocksdb/file_checksum.h"
+#include "rocksdb/io_dispatcher.h"
 #include "table/get_context.h"
 #include "table/multiget_context.h"
 #include "trace_replay/block_cache_tracer.h"
@@ -485,6 +486,27 @@ class VersionStorageInfo {
     return files_by_compaction_pri_[level];
   }
 
+  // Inputs and result of the kCostBenefit compaction priority for one file
+  struct FileCompactionScore {
+    uint64_t file_number = 0;
+    // Expected benefit per byte written; higher is compacted first
+    double score = 0;
+    uint64_t reads_sampled = 0;
+    // Estimated fraction of the file's entries that are deletions or
+    // shadow older versions
+    double overwrite_ratio = 0;
+    uint64_t overlapping_bytes = 0;
+  };
+
+  // Scores of the sorted prefix of FilesByCompactionPri(level), in the same
+  // order. Empty unless compaction_pri is kCostBenefit.
+  // REQUIRES: PrepareForVersionAppend has been called
+  const std::vector<FileCompactionScore>& FileCompactionScores(
+      int level) const {
+    assert(finalized_);
+    return file_compaction_scores_[level];
+  }
+
   // REQUIRES: ComputeCompactionScore has been called
   // REQUIRES: DB mutex held during access
   const autovector<std::pair<int, FileMetaData*>>& FilesMarkedForCompaction()
@@ -733,6 +755,9 @@ class VersionStorageInfo {
   // This vector stores the index of the file from files_.
   std::vector<std::vector<int>> files_by_compaction_pri_;
 
+  // See FileCompactionScores()
+  std::vector<std::vector<FileCompactionScore>> file_compaction_scores_;
+
   // If true, means that files in L0 have keys with non overlapping ranges
   bool level0_non_overlapping_;
 
@@ -906,6 +931,48 @@ class ObsoleteBlobFileInfo {
 };
 
 using MultiGetRange = MultiGetContext::Range;
+
+// The data block reads of a MultiGet, planned across its column families and
+// levels before the lookups, for ReadOptions::plan_multiget_io. Keeps the
+// tables planned open, and the blocks read pinned in the block cache, until
+// destroyed.
+class MultiGetIOPlan {
+ public:
+  MultiGetIOPlan();
+  ~MultiGetIOPlan();
+
+  MultiGetIOPlan(const MultiGetIOPlan&) = delete;
+  MultiGetIOPlan& operator=(const MultiGetIOPlan&) = delete;
+
+  // The job of the table of `file_meta`, created by the table on its first
+  // PlanMultiGetIO(). Takes over `handle` (may be nullptr), the table cache
+  // handle of the table.
+  std::shared_ptr<IOJob>* GetJob(const FileMetaData* file_meta,
+                                 TableCache* table_cache,
+                                 TableCache::TypedHandle* handle);
+
+  // Submits the jobs through one IODispatcher, so that the reads of all the
+  // tables are in flight together, then waits for them. Read errors are left
+  // to the lookups, which read the blocks again.
+  void Execute();
+
+  size_t GetNumJobs() const { return jobs_.size(); }
+  uint64_t GetNumBlocks() const { return num_blocks_; }
+
+ private:
+  struct TableJob {
+    TableCache* table_cache = nullptr;
+    TableCache::TypedHandle* handle = nullptr;
+    std::shared_ptr<IOJob> job;
+  };
+
+  UnorderedMap<const FileMetaData*, TableJob> jobs_;
+  std::unique_ptr<IODispatcher> dispatcher_;
+  std::vector<std::shared_ptr<ReadSet>> read_sets_;
+  std::vector<CachableEntry<Block>> blocks_;
+  uint64_t num_blocks_ = 0;
+};
+
 // A column family's version consists of the table and blob files owned by
 // the column family at a certain point in time.
 class Version {
@@ -977,6 +1044,11 @@ class Version {
                          MultiGetRange* range,
                          ReadCallback* callback = nullptr);
 
+  // Adds to `plan` the data blocks of the SST files which may hold the keys
+  // in `range`, for ReadOptions::plan_multiget_io
+  void PlanMultiGetIO(const ReadOptions& read_options, MultiGetRange* range,
+                      MultiGetIOPlan* plan);
+
   // Retrieves a blob using a blob reference and saves it in *value,
   // assuming the corresponding blob file is part of this Version.
   Status GetBlob(const ReadOptions& read_options, const Slice& user_key,
@@ -0,0 +1,102 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/wal_record_prefetcher.h"
+
+#include <string>
+
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+WalRecordPrefetcher::Record::~Record() {
+  decode_status.PermitUncheckedError();
+  for (const Report& report : reports_) {
+    report.status.PermitUncheckedError();
+  }
+}
+
+void WalRecordPrefetcher::Record::ReplayReports(
+    log::Reader::Reporter* reporter) const {
+  for (const Report& report : reports_) {
+    if (report.old_log_record) {
+      reporter->OldLogRecord(report.bytes);
+    } else {
+      reporter->Corruption(report.bytes, report.status, report.log_number);
+    }
+  }
+}
+
+WalRecordPrefetcher::~WalRecordPrefetcher() {
+  {
+    MutexLock l(&mutex_);
+    stop_ = true;
+    cv_.SignalAll();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void WalRecordPrefetcher::Start(log::Reader* reader) {
+  assert(reader);
+  assert(reader_ == nullptr);
+  reader_ = reader;
+  thread_ = port::Thread(&WalRecordPrefetcher::ReadRecords, this);
+}
+
+std::unique_ptr<WalRecordPrefetcher::Record> WalRecordPrefetcher::Next() {
+  MutexLock l(&mutex_);
+  while (records_.empty()) {
+    cv_.Wait();
+  }
+  std::unique_ptr<Record> record = std::move(records_.front());
+  records_.pop_front();
+  buffered_bytes_ -= record->size;
+  cv_.SignalAll();
+  return record;
+}
+
+void WalRecordPrefetcher::Corruption(size_t bytes, const Status& status,
+                                     uint64_t log_number) {
+  assert(current_);
+  current_->reports_.push_back({false, bytes, status, log_number});
+}
+
+void WalRecordPrefetcher::OldLogRecord(size_t bytes) {
+  assert(current_);
+  current_->reports_.push_back({true, bytes, Status::OK(), kMaxSequenceNumber});
+}
+
+void WalRecordPrefetcher::ReadRecords() {
+  std::string scratch;
+  bool read = true;
+  while (read) {
+    std::unique_ptr<Record> record(new Record());
+    current_ = record.get();
+    Slice contents;
+    read = reader_->ReadRecord(&contents, &scratch, wal_recovery_mode_,
+                               &record->checksum);
+    current_ = nullptr;
+    record->read = read;
+    if (read) {
+      record->size = contents.size();
+      decode_(contents, record.get());
+    }
+
+    MutexLock l(&mutex_);
+    while (!stop_ && buffered_bytes_ >= kMaxBufferedBytes) {
+      cv_.Wait();
+    }
+    if (stop_) {
+      return;
+    }
+    buffered_bytes_ += record->size;
+    records_.push_back(std::move(record));
+    cv_.SignalAll();
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
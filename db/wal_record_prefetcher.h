@@ -0,0 +1,106 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "db/log_reader.h"
+#include "port/port.h"
+#include "rocksdb/options.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "rocksdb/write_batch.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Reads the records of a WAL file on a background thread, ahead of the thread
+// applying them, for DBOptions::pipelined_wal_recovery.
+//
+// The prefetcher is the reporter of the log::Reader it reads from. It records
+// the reporter calls made while reading each record, and the consumer replays
+// them through its own reporter when taking the record, so that corruptions
+// are seen at the same point of the recovery as when reading the WAL
+// directly.
+class WalRecordPrefetcher : public log::Reader::Reporter {
+ public:
+  // Upper bound on the size of the records read ahead of the consumer
+  static constexpr size_t kMaxBufferedBytes = 16 << 20;
+
+  struct Record {
+    // Records may be dropped without being applied
+    ~Record();
+
+    // Result of log::Reader::ReadRecord(). No record follows one that was not
+    // read.
+    bool read = false;
+    size_t size = 0;
+    uint64_t checksum = 0;
+
+    // Set by the DecodeFunc
+    Status decode_status;
+    WriteBatch batch;
+    std::unique_ptr<WriteBatch> new_batch;
+    WriteBatch* batch_to_use = nullptr;
+
+    // Replays the reporter calls made while reading this record.
+    void ReplayReports(log::Reader::Reporter* reporter) const;
+
+   private:
+    friend class WalRecordPrefetcher;
+
+    struct Report {
+      bool old_log_record;
+      size_t bytes;
+      Status status;
+      uint64_t log_number;
+    };
+    std::vector<Report> reports_;
+  };
+
+  // Called on the background thread for each record read, whose size and
+  // checksum are already set in `out`.
+  using DecodeFunc = std::function<void(const Slice& record, Record* out)>;
+
+  WalRecordPrefetcher(WALRecoveryMode wal_recovery_mode, DecodeFunc decode)
+      : wal_recovery_mode_(wal_recovery_mode),
+        decode_(std::move(decode)),
+        cv_(&mutex_) {}
+  // Stops reading and waits for the background thread.
+  ~WalRecordPrefetcher() override;
+
+  // Starts reading from `reader`, which must report to this prefetcher and
+  // outlive it.
+  void Start(log::Reader* reader);
+
+  // Returns the next record, waiting for it to be read if needed. Must not be
+  // called again after returning a record that was not read.
+  std::unique_ptr<Record> Next();
+
+  void Corruption(size_t bytes, const Status& status,
+                  uint64_t log_number = kMaxSequenceNumber) override;
+  void OldLogRecord(size_t bytes) override;
+
+ private:
+  void ReadRecords();
+
+  const WALRecoveryMode wal_recovery_mode_;
+  const DecodeFunc decode_;
+  log::Reader* reader_ = nullptr;
+  port::Thread thread_;
+  // Record being read, only accessed by the background thread
+  Record* current_ = nullptr;
+
+  port::Mutex mutex_;
+  port::CondVar cv_;
+  std::deque<std::unique_ptr<Record>> records_;
+  size_t buffered_bytes_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
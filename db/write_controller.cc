@@ -8,12 +8,39 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
 #include <ratio>
 
 #include "rocksdb/system_clock.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+// Gains of the feedback controller. The control output is applied in log
+// space (rate = base * exp(-output)), so a unit of output changes the rate by
+// a factor of e regardless of its magnitude.
+constexpr double kFeedbackProportionalGain = 2.0;
+constexpr double kFeedbackIntegralGain = 0.5;    // per second
+constexpr double kFeedbackDerivativeGain = 1.0;  // seconds
+// Anti-windup bound for the integral term
+constexpr double kFeedbackMaxIntegral = 4.0;
+// Weight of the newest observation in the smoothed derivative and
+// compaction throughput
+constexpr double kFeedbackDerivativeSmoothing = 0.5;
+constexpr double kFeedbackThroughputSmoothing = 0.3;
+// Back-to-back updates (e.g. from several column families installing new
+// versions together) would make the derivative spike
+constexpr uint64_t kFeedbackMinDerivativeIntervalMicros = 10000;
+// Compactions only report their output when they finish, so throughput is
+// measured over windows of at least this long
+constexpr uint64_t kFeedbackThroughputWindowMicros = 1000000;
+constexpr uint64_t kFeedbackMinWriteRate = 16 * 1024;
+}  // anonymous namespace
+
+WriteController::~WriteController() = default;
+
 std::unique_ptr<WriteControllerToken> WriteController::GetStopToken() {
   ++total_stopped_;
   return std::unique_ptr<WriteControllerToken>(new StopWriteToken(this));
@@ -99,6 +126,147 @@ uint64_t WriteController::GetDelay(SystemClock* clock, uint64_t num_bytes) {
   return std::max(next_refill_time_ - time_now, kMicrosPerRefill);
 }
 
+void WriteController::set_feedback_control(bool enabled) {
+  if (feedback_.enabled == enabled) {
+    return;
+  }
+  feedback_token_.reset();
+  feedback_ = FeedbackState();
+  feedback_.enabled = enabled;
+  feedback_window_start_micros_ = 0;
+  feedback_window_compacted_bytes_ = 0;
+}
+
+void WriteController::UpdateFeedback(uint64_t now_micros,
+                                     const FeedbackSample& sample) {
+  FeedbackState& st = feedback_;
+  if (!st.enabled) {
+    return;
+  }
+  const double error = sample.pressure - kFeedbackSetpoint;
+  if (st.num_updates > 0 && now_micros > st.last_update_micros) {
+    const double dt =
+        static_cast<double>(now_micros - st.last_update_micros) / 1000000;
+    if (now_micros - st.last_update_micros >=
+        kFeedbackMinDerivativeIntervalMicros) {
+      st.derivative = (1 - kFeedbackDerivativeSmoothing) * st.derivative +
+                      kFeedbackDerivativeSmoothing * (error - st.error) / dt;
+    }
+    if (st.engaged) {
+      st.integral = std::clamp(st.integral + error * dt, -kFeedbackMaxIntegral,
+                               kFeedbackMaxIntegral);
+    }
+  }
+
+  if (st.num_updates == 0 ||
+      sample.compacted_bytes < feedback_window_compacted_bytes_) {
+    // First observation, or a column family was dropped: restart the
+    // throughput window
+    feedback_window_start_micros_ = now_micros;
+    feedback_window_compacted_bytes_ = sample.compacted_bytes;
+  } else if (now_micros >=
+             feedback_window_start_micros_ + kFeedbackThroughputWindowMicros) {
+    const double window =
+        static_cast<double>(now_micros - feedback_window_start_micros_) /
+        1000000;
+    const uint64_t compacted =
+        sample.compacted_bytes - feedback_window_compacted_bytes_;
+    if (compacted > 0) {
+      const double rate = static_cast<double>(compacted) / window;
+      st.compaction_bytes_per_sec =
+          st.compaction_bytes_per_sec == 0
+              ? static_cast<uint64_t>(rate)
+              : static_cast<uint64_t>(
+                    kFeedbackThroughputSmoothing * rate +
+                    (1 - kFeedbackThroughputSmoothing) *
+                        static_cast<double>(st.compaction_bytes_per_sec));
+    }
+    feedback_window_start_micros_ = now_micros;
+    feedback_window_compacted_bytes_ = sample.compacted_bytes;
+  }
+  st.pressure = sample.pressure;
+  st.error = error;
+  st.compaction_debt_bytes = sample.compaction_debt_bytes;
+  st.last_update_micros = now_micros;
+  ++st.num_updates;
+
+  if (!st.engaged && sample.pressure >= kFeedbackEngagePressure) {
+    st.engaged = true;
+    st.integral = 0;
+  } else if (st.engaged && sample.pressure < kFeedbackReleasePressure) {
+    st.engaged = false;
+  }
+
+  // Every ingested byte is flushed once and then rewritten
+  // `write_amplification` times by compaction, so the compaction throughput
+  // divided by it is the ingest rate compaction can keep up with.
+  st.write_amplification =
+      sample.flushed_bytes > 0
+          ? std::max(1.0, static_cast<double>(sample.compacted_bytes) /
+                              static_cast<double>(sample.flushed_bytes))
+          : 1.0;
+  st.sustainable_write_rate =
+      st.compaction_bytes_per_sec > 0
+          ? std::min(max_delayed_write_rate_,
+                     static_cast<uint64_t>(
+                         static_cast<double>(st.compaction_bytes_per_sec) /
+                         st.write_amplification))
+          : max_delayed_write_rate_;
+
+  const double output = kFeedbackProportionalGain * st.error +
+                        kFeedbackIntegralGain * st.integral +
+                        kFeedbackDerivativeGain * st.derivative;
+  const double rate =
+      static_cast<double>(st.sustainable_write_rate) * std::exp(-output);
+  uint64_t write_rate = max_delayed_write_rate_;
+  if (rate < static_cast<double>(max_delayed_write_rate_)) {
+    write_rate = std::max(static_cast<uint64_t>(rate),
+                          std::min(kFeedbackMinWriteRate,
+                                   max_delayed_write_rate_));
+  }
+  set_delayed_write_rate(write_rate);
+
+  if (st.engaged && !feedback_token_) {
+    feedback_token_ = GetDelayToken(write_rate);
+  } else if (!st.engaged) {
+    feedback_token_.reset();
+  }
+}
+
+std::string WriteController::FeedbackStateToString() const {
+  const FeedbackState& st = feedback_;
+  char buf[1024];
+  snprintf(buf, sizeof(buf),
+           "enabled: %d\n"
+           "engaged: %d\n"
+           "pressure: %.3f\n"
+           "setpoint: %.3f\n"
+           "error: %.3f\n"
+           "integral: %.3f\n"
+           "derivative: %.3f\n"
+           "compaction_debt_bytes: %" PRIu64
+           "\n"
+           "compaction_bytes_per_sec: %" PRIu64
+           "\n"
+           "write_amplification: %.2f\n"
+           "sustainable_write_rate: %" PRIu64
+           "\n"
+           "delayed_write_rate: %" PRIu64
+           "\n"
+           "max_delayed_write_rate: %" PRIu64
+           "\n"
+           "is_delayed: %d\n"
+           "is_stopped: %d\n"
+           "num_updates: %" PRIu64 "\n",
+           st.enabled ? 1 : 0, st.engaged ? 1 : 0, st.pressure,
+           kFeedbackSetpoint, st.error, st.integral, st.derivative,
+           st.compaction_debt_bytes, st.compaction_bytes_per_sec,
+           st.write_amplification, st.sustainable_write_rate,
+           delayed_write_rate_, max_delayed_write_rate_, NeedsDelay() ? 1 : 0,
+           IsStopped() ? 1 : 0, st.num_updates);
+  return buf;
+}
+
 uint64_t WriteController::NowMicrosMonotonic(SystemClock* clock) {
   return clock->NowNanos() / std::milli::den;
 }
@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
 
 #include "rocksdb/rate_limiter.h"
 
@@ -34,7 +35,7 @@ class WriteController {
             NewGenericRateLimiter(low_pri_rate_bytes_per_sec)) {
     set_max_delayed_write_rate(_delayed_write_rate);
   }
-  ~WriteController() = default;
+  ~WriteController();
 
   // When an actor (column family) requests a stop token, all writes will be
   // stopped until the stop token is released (deleted)
@@ -85,6 +86,55 @@ class WriteController {
 
   RateLimiter* low_pri_rate_limiter() { return low_pri_rate_limiter_.get(); }
 
+  // Closed-loop pacing (DBOptions::write_rate_feedback_control). Instead of
+  // the step changes applied to the delayed write rate by the column
+  // families' delay tokens, a PID controller on the write pressure sets the
+  // rate, starting from an estimate of the ingest rate that compaction can
+  // sustain. Stop conditions are unaffected.
+  struct FeedbackSample {
+    // Largest write pressure across column families. 1.0 means a column
+    // family reached level0_slowdown_writes_trigger or
+    // soft_pending_compaction_bytes_limit.
+    double pressure = 0;
+    // Total estimated pending compaction bytes
+    uint64_t compaction_debt_bytes = 0;
+    // Cumulative bytes written by flushes and by compactions
+    uint64_t flushed_bytes = 0;
+    uint64_t compacted_bytes = 0;
+  };
+
+  struct FeedbackState {
+    bool enabled = false;
+    // Whether the controller currently holds a delay of its own
+    bool engaged = false;
+    double pressure = 0;
+    double error = 0;
+    double integral = 0;
+    double derivative = 0;
+    uint64_t compaction_debt_bytes = 0;
+    // Smoothed compaction output rate, bytes / second
+    uint64_t compaction_bytes_per_sec = 0;
+    // Compaction bytes written per flushed byte
+    double write_amplification = 0;
+    // Ingest rate that compaction is estimated to sustain, bytes / second
+    uint64_t sustainable_write_rate = 0;
+    uint64_t num_updates = 0;
+    uint64_t last_update_micros = 0;
+  };
+
+  static constexpr double kFeedbackSetpoint = 0.75;
+  // Pressure at which the controller starts and stops pacing on its own
+  static constexpr double kFeedbackEngagePressure = 0.5;
+  static constexpr double kFeedbackReleasePressure = 0.3;
+
+  void set_feedback_control(bool enabled);
+  bool feedback_control() const { return feedback_.enabled; }
+  // Feeds one observation to the controller and updates the delayed write
+  // rate. No-op unless feedback control is enabled.
+  void UpdateFeedback(uint64_t now_micros, const FeedbackSample& sample);
+  const FeedbackState& feedback_state() const { return feedback_; }
+  std::string FeedbackStateToString() const;
+
  private:
   uint64_t NowMicrosMonotonic(SystemClock* clock);
 
@@ -107,6 +157,12 @@ class WriteController {
   uint64_t delayed_write_rate_;
 
   std::unique_ptr<RateLimiter> low_pri_rate_limiter_;
+
+  FeedbackState feedback_;
+  // Start of the current compaction throughput measurement window
+  uint64_t feedback_window_start_micros_ = 0;
+  uint64_t feedback_window_compacted_bytes_ = 0;
+  std::unique_ptr<WriteControllerToken> feedback_token_;
 };
 
 class WriteControllerToken {
@@ -239,6 +239,81 @@ TEST_F(WriteControllerTest, CreditAccumulation) {
   ASSERT_EQ(10 SECS, controller.GetDelay(clock_.get(), 10 MB));
 }
 
+TEST_F(WriteControllerTest, FeedbackControl) {
+  WriteController controller(40 MBPS);
+  WriteController::FeedbackSample sample;
+  // Compaction writes 10 MB/s and 4 bytes per flushed byte, so it can
+  // sustain an ingest rate of 2.5 MB/s
+  sample.flushed_bytes = 10 MB;
+  sample.compacted_bytes = 40 MB;
+  auto update = [&](double pressure) {
+    clock_->now_micros_ += 1 SECS;
+    sample.flushed_bytes += 2500000;
+    sample.compacted_bytes += 10 MB;
+    sample.pressure = pressure;
+    controller.UpdateFeedback(clock_->now_micros_, sample);
+  };
+
+  // No-op unless enabled
+  update(1.0);
+  EXPECT_FALSE(controller.NeedsDelay());
+  EXPECT_EQ(0U, controller.feedback_state().num_updates);
+
+  controller.set_feedback_control(true);
+  EXPECT_TRUE(controller.feedback_control());
+  update(0.2);
+  EXPECT_FALSE(controller.feedback_state().engaged);
+  EXPECT_FALSE(controller.NeedsDelay());
+  EXPECT_EQ(40 MBPS, controller.delayed_write_rate());
+
+  // Below the engage threshold the controller does not pace writes, even
+  // once it knows the sustainable rate
+  update(0.4);
+  EXPECT_FALSE(controller.NeedsDelay());
+  EXPECT_NEAR(
+      10.0 MBPS,
+      static_cast<double>(controller.feedback_state().compaction_bytes_per_sec),
+      1.0);
+  EXPECT_NEAR(
+      2500000.0,
+      static_cast<double>(controller.feedback_state().sustainable_write_rate),
+      1.0);
+
+  // Holding the pressure at the setpoint converges on the sustainable rate
+  for (int i = 0; i < 10; ++i) {
+    update(WriteController::kFeedbackSetpoint);
+    EXPECT_TRUE(controller.feedback_state().engaged);
+    EXPECT_TRUE(controller.NeedsDelay());
+  }
+  EXPECT_NEAR(2500000.0, static_cast<double>(controller.delayed_write_rate()),
+              2500000.0 * 0.05);
+  EXPECT_GT(controller.GetDelay(clock_.get(), 10 MB), 0U);
+
+  // Sustained overload slows down smoothly: every update lowers the rate by
+  // a bounded factor, with no stop and no jump to the minimum
+  uint64_t prev_rate = controller.delayed_write_rate();
+  for (int i = 0; i < 10; ++i) {
+    update(0.9);
+    uint64_t rate = controller.delayed_write_rate();
+    EXPECT_LT(rate, prev_rate);
+    EXPECT_GT(rate, prev_rate / 2);
+    prev_rate = rate;
+  }
+  EXPECT_FALSE(controller.IsStopped());
+
+  // Recovery releases the delay
+  update(WriteController::kFeedbackReleasePressure / 2);
+  EXPECT_FALSE(controller.feedback_state().engaged);
+  EXPECT_FALSE(controller.NeedsDelay());
+
+  std::string state = controller.FeedbackStateToString();
+  EXPECT_NE(std::string::npos, state.find("sustainable_write_rate: "));
+
+  controller.set_feedback_control(false);
+  EXPECT_FALSE(controller.feedback_control());
+  EXPECT_EQ(0U, controller.feedback_state().num_updates);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
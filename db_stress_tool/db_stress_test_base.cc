@@ -5190,6 +5190,9 @@ void StressTest::PrintEnv() const {
     case kRoundRobin:
       compaction_pri = "kRoundRobin";
       break;
+    case kCostBenefit:
+      compaction_pri = "kCostBenefit";
+      break;
   }
   fprintf(stdout, "Compaction Pri            : %s\n", compaction_pri);
   fprintf(stdout, "Background Purge          : %d\n",
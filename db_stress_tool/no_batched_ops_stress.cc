@@ -2573,6 +2573,7 @@ class NonBatchedOpsStressTest : public StressTest {
           thread->rand.OneInOpt(2) ? 1024 * 1024 : 0;
       ingest_options.fill_cache = thread->rand.OneInOpt(4);
       ingest_options.file_opening_threads = 1 + thread->rand.Uniform(4);
+      ingest_options.file_preparing_threads = 1 + thread->rand.Uniform(4);
       ingest_options.prefetch_lmax_index_and_filter_blocks =
           !thread->rand.OneInOpt(4);
       const bool use_prepare_commit = thread->rand.OneInOpt(
@@ -2588,6 +2589,8 @@ class NonBatchedOpsStressTest : public StressTest {
                          << ", fill_cache: " << ingest_options.fill_cache
                          << ", file_opening_threads: "
                          << ingest_options.file_opening_threads
+                         << ", file_preparing_threads: "
+                         << ingest_options.file_preparing_threads
                          << ", prefetch_lmax_index_and_filter_blocks: "
                          << ingest_options.prefetch_lmax_index_and_filter_blocks
                          << ", ingest_external_file_data_file_count: "
@@ -713,4 +713,71 @@ const std::shared_ptr<CompressionManager>& GetBuiltinV2CompressionManager();
 // EXPERIMENTAL
 std::shared_ptr<CompressionManagerWrapper> CreateCostAwareCompressionManager(
     std::shared_ptr<CompressionManager> wrapped = nullptr);
+
+// Options for CreateAdaptiveCompressionManager()
+// EXPERIMENTAL
+struct AdaptiveCompressionOptions {
+  // For each kind of block (column family, level of the file at creation and
+  // block type), the manager compresses with the candidate (no compression,
+  // LZ4 and a few ZSTD levels, as supported) minimizing
+  //   compressed size + cpu_weight * decompression time
+  // with both per byte of uncompressed data and the time in nanoseconds. So
+  // cpu_weight is how many bytes of storage one nanosecond of decompression
+  // CPU is worth. Files created in the first num_hot_levels levels, which are
+  // read the most, use hot_cpu_weight, and the others cold_cpu_weight. A
+  // weight of 0 just minimizes the size.
+  double hot_cpu_weight = 0.5;
+  double cold_cpu_weight = 0.0;
+  int num_hot_levels = 2;
+
+  // One block in this many (and the first block of each file) is compressed
+  // with every candidate, and decompressed, to update the estimates of the
+  // compressed size and decompression time of the candidates.
+  uint32_t sample_interval = 64;
+};
+
+// Creates a CompressionManager choosing the compression of each kind of block
+// from a cost model learned online, weighing storage against read CPU. See
+// AdaptiveCompressionOptions. Compatible with the wrapped manager, the
+// built-in one by default.
+// EXPERIMENTAL
+std::shared_ptr<CompressionManagerWrapper> CreateAdaptiveCompressionManager(
+    const AdaptiveCompressionOptions& opts = AdaptiveCompressionOptions(),
+    std::shared_ptr<CompressionManager> wrapped = nullptr);
+
+// Options for CreateSharedDictionaryCompressionManager()
+// EXPERIMENTAL
+struct SharedDictionaryOptions {
+  // Maximum size of each trained dictionary
+  size_t max_dict_bytes = 16 << 10;
+
+  // Bytes of the most recent samples kept for each column family, as training
+  // input. A first dictionary is trained once this much is sampled.
+  size_t max_train_bytes = 1 << 20;
+
+  // One data block in this many is copied into the samples
+  uint32_t sample_interval = 8;
+
+  // A new version of the dictionary is trained once this many bytes of data
+  // blocks have been compressed since the last training
+  uint64_t retrain_interval_bytes = uint64_t{256} << 20;
+};
+
+// Creates a CompressionManager giving SST files of each column family a
+// dictionary trained periodically rather than per file. Data blocks (one in
+// sample_interval) compressed with ZSTD are sampled into a pool per column
+// family, from which a dictionary is trained (see SharedDictionaryOptions) by
+// the flush or compaction thread compressing the block that makes training
+// due, while other threads keep compressing. New files use the current
+// version of the dictionary as pre-defined, saving the buffering and training
+// of dictionary compression with CompressionOptions::max_dict_bytes. Each
+// file still stores its dictionary, so files stay readable by the wrapped
+// manager (the built-in one by default), with which this one is compatible.
+// Files opened with the same dictionary share one digested decompressor. No
+// dictionary is used until the first one is trained.
+// EXPERIMENTAL
+std::shared_ptr<CompressionManagerWrapper>
+CreateSharedDictionaryCompressionManager(
+    const SharedDictionaryOptions& opts = SharedDictionaryOptions(),
+    std::shared_ptr<CompressionManager> wrapped = nullptr);
 }  // namespace ROCKSDB_NAMESPACE
@@ -60,6 +60,17 @@ enum CompactionPri : char {
   // level. The file picking process will cycle through all the files in a
   // round-robin manner.
   kRoundRobin = 0x4,
+  // First compact files with the highest expected benefit per byte written.
+  // The benefit combines the sampled reads served by the file (reads in its
+  // key range get one level cheaper once it is merged down), the fraction of
+  // its entries that shadow older versions or are deletions (space reclaimed
+  // from the next level), and the file's own size. The cost is the file size
+  // plus its overlapping bytes in the next level, so for files that are
+  // neither read nor overwritten this orders like kMinOverlappingRatio.
+  // The scores are reported by the "rocksdb.compaction-file-scores" property.
+  // Files marked for compaction will be prioritized over files that are not
+  // marked.
+  kCostBenefit = 0x5,
 };
 
 struct FileTemperatureAge {
@@ -1489,6 +1500,27 @@ struct AdvancedColumnFamilyOptions {
   // Immutable.
   bool memtable_batch_lookup_optimization = false;
 
+  // EXPERIMENTAL
+  // If non-null, caches the results of Get() on this column family, keyed by
+  // user key. Unlike DBOptions::row_cache, which is keyed by table file and
+  // so loses entries when their keys are compacted, entries here are only
+  // invalidated by writes to their key, range deletions, file ingestion,
+  // DeleteFilesInRange() and the files dropped by FIFO compaction (for ttl or
+  // max_table_files_size), which invalidate the whole cache of the column
+  // family. "Not found" results are cached too, which makes
+  // repeated lookups of missing keys cheap. Passing a separate cache to each
+  // column family sizes the caches per column family; a cache can also be
+  // shared between column families and DBs.
+  //
+  // Only Get() of a column family without user-defined timestamps, reading
+  // all tiers, uses the cache. Not compatible with compaction filters,
+  // inplace_update_support or DBOptions::unordered_write, which can change
+  // the result of a Get() without a write to the key.
+  //
+  // Default: nullptr (disabled)
+  // Immutable.
+  std::shared_ptr<Cache> user_key_row_cache = nullptr;
+
   // Create ColumnFamilyOptions with default values for all fields
   AdvancedColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
@@ -5853,6 +5853,14 @@ extern ROCKSDB_LIBRARY_API int
 rocksdb_ingestexternalfileoptions_get_file_opening_threads(
     rocksdb_ingestexternalfileoptions_t* opt);
 
+extern ROCKSDB_LIBRARY_API void
+rocksdb_ingestexternalfileoptions_set_file_preparing_threads(
+    rocksdb_ingestexternalfileoptions_t* opt, int v);
+
+extern ROCKSDB_LIBRARY_API int
+rocksdb_ingestexternalfileoptions_get_file_preparing_threads(
+    rocksdb_ingestexternalfileoptions_t* opt);
+
 /* OpenAndCompactOptions */
 
 extern ROCKSDB_LIBRARY_API unsigned char
@@ -24,6 +24,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Cache;  // defined in advanced_cache.h
 struct ConfigOptions;
+class FileSystem;
 class SecondaryCache;
 
 // These definitions begin source compatibility for a future change in which
@@ -310,6 +311,17 @@ struct CompressedSecondaryCacheOptions : LRUCacheOptions {
   // into chunks so that they may better fit jemalloc bins.
   bool enable_custom_split_merge = false;
 
+  // If non-zero, values are stored in slabs of this many bytes, appended one
+  // after the other, instead of in an allocation (or chain of chunks) per
+  // value, and enable_custom_split_merge is ignored. Slabs left mostly empty
+  // by evictions are compacted as new slabs are filled. The bytes of the
+  // slabs not holding live values are charged to the cache too, so that the
+  // slabs stay within the capacity, which should therefore be many times the
+  // slab size. Lookups decompress straight from the slabs. Values larger than
+  // a slab get their own allocation. Something like 256KB suits blocks of a
+  // few KB.
+  size_t slab_size = 0;
+
   // Kinds of entries that should not be compressed, but can be stored.
   // (Filter blocks are essentially non-compressible but others usually are.)
   CacheEntryRoleSet do_not_compress_roles = {CacheEntryRole::kFilterBlock};
@@ -368,6 +380,43 @@ inline std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
   return opts.MakeSharedSecondaryCache();
 }
 
+// EXPERIMENTAL
+// Options structure for configuring a SecondaryCache instance on local flash
+// (such as NVMe SSD), typically for TieredCacheOptions::nvm_sec_cache. The
+// cache is log structured: inserted blocks are batched in memory and appended
+// to large segment files with big sequential writes, and when the cache is
+// full, the oldest segment is evicted as a whole. An in-memory index maps each
+// key to its location, costing something like 50 bytes per cached block.
+// Lookups that need not complete right away are issued as async reads, when
+// the FileSystem supports them. The cache starts empty, and the segment files
+// are deleted when it is destroyed.
+struct FlashSecondaryCacheOptions {
+  // Directory holding the segment files, created if missing. Any segment file
+  // already in it is deleted when the cache is created. Required.
+  std::string path;
+
+  // The FileSystem holding `path`. nullptr means FileSystem::Default().
+  std::shared_ptr<FileSystem> fs;
+
+  // Bytes of flash used by the cache. At least two segments are kept.
+  size_t capacity = 0;
+
+  // Size of the segment files, the unit of eviction
+  size_t segment_size = 64 << 20;
+
+  // Inserted blocks are written in batches of this many bytes. When the
+  // writes fall behind, inserts are dropped rather than buffered.
+  size_t write_batch_size = 1 << 20;
+
+  // Read and write the segment files with direct I/O, bypassing the page
+  // cache. Not every file system supports it.
+  bool use_direct_io = true;
+
+  // Construct an instance of the flash secondary cache using these options
+  Status MakeSharedSecondaryCache(
+      std::shared_ptr<SecondaryCache>* result) const;
+};
+
 // HyperClockCache (also known as HCC) - A lock-free Cache alternative for
 // RocksDB block cache that offers much improved CPU efficiency vs. LRUCache
 // under high parallel load or high contention. Additionally, HCC only uses
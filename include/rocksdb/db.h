@@ -1392,6 +1392,13 @@ class DB {
     //      of files per level and total size of each level (MB).
     static const std::string kLevelStats;
 
+    //  "rocksdb.compaction-file-scores" - returns a multi-line string with,
+    //      for each level, the files next in line for compaction and the
+    //      inputs to their score: sampled reads, estimated overwrite ratio
+    //      and overlapping bytes in the next level. Only populated when
+    //      compaction_pri is kCostBenefit.
+    static const std::string kCompactionFileScores;
+
     //  "rocksdb.block-cache-entry-stats" - returns a multi-line string or
     //      map with statistics on block cache usage. See
     //      `BlockCacheEntryStatsMapKeys` for structured representation of keys
@@ -1586,6 +1593,13 @@ class DB {
     //  "rocksdb.is-write-stopped" - Return 1 if write has been stopped.
     static const std::string kIsWriteStopped;
 
+    //  "rocksdb.write-controller-state" - returns a multi-line string with
+    //      the state of the write rate feedback controller (see
+    //      DBOptions::write_rate_feedback_control): write pressure, PID
+    //      terms, estimated compaction throughput and the resulting delayed
+    //      write rate.
+    static const std::string kWriteControllerState;
+
     //  "rocksdb.estimate-oldest-key-time" - returns an estimation of
     //      oldest key timestamp in the DB. Currently only available for
     //      FIFO compaction with
@@ -1607,6 +1621,12 @@ class DB {
     //      of options.statistics
     static const std::string kOptionsStatistics;
 
+    // "rocksdb.perf-context-samples" - returns a multi-line string with
+    //      per-operation-type histograms of the PerfContext and
+    //      IOStatsContext metrics of operations sampled according to
+    //      DBOptions::perf_context_sample_rate.
+    static const std::string kPerfContextSamples;
+
     // "rocksdb.num-blob-files" - returns number of blob files in the current
     //      version.
     static const std::string kNumBlobFiles;
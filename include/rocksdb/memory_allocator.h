@@ -84,4 +84,60 @@ Status NewJemallocNodumpAllocator(
     const JemallocAllocatorOptions& options,
     std::shared_ptr<MemoryAllocator>* memory_allocator);
 
+struct HugePageSlabAllocatorOptions {
+  static const char* kName() { return "HugePageSlabAllocatorOptions"; }
+  // Upper bound on the memory carved into slabs. This much virtual address
+  // space is reserved up front, but only the slabs in use are backed by
+  // memory. Allocations that do not fit in the reserved space fall back to
+  // malloc.
+  size_t capacity = size_t{1} << 30;
+
+  // Size of a slab, the unit in which memory is committed and recycled
+  // across size classes. Must be a power of two and a multiple of
+  // `huge_page_size` when that is set.
+  size_t slab_size = size_t{2} << 20;
+
+  // If non-zero, slabs are mapped with explicit huge pages of this size
+  // (2MB or 1GB on x86-64, see /sys/kernel/mm/hugepages), falling back to
+  // regular pages when the huge page pool is exhausted. If zero, slabs are
+  // advised to use transparent huge pages (MADV_HUGEPAGE).
+  size_t huge_page_size = 0;
+
+  // Allocations larger than this bypass the slabs and use malloc. The value
+  // must not exceed `slab_size`. The default covers typical data block sizes.
+  size_t max_allocation_size = 256 << 10;
+
+  // Number of independently locked sets of partially used slabs, across
+  // which threads spread allocation requests. The value must be positive.
+  size_t num_shards = 8;
+
+  // Whether to mlock() slabs so that they are never swapped out. Failure to
+  // lock a slab (e.g. due to RLIMIT_MEMLOCK) is not an error.
+  bool mlock = false;
+
+  // Whether to exclude slabs from core dumps with MADV_DONTDUMP.
+  bool exclude_from_core_dump = true;
+};
+
+// EXPERIMENTAL
+//
+// Generate a memory allocator that carves allocations out of slabs backed by
+// huge pages, to reduce TLB misses with very large block caches. It can be
+// used as the memory_allocator of a block cache (e.g. HyperClockCache) or of
+// a CompressedSecondaryCache.
+//
+// Each allocation is rounded up to one of four size classes per power of two
+// (e.g. 4KB, 5KB, 6KB, 7KB, 8KB, ...), and served from a slab dedicated to its
+// size class. A slab whose allocations are all freed returns to a common pool
+// from which it can be reused by any size class, which bounds fragmentation
+// when the mix of block sizes shifts. (Each shard keeps one empty slab per
+// size class to avoid churn.) Memory committed to slabs is retained
+// by the allocator until it is destroyed, and the allocator must outlive
+// all its allocations.
+//
+// Only supported on POSIX platforms.
+Status NewHugePageSlabAllocator(
+    const HugePageSlabAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator);
+
 }  // namespace ROCKSDB_NAMESPACE
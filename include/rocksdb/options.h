@@ -53,6 +53,7 @@ class Snapshot;
 class MemTableRepFactory;
 class RateLimiter;
 class ReadScopedBlockBufferProvider;
+class ScanPredicate;
 class Slice;
 class Statistics;
 class InternalKeyComparator;
@@ -1248,6 +1249,18 @@ struct DBOptions {
   // Default: 1MB
   size_t stats_history_buffer_size = 1024 * 1024;
 
+  // If not zero, 1 in every perf_context_sample_rate Get, MultiGet and Write
+  // calls on each thread is executed with PerfLevel raised to
+  // kEnableTimeExceptForMutex, and its PerfContext / IOStatsContext breakdown
+  // is aggregated into per-operation-type histograms, readable through the
+  // "rocksdb.perf-context-samples" property. The remaining calls only pay for
+  // a thread-local countdown. Sampled calls also add their timing metrics to
+  // the calling thread's own PerfContext.
+  // Default: 0 (disabled)
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  uint32_t perf_context_sample_rate = 0;
+
   // If set true, will hint the underlying file system that the file
   // access pattern is random, when a sst file is opened.
   // Default: true
@@ -1393,6 +1406,24 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   uint64_t delayed_write_rate = 0;
 
+  // If true, the delayed write rate is set by a closed-loop (PID) controller
+  // rather than stepped up and down as column families enter and leave the
+  // slowdown conditions. The controller tracks how close the column families
+  // are to level0_slowdown_writes_trigger and
+  // soft_pending_compaction_bytes_limit, starts pacing writes at half of
+  // either trigger, and steers the write rate around an estimate of the ingest
+  // rate that compaction can sustain, bounded by `delayed_write_rate`. This
+  // trades the abrupt multi-second stalls of the step function for a smooth,
+  // earlier slowdown. Stop conditions (level0_stop_writes_trigger,
+  // hard_pending_compaction_bytes_limit, max_write_buffer_number) still apply.
+  // The control state is reported by the "rocksdb.write-controller-state"
+  // property.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  bool write_rate_feedback_control = false;
+
   // By default, a single write thread queue is maintained. The thread gets
   // to the head of the queue becomes write batch group leader and responsible
   // for writing to WAL and memtable for the batch group.
@@ -1542,6 +1573,14 @@ struct DBOptions {
   // DEFAULT: true
   bool enforce_write_buffer_manager_during_recovery = true;
 
+  // If true, WAL recovery reads, checksums and decodes the records of each WAL
+  // file on a separate thread, ahead of the thread inserting them into the
+  // memtables. Records are still applied in order, and corruptions are
+  // handled as without this option under every WALRecoveryMode.
+  //
+  // DEFAULT: false
+  bool pipelined_wal_recovery = false;
+
   // By default RocksDB will flush all memtables on DB close if there are
   // unpersisted data (i.e. with WAL disabled) The flush can be skip to speedup
   // DB close. Unpersisted data WILL BE LOST.
@@ -2283,6 +2322,23 @@ struct ReadOptions {
   // comes at the expense of slightly higher CPU overhead.
   bool optimize_multiget_for_io = true;
 
+  // Experimental
+  //
+  // If true, MultiGet plans the data block reads of all of its keys, across
+  // column families and levels, before looking any of them up in the SST
+  // files. After the memtable lookups, it checks the filters and indexes of
+  // the SST files which may hold each key left, and submits the reads of the
+  // data blocks not in the block cache, coalesced per file, in one batch
+  // through an IODispatcher (as async reads if async_io is set). The lookups
+  // then find the blocks in the block cache, instead of reading them in one
+  // round of IO per file or level.
+  //
+  // The planning costs one more filter and index lookup per key and file, and
+  // may read blocks of lower levels for keys then found in upper levels, so
+  // it is meant for large MultiGets of keys mostly not in the block cache.
+  // No effect without a block cache, or if fill_cache is false.
+  bool plan_multiget_io = false;
+
   // *** END options relevant to point lookups (as well as scans) ***
   // *** BEGIN options only relevant to iterators or scans ***
 
@@ -2296,6 +2352,16 @@ struct ReadOptions {
   // of forward iteration on spinning disks.
   size_t readahead_size = 0;
 
+  // If non-zero, a forward-iterating iterator reads blob values (from
+  // column families with enable_blob_files) through a per-blob-file readahead
+  // buffer of this size. Flush and compaction write the blobs of consecutive
+  // keys next to each other, so this turns the one random read per key of a
+  // scan into a few large sequential reads. Blobs found in the blob cache are
+  // served from the cache as usual; backward iteration does not read ahead.
+  //
+  // Default: 0 (disabled)
+  size_t blob_readahead_size = 0;
+
   // A threshold for the number of keys that can be skipped before failing an
   // iterator seek as incomplete. The default value of 0 should be used to
   // never fail a request as incomplete, even on skipping too many keys.
@@ -2451,8 +2517,11 @@ struct ReadOptions {
   // application. See also IteratorBase::PrepareValue().
   //
   // Note: this option currently only applies to 1) large values stored in blob
-  // files using BlobDB and 2) multi-column-family iterators (CoalescingIterator
-  // and AttributeGroupIterator). Otherwise, it has no effect.
+  // files using BlobDB, 2) multi-column-family iterators (CoalescingIterator
+  // and AttributeGroupIterator) and 3) plain values of forward scans, which
+  // lets key-only scans skip reading the values that SST files store outside
+  // of their data blocks (BlockBasedTableOptions::embedded_blob_min_size).
+  // Otherwise, it has no effect.
   //
   // Default: false
   bool allow_unprepared_value = false;
@@ -2538,6 +2607,21 @@ struct ReadOptions {
   // preserve provider-backed block ownership.
   ReadScopedBlockBufferProvider* read_scoped_block_buffer_provider = nullptr;
 
+  // EXPERIMENTAL
+  //
+  // If non-nullptr, iterators skip the entries that do not match this
+  // predicate (see rocksdb/scan_predicate.h), saving the application from
+  // copying and discarding them. With
+  // BlockBasedTableOptions::data_block_value_stats, whole data blocks of
+  // bottommost data that cannot match are skipped without being read.
+  //
+  // Only applies to DB iterators, and is ignored when iter_start_ts is set.
+  // Not supported for iterators over a WriteBatchWithIndex or a transaction,
+  // which then have status NotSupported.
+  //
+  // Default: nullptr
+  const ScanPredicate* scan_predicate = nullptr;
+
   // *** END options only relevant to iterators or scans ***
 
   // *** BEGIN options for RocksDB internal use only ***
@@ -3055,6 +3139,13 @@ struct IngestExternalFileOptions {
   // multiple files at once.
   int file_opening_threads = 1;
 
+  // Maximum number of threads used to read, verify, copy or link, and
+  // checksum the files being ingested before commit, can speed up ingestion
+  // of many files at once. The files of all column families of one
+  // IngestExternalFiles() call share the largest of these thread counts.
+  // Assigning files to levels at commit remains single-threaded.
+  int file_preparing_threads = 1;
+
   bool operator==(const IngestExternalFileOptions& rhs) const = default;
 };
 
@@ -3144,6 +3235,14 @@ struct TraceOptions {
   // Default: false. This means write records in the trace may be in an order
   // different from the WAL's order.
   bool preserve_write_order = false;
+  // When true, each query trace record also carries an identifier of the
+  // client thread that issued it (8 extra bytes per record), so that
+  // ReplayOptions::preserve_client_threads can replay the trace with the
+  // original per-thread structure. With preserve_write_order, a write record
+  // carries the ID of the thread that led its write group.
+  //
+  // Default: false.
+  bool record_client_thread_id = false;
 };
 
 // ImportColumnFamilyOptions is used by ImportColumnFamily()
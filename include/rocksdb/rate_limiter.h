@@ -9,6 +9,11 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 #include "rocksdb/env.h"
 #include "rocksdb/statistics.h"
 #include "rocksdb/status.h"
@@ -169,4 +174,74 @@ RateLimiter* NewGenericRateLimiter(
     RateLimiter::Mode mode = RateLimiter::Mode::kWritesOnly,
     bool auto_tuned = false, int64_t single_burst_bytes = 0);
 
+// EXPERIMENTAL
+// Options for NewMultiTenantRateLimiter().
+struct MultiTenantRateLimiterOptions {
+  // Total rate shared by all tenants. Must be positive.
+  int64_t rate_bytes_per_sec = 0;
+
+  // Same as for NewGenericRateLimiter().
+  int64_t refill_period_us = 100 * 1000;
+
+  // Relative share of the rate each tenant gets while tenants compete for it.
+  // Tenants not listed here get `default_weight`. A weight of 0 is treated
+  // as 1.
+  std::unordered_map<std::string, uint32_t> tenant_weights;
+  uint32_t default_weight = 1;
+
+  // Target queueing latency for foreground (`Env::IO_USER`) requests. Queued
+  // foreground requests that have waited longer than this are granted ahead
+  // of the round robin order, and their bytes are charged to their tenant's
+  // share. 0 means foreground requests are only prioritized over the
+  // background requests of their own tenant.
+  uint64_t foreground_latency_slo_us = 0;
+
+  RateLimiter::Mode mode = RateLimiter::Mode::kWritesOnly;
+};
+
+// EXPERIMENTAL
+// A RateLimiter that shares the rate between tenants by deficit round robin
+// with per-tenant weights, so that a tenant issuing a lot of background I/O
+// (e.g. a large compaction) can't starve the I/O of other tenants.
+//
+// A request is attributed to the tenant tag set on the calling thread with
+// SetThreadIOTenant() if any, and otherwise to the column family the I/O is
+// done for (flushes, compactions, and `Get()`/`MultiGet()` with
+// `ReadOptions::rate_limiter_priority` set), or to the "" tenant when there
+// is no such column family. Within a tenant, foreground (`Env::IO_USER`)
+// requests are granted before background ones.
+class MultiTenantRateLimiter : public RateLimiter {
+ public:
+  struct TenantStats {
+    uint32_t weight = 0;
+    uint64_t requests = 0;
+    uint64_t bytes = 0;
+    uint64_t foreground_requests = 0;
+    uint64_t foreground_bytes = 0;
+    // Requests that had to wait for a refill
+    uint64_t delayed_requests = 0;
+    // Foreground requests that waited longer than foreground_latency_slo_us
+    uint64_t slo_violations = 0;
+    // Time requests spent queued, in microseconds
+    HistogramData foreground_wait_micros;
+    HistogramData background_wait_micros;
+  };
+
+  explicit MultiTenantRateLimiter(Mode mode) : RateLimiter(mode) {}
+
+  // Stats of every tenant that has issued a request, keyed by tenant.
+  virtual std::map<std::string, TenantStats> GetTenantStats() const = 0;
+
+  virtual void SetTenantWeight(const std::string& tenant, uint32_t weight) = 0;
+};
+
+MultiTenantRateLimiter* NewMultiTenantRateLimiter(
+    const MultiTenantRateLimiterOptions& options);
+
+// EXPERIMENTAL
+// Attributes the I/O subsequently issued by the calling thread to `tenant`
+// for MultiTenantRateLimiter, overriding the default attribution to a column
+// family. An empty `tenant` clears the tag.
+void SetThreadIOTenant(const std::string& tenant);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,77 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/wide_columns.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// EXPERIMENTAL
+//
+// A filter on the entries returned by an iterator, set through
+// ReadOptions::scan_predicate. Entries for which Matches() returns false are
+// skipped by the iterator as if they did not exist, after deletions, merges
+// and snapshot visibility have been applied, so that skipping an entry never
+// exposes an older version of its key.
+//
+// Implementations must be thread-safe, and must outlive the iterators using
+// them.
+class ScanPredicate {
+ public:
+  virtual ~ScanPredicate() {}
+
+  // The name of this predicate, for logging.
+  virtual const char* Name() const = 0;
+
+  // Returns whether the entry for `key` (without timestamp) with `columns`
+  // should be returned. A plain key-value has a single anonymous column (see
+  // kDefaultWideColumnName) holding its value.
+  virtual bool Matches(const Slice& key, const WideColumns& columns) const = 0;
+
+  // Returns false only if no plain value `v` (not a wide-column entity) with
+  //   smallest <= v.substr(0, prefix_len) <= largest
+  // can match, where `smallest` and `largest` are at most `prefix_len` bytes
+  // long. This lets block-based tables with
+  // BlockBasedTableOptions::data_block_value_stats skip whole data blocks
+  // without reading them. Returning true is always safe.
+  virtual bool MayMatchValuePrefixRange(const Slice& /*smallest*/,
+                                        const Slice& /*largest*/,
+                                        size_t /*prefix_len*/) const {
+    return true;
+  }
+};
+
+// Matches entries whose value (the anonymous column) is in [lower, upper) by
+// bytewise comparison. An empty `upper` means no upper bound. Entities
+// without an anonymous column do not match.
+std::unique_ptr<ScanPredicate> NewValueRangePredicate(const std::string& lower,
+                                                      const std::string& upper);
+
+// Matches entries whose value (the anonymous column) starts with any of
+// `prefixes`. Entities without an anonymous column do not match.
+std::unique_ptr<ScanPredicate> NewValuePrefixPredicate(
+    const std::vector<std::string>& prefixes);
+
+// Matches entries with a column named `column` whose value is `value`. With
+// `column` == kDefaultWideColumnName, this compares the value of plain
+// key-values.
+std::unique_ptr<ScanPredicate> NewWideColumnEqualsPredicate(
+    const std::string& column, const std::string& value);
+
+// Matches entries with a column named `column` whose value is in
+// [lower, upper) by bytewise comparison. An empty `upper` means no upper
+// bound.
+std::unique_ptr<ScanPredicate> NewWideColumnRangePredicate(
+    const std::string& column, const std::string& lower,
+    const std::string& upper);
+
+}  // namespace ROCKSDB_NAMESPACE
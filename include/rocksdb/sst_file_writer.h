@@ -46,6 +46,41 @@ struct SstFileWriterEmbeddedBlobOptions {
   CompressionOptions compression_options;
 };
 
+// Options for SstFileWriter::OpenPipelined().
+//
+// In pipelined mode, Put() and the other calls adding entries only check the
+// keys and copy the entries into chunks. A dedicated thread adds the chunks to
+// the table builder, which builds the data blocks, the index and the filter.
+// Meanwhile, filter_hash_threads hash the keys of the queued chunks for the
+// filter. With CompressionOptions::parallel_threads > 1, the table builder in
+// turn hands compression, checksums and writes over to its own worker
+// threads. The file contents are the same as with Open(),
+// except that CompressionOptions::auto_skip does not start from the state
+// left by files built earlier on the calling thread.
+//
+// This mode is EXPERIMENTAL. Errors from building the file surface at a later
+// call adding an entry, or at Finish(), and FileSize() lags behind the
+// entries added.
+struct SstFileWriterPipelineOptions {
+  // Entries are handed over to the building thread in chunks of about this
+  // many bytes.
+  size_t chunk_size = 1 << 20;
+
+  // Limit on the bytes of entries copied but not yet added to the table
+  // builder, rounded to whole chunks (at least 3). Calls adding entries wait
+  // while it is reached.
+  size_t max_buffered_bytes = 8 << 20;
+
+  // Number of threads hashing the keys of the queued chunks for the filter,
+  // ahead of the thread adding them to the table builder. Only used with
+  // filters built from key hashes, i.e. the built-in Bloom filters of
+  // format_version >= 5 and the Ribbon filters, when not partitioned. The
+  // hashes take up to 24 bytes per queued entry on top of
+  // max_buffered_bytes. With 0, the keys are hashed when added to the
+  // builder.
+  uint32_t filter_hash_threads = 1;
+};
+
 // ExternalSstFileInfo include information about sst files created
 // using SstFileWriter.
 struct ExternalSstFileInfo {
@@ -148,6 +183,13 @@ class SstFileWriter {
       const SstFileWriterEmbeddedBlobOptions& embedded_blob_options,
       Temperature temp = Temperature::kUnknown);
 
+  // EXPERIMENTAL: like Open(), but builds the file on a dedicated thread, so
+  // that the calling thread can generate the next entries meanwhile. See
+  // SstFileWriterPipelineOptions.
+  Status OpenPipelined(const std::string& file_path,
+                       const SstFileWriterPipelineOptions& pipeline_options,
+                       Temperature temp = Temperature::kUnknown);
+
   // Add a Put key with value to currently opened file
   // REQUIRES: user_key is after any previously added point (Put/Merge/Delete)
   //           key according to the comparator.
@@ -677,6 +677,23 @@ enum Tickers : uint32_t {
   // logical value size minus the bytes actually read.
   BLOB_DB_LAZY_PARTIAL_BYTES_SAVED,
 
+  // Number of operations sampled with a detailed PerfContext breakdown (see
+  // DBOptions::perf_context_sample_rate).
+  PERF_CONTEXT_SAMPLES,
+
+  // AdvancedColumnFamilyOptions::user_key_row_cache lookups that found a
+  // valid entry, including "not found" entries, and that did not.
+  USER_KEY_ROW_CACHE_HIT,
+  USER_KEY_ROW_CACHE_MISS,
+  // Hits on cached "not found" results, a subset of USER_KEY_ROW_CACHE_HIT.
+  USER_KEY_ROW_CACHE_NEGATIVE_HIT,
+
+  // Entries skipped by iterators because they did not match
+  // ReadOptions::scan_predicate, and data blocks skipped without being read
+  // because none of their entries could match it.
+  SCAN_PREDICATE_ENTRIES_SKIPPED,
+  SCAN_PREDICATE_DATA_BLOCKS_SKIPPED,
+
   TICKER_ENUM_MAX
 };
 
@@ -865,6 +882,10 @@ enum Histograms : uint32_t {
   // Time spent opening the secondary DB inside DB::OpenAndCompact().
   OPEN_AND_COMPACT_DB_OPEN_MICROS,
 
+  // Time to promote a hit in CompressedSecondaryCache, from finding the value
+  // to creating the object for the primary cache (decompression included).
+  COMPRESSED_SECONDARY_CACHE_PROMOTION_MICROS,
+
   HISTOGRAM_ENUM_MAX
 };
 
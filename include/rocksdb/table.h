@@ -775,6 +775,36 @@ struct BlockBasedTableOptions {
   // Default: false
   bool separate_key_value_in_data_block = false;
 
+  // When non-zero, table files written by flush and compaction store each
+  // value of at least this many bytes (each wide-column value is considered
+  // independently) outside of the data blocks, as a record in the same file
+  // referenced by offset, like SstFileWriter::OpenWithEmbeddedBlobs() does.
+  // This keeps data blocks compact for values that are too small for blob
+  // files, so that Seek(), lookups that miss and scans over overwritten or
+  // deleted keys read less: such a value is only read when Get() or an
+  // iterator returns its entry. Forward iteration coalesces the reads of
+  // consecutive values by reading ahead max_auto_readahead_size bytes, or
+  // ReadOptions::readahead_size if set. Values read this way are cached in
+  // the blob cache if one is configured.
+  //
+  // Requires format_version >= 7 and is incompatible with block_align.
+  //
+  // Default: 0 (disabled)
+  uint64_t embedded_blob_min_size = 0;
+
+  // EXPERIMENTAL
+  //
+  // If true, table files record, for each data block holding only plain
+  // values with sequence number zero (as typically found in the bottommost
+  // level), the smallest and largest of the first 16 bytes of its values.
+  // Iterators with a ReadOptions::scan_predicate use them to skip data blocks
+  // that the predicate cannot match without reading them. Has no effect with
+  // user-defined timestamps, or on reads when the column family has a merge
+  // operator. Disables parallel compression.
+  //
+  // Default: false
+  bool data_block_value_stats = false;
+
   // Coefficient of variation (CV) threshold used to determine if keys in an
   // index block are uniformly distributed. Lower CV means more "uniform", and
   // the more likely interpolation search will outperform binary search.
@@ -824,6 +854,22 @@ struct BlockBasedTableOptions {
   OptimizeKeyCommonPrefix optimize_key_common_prefix =
       OptimizeKeyCommonPrefix::kIfFastSeek;
 
+  // EXPERIMENTAL. With a partitioned index (kTwoLevelIndexSearch) and the
+  // common user-key prefix optimization above in effect for index blocks,
+  // each index partition stores the common prefix of its keys once. For keys
+  // carrying long shared prefixes (e.g. tenant or table ids), a partition
+  // spanning two such prefixes only gets to strip the part they share. When
+  // this is set and the column family has a prefix_extractor, an index
+  // partition at least half of metadata_block_size in size is cut where the
+  // prefix of the data block keys changes, and the index entry of the last
+  // data block of a prefix keeps that block's last key instead of a shortened
+  // separator, so that each partition strips its whole prefix where possible.
+  // This saves index space and memory in proportion to the prefix length, at
+  // the cost of some more, smaller partitions. Coupled filter partitions
+  // (partition_filters without decouple_partitioned_filters) are cut along.
+  // No effect otherwise, and no change to the format.
+  bool align_index_partitions_to_prefix = false;
+
   // Store index blocks on disk in compressed format. Changing this option to
   // false  will avoid the overhead of decompression if index blocks are evicted
   // and read back
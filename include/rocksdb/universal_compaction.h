@@ -111,6 +111,22 @@ class CompactionOptionsUniversal {
   // Default: false
   bool incremental;
 
+  // EXPERIMENTAL
+  // If true, size amplification is reduced one key range partition at a time
+  // instead of by compacting all sorted runs into the last one. The key space
+  // is split into partitions of about max_compaction_bytes / 2 of last level
+  // data, cut only at boundaries allowed by the configured
+  // sst_partitioner_factory (if any), and each size amp compaction merges the
+  // overlapping data of the non-L0 sorted runs into the partition with the
+  // most newer data relative to its size. Partitions that do not overlap can
+  // be compacted concurrently, and the temporary space needed by a size amp
+  // compaction is bounded by the partition size rather than the whole DB.
+  // When the newer data is all in L0, it is first compacted into the level
+  // above the last level. Falls back to a full size amp compaction when there
+  // is no such level.
+  // Default: false
+  bool partitioned_size_amp_compaction;
+
   // If true, auto universal compaction picking will adjust to minimize locking
   // of input files when bottom priority compactions are waiting to run. This
   // can increase the likelihood of existing L0s being selected for compaction,
@@ -140,6 +156,7 @@ class CompactionOptionsUniversal {
         stop_style(kCompactionStopStyleTotalSize),
         allow_trivial_move(false),
         incremental(false),
+        partitioned_size_amp_compaction(false),
         reduce_file_locking(true) {}
 
   bool operator==(const CompactionOptionsUniversal& rhs) const = default;
@@ -322,6 +322,25 @@ struct CreateBackupOptions : public CreateCheckpointOrBackupOptions {
   bool atomic_flush = false;
 };
 
+// Snapshot of restore progress passed to RestoreOptions::progress_callback.
+struct RestoreProgress {
+  // Total bytes and files that need to be copied by this restore (files
+  // retained in place by an incremental restore mode are not counted).
+  uint64_t total_bytes = 0;
+  uint64_t total_files = 0;
+  // Bytes copied so far. Reported at callback_trigger_interval_size
+  // granularity, so it may lag the true value until the restore completes.
+  uint64_t restored_bytes = 0;
+  // Files (all chunks included) that are fully copied and verified.
+  uint64_t restored_files = 0;
+  uint64_t elapsed_micros = 0;
+  // Average throughput since the restore started, in bytes per second.
+  uint64_t bytes_per_second = 0;
+  // Estimated time to completion based on the average throughput, or 0 if it
+  // cannot be estimated yet.
+  uint64_t eta_micros = 0;
+};
+
 struct RestoreOptions {
   // Enum reflecting tiered approach to restores.
   //
@@ -371,6 +390,24 @@ struct RestoreOptions {
   // Specifies the level of incremental restore. 'kPurgeAllFiles' by default.
   Mode mode;
 
+  // If non-zero, files larger than this many bytes are split into chunks of
+  // this size that are copied and checksummed concurrently by the background
+  // threads (see max_background_operations). The per-chunk checksums are
+  // combined and verified against the backup metadata once all chunks of a
+  // file complete. Requires the DB FileSystem to support NewRandomRWFile;
+  // otherwise files are copied whole. Regardless of this setting, files are
+  // scheduled largest first so that the longest copies start earliest.
+  // Default: 0 (copy each file as a whole)
+  uint64_t parallel_copy_chunk_size = 0;
+
+  // Callback for reporting restore progress, invoked about every
+  // callback_trigger_interval_size bytes copied and once when all files have
+  // been copied. Calls are serialized but may come from background threads.
+  //
+  // An exception thrown from the callback will result in Status::Aborted from
+  // the operation.
+  std::function<void(const RestoreProgress&)> progress_callback = {};
+
   // FIXME(https://github.com/facebook/rocksdb/issues/13293)
   explicit RestoreOptions(bool _keep_log_files = false,
                           Mode _mode = Mode::kPurgeAllFiles)
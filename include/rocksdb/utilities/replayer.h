@@ -6,10 +6,13 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <memory>
 
 #include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/statistics.h"
 #include "rocksdb/status.h"
+#include "rocksdb/trace_record.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -28,12 +31,43 @@ struct ReplayOptions {
   //   If > 1, speed up the replay by this amount.
   double fast_forward;
 
+  // If true, replay with the client thread structure of the trace: every
+  // client thread recorded in the trace (see
+  // TraceOptions::record_client_thread_id) gets a dedicated replay thread that
+  // issues that client's operations in their original order, each no earlier
+  // than its original (fast_forward scaled) time. As in production, an
+  // operation waits for the previous operation of the same client to finish,
+  // so a slower configuration shows up as queueing delay rather than being
+  // hidden by an unbounded thread pool. Records without a client thread ID are
+  // replayed as if issued by a single client. num_threads is ignored.
+  bool preserve_client_threads = false;
+
   ReplayOptions() : num_threads(1), fast_forward(1.0) {}
 
   ReplayOptions(uint32_t num_of_threads, double fast_forward_ratio)
       : num_threads(num_of_threads), fast_forward(fast_forward_ratio) {}
 };
 
+// Summary of the most recent Replayer::Replay() call.
+struct ReplayReport {
+  // SystemClock::NowMicros() when the replay started and finished. A trace
+  // record with timestamp `ts` was scheduled to start at
+  //   start_micros + (ts - Replayer::GetHeaderTimestamp()) / fast_forward
+  // IO traces and block cache traces recorded during the replay use the same
+  // clock, so their timelines can be aligned with the replayed operations.
+  uint64_t start_micros = 0;
+  uint64_t end_micros = 0;
+
+  // Execution latency, in microseconds, of the replayed operations by trace
+  // type (kTraceGet, kTraceWrite, kTraceMultiGet, ...).
+  std::map<TraceType, HistogramData> latency_micros;
+
+  // How late, in microseconds, operations started relative to their scheduled
+  // time. A growing lag means the DB (or the replay host) cannot sustain the
+  // traced load at the requested speed.
+  HistogramData schedule_lag_micros;
+};
+
 // Replayer helps to replay the captured RocksDB query level operations.
 // The Replayer can either be created from DB::NewReplayer method, or be
 // instantiated via db_bench today, on using "replay" benchmark.
@@ -80,6 +114,11 @@ class Replayer {
       const ReplayOptions& options,
       const std::function<void(Status, std::unique_ptr<TraceRecordResult>&&)>&
           result_callback) = 0;
+
+  // Return the latency and scheduling summary of the most recent Replay().
+  virtual Status GetReplayReport(ReplayReport* /*report*/) const {
+    return Status::NotSupported("GetReplayReport");
+  }
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -36,6 +36,12 @@ struct SortedRunBuilderOptions {
   // your binary.
   CompressionType compression = kNoCompression;
 
+  // Threads building each output SST file, for compressing and writing data
+  // blocks in parallel with building the next ones (see
+  // CompressionOptions::parallel_threads).
+  // Default: 1 (no parallel building).
+  uint32_t compression_parallel_threads = 1;
+
   // Max number of background compaction threads.
   // Higher = faster sort for large datasets.
   int max_compaction_threads = 4;
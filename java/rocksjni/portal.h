@@ -4760,6 +4760,8 @@ class CompactionPriorityJni {
         return 0x3;
       case ROCKSDB_NAMESPACE::CompactionPri::kRoundRobin:
         return 0x4;
+      case ROCKSDB_NAMESPACE::CompactionPri::kCostBenefit:
+        return 0x5;
       default:
         return 0x0;  // undefined
     }
@@ -4780,6 +4782,8 @@ class CompactionPriorityJni {
         return ROCKSDB_NAMESPACE::CompactionPri::kMinOverlappingRatio;
       case 0x4:
         return ROCKSDB_NAMESPACE::CompactionPri::kRoundRobin;
+      case 0x5:
+        return ROCKSDB_NAMESPACE::CompactionPri::kCostBenefit;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::CompactionPri::kByCompensatedSize;
@@ -6098,6 +6102,9 @@ class HistogramTypeJni {
       case ROCKSDB_NAMESPACE::Histograms::
           IO_DISPATCHER_ASYNC_READ_PREFETCH_LEAD_MICROS:
         return 0x4E;
+      case ROCKSDB_NAMESPACE::Histograms::
+          COMPRESSED_SECONDARY_CACHE_PROMOTION_MICROS:
+        return 0x4F;
       case ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX:
         // 0x3E is reserved for backwards compatibility on current minor
         // version.
@@ -6280,6 +6287,9 @@ class HistogramTypeJni {
       case 0x4E:
         return ROCKSDB_NAMESPACE::Histograms::
             IO_DISPATCHER_ASYNC_READ_PREFETCH_LEAD_MICROS;
+      case 0x4F:
+        return ROCKSDB_NAMESPACE::Histograms::
+            COMPRESSED_SECONDARY_CACHE_PROMOTION_MICROS;
       case 0x3E:
         // 0x3E is reserved for backwards compatibility on current minor
         // version.
@@ -41,7 +41,14 @@ public enum CompactionPriority {
    * level. The file picking process will cycle through all the files in a
    * round-robin manner.
    */
-  RoundRobin((byte)0x4);
+  RoundRobin((byte)0x4),
+
+  /**
+   * First compact files with the highest expected reduction in read cost and
+   * space amplification per byte written, based on sampled per-file reads
+   * and overwrite ratios.
+   */
+  CostBenefit((byte)0x5);
 
 
   private final byte value;
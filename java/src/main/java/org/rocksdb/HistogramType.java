@@ -291,6 +291,11 @@ public enum HistogramType {
    */
   IO_DISPATCHER_ASYNC_READ_PREFETCH_LEAD_MICROS((byte) 0x4E),
 
+  /**
+   * Time to promote a hit in the compressed secondary cache.
+   */
+  COMPRESSED_SECONDARY_CACHE_PROMOTION_MICROS((byte) 0x4F),
+
   // 0x3E is reserved for backwards compatibility on current minor version.
   HISTOGRAM_ENUM_MAX((byte) 0x3E);
 
@@ -0,0 +1,416 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "memory/huge_page_slab_allocator.h"
+
+#include <cstdlib>
+
+#include "rocksdb/convenience.h"
+#include "rocksdb/utilities/options_type.h"
+#include "util/math.h"
+#include "util/mutexlock.h"
+#include "util/random.h"
+
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+#include <sys/mman.h>
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+
+namespace ROCKSDB_NAMESPACE {
+
+static std::unordered_map<std::string, OptionTypeInfo>
+    huge_page_slab_type_info = {
+        {"capacity",
+         {offsetof(struct HugePageSlabAllocatorOptions, capacity),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"slab_size",
+         {offsetof(struct HugePageSlabAllocatorOptions, slab_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"huge_page_size",
+         {offsetof(struct HugePageSlabAllocatorOptions, huge_page_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"max_allocation_size",
+         {offsetof(struct HugePageSlabAllocatorOptions, max_allocation_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"num_shards",
+         {offsetof(struct HugePageSlabAllocatorOptions, num_shards),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"mlock",
+         {offsetof(struct HugePageSlabAllocatorOptions, mlock),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"exclude_from_core_dump",
+         {offsetof(struct HugePageSlabAllocatorOptions,
+                   exclude_from_core_dump),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+};
+
+bool HugePageSlabAllocator::IsSupported(std::string* why) {
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+  (void)why;
+  return true;
+#else
+  *why = "HugePageSlabAllocator is only available on POSIX platforms";
+  return false;
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+}
+
+HugePageSlabAllocator::HugePageSlabAllocator(
+    const HugePageSlabAllocatorOptions& options)
+    : options_(options) {
+  RegisterOptions(&options_, &huge_page_slab_type_info);
+}
+
+HugePageSlabAllocator::~HugePageSlabAllocator() {
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+  if (reservation_ != nullptr) {
+    int ret __attribute__((__unused__)) =
+        munmap(reservation_, reservation_size_);
+    assert(ret == 0);
+  }
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+}
+
+Status HugePageSlabAllocator::PrepareOptions(
+    const ConfigOptions& config_options) {
+  std::string message;
+
+  if (!IsSupported(&message)) {
+    return Status::NotSupported(message);
+  } else if (options_.slab_size == 0 ||
+             (options_.slab_size & (options_.slab_size - 1)) != 0) {
+    return Status::InvalidArgument("slab_size must be a power of two");
+  } else if (options_.huge_page_size != 0 &&
+             ((options_.huge_page_size & (options_.huge_page_size - 1)) != 0 ||
+              options_.slab_size % options_.huge_page_size != 0)) {
+    return Status::InvalidArgument(
+        "huge_page_size must be a power of two dividing slab_size");
+  } else if (options_.max_allocation_size == 0 ||
+             options_.max_allocation_size > options_.slab_size / 2) {
+    return Status::InvalidArgument(
+        "max_allocation_size must be positive and at most half of slab_size");
+  } else if (options_.capacity < options_.slab_size ||
+             options_.capacity / options_.slab_size >= UINT32_MAX) {
+    return Status::InvalidArgument(
+        "capacity must hold between 1 and 2^32 - 2 slabs");
+  } else if (options_.num_shards < 1) {
+    return Status::InvalidArgument("num_shards must be a positive integer");
+  } else if (IsMutable()) {
+    Status s = MemoryAllocator::PrepareOptions(config_options);
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+    if (s.ok()) {
+      s = Initialize();
+    }
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+    return s;
+  } else {
+    // Already prepared
+    return Status::OK();
+  }
+}
+
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+Status HugePageSlabAllocator::Initialize() {
+  assert(!init_);
+  init_ = true;
+
+  // Four size classes per power of two from kMinChunkSize, the last one at
+  // least max_allocation_size. See GetSizeClass().
+  chunk_sizes_.push_back(kMinChunkSize);
+  for (size_t base = kMinChunkSize;
+       chunk_sizes_.back() < options_.max_allocation_size; base <<= 1) {
+    for (size_t j = 1; j <= 4; ++j) {
+      chunk_sizes_.push_back(base + j * (base >> 2));
+    }
+  }
+  for (size_t chunk_size : chunk_sizes_) {
+    chunks_per_slab_.push_back(
+        static_cast<uint32_t>(options_.slab_size / chunk_size));
+  }
+
+  shards_.reset(new Shard[options_.num_shards]);
+  for (size_t i = 0; i < options_.num_shards; ++i) {
+    shards_[i].heads.assign(chunk_sizes_.size(), kNoSlab);
+  }
+
+  num_slabs_ = static_cast<uint32_t>(options_.capacity / options_.slab_size);
+  slab_shift_ = FloorLog2(options_.slab_size);
+  slabs_.resize(num_slabs_);
+
+  // Reserve one extra slab to align the start. The reservation is not backed
+  // by memory until touched.
+  reservation_size_ =
+      (static_cast<size_t>(num_slabs_) + 1) * options_.slab_size;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif  // MAP_NORESERVE
+  void* addr =
+      mmap(nullptr, reservation_size_, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (addr == MAP_FAILED) {
+    return Status::Incomplete("Failed to reserve address space for " +
+                              std::to_string(num_slabs_) + " slabs");
+  }
+  reservation_ = addr;
+  const uintptr_t mask = options_.slab_size - 1;
+  base_ = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(addr) + mask) & ~mask);
+  return Status::OK();
+}
+
+uint32_t HugePageSlabAllocator::GetSizeClass(size_t size) const {
+  if (size > options_.max_allocation_size) {
+    return kNoSizeClass;
+  }
+  if (size <= kMinChunkSize) {
+    return 0;
+  }
+  // With 2^k < size <= 2^(k+1), the size classes of the range are
+  // 2^k + j * 2^(k-2) for j in [1, 4].
+  const int k = FloorLog2(size - 1);
+  const size_t base = size_t{1} << k;
+  const size_t step = base >> 2;
+  const size_t j = (size - base + step - 1) / step;
+  const uint32_t size_class = static_cast<uint32_t>(
+      1 + (k - FloorLog2(kMinChunkSize)) * 4 + (j - 1));
+  assert(size_class < chunk_sizes_.size());
+  assert(chunk_sizes_[size_class] >= size);
+  return size_class;
+}
+
+size_t HugePageSlabAllocator::GetChunkSize(size_t size) const {
+  const uint32_t size_class = GetSizeClass(size);
+  return size_class == kNoSizeClass ? 0 : chunk_sizes_[size_class];
+}
+
+uint32_t HugePageSlabAllocator::GetShardIndex() const {
+  if (options_.num_shards == 1) {
+    return 0;
+  }
+
+  static std::atomic<uint32_t> next_seed = 0;
+  thread_local Random tl_random(next_seed.fetch_add(1));
+  return tl_random.Uniform(static_cast<int>(options_.num_shards));
+}
+
+uint32_t HugePageSlabAllocator::SlabOf(const void* p) const {
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+  const uintptr_t base = reinterpret_cast<uintptr_t>(base_);
+  if (addr < base ||
+      addr - base >= static_cast<uintptr_t>(num_slabs_) * options_.slab_size) {
+    return kNoSlab;
+  }
+  return static_cast<uint32_t>((addr - base) >> slab_shift_);
+}
+
+void HugePageSlabAllocator::LinkSlab(Shard* shard, uint32_t slab_index) {
+  Slab& slab = slabs_[slab_index];
+  uint32_t& head = shard->heads[slab.size_class];
+  slab.prev = kNoSlab;
+  slab.next = head;
+  if (head != kNoSlab) {
+    slabs_[head].prev = slab_index;
+  }
+  head = slab_index;
+}
+
+void HugePageSlabAllocator::UnlinkSlab(Shard* shard, uint32_t slab_index) {
+  Slab& slab = slabs_[slab_index];
+  if (slab.prev != kNoSlab) {
+    slabs_[slab.prev].next = slab.next;
+  } else {
+    assert(shard->heads[slab.size_class] == slab_index);
+    shard->heads[slab.size_class] = slab.next;
+  }
+  if (slab.next != kNoSlab) {
+    slabs_[slab.next].prev = slab.prev;
+  }
+  slab.prev = kNoSlab;
+  slab.next = kNoSlab;
+}
+
+void HugePageSlabAllocator::CommitSlab(uint32_t slab_index) {
+  char* addr = SlabAddress(slab_index);
+  const size_t len = options_.slab_size;
+  bool huge_tlb = false;
+#ifdef MAP_HUGETLB
+  if (options_.huge_page_size > 0) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+    flags |= FloorLog2(options_.huge_page_size) << MAP_HUGE_SHIFT;
+#endif  // MAP_HUGE_SHIFT
+    // Replaces the reserved pages on success. A failure, typically because
+    // the huge page pool is exhausted, can still unmap the range, so map it
+    // again with regular pages.
+    huge_tlb =
+        mmap(addr, len, PROT_READ | PROT_WRITE, flags, -1, 0) != MAP_FAILED;
+    if (!huge_tlb) {
+      int regular_flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+#ifdef MAP_NORESERVE
+      regular_flags |= MAP_NORESERVE;
+#endif  // MAP_NORESERVE
+      void* p __attribute__((__unused__)) =
+          mmap(addr, len, PROT_READ | PROT_WRITE, regular_flags, -1, 0);
+      assert(p == addr);
+    }
+  }
+#endif  // MAP_HUGETLB
+  if (huge_tlb) {
+    num_huge_tlb_slabs_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+#ifdef MADV_HUGEPAGE
+    // Best effort, e.g. transparent huge pages may be disabled
+    (void)madvise(addr, len, MADV_HUGEPAGE);
+#endif  // MADV_HUGEPAGE
+  }
+#ifdef MADV_DONTDUMP
+  if (options_.exclude_from_core_dump) {
+    (void)madvise(addr, len, MADV_DONTDUMP);
+  }
+#endif  // MADV_DONTDUMP
+  if (options_.mlock) {
+    // Best effort, e.g. RLIMIT_MEMLOCK may be too low
+    (void)mlock(addr, len);
+  }
+}
+
+uint32_t HugePageSlabAllocator::AcquireSlab() {
+  uint32_t slab_index = kNoSlab;
+  bool commit = false;
+  {
+    MutexLock l(&pool_mutex_);
+    if (!pooled_slabs_.empty()) {
+      // Most recently pooled first, as it is most likely to be cached
+      slab_index = pooled_slabs_.back();
+      pooled_slabs_.pop_back();
+    } else if (num_committed_ < num_slabs_) {
+      slab_index = num_committed_++;
+      commit = true;
+    } else {
+      return kNoSlab;
+    }
+  }
+  if (commit) {
+    CommitSlab(slab_index);
+  }
+  num_slabs_in_use_.fetch_add(1, std::memory_order_relaxed);
+  return slab_index;
+}
+
+void HugePageSlabAllocator::ReleaseSlab(uint32_t slab_index) {
+  num_slabs_in_use_.fetch_sub(1, std::memory_order_relaxed);
+  MutexLock l(&pool_mutex_);
+  pooled_slabs_.push_back(slab_index);
+}
+
+size_t HugePageSlabAllocator::GetNumSlabsCommitted() const {
+  MutexLock l(&pool_mutex_);
+  return num_committed_;
+}
+
+void* HugePageSlabAllocator::Allocate(size_t size) {
+  const uint32_t size_class = GetSizeClass(size);
+  if (size_class == kNoSizeClass) {
+    return malloc(size);
+  }
+  const uint32_t shard_index = GetShardIndex();
+  Shard& shard = shards_[shard_index];
+  MutexLock l(&shard.mutex);
+  uint32_t slab_index = shard.heads[size_class];
+  if (slab_index == kNoSlab) {
+    slab_index = AcquireSlab();
+    if (slab_index == kNoSlab) {
+      // All of the capacity is in use
+      return malloc(size);
+    }
+    Slab& slab = slabs_[slab_index];
+    slab.size_class = size_class;
+    slab.shard = shard_index;
+    slab.num_used = 0;
+    slab.num_carved = 0;
+    slab.free_list = nullptr;
+    LinkSlab(&shard, slab_index);
+  }
+  Slab& slab = slabs_[slab_index];
+  void* p;
+  if (slab.free_list != nullptr) {
+    p = slab.free_list;
+    slab.free_list = *static_cast<void**>(p);
+  } else {
+    p = SlabAddress(slab_index) +
+        static_cast<size_t>(slab.num_carved) * chunk_sizes_[size_class];
+    ++slab.num_carved;
+  }
+  if (++slab.num_used == chunks_per_slab_[size_class]) {
+    UnlinkSlab(&shard, slab_index);
+  }
+  return p;
+}
+
+void HugePageSlabAllocator::Deallocate(void* p) {
+  const uint32_t slab_index = SlabOf(p);
+  if (slab_index == kNoSlab) {
+    free(p);
+    return;
+  }
+  // The slab cannot change owner while `p` is allocated from it
+  Slab& slab = slabs_[slab_index];
+  Shard& shard = shards_[slab.shard];
+  bool release = false;
+  {
+    MutexLock l(&shard.mutex);
+    assert(slab.num_used > 0);
+    const uint32_t size_class = slab.size_class;
+    if (slab.num_used == chunks_per_slab_[size_class]) {
+      // Was full
+      LinkSlab(&shard, slab_index);
+    }
+    *static_cast<void**>(p) = slab.free_list;
+    slab.free_list = p;
+    // Keep an empty slab if it is the only one with free chunks for its size
+    // class in the shard, so that a single allocation going back and forth
+    // does not acquire and release a slab each time.
+    if (--slab.num_used == 0 && (shard.heads[size_class] != slab_index ||
+                                 slab.next != kNoSlab)) {
+      UnlinkSlab(&shard, slab_index);
+      slab.size_class = kNoSizeClass;
+      release = true;
+    }
+  }
+  if (release) {
+    ReleaseSlab(slab_index);
+  }
+}
+
+size_t HugePageSlabAllocator::UsableSize(void* p,
+                                         size_t allocation_size) const {
+  const uint32_t slab_index = SlabOf(p);
+  if (slab_index == kNoSlab) {
+    return allocation_size;
+  }
+  return chunk_sizes_[slabs_[slab_index].size_class];
+}
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+
+Status NewHugePageSlabAllocator(
+    const HugePageSlabAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator) {
+  if (memory_allocator == nullptr) {
+    return Status::InvalidArgument("memory_allocator must be non-null.");
+  }
+  std::unique_ptr<MemoryAllocator> allocator(
+      new HugePageSlabAllocator(options));
+  Status s = allocator->PrepareOptions(ConfigOptions());
+  if (s.ok()) {
+    memory_allocator->reset(allocator.release());
+  }
+  return s;
+}
+}  // namespace ROCKSDB_NAMESPACE
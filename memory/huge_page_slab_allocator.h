@@ -0,0 +1,143 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/memory_allocator.h"
+#include "utilities/memory_allocators.h"
+
+#ifndef OS_WIN
+#define ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+#endif  // OS_WIN
+
+namespace ROCKSDB_NAMESPACE {
+
+// See NewHugePageSlabAllocator().
+//
+// The allocator reserves `capacity` bytes of address space aligned to
+// `slab_size`, so that the slab holding an allocation is found from its
+// address alone. Slabs are committed (mapped with huge pages, advised and
+// optionally locked) on first use, in address order.
+//
+// Each shard keeps, for each size class, a doubly linked list of its slabs
+// that have free chunks. A slab hands out chunks from its intrusive free list,
+// then from its not yet used tail. Deallocation locks the shard owning the
+// slab, so a chunk can be freed by any thread.
+class HugePageSlabAllocator : public BaseMemoryAllocator {
+ public:
+  explicit HugePageSlabAllocator(const HugePageSlabAllocatorOptions& options);
+  ~HugePageSlabAllocator() override;
+
+  static const char* kClassName() { return "HugePageSlabAllocator"; }
+  const char* Name() const override { return kClassName(); }
+  static bool IsSupported() {
+    std::string unused;
+    return IsSupported(&unused);
+  }
+  static bool IsSupported(std::string* why);
+  bool IsMutable() const { return !init_; }
+
+  Status PrepareOptions(const ConfigOptions& config_options) override;
+
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+  void* Allocate(size_t size) override;
+  void Deallocate(void* p) override;
+  size_t UsableSize(void* p, size_t allocation_size) const override;
+
+  // Returns the size of the chunks serving allocations of `size`, or 0 if such
+  // allocations bypass the slabs.
+  size_t GetChunkSize(size_t size) const;
+
+  // Returns the number of slabs currently assigned to a size class.
+  size_t GetNumSlabsInUse() const {
+    return num_slabs_in_use_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the number of slabs committed so far, in use or pooled.
+  size_t GetNumSlabsCommitted() const;
+
+  // Returns the number of committed slabs mapped with explicit huge pages.
+  size_t GetNumHugeTlbSlabs() const {
+    return num_huge_tlb_slabs_.load(std::memory_order_relaxed);
+  }
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+
+ private:
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+  static constexpr uint32_t kNoSlab = UINT32_MAX;
+  static constexpr uint32_t kNoSizeClass = UINT32_MAX;
+  static constexpr size_t kMinChunkSize = 64;
+
+  struct Slab {
+    // Size class of the chunks, or kNoSizeClass while pooled
+    uint32_t size_class = kNoSizeClass;
+    uint32_t shard = 0;
+    uint32_t num_used = 0;
+    // Chunks handed out from the tail at least once
+    uint32_t num_carved = 0;
+    void* free_list = nullptr;
+    // Links in the shard's list of slabs with free chunks of this size class
+    uint32_t prev = kNoSlab;
+    uint32_t next = kNoSlab;
+  };
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) Shard {
+    port::Mutex mutex;
+    // Head of the list of slabs with free chunks, per size class
+    std::vector<uint32_t> heads;
+  };
+
+  Status Initialize();
+  uint32_t GetSizeClass(size_t size) const;
+  uint32_t GetShardIndex() const;
+  char* SlabAddress(uint32_t slab) const {
+    return base_ + static_cast<size_t>(slab) * options_.slab_size;
+  }
+  // Returns kNoSlab if `p` is not in the reserved space
+  uint32_t SlabOf(const void* p) const;
+  // Returns a pooled or newly committed slab, or kNoSlab if all slabs are in
+  // use.
+  uint32_t AcquireSlab();
+  void ReleaseSlab(uint32_t slab);
+  void CommitSlab(uint32_t slab);
+  void LinkSlab(Shard* shard, uint32_t slab);
+  void UnlinkSlab(Shard* shard, uint32_t slab);
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+
+  HugePageSlabAllocatorOptions options_;
+
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+  // Chunk size and number of chunks per slab of each size class, ascending
+  std::vector<size_t> chunk_sizes_;
+  std::vector<uint32_t> chunks_per_slab_;
+  std::unique_ptr<Shard[]> shards_;
+  std::vector<Slab> slabs_;
+
+  // Reserved address space, and its slab aligned start
+  void* reservation_ = nullptr;
+  size_t reservation_size_ = 0;
+  char* base_ = nullptr;
+  uint32_t num_slabs_ = 0;
+  int slab_shift_ = 0;
+
+  // Protects pooled_slabs_ and num_committed_
+  mutable port::Mutex pool_mutex_;
+  std::vector<uint32_t> pooled_slabs_;
+  uint32_t num_committed_ = 0;
+
+  std::atomic<size_t> num_slabs_in_use_{0};
+  std::atomic<size_t> num_huge_tlb_slabs_{0};
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+
+  bool init_ = false;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -5,6 +5,7 @@
 
 #include "rocksdb/memory_allocator.h"
 
+#include "memory/huge_page_slab_allocator.h"
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
 #include "rocksdb/utilities/customizable_util.h"
@@ -46,6 +47,16 @@ static int RegisterBuiltinAllocators(ObjectLibrary& library,
         }
         return guard->get();
       });
+  library.AddFactory<MemoryAllocator>(
+      HugePageSlabAllocator::kClassName(),
+      [](const std::string& /*uri*/, std::unique_ptr<MemoryAllocator>* guard,
+         std::string* errmsg) {
+        if (HugePageSlabAllocator::IsSupported(errmsg)) {
+          HugePageSlabAllocatorOptions options;
+          guard->reset(new HugePageSlabAllocator(options));
+        }
+        return guard->get();
+      });
   library.AddFactory<MemoryAllocator>(
       MemkindKmemAllocator::kClassName(),
       [](const std::string& /*uri*/, std::unique_ptr<MemoryAllocator>* guard,
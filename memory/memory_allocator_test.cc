@@ -6,6 +6,7 @@
 
 #include <cstdio>
 
+#include "memory/huge_page_slab_allocator.h"
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
 #include "rocksdb/cache.h"
@@ -14,6 +15,7 @@
 #include "rocksdb/options.h"
 #include "table/block_based/block_based_table_factory.h"
 #include "test_util/testharness.h"
+#include "util/cast_util.h"
 #include "utilities/memory_allocators.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -209,6 +211,123 @@ TEST_F(CreateMemoryAllocatorTest, NewJemallocNodumpAllocator) {
   ASSERT_EQ(opts->limit_tcache_size, jopts.limit_tcache_size);
 }
 
+TEST_F(CreateMemoryAllocatorTest, NewHugePageSlabAllocator) {
+  HugePageSlabAllocatorOptions hopts;
+  std::shared_ptr<MemoryAllocator> allocator;
+
+  hopts.capacity = 4 << 20;
+  hopts.slab_size = 1 << 20;
+  hopts.max_allocation_size = 64 << 10;
+  hopts.num_shards = 1;
+
+  ASSERT_NOK(NewHugePageSlabAllocator(hopts, nullptr));
+  std::string msg;
+  if (!HugePageSlabAllocator::IsSupported(&msg)) {
+    ASSERT_NOK(NewHugePageSlabAllocator(hopts, &allocator));
+    ROCKSDB_GTEST_BYPASS("HugePageSlabAllocator not supported");
+    return;
+  }
+
+  // Invalid options
+  HugePageSlabAllocatorOptions bad = hopts;
+  bad.slab_size = 3 << 20;
+  ASSERT_NOK(NewHugePageSlabAllocator(bad, &allocator));
+  bad = hopts;
+  bad.huge_page_size = 2 << 20;
+  ASSERT_NOK(NewHugePageSlabAllocator(bad, &allocator));
+  bad = hopts;
+  bad.max_allocation_size = hopts.slab_size;
+  ASSERT_NOK(NewHugePageSlabAllocator(bad, &allocator));
+  bad = hopts;
+  bad.capacity = hopts.slab_size / 2;
+  ASSERT_NOK(NewHugePageSlabAllocator(bad, &allocator));
+  ASSERT_EQ(allocator, nullptr);
+
+  ASSERT_OK(NewHugePageSlabAllocator(hopts, &allocator));
+  ASSERT_NE(allocator, nullptr);
+  auto* slab_allocator =
+      static_cast_with_check<HugePageSlabAllocator>(allocator.get());
+
+  // Size classes
+  ASSERT_EQ(slab_allocator->GetChunkSize(1), 64U);
+  ASSERT_EQ(slab_allocator->GetChunkSize(65), 80U);
+  ASSERT_EQ(slab_allocator->GetChunkSize(4096), 4096U);
+  ASSERT_EQ(slab_allocator->GetChunkSize(4097), 5120U);
+  ASSERT_EQ(slab_allocator->GetChunkSize(64 << 10), size_t{64} << 10);
+  ASSERT_EQ(slab_allocator->GetChunkSize((64 << 10) + 1), 0U);
+  for (size_t size = 1; size <= (64 << 10); size += 37) {
+    size_t chunk_size = slab_allocator->GetChunkSize(size);
+    ASSERT_GE(chunk_size, size);
+    ASSERT_LE(chunk_size, std::max(size_t{64}, size + size / 4));
+  }
+
+  // Allocations of a size class share a slab until it is full
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 256; ++i) {
+    void* p = allocator->Allocate(4000);
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(allocator->UsableSize(p, 4000), 4096U);
+    memset(p, i, 4000);
+    ptrs.push_back(p);
+  }
+  ASSERT_EQ(slab_allocator->GetNumSlabsInUse(), 1U);
+  ptrs.push_back(allocator->Allocate(4000));
+  ASSERT_EQ(slab_allocator->GetNumSlabsInUse(), 2U);
+
+  // Another size class gets its own slab
+  void* other = allocator->Allocate(8000);
+  ASSERT_EQ(allocator->UsableSize(other, 8000), 8192U);
+  ASSERT_EQ(slab_allocator->GetNumSlabsInUse(), 3U);
+
+  // Too large allocations bypass the slabs
+  void* large = allocator->Allocate(100 << 10);
+  ASSERT_NE(large, nullptr);
+  ASSERT_EQ(allocator->UsableSize(large, 100 << 10), size_t{100} << 10);
+  allocator->Deallocate(large);
+
+  // Freed chunks are reused
+  void* freed = ptrs[10];
+  allocator->Deallocate(freed);
+  ptrs[10] = allocator->Allocate(4000);
+  ASSERT_EQ(ptrs[10], freed);
+
+  // Emptied slabs are recycled across size classes, except the last one with
+  // free chunks of the size class
+  for (void* p : ptrs) {
+    allocator->Deallocate(p);
+  }
+  ptrs.clear();
+  ASSERT_EQ(slab_allocator->GetNumSlabsInUse(), 2U);
+  ASSERT_EQ(slab_allocator->GetNumSlabsCommitted(), 3U);
+  void* recycled = allocator->Allocate(1000);
+  ASSERT_EQ(slab_allocator->GetNumSlabsInUse(), 3U);
+  ASSERT_EQ(slab_allocator->GetNumSlabsCommitted(), 3U);
+  allocator->Deallocate(recycled);
+  allocator->Deallocate(other);
+
+  // Beyond capacity, allocations fall back to malloc
+  for (int i = 0; i < 20; ++i) {
+    ptrs.push_back(allocator->Allocate(60 << 10));
+  }
+  ASSERT_EQ(slab_allocator->GetNumSlabsCommitted(), 4U);
+  ASSERT_EQ(allocator->UsableSize(ptrs.back(), 60 << 10), size_t{60} << 10);
+  for (void* p : ptrs) {
+    allocator->Deallocate(p);
+  }
+
+  // Configurable by string
+  ASSERT_OK(MemoryAllocator::CreateFromString(
+      config_options_,
+      std::string("id=") + HugePageSlabAllocator::kClassName() +
+          "; capacity=8388608; slab_size=2097152; num_shards=2; mlock=true",
+      &allocator));
+  auto opts = allocator->GetOptions<HugePageSlabAllocatorOptions>();
+  ASSERT_NE(opts, nullptr);
+  ASSERT_EQ(opts->capacity, size_t{8} << 20);
+  ASSERT_EQ(opts->num_shards, 2U);
+  ASSERT_TRUE(opts->mlock);
+}
+
 INSTANTIATE_TEST_CASE_P(DefaultMemoryAllocator, MemoryAllocatorTest,
                         ::testing::Values(std::make_tuple(
                             DefaultMemoryAllocator::kClassName(), true)));
@@ -219,6 +338,13 @@ INSTANTIATE_TEST_CASE_P(
                                       MemkindKmemAllocator::IsSupported())));
 #endif  // MEMKIND
 
+#ifdef ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+INSTANTIATE_TEST_CASE_P(
+    HugePageSlabAllocator, MemoryAllocatorTest,
+    ::testing::Values(std::make_tuple(HugePageSlabAllocator::kClassName(),
+                                      HugePageSlabAllocator::IsSupported())));
+#endif  // ROCKSDB_HUGE_PAGE_SLAB_ALLOCATOR
+
 #ifdef ROCKSDB_JEMALLOC
 INSTANTIATE_TEST_CASE_P(
     JemallocNodumpAllocator, MemoryAllocatorTest,
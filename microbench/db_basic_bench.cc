@@ -12,8 +12,13 @@
 #include "rocksdb/db.h"
 #include "rocksdb/filter_policy.h"
 #include "rocksdb/options.h"
+#include "rocksdb/sst_file_writer.h"
 #include "table/block_based/block.h"
+#include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/format.h"
+#include "table/multiget_context.h"
+#include "util/compression.h"
 #include "util/random.h"
 #include "utilities/merge_operators.h"
 
@@ -258,6 +263,63 @@ static void DBClose(benchmark::State& state) {
 BENCHMARK(DBClose)->Iterations(200);  // specify iteration number as the db size
                                       // is impacted by iteration number
 
+static void DBOpenWalRecovery(benchmark::State& state) {
+  auto pipelined_wal_recovery = static_cast<bool>(state.range(0));
+  auto wal_size = static_cast<uint64_t>(state.range(1));
+  auto value_size = static_cast<uint64_t>(state.range(2));
+
+  // create a DB whose data is only in the WAL
+  std::unique_ptr<DB> db;
+  Options options;
+  options.write_buffer_size = 2 * wal_size;
+  options.avoid_flush_during_shutdown = true;
+  SetupDB(state, options, &db, "DBOpenWalRecovery");
+
+  auto rnd = Random(301 + state.thread_index());
+  auto wo = WriteOptions();
+  Status s;
+  for (uint64_t written = 0; written < wal_size; written += value_size) {
+    s = db->Put(wo, rnd.RandomString(16), rnd.RandomString(value_size));
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+  }
+  std::string db_name = db->GetName();
+  s = db->Close();
+  if (!s.ok()) {
+    state.SkipWithError(s.ToString().c_str());
+  }
+
+  // read-only opens recover the WAL without consuming it
+  options.create_if_missing = false;
+  options.pipelined_wal_recovery = pipelined_wal_recovery;
+  for (auto _ : state) {
+    s = DB::OpenForReadOnly(options, db_name, &db);
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+    state.PauseTiming();
+    db.reset();
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(wal_size));
+  DestroyDB(db_name, options);
+}
+
+static void DBOpenWalRecoveryArguments(benchmark::internal::Benchmark* b) {
+  for (bool pipelined_wal_recovery : {false, true}) {
+    for (int64_t wal_size : {64 << 20, 256 << 20}) {
+      for (int64_t value_size : {100, 1024}) {
+        b->Args({pipelined_wal_recovery, wal_size, value_size});
+      }
+    }
+  }
+  b->ArgNames({"pipelined_wal_recovery", "wal_size", "value_size"});
+}
+
+BENCHMARK(DBOpenWalRecovery)->Iterations(5)->Apply(DBOpenWalRecoveryArguments);
+
 static void DBPut(benchmark::State& state) {
   auto compaction_style = static_cast<CompactionStyle>(state.range(0));
   uint64_t max_data = state.range(1);
@@ -434,6 +496,9 @@ static void ManualCompaction(benchmark::State& state) {
           static_cast<double>(get_perf_context()->block_read_cpu_time);
       state.counters["block_checksum_time"] =
           static_cast<double>(get_perf_context()->block_checksum_time);
+      state.counters["block_checksum_ns_per_block"] =
+          static_cast<double>(get_perf_context()->block_checksum_time) /
+          std::max(get_perf_context()->block_read_count, uint64_t{1});
       state.counters["new_table_block_iter_nanos"] =
           static_cast<double>(get_perf_context()->new_table_block_iter_nanos);
       state.counters["new_table_iterator_nanos"] =
@@ -1102,6 +1167,59 @@ static void DataBlockSeek(benchmark::State& state) {
 
 BENCHMARK(DataBlockSeek)->Iterations(1000000);
 
+// Checksums of a MultiGet batch of blocks, one after another or in one batch
+// TODO: move it to different files, as it's testing an internal API
+static void BlockChecksums(benchmark::State& state) {
+  auto checksum_type = static_cast<ChecksumType>(state.range(0));
+  auto block_size = static_cast<size_t>(state.range(1));
+  bool batched = state.range(2);
+  constexpr size_t kNumBlocks = MultiGetContext::MAX_BATCH_SIZE;
+
+  const size_t stride = block_size + BlockBasedTable::kBlockTrailerSize;
+  Random rnd(301);
+  std::string blocks =
+      rnd.RandomBinaryString(static_cast<int>(kNumBlocks * stride));
+  std::array<const char*, kNumBlocks> data;
+  std::array<size_t, kNumBlocks> sizes;
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    data[i] = blocks.data() + i * stride;
+    // With the compression type
+    sizes[i] = block_size + 1;
+  }
+
+  std::array<uint32_t, kNumBlocks> checksums;
+  for (auto _ : state) {
+    if (batched) {
+      ComputeBuiltinChecksums(checksum_type, data.data(), sizes.data(),
+                              kNumBlocks, checksums.data());
+    } else {
+      for (size_t i = 0; i < kNumBlocks; ++i) {
+        checksums[i] = ComputeBuiltinChecksum(checksum_type, data[i], sizes[i]);
+      }
+    }
+    benchmark::DoNotOptimize(checksums);
+  }
+  state.counters["time_per_block"] = benchmark::Counter(
+      static_cast<double>(kNumBlocks),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() *
+                                               kNumBlocks * block_size));
+}
+
+static void BlockChecksumsArguments(benchmark::internal::Benchmark* b) {
+  for (int checksum_type : {kCRC32c, kXXH3}) {
+    for (int64_t block_size : {512, 4096, 16384}) {
+      for (bool batched : {false, true}) {
+        b->Args({checksum_type, block_size, batched});
+      }
+    }
+  }
+  b->ArgNames({"checksum_type", "block_size", "batched"});
+}
+
+BENCHMARK(BlockChecksums)->Apply(BlockChecksumsArguments);
+
 static void IteratorSeek(benchmark::State& state) {
   auto compaction_style = static_cast<CompactionStyle>(state.range(0));
   uint64_t max_data = state.range(1);
@@ -1611,6 +1729,84 @@ BENCHMARK(RandomAccessFileReaderRead)
     ->Arg(1)
     ->ArgName("enable_statistics");
 
+// Writes one SST file of file_size_mb with SstFileWriter, with Open() or
+// OpenPipelined()
+static void SstFileWriterBuild(benchmark::State& state) {
+  const uint64_t file_size = static_cast<uint64_t>(state.range(0)) << 20;
+  const bool pipelined = state.range(1);
+  const auto parallel_threads = static_cast<uint32_t>(state.range(2));
+  const auto filter_hash_threads = static_cast<uint32_t>(state.range(3));
+  constexpr int kKeySize = 24;
+  constexpr int kValueSize = 100;
+  constexpr int kNumValues = 1024;
+
+  Options options;
+  options.compression = LZ4_Supported() ? kLZ4Compression : kNoCompression;
+  options.compression_opts.parallel_threads = parallel_threads;
+  BlockBasedTableOptions table_options;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  SstFileWriterPipelineOptions pipeline_options;
+  pipeline_options.filter_hash_threads = filter_hash_threads;
+
+  auto env = Env::Default();
+  std::string dir;
+  Status s = env->GetTestDirectory(&dir);
+  if (!s.ok()) {
+    state.SkipWithError(s.ToString().c_str());
+    return;
+  }
+  const std::string file_name = dir + kFilePathSeparator +
+                                "sst_file_writer_bench" +
+                                std::to_string(getpid());
+
+  Random rnd(301);
+  const std::string values = rnd.HumanReadableString(kValueSize * kNumValues);
+  const uint64_t num_entries = file_size / (kKeySize + kValueSize);
+  char key[kKeySize + 1];
+  for (auto _ : state) {
+    SstFileWriter writer(EnvOptions(), options);
+    s = pipelined ? writer.OpenPipelined(file_name, pipeline_options)
+                  : writer.Open(file_name);
+    for (uint64_t i = 0; s.ok() && i < num_entries; ++i) {
+      snprintf(key, sizeof(key), "%024" PRIu64, i);
+      s = writer.Put(
+          Slice(key, kKeySize),
+          Slice(values.data() + (i % kNumValues) * kValueSize, kValueSize));
+    }
+    if (s.ok()) {
+      s = writer.Finish();
+    }
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      break;
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(
+      state.iterations() * num_entries * (kKeySize + kValueSize)));
+  env->DeleteFile(file_name);  // ignore return, okay to fail cleanup
+}
+
+static void SstFileWriterBuildArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t file_size_mb : {256}) {
+    // Open(), without and with parallel compression
+    b->Args({file_size_mb, false, 1, 0});
+    b->Args({file_size_mb, false, 4, 0});
+    // OpenPipelined(), without and with filter hash threads
+    b->Args({file_size_mb, true, 4, 0});
+    b->Args({file_size_mb, true, 4, 1});
+    b->Args({file_size_mb, true, 4, 2});
+  }
+  b->ArgNames({"file_size_mb", "pipelined", "parallel_threads",
+               "filter_hash_threads"});
+}
+
+BENCHMARK(SstFileWriterBuild)
+    ->Apply(SstFileWriterBuildArguments)
+    ->Iterations(3)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
 }  // namespace ROCKSDB_NAMESPACE
 
 BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmark for the cost of recording into and reading from histograms,
+// both bare and through the per-core histograms of StatisticsImpl.
+#include "benchmark/benchmark.h"
+#include "monitoring/histogram.h"
+#include "rocksdb/statistics.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Pre-generated values spread over many orders of magnitude, like latencies
+// and sizes recorded by the DB.
+static std::vector<uint64_t> GenerateValues() {
+  Random64 rnd(301);
+  std::vector<uint64_t> values(1024);
+  for (auto& v : values) {
+    v = rnd.Next() >> (rnd.Next() % 64);
+  }
+  return values;
+}
+
+static void HistogramBucketIndex(benchmark::State& state) {
+  HistogramBucketMapper mapper;
+  auto values = GenerateValues();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        mapper.IndexForValue(values[i++ % values.size()]));
+  }
+}
+
+BENCHMARK(HistogramBucketIndex);
+
+static void HistogramStatAdd(benchmark::State& state) {
+  HistogramStat hist;
+  auto values = GenerateValues();
+  size_t i = 0;
+  for (auto _ : state) {
+    hist.Add(values[i++ % values.size()]);
+  }
+  benchmark::DoNotOptimize(hist.num());
+}
+
+BENCHMARK(HistogramStatAdd);
+
+static void StatisticsRecordInHistogram(benchmark::State& state) {
+  static std::shared_ptr<Statistics> stats;
+  if (state.thread_index() == 0) {
+    stats = CreateDBStatistics();
+  }
+  auto values = GenerateValues();
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    stats->recordInHistogram(DB_GET, values[i++ % values.size()]);
+  }
+  if (state.thread_index() == 0) {
+    HistogramData data;
+    stats->histogramData(DB_GET, &data);
+    state.counters["p99"] = data.percentile99;
+  }
+}
+
+BENCHMARK(StatisticsRecordInHistogram)->ThreadRange(1, 16)->UseRealTime();
+
+static void StatisticsHistogramData(benchmark::State& state) {
+  auto stats = CreateDBStatistics();
+  auto values = GenerateValues();
+  for (auto v : values) {
+    stats->recordInHistogram(DB_GET, v);
+  }
+  for (auto _ : state) {
+    HistogramData data;
+    stats->histogramData(DB_GET, &data);
+    benchmark::DoNotOptimize(data.percentile99);
+  }
+}
+
+BENCHMARK(StatisticsHistogramData);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
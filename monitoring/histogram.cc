@@ -17,6 +17,7 @@
 
 #include "port/port.h"
 #include "util/cast_util.h"
+#include "util/math.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -39,16 +40,29 @@ HistogramBucketMapper::HistogramBucketMapper() {
   }
   maxBucketValue_ = bucketValues_.back();
   minBucketValue_ = bucketValues_.front();
+  assert(bucketValues_.size() <= std::numeric_limits<uint8_t>::max());
+  for (size_t k = 0; k < firstIndexForLog2_.size(); ++k) {
+    size_t index = std::lower_bound(bucketValues_.begin(), bucketValues_.end(),
+                                    uint64_t{1} << k) -
+                   bucketValues_.begin();
+    firstIndexForLog2_[k] =
+        static_cast<uint8_t>(std::min(index, bucketValues_.size() - 1));
+  }
 }
 
 size_t HistogramBucketMapper::IndexForValue(const uint64_t value) const {
-  auto beg = bucketValues_.begin();
-  auto end = bucketValues_.end();
   if (value >= maxBucketValue_) {
-    return end - beg - 1;  // bucketValues_.size() - 1
-  } else {
-    return std::lower_bound(beg, end, value) - beg;
+    return bucketValues_.size() - 1;
+  } else if (value == 0) {
+    return 0;
+  }
+  // Equivalent to std::lower_bound over bucketValues_, starting from the
+  // first bucket that can hold a value of this magnitude.
+  size_t index = firstIndexForLog2_[FloorLog2(value)];
+  while (bucketValues_[index] < value) {
+    ++index;
   }
+  return index;
 }
 
 namespace {
@@ -261,6 +275,11 @@ void HistogramImpl::Merge(const HistogramImpl& other) {
   stats_.Merge(other.stats_);
 }
 
+void HistogramImpl::Merge(const HistogramStat& other) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.Merge(other);
+}
+
 double HistogramImpl::Median() const { return stats_.Median(); }
 
 double HistogramImpl::Percentile(double p) const {
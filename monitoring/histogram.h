@@ -8,6 +8,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #pragma once
+#include <array>
 #include <cassert>
 #include <map>
 #include <mutex>
@@ -22,7 +23,9 @@ class HistogramBucketMapper {
  public:
   HistogramBucketMapper();
 
-  // converts a value to the bucket index.
+  // converts a value to the bucket index. Runs in constant time: the bucket
+  // limits grow by 1.5x, so at most a couple of them fall between two powers
+  // of two.
   size_t IndexForValue(uint64_t value) const;
   // number of buckets required.
 
@@ -41,6 +44,9 @@ class HistogramBucketMapper {
   std::vector<uint64_t> bucketValues_;
   uint64_t maxBucketValue_;
   uint64_t minBucketValue_;
+  // firstIndexForLog2_[k] is the index of the first bucket whose limit is
+  // >= 2^k, i.e. the lowest bucket a value with FloorLog2 == k can map to.
+  std::array<uint8_t, 64> firstIndexForLog2_;
 };
 
 struct HistogramStat {
@@ -119,6 +125,9 @@ class HistogramImpl : public Histogram {
   void Add(uint64_t value) override;
   void Merge(const Histogram& other) override;
   void Merge(const HistogramImpl& other);
+  // Merges a bare HistogramStat, e.g. one of the per-core histograms of
+  // StatisticsImpl.
+  void Merge(const HistogramStat& other);
 
   std::string ToString() const override;
   const char* Name() const override { return "HistogramImpl"; }
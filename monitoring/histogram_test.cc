@@ -5,9 +5,11 @@
 //
 #include "monitoring/histogram.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "monitoring/histogram_windowing.h"
+#include "port/port.h"
 #include "rocksdb/system_clock.h"
 #include "test_util/mock_time_env.h"
 #include "test_util/testharness.h"
@@ -245,6 +247,98 @@ TEST_F(HistogramTest, LostUpdateStandardDeviation) {
   ASSERT_GE(histogram.StandardDeviation(), 0.0);
 }
 
+TEST_F(HistogramTest, BucketIndexMatchesBinarySearch) {
+  auto reference_index = [](uint64_t value) -> size_t {
+    for (size_t b = 0; b < bucketMapper.BucketCount(); ++b) {
+      if (bucketMapper.BucketLimit(b) >= value) {
+        return b;
+      }
+    }
+    return bucketMapper.BucketCount() - 1;
+  };
+  std::vector<uint64_t> values = {0, std::numeric_limits<uint64_t>::max()};
+  for (size_t b = 0; b < bucketMapper.BucketCount(); ++b) {
+    uint64_t limit = bucketMapper.BucketLimit(b);
+    values.push_back(limit - 1);
+    values.push_back(limit);
+    values.push_back(limit + 1);
+  }
+  for (int k = 0; k < 64; ++k) {
+    uint64_t pow2 = uint64_t{1} << k;
+    values.push_back(pow2 - 1);
+    values.push_back(pow2);
+    values.push_back(pow2 + 1);
+  }
+  Random64 rnd(test::RandomSeed());
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(rnd.Next() >> rnd.Uniform(64));
+  }
+  for (uint64_t value : values) {
+    ASSERT_EQ(bucketMapper.IndexForValue(value), reference_index(value))
+        << value;
+  }
+}
+
+TEST_F(HistogramTest, PerCoreStatisticsAccuracy) {
+  // Values recorded from several threads land in different per-core
+  // histograms; the merged result must match an exact computation over the
+  // same values to within the width of a bucket.
+  auto stats = CreateDBStatistics();
+  constexpr int kNumThreads = 4;
+  constexpr int kValuesPerThread = 20000;
+  std::vector<std::vector<uint64_t>> values(kNumThreads);
+  Random64 rnd(test::RandomSeed());
+  for (auto& thread_values : values) {
+    for (int i = 0; i < kValuesPerThread; ++i) {
+      // Log-uniform over [1, 2^30)
+      thread_values.push_back((rnd.Next() >> (34 + rnd.Uniform(30))) + 1);
+    }
+  }
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (uint64_t v : values[t]) {
+        stats->recordInHistogram(DB_GET, v);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<uint64_t> all;
+  uint64_t sum = 0;
+  for (auto& thread_values : values) {
+    for (uint64_t v : thread_values) {
+      all.push_back(v);
+      sum += v;
+    }
+  }
+  std::sort(all.begin(), all.end());
+
+  HistogramData data;
+  stats->histogramData(DB_GET, &data);
+  // Per-core updates are not atomic read-modify-writes, so a thread being
+  // preempted mid-update can rarely lose one; allow for a tiny shortfall.
+  ASSERT_LE(data.count, all.size());
+  ASSERT_GE(data.count, all.size() * 999 / 1000);
+  ASSERT_LE(data.sum, sum);
+  ASSERT_GE(data.sum, sum * 0.99);
+  ASSERT_EQ(data.min, all.front());
+  ASSERT_EQ(data.max, all.back());
+
+  // Adjacent bucket limits are at most ~1.5x apart
+  auto check_percentile = [&](double reported, double p) {
+    double exact = static_cast<double>(
+        all[std::min(all.size() - 1, static_cast<size_t>(all.size() * p))]);
+    ASSERT_GE(reported, exact / 1.6) << p;
+    ASSERT_LE(reported, exact * 1.6) << p;
+  };
+  check_percentile(data.median, 0.5);
+  check_percentile(data.percentile95, 0.95);
+  check_percentile(data.percentile99, 0.99);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -0,0 +1,239 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "monitoring/perf_context_sampler.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "monitoring/iostats_context_imp.h"
+#include "monitoring/perf_context_imp.h"
+#include "monitoring/statistics_impl.h"
+#include "test_util/sync_point.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+const char* SampledOpTypeName(SampledOpType op) {
+  switch (op) {
+    case SampledOpType::kGet:
+      return "Get";
+    case SampledOpType::kMultiGet:
+      return "MultiGet";
+    case SampledOpType::kWrite:
+      return "Write";
+    case SampledOpType::kNumOpTypes:
+      break;
+  }
+  assert(false);
+  return "Unknown";
+}
+
+const char* PerfContextSampler::MetricName(Metric metric) {
+  switch (metric) {
+    case kTotalNanos:
+      return "total_nanos";
+#define PERF_CONTEXT_SAMPLER_NAME(metric) \
+  case kPerf_##metric:                    \
+    return #metric;
+      PERF_CONTEXT_SAMPLER_PERF_METRICS(PERF_CONTEXT_SAMPLER_NAME)
+#undef PERF_CONTEXT_SAMPLER_NAME
+#define PERF_CONTEXT_SAMPLER_NAME(metric) \
+  case kIOStats_##metric:                 \
+    return "iostats." #metric;
+      PERF_CONTEXT_SAMPLER_IOSTATS_METRICS(PERF_CONTEXT_SAMPLER_NAME)
+#undef PERF_CONTEXT_SAMPLER_NAME
+    case kNumMetrics:
+      break;
+  }
+  assert(false);
+  return "unknown";
+}
+
+PerfContextSampler::PerfContextSampler(size_t ring_capacity)
+    : capacity_(ring_capacity), ring_(new Slot[ring_capacity]) {
+  assert(capacity_ > 0);
+}
+
+void PerfContextSampler::Record(SampledOpType op, const MetricValues& values) {
+  const uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = ring_[index % capacity_];
+  // Seqlock-style publication: readers discard the slot unless they observe
+  // the same completed sequence number before and after copying it. Writers
+  // claim the slot by moving its sequence number from even to odd, so that a
+  // writer lapping the ring never mixes its values with those of a writer
+  // still copying into the same slot. The lapping sample is dropped instead.
+  uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+  if (seq > 2 * index) {
+    // Already lapped by a later sample
+    return;
+  }
+  if ((seq & 1) != 0 ||
+      !slot.seq.compare_exchange_strong(seq, 2 * index + 1,
+                                        std::memory_order_relaxed)) {
+    // Tell the reader not to wait for this sample
+    uint64_t skipped = slot.skipped.load(std::memory_order_relaxed);
+    while (skipped < index + 1 &&
+           !slot.skipped.compare_exchange_weak(skipped, index + 1,
+                                               std::memory_order_release)) {
+    }
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  TEST_SYNC_POINT("PerfContextSampler::Record:Claimed");
+  slot.op.store(static_cast<uint64_t>(op), std::memory_order_relaxed);
+  for (size_t i = 0; i < kNumMetrics; ++i) {
+    slot.values[i].store(values[i], std::memory_order_relaxed);
+  }
+  slot.seq.store(2 * (index + 1), std::memory_order_release);
+}
+
+void PerfContextSampler::DrainLocked() {
+  aggregate_mutex_.AssertHeld();
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  if (head - tail_ > capacity_) {
+    dropped_ += head - tail_ - capacity_;
+    tail_ = head - capacity_;
+  }
+  MetricValues values;
+  for (; tail_ < head; ++tail_) {
+    Slot& slot = ring_[tail_ % capacity_];
+    const uint64_t expected_seq = 2 * (tail_ + 1);
+    const uint64_t seq_before = slot.seq.load(std::memory_order_acquire);
+    if (seq_before < expected_seq) {
+      if (slot.skipped.load(std::memory_order_acquire) > tail_) {
+        // Skipped by its writer
+        ++dropped_;
+        continue;
+      }
+      // Still being written; pick it up on the next drain
+      break;
+    }
+    const uint64_t op = slot.op.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kNumMetrics; ++i) {
+      values[i] = slot.values[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t seq_after = slot.seq.load(std::memory_order_relaxed);
+    if (seq_before != expected_seq || seq_after != expected_seq ||
+        op >= static_cast<uint64_t>(SampledOpType::kNumOpTypes)) {
+      // Overwritten by a later sample
+      ++dropped_;
+      continue;
+    }
+    if (!histograms_) {
+      constexpr size_t kNumHistograms =
+          static_cast<size_t>(SampledOpType::kNumOpTypes) * kNumMetrics;
+      histograms_.reset(new HistogramImpl[kNumHistograms]);
+    }
+    ++num_samples_[op];
+    for (size_t i = 0; i < kNumMetrics; ++i) {
+      histograms_[op * kNumMetrics + i].Add(values[i]);
+    }
+  }
+}
+
+uint64_t PerfContextSampler::GetAggregated(SampledOpType op, Metric metric,
+                                           HistogramData* data) {
+  MutexLock l(&aggregate_mutex_);
+  DrainLocked();
+  const size_t op_index = static_cast<size_t>(op);
+  if (data != nullptr) {
+    if (histograms_) {
+      histograms_[op_index * kNumMetrics + metric].Data(data);
+    } else {
+      HistogramImpl().Data(data);
+    }
+  }
+  return num_samples_[op_index];
+}
+
+uint64_t PerfContextSampler::GetDroppedSamples() {
+  MutexLock l(&aggregate_mutex_);
+  DrainLocked();
+  return dropped_;
+}
+
+std::string PerfContextSampler::ToString() {
+  MutexLock l(&aggregate_mutex_);
+  DrainLocked();
+  std::string out;
+  char buf[256];
+  snprintf(buf, sizeof(buf),
+           "Sample rate: 1/%" PRIu32 ", dropped samples: %" PRIu64 "\n",
+           sample_rate_.load(std::memory_order_relaxed), dropped_);
+  out.append(buf);
+  for (size_t op = 0; op < static_cast<size_t>(SampledOpType::kNumOpTypes);
+       ++op) {
+    snprintf(buf, sizeof(buf), "\n** %s: %" PRIu64 " samples **\n",
+             SampledOpTypeName(static_cast<SampledOpType>(op)),
+             num_samples_[op]);
+    out.append(buf);
+    if (num_samples_[op] == 0) {
+      continue;
+    }
+    snprintf(buf, sizeof(buf), "%-44s %12s %12s %12s %12s\n", "metric",
+             "average", "P50", "P99", "max");
+    out.append(buf);
+    for (size_t i = 0; i < kNumMetrics; ++i) {
+      const HistogramImpl& h = histograms_[op * kNumMetrics + i];
+      if (h.max() == 0) {
+        // Not touched by this operation type
+        continue;
+      }
+      snprintf(buf, sizeof(buf), "%-44s %12.1f %12.1f %12.1f %12" PRIu64 "\n",
+               MetricName(static_cast<Metric>(i)), h.Average(),
+               h.Percentile(50.0), h.Percentile(99.0), h.max());
+      out.append(buf);
+    }
+  }
+  return out;
+}
+
+void PerfContextSampleGuard::Snapshot(
+    PerfContextSampler::MetricValues* values) {
+  (*values)[PerfContextSampler::kTotalNanos] = 0;
+#define PERF_CONTEXT_SAMPLER_SNAPSHOT(metric) \
+  (*values)[PerfContextSampler::kPerf_##metric] = perf_context.metric;
+  PERF_CONTEXT_SAMPLER_PERF_METRICS(PERF_CONTEXT_SAMPLER_SNAPSHOT)
+#undef PERF_CONTEXT_SAMPLER_SNAPSHOT
+#define PERF_CONTEXT_SAMPLER_SNAPSHOT(metric) \
+  (*values)[PerfContextSampler::kIOStats_##metric] = IOSTATS(metric);
+  PERF_CONTEXT_SAMPLER_IOSTATS_METRICS(PERF_CONTEXT_SAMPLER_SNAPSHOT)
+#undef PERF_CONTEXT_SAMPLER_SNAPSHOT
+}
+
+void PerfContextSampleGuard::Start(PerfContextSampler* sampler,
+                                   SampledOpType op, SystemClock* clock,
+                                   Statistics* stats) {
+  sampler_ = sampler;
+  clock_ = clock;
+  stats_ = stats;
+  op_ = op;
+  prev_perf_level_ = GetPerfLevel();
+  if (prev_perf_level_ < PerfLevel::kEnableTimeExceptForMutex) {
+    SetPerfLevel(PerfLevel::kEnableTimeExceptForMutex);
+  }
+  Snapshot(&start_values_);
+  start_values_[PerfContextSampler::kTotalNanos] = clock_->NowNanos();
+}
+
+void PerfContextSampleGuard::Finish() {
+  PerfContextSampler::MetricValues values;
+  Snapshot(&values);
+  values[PerfContextSampler::kTotalNanos] = clock_->NowNanos();
+  for (size_t i = 0; i < PerfContextSampler::kNumMetrics; ++i) {
+    // Guard against an application resetting its PerfContext mid-operation
+    values[i] =
+        values[i] >= start_values_[i] ? values[i] - start_values_[i] : 0;
+  }
+  if (prev_perf_level_ < PerfLevel::kEnableTimeExceptForMutex) {
+    SetPerfLevel(prev_perf_level_);
+  }
+  sampler_->Record(op_, values);
+  RecordTick(stats_, PERF_CONTEXT_SAMPLES);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
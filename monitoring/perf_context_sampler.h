@@ -0,0 +1,208 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "monitoring/histogram.h"
+#include "monitoring/perf_level_imp.h"
+#include "port/port.h"
+#include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/statistics.h"
+#include "rocksdb/system_clock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// The PerfContext / IOStatsContext metrics captured for each sampled
+// operation, as (source, metric) pairs. Only metrics relevant to point reads
+// and writes are captured so that a sample stays small.
+#define PERF_CONTEXT_SAMPLER_PERF_METRICS(X)   \
+  X(get_snapshot_time)                         \
+  X(get_from_memtable_time)                    \
+  X(get_from_output_files_time)                \
+  X(get_post_process_time)                     \
+  X(find_table_nanos)                          \
+  X(read_index_block_nanos)                    \
+  X(read_filter_block_nanos)                   \
+  X(new_table_block_iter_nanos)                \
+  X(block_seek_nanos)                          \
+  X(block_read_time)                           \
+  X(block_checksum_time)                       \
+  X(block_decompress_time)                     \
+  X(blob_read_time)                            \
+  X(merge_operator_time_nanos)                 \
+  X(write_wal_time)                            \
+  X(write_memtable_time)                       \
+  X(write_delay_time)                          \
+  X(write_scheduling_flushes_compactions_time) \
+  X(write_pre_and_post_process_time)           \
+  X(write_thread_wait_nanos)                   \
+  X(block_cache_hit_count)                     \
+  X(block_read_count)                          \
+  X(block_read_byte)                           \
+  X(bloom_sst_miss_count)                      \
+  X(user_key_comparison_count)
+
+#define PERF_CONTEXT_SAMPLER_IOSTATS_METRICS(X) \
+  X(read_nanos)                                 \
+  X(write_nanos)                                \
+  X(fsync_nanos)                                \
+  X(bytes_read)                                 \
+  X(bytes_written)
+
+enum class SampledOpType : uint8_t {
+  kGet = 0,
+  kMultiGet,
+  kWrite,
+  kNumOpTypes,
+};
+
+const char* SampledOpTypeName(SampledOpType op);
+
+// Samples 1 in N operations on a DB with a detailed PerfContext and
+// IOStatsContext breakdown, without requiring the application to run with an
+// expensive PerfLevel all the time.
+//
+// Sampled operations publish their breakdown into a fixed-size lock-free ring
+// buffer. Reading the aggregate (e.g. through DB::GetProperty) drains the ring
+// into per-operation-type histograms; samples overwritten before they are
+// drained are counted as dropped.
+class PerfContextSampler {
+ public:
+  enum Metric : uint32_t {
+    kTotalNanos = 0,
+#define PERF_CONTEXT_SAMPLER_ENUM(metric) kPerf_##metric,
+    PERF_CONTEXT_SAMPLER_PERF_METRICS(PERF_CONTEXT_SAMPLER_ENUM)
+#undef PERF_CONTEXT_SAMPLER_ENUM
+#define PERF_CONTEXT_SAMPLER_ENUM(metric) kIOStats_##metric,
+    PERF_CONTEXT_SAMPLER_IOSTATS_METRICS(PERF_CONTEXT_SAMPLER_ENUM)
+#undef PERF_CONTEXT_SAMPLER_ENUM
+    kNumMetrics,
+  };
+  using MetricValues = std::array<uint64_t, kNumMetrics>;
+
+  static const char* MetricName(Metric metric);
+
+  explicit PerfContextSampler(size_t ring_capacity = kDefaultRingCapacity);
+
+  // 0 disables sampling.
+  void SetSampleRate(uint32_t sample_rate) {
+    sample_rate_.store(sample_rate, std::memory_order_relaxed);
+  }
+
+  // Fast path for every operation: a relaxed load and, when sampling is
+  // enabled, a thread-local countdown.
+  bool ShouldSample() const {
+    uint32_t rate = sample_rate_.load(std::memory_order_relaxed);
+    if (rate == 0) {
+      return false;
+    }
+    static thread_local uint32_t countdown = 0;
+    if (countdown >= rate) {
+      // The rate was lowered since the countdown started
+      countdown = rate - 1;
+    }
+    if (countdown > 0) {
+      --countdown;
+      return false;
+    }
+    countdown = rate - 1;
+    return true;
+  }
+
+  // Publishes one sample into the ring buffer. Lock-free; safe to call from
+  // any number of threads.
+  void Record(SampledOpType op, const MetricValues& values);
+
+  // Drains the ring buffer into the aggregate histograms and returns a
+  // human-readable table of the per-operation-type breakdowns.
+  std::string ToString();
+
+  // Drains the ring buffer and returns the number of samples aggregated so
+  // far for `op`, and optionally copies the histogram of `metric`.
+  uint64_t GetAggregated(SampledOpType op, Metric metric,
+                         HistogramData* data);
+
+  uint64_t GetDroppedSamples();
+
+  static constexpr size_t kDefaultRingCapacity = 4096;
+
+ private:
+  struct Slot {
+    // 2 * (index + 1) once the sample for ring index `index` is complete,
+    // 2 * index + 1 while it is being written.
+    std::atomic<uint64_t> seq{0};
+    // 1 + the latest ring index whose writer skipped the slot, because a
+    // writer of an earlier lap was still writing it
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<uint64_t> op{0};
+    std::array<std::atomic<uint64_t>, kNumMetrics> values{};
+  };
+
+  // REQUIRES: aggregate_mutex_ held
+  void DrainLocked();
+
+  std::atomic<uint32_t> sample_rate_{0};
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> ring_;
+  std::atomic<uint64_t> head_{0};
+
+  port::Mutex aggregate_mutex_;
+  uint64_t tail_ = 0;
+  uint64_t dropped_ = 0;
+  std::array<uint64_t, static_cast<size_t>(SampledOpType::kNumOpTypes)>
+      num_samples_{};
+  // kNumOpTypes * kNumMetrics histograms, allocated on the first sample
+  std::unique_ptr<HistogramImpl[]> histograms_;
+};
+
+// Scoped helper placed at the top of a DB operation. When the operation is
+// sampled, it raises the thread's PerfLevel to kEnableTimeExceptForMutex for
+// the duration of the operation (unless it is already at least that), and on
+// destruction records the difference in the captured metrics and bumps the
+// PERF_CONTEXT_SAMPLES ticker. The thread's own PerfContext keeps accumulating
+// as usual, so a sampled operation can add timing metrics to it that the
+// configured PerfLevel would not have collected.
+//
+// Must be constructed before any PerfStepTimer of the operation, since those
+// latch the PerfLevel on construction.
+class PerfContextSampleGuard {
+ public:
+  PerfContextSampleGuard(PerfContextSampler* sampler, SampledOpType op,
+                         SystemClock* clock, Statistics* stats) {
+    if (sampler->ShouldSample()) {
+      Start(sampler, op, clock, stats);
+    }
+  }
+
+  ~PerfContextSampleGuard() {
+    if (sampler_ != nullptr) {
+      Finish();
+    }
+  }
+
+  PerfContextSampleGuard(const PerfContextSampleGuard&) = delete;
+  PerfContextSampleGuard& operator=(const PerfContextSampleGuard&) = delete;
+
+ private:
+  void Start(PerfContextSampler* sampler, SampledOpType op, SystemClock* clock,
+             Statistics* stats);
+  void Finish();
+  static void Snapshot(PerfContextSampler::MetricValues* values);
+
+  PerfContextSampler* sampler_ = nullptr;
+  SystemClock* clock_ = nullptr;
+  Statistics* stats_ = nullptr;
+  SampledOpType op_ = SampledOpType::kGet;
+  PerfLevel prev_perf_level_ = PerfLevel::kUninitialized;
+  PerfContextSampler::MetricValues start_values_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
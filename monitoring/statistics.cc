@@ -343,6 +343,14 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {BLOB_DB_LAZY_PARTIAL_READ_COUNT, "rocksdb.blobdb.lazy.partial.read.count"},
     {BLOB_DB_LAZY_PARTIAL_BYTES_SAVED,
      "rocksdb.blobdb.lazy.partial.bytes.saved"},
+    {PERF_CONTEXT_SAMPLES, "rocksdb.perf.context.samples"},
+    {USER_KEY_ROW_CACHE_HIT, "rocksdb.user.key.row.cache.hit"},
+    {USER_KEY_ROW_CACHE_MISS, "rocksdb.user.key.row.cache.miss"},
+    {USER_KEY_ROW_CACHE_NEGATIVE_HIT,
+     "rocksdb.user.key.row.cache.negative.hit"},
+    {SCAN_PREDICATE_ENTRIES_SKIPPED, "rocksdb.scan.predicate.entries.skipped"},
+    {SCAN_PREDICATE_DATA_BLOCKS_SKIPPED,
+     "rocksdb.scan.predicate.data.blocks.skipped"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
@@ -440,6 +448,8 @@ const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
      "rocksdb.flush.write_buffer_manager.memtable.memory.bytes"},
     {OPEN_AND_COMPACT_DB_OPEN_MICROS,
      "rocksdb.open.and.compact.db.open.micros"},
+    {COMPRESSED_SECONDARY_CACHE_PROMOTION_MICROS,
+     "rocksdb.compressed.secondary.cache.promotion.micros"},
 };
 
 std::shared_ptr<Statistics> CreateDBStatistics() {
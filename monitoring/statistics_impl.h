@@ -81,15 +81,19 @@ class StatisticsImpl : public Statistics {
   // per-core. It is cache-aligned, so tickers/histograms belonging to different
   // cores can never share the same cache line.
   //
+  // Histograms are kept as bare HistogramStat (relaxed atomics only, no vtable
+  // or mutex): recording is the hot path, while merging the per-core copies
+  // and computing percentiles only happens on read, under aggregate_lock_.
+  //
   // Alignment attributes expand to nothing depending on the platform
   struct ALIGN_AS(CACHE_LINE_SIZE) StatisticsData {
     std::atomic_uint_fast64_t tickers_[INTERNAL_TICKER_ENUM_MAX] = {{0}};
-    HistogramImpl histograms_[INTERNAL_HISTOGRAM_ENUM_MAX];
+    HistogramStat histograms_[INTERNAL_HISTOGRAM_ENUM_MAX];
 #ifndef HAVE_ALIGNED_NEW
     char
         padding[(CACHE_LINE_SIZE -
                  (INTERNAL_TICKER_ENUM_MAX * sizeof(std::atomic_uint_fast64_t) +
-                  INTERNAL_HISTOGRAM_ENUM_MAX * sizeof(HistogramImpl)) %
+                  INTERNAL_HISTOGRAM_ENUM_MAX * sizeof(HistogramStat)) %
                      CACHE_LINE_SIZE)] ROCKSDB_FIELD_UNUSED;
 #endif
     void* operator new(size_t s) { return port::cacheline_aligned_alloc(s); }
@@ -390,6 +390,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(class CompactionOptionsUniversal, incremental),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"partitioned_size_amp_compaction",
+         {offsetof(class CompactionOptionsUniversal,
+                   partitioned_size_amp_compaction),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"allow_trivial_move",
          {offsetof(class CompactionOptionsUniversal, allow_trivial_move),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -1010,6 +1015,16 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    memtable_batch_lookup_optimization),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"user_key_row_cache",
+         {offsetof(struct ImmutableCFOptions, user_key_row_cache),
+          OptionType::kUnknown, OptionVerificationType::kNormal,
+          (OptionTypeFlags::kCompareNever | OptionTypeFlags::kDontSerialize),
+          // Parses the input value as a Cache
+          [](const ConfigOptions& opts, const std::string&,
+             const std::string& value, void* addr) {
+            auto* cache = static_cast<std::shared_ptr<Cache>*>(addr);
+            return Cache::CreateFromString(opts, value, cache);
+          }}},
 };
 
 const std::string OptionsHelper::kCFOptionsName = "ColumnFamilyOptions";
@@ -1156,7 +1171,8 @@ ImmutableCFOptions::ImmutableCFOptions(const ColumnFamilyOptions& cf_options)
           cf_options.persist_user_defined_timestamps),
       cf_allow_ingest_behind(cf_options.cf_allow_ingest_behind),
       memtable_batch_lookup_optimization(
-          cf_options.memtable_batch_lookup_optimization) {}
+          cf_options.memtable_batch_lookup_optimization),
+      user_key_row_cache(cf_options.user_key_row_cache) {}
 
 ImmutableOptions::ImmutableOptions() : ImmutableOptions(Options()) {}
 
@@ -1361,6 +1377,10 @@ void MutableCFOptions::Dump(Logger* log) const {
       static_cast<int>(compaction_options_universal.allow_trivial_move));
   ROCKS_LOG_INFO(log, "compaction_options_universal.incremental        : %d",
                  static_cast<int>(compaction_options_universal.incremental));
+  ROCKS_LOG_INFO(
+      log, "compaction_options_universal.partitioned_size_amp_compaction : %d",
+      static_cast<int>(
+          compaction_options_universal.partitioned_size_amp_compaction));
   ROCKS_LOG_INFO(log, "compaction_options_universal.reduce_file_locking : %d",
                  compaction_options_universal.reduce_file_locking);
 
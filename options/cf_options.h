@@ -99,6 +99,8 @@ struct ImmutableCFOptions {
   bool cf_allow_ingest_behind;
 
   bool memtable_batch_lookup_optimization;
+
+  std::shared_ptr<Cache> user_key_row_cache;
 };
 
 struct ImmutableOptions : public ImmutableDBOptions, public ImmutableCFOptions {
@@ -80,6 +80,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableDBOptions, delayed_write_rate),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"write_rate_feedback_control",
+         {offsetof(struct MutableDBOptions, write_rate_feedback_control),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"max_total_wal_size",
          {offsetof(struct MutableDBOptions, max_total_wal_size),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
@@ -153,6 +157,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    max_compaction_trigger_wakeup_seconds),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"perf_context_sample_rate",
+         {offsetof(struct MutableDBOptions, perf_context_sample_rate),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"fast_sst_open",
          {offsetof(struct MutableDBOptions, fast_sst_open),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -414,6 +422,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    enforce_write_buffer_manager_during_recovery),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"pipelined_wal_recovery",
+         {offsetof(struct ImmutableDBOptions, pipelined_wal_recovery),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"allow_ingest_behind",
          {offsetof(struct ImmutableDBOptions, allow_ingest_behind),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -827,6 +839,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       avoid_flush_during_recovery(options.avoid_flush_during_recovery),
       enforce_write_buffer_manager_during_recovery(
           options.enforce_write_buffer_manager_during_recovery),
+      pipelined_wal_recovery(options.pipelined_wal_recovery),
       allow_ingest_behind(options.allow_ingest_behind),
       two_write_queues(options.two_write_queues),
       manual_wal_flush(options.manual_wal_flush),
@@ -1003,6 +1016,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(
       log, "        Options.enforce_write_buffer_manager_during_recovery: %d",
       enforce_write_buffer_manager_during_recovery);
+  ROCKS_LOG_HEADER(log, "            Options.pipelined_wal_recovery: %d",
+                   pipelined_wal_recovery);
   ROCKS_LOG_HEADER(log, "            Options.allow_ingest_behind: %d",
                    allow_ingest_behind);
   ROCKS_LOG_HEADER(log, "            Options.two_write_queues: %d",
@@ -1096,12 +1111,14 @@ MutableDBOptions::MutableDBOptions(const DBOptions& options)
       avoid_flush_during_shutdown(options.avoid_flush_during_shutdown),
       writable_file_max_buffer_size(options.writable_file_max_buffer_size),
       delayed_write_rate(options.delayed_write_rate),
+      write_rate_feedback_control(options.write_rate_feedback_control),
       max_total_wal_size(options.max_total_wal_size),
       delete_obsolete_files_period_micros(
           options.delete_obsolete_files_period_micros),
       stats_dump_period_sec(options.stats_dump_period_sec),
       stats_persist_period_sec(options.stats_persist_period_sec),
       stats_history_buffer_size(options.stats_history_buffer_size),
+      perf_context_sample_rate(options.perf_context_sample_rate),
       max_open_files(options.max_open_files),
       bytes_per_sync(options.bytes_per_sync),
       wal_bytes_per_sync(options.wal_bytes_per_sync),
@@ -1135,6 +1152,8 @@ void MutableDBOptions::Dump(Logger* log) const {
       writable_file_max_buffer_size);
   ROCKS_LOG_HEADER(log, "            Options.delayed_write_rate : %" PRIu64,
                    delayed_write_rate);
+  ROCKS_LOG_HEADER(log, "   Options.write_rate_feedback_control: %d",
+                   write_rate_feedback_control);
   ROCKS_LOG_HEADER(log, "            Options.max_total_wal_size: %" PRIu64,
                    max_total_wal_size);
   ROCKS_LOG_HEADER(
@@ -1148,6 +1167,9 @@ void MutableDBOptions::Dump(Logger* log) const {
       log,
       "                Options.stats_history_buffer_size: %" ROCKSDB_PRIszt,
       stats_history_buffer_size);
+  ROCKS_LOG_HEADER(log,
+                   "               Options.perf_context_sample_rate: %" PRIu32,
+                   perf_context_sample_rate);
   ROCKS_LOG_HEADER(log, "                         Options.max_open_files: %d",
                    max_open_files);
   ROCKS_LOG_HEADER(log,
@@ -82,6 +82,7 @@ struct ImmutableDBOptions {
   bool dump_malloc_stats;
   bool avoid_flush_during_recovery;
   bool enforce_write_buffer_manager_during_recovery;
+  bool pipelined_wal_recovery;
   bool allow_ingest_behind;
   bool two_write_queues;
   bool manual_wal_flush;
@@ -139,11 +140,13 @@ struct MutableDBOptions {
   bool avoid_flush_during_shutdown;
   size_t writable_file_max_buffer_size;
   uint64_t delayed_write_rate;
+  bool write_rate_feedback_control;
   uint64_t max_total_wal_size;
   uint64_t delete_obsolete_files_period_micros;
   unsigned int stats_dump_period_sec;
   unsigned int stats_persist_period_sec;
   size_t stats_history_buffer_size;
+  uint32_t perf_context_sample_rate;
   int max_open_files;
   uint64_t bytes_per_sync;
   uint64_t wal_bytes_per_sync;
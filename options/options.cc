@@ -122,7 +122,8 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       min_tombstones_for_range_conversion(
           options.min_tombstones_for_range_conversion),
       memtable_batch_lookup_optimization(
-          options.memtable_batch_lookup_optimization) {
+          options.memtable_batch_lookup_optimization),
+      user_key_row_cache(options.user_key_row_cache) {
   assert(memtable_factory.get() != nullptr);
   if (max_bytes_for_level_multiplier_additional.size() <
       static_cast<unsigned int>(num_levels)) {
@@ -375,6 +376,11 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(
       log, "Options.compaction_options_universal.reduce_file_locking: %d",
       compaction_options_universal.reduce_file_locking);
+  ROCKS_LOG_HEADER(
+      log,
+      "Options.compaction_options_universal.partitioned_size_amp_compaction: "
+      "%d",
+      compaction_options_universal.partitioned_size_amp_compaction);
   ROCKS_LOG_HEADER(
       log, "Options.compaction_options_fifo.max_table_files_size: %" PRIu64,
       compaction_options_fifo.max_table_files_size);
@@ -485,6 +491,12 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                    cf_allow_ingest_behind ? "true" : "false");
   ROCKS_LOG_HEADER(log, "  Options.memtable_batch_lookup_optimization: %s",
                    memtable_batch_lookup_optimization ? "true" : "false");
+  if (user_key_row_cache) {
+    ROCKS_LOG_HEADER(log, "                  Options.user_key_row_cache: %s",
+                     user_key_row_cache->Name());
+    ROCKS_LOG_HEADER(log, "                  user_key_row_cache options: %s",
+                     user_key_row_cache->GetPrintableOptions().c_str());
+  }
   ROCKS_LOG_HEADER(log, "             Options.enable_blob_direct_write: %s",
                    enable_blob_direct_write ? "true" : "false");
   ROCKS_LOG_HEADER(log,
@@ -128,6 +128,8 @@ void BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.persist_stats_to_disk = immutable_db_options.persist_stats_to_disk;
   options.stats_history_buffer_size =
       mutable_db_options.stats_history_buffer_size;
+  options.perf_context_sample_rate =
+      mutable_db_options.perf_context_sample_rate;
   options.advise_random_on_open = immutable_db_options.advise_random_on_open;
   options.db_write_buffer_size = immutable_db_options.db_write_buffer_size;
   options.write_buffer_manager = immutable_db_options.write_buffer_manager;
@@ -142,6 +144,8 @@ void BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.listeners = immutable_db_options.listeners;
   options.enable_thread_tracking = immutable_db_options.enable_thread_tracking;
   options.delayed_write_rate = mutable_db_options.delayed_write_rate;
+  options.write_rate_feedback_control =
+      mutable_db_options.write_rate_feedback_control;
   options.enable_pipelined_write = immutable_db_options.enable_pipelined_write;
   options.unordered_write = immutable_db_options.unordered_write;
   options.allow_concurrent_memtable_write =
@@ -165,6 +169,7 @@ void BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
       immutable_db_options.avoid_flush_during_recovery;
   options.enforce_write_buffer_manager_during_recovery =
       immutable_db_options.enforce_write_buffer_manager_during_recovery;
+  options.pipelined_wal_recovery = immutable_db_options.pipelined_wal_recovery;
   options.avoid_flush_during_shutdown =
       mutable_db_options.avoid_flush_during_shutdown;
   options.allow_ingest_behind = immutable_db_options.allow_ingest_behind;
@@ -367,6 +372,7 @@ void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
   cf_opts->compaction_thread_limiter = ioptions.compaction_thread_limiter;
   cf_opts->sst_partitioner_factory = ioptions.sst_partitioner_factory;
   cf_opts->blob_cache = ioptions.blob_cache;
+  cf_opts->user_key_row_cache = ioptions.user_key_row_cache;
   cf_opts->enable_blob_direct_write = ioptions.enable_blob_direct_write;
   cf_opts->blob_direct_write_partitions = ioptions.blob_direct_write_partitions;
   cf_opts->blob_direct_write_partition_strategy =
@@ -394,7 +400,8 @@ std::map<CompactionPri, std::string> OptionsHelper::compaction_pri_to_string = {
     {kOldestLargestSeqFirst, "kOldestLargestSeqFirst"},
     {kOldestSmallestSeqFirst, "kOldestSmallestSeqFirst"},
     {kMinOverlappingRatio, "kMinOverlappingRatio"},
-    {kRoundRobin, "kRoundRobin"}};
+    {kRoundRobin, "kRoundRobin"},
+    {kCostBenefit, "kCostBenefit"}};
 
 std::map<CompactionStopStyle, std::string>
     OptionsHelper::compaction_stop_style_to_string = {
@@ -1050,7 +1057,8 @@ std::unordered_map<std::string, CompactionPri>
         {"kOldestLargestSeqFirst", kOldestLargestSeqFirst},
         {"kOldestSmallestSeqFirst", kOldestSmallestSeqFirst},
         {"kMinOverlappingRatio", kMinOverlappingRatio},
-        {"kRoundRobin", kRoundRobin}};
+        {"kRoundRobin", kRoundRobin},
+        {"kCostBenefit", kCostBenefit}};
 
 std::unordered_map<std::string, CompactionStopStyle>
     OptionsHelper::compaction_stop_style_string_map = {
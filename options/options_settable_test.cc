@@ -185,6 +185,7 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "index_block_search_type=kBinary;"
       "data_block_index_type=kDataBlockBinaryAndHash;"
       "optimize_key_common_prefix=kEnabled;"
+      "align_index_partitions_to_prefix=true;"
       "index_shortening=kNoShortening;"
       "index_mode=kCustomDefault;"
       "data_block_hash_table_util_ratio=0.75;"
@@ -212,6 +213,8 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "fail_if_no_udi_on_open=true;"
       "use_udi_as_primary_index=true;"
       "separate_key_value_in_data_block=true;"
+      "embedded_blob_min_size=4096;"
+      "data_block_value_stats=true;"
       "uniform_cv_threshold=0.2",
       new_bbto));
 
@@ -442,12 +445,14 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
       "create_if_missing=false;"
       "error_if_exists=true;"
       "delayed_write_rate=4294976214;"
+      "write_rate_feedback_control=true;"
       "manifest_preallocation_size=1222;"
       "allow_mmap_writes=false;"
       "stats_dump_period_sec=70127;"
       "stats_persist_period_sec=54321;"
       "persist_stats_to_disk=true;"
       "stats_history_buffer_size=14159;"
+      "perf_context_sample_rate=1000;"
       "allow_fallocate=true;"
       "allow_mmap_reads=false;"
       "use_direct_reads=false;"
@@ -467,6 +472,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
       "allow_2pc=false;"
       "avoid_flush_during_recovery=false;"
       "enforce_write_buffer_manager_during_recovery=true;"
+      "pipelined_wal_recovery=true;"
       "avoid_flush_during_shutdown=false;"
       "allow_ingest_behind=false;"
       "concurrent_prepare=false;"
@@ -555,6 +561,8 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
        sizeof(CompressionOptions)},
       {offsetof(struct ColumnFamilyOptions, blob_cache),
        sizeof(std::shared_ptr<Cache>)},
+      {offsetof(struct ColumnFamilyOptions, user_key_row_cache),
+       sizeof(std::shared_ptr<Cache>)},
       {offsetof(struct ColumnFamilyOptions,
                 blob_direct_write_partition_strategy),
        sizeof(std::shared_ptr<BlobFilePartitionStrategy>)},
@@ -9,6 +9,8 @@ LIB_SOURCES =                                                   \
   cache/clock_cache.cc                                          \
   cache/lru_cache.cc                                            \
   cache/compressed_secondary_cache.cc                           \
+  cache/compressed_slab_store.cc                                \
+  cache/flash_secondary_cache.cc                                \
   cache/secondary_cache.cc                                      \
   cache/secondary_cache_adapter.cc                              \
   cache/sharded_cache.cc                                        \
@@ -90,11 +92,13 @@ LIB_SOURCES =                                                   \
   db/range_del_aggregator.cc                                    \
   db/range_tombstone_fragmenter.cc                              \
   db/repair.cc                                                  \
+  db/scan_predicate.cc                                          \
   db/seqno_to_time_mapping.cc                                   \
   db/snapshot_impl.cc                                           \
   db/table_cache.cc                                             \
   db/table_properties_collector.cc                              \
   db/trim_history_scheduler.cc                                  \
+  db/user_key_row_cache.cc                                      \
   db/version_builder.cc                                         \
   db/version_edit.cc                                            \
   db/version_edit_handler.cc                                    \
@@ -103,6 +107,7 @@ LIB_SOURCES =                                                   \
   db/wal_edit.cc                                                \
   db/wal_iterator_impl.cc                                       \
   db/wal_manager.cc                                             \
+  db/wal_record_prefetcher.cc                                   \
   db/wide/lazy_wide_columns.cc                                  \
   db/wide/read_path_blob_resolver.cc                            \
   db/wide/wide_column_serialization.cc                          \
@@ -142,6 +147,7 @@ LIB_SOURCES =                                                   \
   logging/log_buffer.cc                                         \
   memory/arena.cc                                               \
   memory/concurrent_arena.cc                                    \
+  memory/huge_page_slab_allocator.cc                            \
   memory/jemalloc_nodump_allocator.cc                           \
   memory/memkind_kmem_allocator.cc                              \
   memory/memory_allocator.cc                                    \
@@ -158,6 +164,7 @@ LIB_SOURCES =                                                   \
   monitoring/instrumented_mutex.cc                              \
   monitoring/iostats_context.cc                                 \
   monitoring/perf_context.cc                                    \
+  monitoring/perf_context_sampler.cc                            \
   monitoring/perf_level.cc                                      \
   monitoring/persistent_stats_history.cc                        \
   monitoring/statistics.cc                                      \
@@ -197,6 +204,7 @@ LIB_SOURCES =                                                   \
   table/block_based/block_prefix_index.cc                       \
   table/block_based/data_block_hash_index.cc                    \
   table/block_based/data_block_footer.cc                        \
+  table/block_based/data_block_value_stats.cc                   \
   table/block_based/filter_block_reader_common.cc               \
   table/block_based/filter_policy.cc                            \
   table/block_based/flush_block_policy.cc                       \
@@ -245,6 +253,7 @@ LIB_SOURCES =                                                   \
   trace_replay/trace_replay.cc                                  \
   trace_replay/block_cache_tracer.cc                            \
   trace_replay/io_tracer.cc                                     \
+  util/adaptive_compressor.cc                                   \
   util/async_file_reader.cc					                            \
   util/auto_tune_compressor.cc                                           \
   util/build_version.cc                                         \
@@ -261,10 +270,12 @@ LIB_SOURCES =                                                   \
   util/data_structure.cc                                        \
   util/dynamic_bloom.cc                                         \
   util/hash.cc                                                  \
+  util/multi_tenant_rate_limiter.cc                             \
   util/murmurhash.cc                                            \
   util/random.cc                                                \
   util/rate_limiter.cc                                          \
   util/ribbon_config.cc                                         \
+  util/shared_dict_compressor.cc                                \
   util/slice.cc                                                 \
   util/file_checksum_helper.cc                                  \
   util/simple_mixed_compressor.cc                               \
@@ -475,6 +486,7 @@ TEST_MAIN_SOURCES =                                                     \
   cache/cache_test.cc                                                   \
   cache/cache_reservation_manager_test.cc                               \
   cache/compressed_secondary_cache_test.cc                              \
+  cache/flash_secondary_cache_test.cc                                   \
   cache/lru_cache_test.cc                                               \
   cache/tiered_secondary_cache_test.cc					                        \
   db/blob/blob_counting_iterator_test.cc                                \
@@ -702,6 +714,7 @@ WITH_FAISS_TEST_MAIN_SOURCES =                                          \
 MICROBENCH_SOURCES =                                          \
   microbench/ribbon_bench.cc                                  \
   microbench/db_basic_bench.cc                                \
+  microbench/histogram_bench.cc                               \
 
 JNI_NATIVE_SOURCES =                                          \
   java/rocksjni/backupenginejni.cc                            \
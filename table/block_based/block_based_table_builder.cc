@@ -51,6 +51,7 @@
 #include "table/block_based/block_based_table_factory.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/data_block_value_stats.h"
 #include "table/block_based/filter_block.h"
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
@@ -185,6 +186,28 @@ bool UseCommonPrefixForIndex(const BlockBasedTableOptions& table_options,
          UseCommonPrefixForDataBlock(table_options, ucmp, ts_sz);
 }
 
+// Returns the embedded blob options for a new table: those passed explicitly
+// (e.g. by SstFileWriter::OpenWithEmbeddedBlobs), otherwise those implied by
+// BlockBasedTableOptions::embedded_blob_min_size, or nullptr if values stay in
+// the data blocks.
+std::unique_ptr<const EmbeddedBlobSstBuilderOptions> GetEmbeddedBlobOptions(
+    const BlockBasedTableOptions& table_options,
+    const TableBuilderOptions& tbo) {
+  if (tbo.embedded_blob_options != nullptr) {
+    return std::make_unique<EmbeddedBlobSstBuilderOptions>(
+        *tbo.embedded_blob_options);
+  }
+  if (table_options.embedded_blob_min_size == 0 ||
+      !FormatVersionUsesCompressionManagerName(table_options.format_version) ||
+      table_options.block_align) {
+    return nullptr;
+  }
+  auto embedded_blob_options =
+      std::make_unique<EmbeddedBlobSstBuilderOptions>();
+  embedded_blob_options->min_blob_size = table_options.embedded_blob_min_size;
+  return embedded_blob_options;
+}
+
 // Create a filter block builder based on its type.
 FilterBlockBuilder* CreateFilterBlockBuilder(
     const ImmutableCFOptions& /*opt*/, const MutableCFOptions& mopt,
@@ -1160,15 +1183,19 @@ struct BlockBasedTableBuilder::Rep {
   // This is used for logging compaction stats.
   uint64_t pre_compression_size = 0;
 
-  // Embedded-blob SST support. When `embedded_blob_options` is set the builder
-  // is in embedded mode: index value delta encoding is disabled and eligible
-  // large values are written inline as same-file blob records as values are
-  // added (so they may be interleaved with data blocks), with table entries
-  // rewritten to same-file BlobIndex references. This is a private owned copy:
+  // Embedded-blob SST support. When `embedded_blob_options` is set (see
+  // GetEmbeddedBlobOptions()) the builder is in embedded mode: index value
+  // delta encoding is disabled and eligible large values are written inline as
+  // same-file blob records as values are added (so they may be interleaved with
+  // data blocks), with table entries rewritten to same-file BlobIndex
+  // references. This is a private owned copy:
   // the caller (e.g. SstFileWriter::OpenWithEmbeddedBlobs) may free its own
   // copy as soon as the builder is constructed, so we must not alias it.
   std::unique_ptr<const EmbeddedBlobSstBuilderOptions> embedded_blob_options;
 
+  // Set with BlockBasedTableOptions::data_block_value_stats
+  std::unique_ptr<DataBlockValueStatsBuilder> data_block_value_stats;
+
   // Mutable state for embedded blob writing, lazily allocated when the first
   // blob record is written. Its presence is the signal that the file contains
   // embedded blobs (driving the presence property). Holds the diagnostic
@@ -1424,7 +1451,8 @@ struct BlockBasedTableBuilder::Rep {
             // in-value escape (see IndexValue::EncodeTo), so value-delta
             // encoding is safe with embedded blobs there; older versions must
             // fall back to full handles.
-            (tbo.embedded_blob_options == nullptr ||
+            (!(tbo.embedded_blob_options != nullptr ||
+               table_opt.embedded_blob_min_size > 0) ||
              FormatVersionUsesValueDeltaEscape(table_opt.format_version))),
         reason(tbo.reason),
         target_file_size_is_upper_bound(
@@ -1446,11 +1474,7 @@ struct BlockBasedTableBuilder::Rep {
             table_options.block_restart_interval,
             table_options.index_block_restart_interval),
         tail_size(0),
-        embedded_blob_options(
-            tbo.embedded_blob_options
-                ? std::make_unique<EmbeddedBlobSstBuilderOptions>(
-                      *tbo.embedded_blob_options)
-                : nullptr) {
+        embedded_blob_options(GetEmbeddedBlobOptions(table_opt, tbo)) {
     FilterBuildingContext filter_context(table_options);
 
     filter_context.info_log = ioptions.logger;
@@ -1599,12 +1623,17 @@ struct BlockBasedTableBuilder::Rep {
     // Hard structural constraints override any recommendation
     if ((table_opt.partition_filters &&
          !table_opt.decouple_partitioned_filters) ||
-        table_options.user_defined_index_factory || embedded_blob_options) {
+        table_options.user_defined_index_factory || embedded_blob_options ||
+        table_options.data_block_value_stats) {
       // Embedded-blob SSTs write blob records inline on the emit thread, so
       // they require single-threaded writes for correct, race-free ordering of
-      // blob appends and data-block writes.
+      // blob appends and data-block writes. Data block value stats need the
+      // offset of each block as it is written.
       compression_parallel_threads = 1;
     }
+    if (table_options.data_block_value_stats && ts_sz == 0) {
+      data_block_value_stats = std::make_unique<DataBlockValueStatsBuilder>();
+    }
 
     // Seed AutoSkip from this thread's inter-file carryover (no-op if disabled
     // or if the data-block compressor isn't set up yet, e.g. dictionary
@@ -1657,7 +1686,8 @@ struct BlockBasedTableBuilder::Rep {
           &internal_comparator, use_delta_encoding_for_index_values,
           table_options, ts_sz, persist_user_defined_timestamps, ioptions.stats,
           /*use_common_prefix_top=*/use_common_prefix_index,
-          /*use_common_prefix_sub=*/use_common_prefix_index);
+          /*use_common_prefix_sub=*/use_common_prefix_index,
+          tbo.moptions.prefix_extractor.get());
       index_builder.reset(p_index_builder_);
     } else {
       index_builder.reset(IndexBuilder::CreateIndexBuilder(
@@ -1941,6 +1971,30 @@ BlockBasedTableBuilder::~BlockBasedTableBuilder() {
 }
 
 void BlockBasedTableBuilder::Add(const Slice& ikey, const Slice& value) {
+  AddImpl(ikey, value, /*filter_key_hashes=*/nullptr);
+}
+
+bool BlockBasedTableBuilder::SupportsFilterKeyHashes() const {
+  return rep_->filter_builder != nullptr &&
+         rep_->filter_builder->SupportsKeyHashes();
+}
+
+void BlockBasedTableBuilder::HashFilterKey(const Slice& ikey,
+                                           FilterKeyHashes* hashes) const {
+  assert(SupportsFilterKeyHashes());
+  rep_->filter_builder->HashKey(
+      ExtractUserKeyAndStripTimestamp(ikey, rep_->ts_sz), hashes);
+}
+
+void BlockBasedTableBuilder::AddWithFilterKeyHashes(
+    const Slice& ikey, const Slice& value, const FilterKeyHashes& hashes) {
+  assert(SupportsFilterKeyHashes());
+  AddImpl(ikey, value, &hashes);
+}
+
+void BlockBasedTableBuilder::AddImpl(
+    const Slice& ikey, const Slice& value,
+    const FilterKeyHashes* filter_key_hashes) {
   Rep* r = rep_.get();
   assert(rep_->state != Rep::State::kClosed);
   if (UNLIKELY(!ok())) {
@@ -2001,7 +2055,9 @@ void BlockBasedTableBuilder::Add(const Slice& ikey, const Slice& value) {
     // builder after being added to and "finished" in the index builder, so
     // forces no parallel compression (logic in Rep constructor).
     if (r->state == Rep::State::kUnbuffered) {
-      if (r->filter_builder != nullptr) {
+      if (r->filter_builder != nullptr && filter_key_hashes != nullptr) {
+        r->filter_builder->AddHashes(*filter_key_hashes);
+      } else if (r->filter_builder != nullptr) {
         r->filter_builder->AddWithPrevKey(
             ExtractUserKeyAndStripTimestamp(entry_ikey, r->ts_sz),
             r->last_ikey.empty()
@@ -2012,6 +2068,9 @@ void BlockBasedTableBuilder::Add(const Slice& ikey, const Slice& value) {
 
     // NOTE: WriteBatch guarantees keys < 4GB; value size checked above
     r->data_block.AddWithLastKey(entry_ikey, entry_value, r->last_ikey);
+    if (r->data_block_value_stats) {
+      r->data_block_value_stats->Add(entry_ikey, entry_value);
+    }
     r->last_ikey.assign(entry_ikey.data(), entry_ikey.size());
     assert(!r->last_ikey.empty());
     if (r->state == Rep::State::kBuffered) {
@@ -2076,6 +2135,9 @@ void BlockBasedTableBuilder::Flush(const Slice* first_key_in_next_block) {
     return;
   }
   Slice uncompressed_block_data = r->data_block.Finish();
+  if (r->data_block_value_stats) {
+    r->data_block_value_stats->FinishBlock();
+  }
 
   // NOTE: compression sampling is done here in the same thread as building
   // the uncompressed block because of the requirements to call table
@@ -2252,6 +2314,9 @@ void BlockBasedTableBuilder::EmitBlock(std::string& uncompressed,
   WriteBlock(uncompressed, &r->pending_handle, BlockType::kData,
              &skip_delta_encoding);
   if (LIKELY(ok())) {
+    if (r->data_block_value_stats) {
+      r->data_block_value_stats->OnBlockWritten(r->pending_handle.offset());
+    }
     // We do not emit the index entry for a block until we have seen the
     // first key for the next data block.  This allows us to use shorter
     // keys in the index block.  For example, consider a block boundary
@@ -3277,6 +3342,19 @@ void BlockBasedTableBuilder::WriteRangeDelBlock(
   }
 }
 
+void BlockBasedTableBuilder::WriteDataBlockValueStatsBlock(
+    MetaIndexBuilder* meta_index_builder) {
+  if (LIKELY(ok()) && rep_->data_block_value_stats &&
+      !rep_->data_block_value_stats->empty()) {
+    BlockHandle data_block_value_stats_handle;
+    WriteMaybeCompressedBlock(rep_->data_block_value_stats->Finish(),
+                              kNoCompression, &data_block_value_stats_handle,
+                              BlockType::kProperties);
+    meta_index_builder->Add(kDataBlockValueStatsBlockName,
+                            data_block_value_stats_handle);
+  }
+}
+
 void BlockBasedTableBuilder::WriteFooter(BlockHandle& metaindex_block_handle,
                                          BlockHandle& index_block_handle) {
   assert(LIKELY(ok()));
@@ -3544,15 +3622,17 @@ Status BlockBasedTableBuilder::Finish() {
   //    2. [meta block: index]
   //    3. [meta block: compression dictionary]
   //    4. [meta block: range deletion tombstone]
-  //    5. [meta block: properties]
-  //    6. [metaindex block]
-  //    7. Footer
+  //    5. [meta block: data block value stats]
+  //    6. [meta block: properties]
+  //    7. [metaindex block]
+  //    8. Footer
   BlockHandle metaindex_block_handle, index_block_handle;
   MetaIndexBuilder meta_index_builder;
   WriteFilterBlock(&meta_index_builder);
   WriteIndexBlock(&meta_index_builder, &index_block_handle);
   WriteCompressionDictBlock(&meta_index_builder);
   WriteRangeDelBlock(&meta_index_builder);
+  WriteDataBlockValueStatsBlock(&meta_index_builder);
   WritePropertiesBlock(&meta_index_builder);
   if (LIKELY(ok())) {
     // flush the meta index block
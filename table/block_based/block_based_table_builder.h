@@ -66,6 +66,11 @@ class BlockBasedTableBuilder : public TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called
   void Add(const Slice& key, const Slice& value) override;
 
+  bool SupportsFilterKeyHashes() const override;
+  void HashFilterKey(const Slice& key, FilterKeyHashes* hashes) const override;
+  void AddWithFilterKeyHashes(const Slice& key, const Slice& value,
+                              const FilterKeyHashes& hashes) override;
+
   // Return non-ok iff some error has been detected.
   Status status() const override;
 
@@ -185,6 +190,7 @@ class BlockBasedTableBuilder : public TableBuilder {
   void WritePropertiesBlock(MetaIndexBuilder* meta_index_builder);
   void WriteCompressionDictBlock(MetaIndexBuilder* meta_index_builder);
   void WriteRangeDelBlock(MetaIndexBuilder* meta_index_builder);
+  void WriteDataBlockValueStatsBlock(MetaIndexBuilder* meta_index_builder);
   void WriteFooter(BlockHandle& metaindex_block_handle,
                    BlockHandle& index_block_handle);
 
@@ -220,6 +226,10 @@ class BlockBasedTableBuilder : public TableBuilder {
   struct WorkingAreaPair;
   struct ParallelCompressionRep;
 
+  // Add(), with the filter hashes of key if not nullptr
+  void AddImpl(const Slice& key, const Slice& value,
+               const FilterKeyHashes* filter_key_hashes);
+
   // Advanced operation: flush any buffered key/value pairs to file.
   // Can be used to ensure that two adjacent entries never live in
   // the same data block.  Most clients should not need to use this method.
@@ -309,6 +309,10 @@ static struct BlockBasedTableTypeInfo {
              offsetof(struct BlockBasedTableOptions,
                       optimize_key_common_prefix),
              &block_base_table_optimize_key_common_prefix_string_map)},
+        {"align_index_partitions_to_prefix",
+         {offsetof(struct BlockBasedTableOptions,
+                   align_index_partitions_to_prefix),
+          OptionType::kBoolean, OptionVerificationType::kNormal}},
         {"index_shortening",
          OptionTypeInfo::Enum<BlockBasedTableOptions::IndexShorteningMode>(
              offsetof(struct BlockBasedTableOptions, index_shortening),
@@ -384,6 +388,12 @@ static struct BlockBasedTableTypeInfo {
          {offsetof(struct BlockBasedTableOptions,
                    separate_key_value_in_data_block),
           OptionType::kBoolean, OptionVerificationType::kNormal}},
+        {"embedded_blob_min_size",
+         {offsetof(struct BlockBasedTableOptions, embedded_blob_min_size),
+          OptionType::kUInt64T, OptionVerificationType::kNormal}},
+        {"data_block_value_stats",
+         {offsetof(struct BlockBasedTableOptions, data_block_value_stats),
+          OptionType::kBoolean, OptionVerificationType::kNormal}},
         {"uniform_cv_threshold",
          {offsetof(struct BlockBasedTableOptions, uniform_cv_threshold),
           OptionType::kDouble, OptionVerificationType::kNormal}},
@@ -707,6 +717,17 @@ Status BlockBasedTableFactory::ValidateOptions(
         "Unsupported BlockBasedTable format_version. Please check "
         "include/rocksdb/table.h for more info");
   }
+  if (table_options_.embedded_blob_min_size > 0) {
+    if (!FormatVersionUsesCompressionManagerName(
+            table_options_.format_version)) {
+      return Status::InvalidArgument(
+          "embedded_blob_min_size requires format_version >= 7");
+    }
+    if (table_options_.block_align) {
+      return Status::InvalidArgument(
+          "Enable block_align, but embedded_blob_min_size is set");
+    }
+  }
   bool using_builtin_compatible_compression = true;
   if (cf_opts.compression_manager &&
       strcmp(cf_opts.compression_manager->CompatibilityName(),
@@ -936,6 +957,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  optimize_key_common_prefix: %d\n",
            static_cast<int>(table_options_.optimize_key_common_prefix));
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  align_index_partitions_to_prefix: %d\n",
+           table_options_.align_index_partitions_to_prefix);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  index_shortening: %d\n",
            static_cast<int>(table_options_.index_shortening));
   ret.append(buffer);
@@ -1017,6 +1041,12 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  format_version: %d\n",
            table_options_.format_version);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  embedded_blob_min_size: %" PRIu64 "\n",
+           table_options_.embedded_blob_min_size);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_value_stats: %d\n",
+           table_options_.data_block_value_stats);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  uniform_cv_threshold: %lf\n",
            table_options_.uniform_cv_threshold);
   ret.append(buffer);
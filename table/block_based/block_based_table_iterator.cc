@@ -641,6 +641,9 @@ void BlockBasedTableIterator::FindKeyForward() {
 }
 
 void BlockBasedTableIterator::FindBlockForward() {
+  // Whether a data block skipped for ReadOptions::scan_predicate contains the
+  // upper bound, so that the blocks after it are out of bound
+  bool skipped_block_reaches_upper_bound = false;
   // TODO the while loop inherits from two-level-iterator. We don't know
   // whether a block can be empty so it can be replaced by an "if".
   do {
@@ -657,10 +660,11 @@ void BlockBasedTableIterator::FindBlockForward() {
     // a scan range when the block separator >= iterate_upper_bound but
     // valid keys still remain in the current range's blocks.
     bool next_block_is_out_of_bound =
-        !multi_scan_read_set_ && IsIndexAtCurr() &&
-        read_options_.iterate_upper_bound != nullptr &&
-        block_iter_points_to_real_block_ &&
-        block_upper_bound_check_ == BlockUpperBound::kUpperBoundInCurBlock;
+        skipped_block_reaches_upper_bound ||
+        (!multi_scan_read_set_ && IsIndexAtCurr() &&
+         read_options_.iterate_upper_bound != nullptr &&
+         block_iter_points_to_real_block_ &&
+         block_upper_bound_check_ == BlockUpperBound::kUpperBoundInCurBlock);
 
     assert(!next_block_is_out_of_bound ||
            user_comparator_.CompareWithoutTimestamp(
@@ -726,6 +730,16 @@ void BlockBasedTableIterator::FindBlockForward() {
       }
       IndexValue v = index_iter_->value();
 
+      if (!multi_scan_read_set_ && ScanPredicateExcludesBlock(v.handle)) {
+        skipped_block_reaches_upper_bound =
+            read_options_.iterate_upper_bound != nullptr &&
+            user_comparator_.CompareWithoutTimestamp(
+                *read_options_.iterate_upper_bound, /*a_has_ts=*/false,
+                index_iter_->user_key(), /*b_has_ts=*/true) <= 0;
+        // Move on to the next block; block_iter_ is invalid
+        continue;
+      }
+
       if (!v.first_internal_key.empty() && allow_unprepared_value_) {
         // Index contains the first key of the block. Defer reading the block.
         is_at_first_key_from_index_ = true;
@@ -741,6 +755,30 @@ void BlockBasedTableIterator::FindBlockForward() {
   } while (!block_iter_.Valid());
 }
 
+bool BlockBasedTableIterator::ScanPredicateExcludesBlock(
+    const BlockHandle& handle) const {
+  const ScanPredicate* predicate = read_options_.scan_predicate;
+  if (predicate == nullptr) {
+    return false;
+  }
+  const BlockBasedTable::Rep* rep = table_->get_rep();
+  // Skipping entries of a block is only safe if no newer entry of the same
+  // key can need them: the stats only cover blocks of sequence number zero
+  // plain values, which stops holding once a global sequence number is
+  // assigned, and the value may be the base of a newer merge operand.
+  if (rep->data_block_value_stats == nullptr ||
+      rep->ioptions.merge_operator != nullptr ||
+      (rep->global_seqno != kDisableGlobalSequenceNumber &&
+       rep->global_seqno != 0)) {
+    return false;
+  }
+  if (rep->data_block_value_stats->MayMatch(handle.offset(), *predicate)) {
+    return false;
+  }
+  RecordTick(table_->GetStatistics(), SCAN_PREDICATE_DATA_BLOCKS_SKIPPED);
+  return true;
+}
+
 void BlockBasedTableIterator::FindKeyBackward() {
   while (!block_iter_.Valid()) {
     if (!block_iter_.status().ok()) {
@@ -426,6 +426,9 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   bool MaterializeCurrentBlock();
   void FindKeyForward();
   void FindBlockForward();
+  // Returns true if ReadOptions::scan_predicate cannot match any entry of the
+  // data block at `handle`, based on the table's data block value stats.
+  bool ScanPredicateExcludesBlock(const BlockHandle& handle) const;
   void FindKeyBackward();
   void CheckOutOfBound();
 
@@ -1023,6 +1023,8 @@ Status BlockBasedTable::Open(
   if (!s.ok()) {
     return s;
   }
+  new_table->ReadDataBlockValueStatsBlock(ro, prefetch_buffer.get(),
+                                          metaindex_iter.get());
   rep->verify_checksum_set_on_open = ro.verify_checksums;
   s = new_table->PrefetchIndexAndFilterBlocks(
       ro, prefetch_buffer.get(), metaindex_iter.get(), new_table.get(),
@@ -1298,10 +1300,10 @@ Status BlockBasedTable::ResolveEmbeddedBlob(const ReadOptions& read_options,
   // trailer with a shrink (no extra copy on the common non-mmap path).
   value->resize(record_size);
   s = ReadAndVerifySimpleGen2BlobRecord(
-      read_options, rep_->file.get(), blob_index.offset(), payload_size,
-      record_size, rep_->footer.checksum_type(),
-      rep_->footer.base_context_checksum(), blob_index.compression(),
-      &(*value)[0]);
+      read_options, rep_->file.get(), /*prefetch_buffer=*/nullptr,
+      blob_index.offset(), payload_size, record_size,
+      rep_->footer.checksum_type(), rep_->footer.base_context_checksum(),
+      blob_index.compression(), &(*value)[0]);
   if (!s.ok()) {
     return s;
   }
@@ -1311,7 +1313,7 @@ Status BlockBasedTable::ResolveEmbeddedBlob(const ReadOptions& read_options,
 
 Status BlockBasedTable::ResolveEmbeddedBlobPinned(
     const ReadOptions& read_options, const BlobIndex& blob_index,
-    PinnableSlice* value) const {
+    PinnableSlice* value, FilePrefetchBuffer* prefetch_buffer) const {
   assert(value != nullptr);
   size_t payload_size = 0;
   size_t record_size = 0;
@@ -1329,8 +1331,8 @@ Status BlockBasedTable::ResolveEmbeddedBlobPinned(
   // sits unused at the tail of the buffer.
   std::unique_ptr<char[]> buf(new char[record_size]);
   s = ReadAndVerifySimpleGen2BlobRecord(
-      read_options, rep_->file.get(), blob_index.offset(), payload_size,
-      record_size, rep_->footer.checksum_type(),
+      read_options, rep_->file.get(), prefetch_buffer, blob_index.offset(),
+      payload_size, record_size, rep_->footer.checksum_type(),
       rep_->footer.base_context_checksum(), blob_index.compression(),
       buf.get());
   if (!s.ok()) {
@@ -1343,7 +1345,7 @@ Status BlockBasedTable::ResolveEmbeddedBlobPinned(
 
 Status BlockBasedTable::ResolveEmbeddedBlobCached(
     const ReadOptions& read_options, const BlobIndex& blob_index,
-    PinnableSlice* value) const {
+    PinnableSlice* value, FilePrefetchBuffer* prefetch_buffer) const {
   assert(value != nullptr);
   assert(rep_->blob_source_ != nullptr);
   size_t payload_size = 0;
@@ -1358,8 +1360,8 @@ Status BlockBasedTable::ResolveEmbeddedBlobCached(
   // we only pass the SST's base cache key. This keeps embedded blob records
   // collision-free with data blocks even when blob_cache == block_cache.
   return rep_->blob_source_->GetSimpleGen2Blob(
-      read_options, rep_->base_cache_key, rep_->file.get(), blob_index.offset(),
-      payload_size, rep_->footer.checksum_type(),
+      read_options, rep_->base_cache_key, rep_->file.get(), prefetch_buffer,
+      blob_index.offset(), payload_size, rep_->footer.checksum_type(),
       rep_->footer.base_context_checksum(), blob_index.compression(), value,
       /*bytes_read=*/nullptr);
 }
@@ -1431,11 +1433,37 @@ Status BlockBasedTable::ResolveEmbeddedBlobRangeCached(
       range_offset, range_length, value, /*bytes_read=*/nullptr);
 }
 
+std::unique_ptr<FilePrefetchBuffer>
+BlockBasedTable::NewEmbeddedBlobPrefetchBuffer(
+    const ReadOptions& read_options) const {
+  const size_t readahead_size =
+      (read_options.readahead_size != 0)
+          ? read_options.readahead_size
+          : rep_->table_options.max_auto_readahead_size;
+  if (readahead_size == 0) {
+    return nullptr;
+  }
+  // Blob records are interleaved with data blocks, so consecutive records are
+  // close but not contiguous, which defeats implicit auto readahead. Read
+  // ahead a fixed amount on every miss instead.
+  ReadaheadParams readahead_params;
+  readahead_params.initial_readahead_size = readahead_size;
+  readahead_params.max_readahead_size = readahead_size;
+  std::unique_ptr<FilePrefetchBuffer> prefetch_buffer;
+  rep_->CreateFilePrefetchBuffer(
+      readahead_params, &prefetch_buffer, /*readaheadsize_cb=*/nullptr,
+      read_options.io_activity == Env::IOActivity::kCompaction
+          ? FilePrefetchBufferUsage::kCompactionPrefetch
+          : FilePrefetchBufferUsage::kUserScanPrefetch);
+  return prefetch_buffer;
+}
+
 Status BlockBasedTable::MaybeResolveEmbeddedValue(
     const ReadOptions& read_options, const Slice& internal_key,
     const Slice& value, std::string* resolved_internal_key,
     std::string* resolved_value, bool* resolved, PinnableSlice* pinned_value,
-    bool* value_pinned, bool skip_wide_column_entities) const {
+    bool* value_pinned, bool skip_wide_column_entities,
+    FilePrefetchBuffer* prefetch_buffer) const {
   assert(resolved_internal_key != nullptr);
   assert(resolved_value != nullptr);
   assert(resolved != nullptr);
@@ -1486,19 +1514,22 @@ Status BlockBasedTable::MaybeResolveEmbeddedValue(
     // `resolved_value`.
     if (rep_->blob_source_ != nullptr) {
       if (pinned_value != nullptr) {
-        s = ResolveEmbeddedBlobCached(read_options, blob_index, pinned_value);
+        s = ResolveEmbeddedBlobCached(read_options, blob_index, pinned_value,
+                                      prefetch_buffer);
         if (s.ok() && value_pinned != nullptr) {
           *value_pinned = true;
         }
       } else {
         PinnableSlice local_value;
-        s = ResolveEmbeddedBlobCached(read_options, blob_index, &local_value);
+        s = ResolveEmbeddedBlobCached(read_options, blob_index, &local_value,
+                                      prefetch_buffer);
         if (s.ok()) {
           resolved_value->assign(local_value.data(), local_value.size());
         }
       }
     } else if (pinned_value != nullptr) {
-      s = ResolveEmbeddedBlobPinned(read_options, blob_index, pinned_value);
+      s = ResolveEmbeddedBlobPinned(read_options, blob_index, pinned_value,
+                                    prefetch_buffer);
       if (s.ok() && value_pinned != nullptr) {
         *value_pinned = true;
       }
@@ -1683,6 +1714,31 @@ Status BlockBasedTable::ReadRangeDelBlock(
   return s;
 }
 
+void BlockBasedTable::ReadDataBlockValueStatsBlock(
+    const ReadOptions& ro, FilePrefetchBuffer* prefetch_buffer,
+    InternalIterator* meta_iter) {
+  BlockHandle handle;
+  Status s =
+      FindOptionalMetaBlock(meta_iter, kDataBlockValueStatsBlockName, &handle);
+  if (s.ok() && !handle.IsNull()) {
+    BlockContents contents;
+    s = BlockFetcher(rep_->file.get(), prefetch_buffer, rep_->footer, ro,
+                     handle, &contents, rep_->ioptions, false /* decompress */,
+                     false /*maybe_compressed*/, BlockType::kProperties,
+                     nullptr /*decompressor*/, rep_->persistent_cache_options)
+            .ReadBlockContents();
+    if (s.ok()) {
+      s = DataBlockValueStatsReader::Create(contents.data.ToString(),
+                                            &rep_->data_block_value_stats);
+    }
+  }
+  if (!s.ok()) {
+    ROCKS_LOG_WARN(rep_->ioptions.logger,
+                   "Failed to read data block value stats from file %s: %s",
+                   rep_->file->file_name().c_str(), s.ToString().c_str());
+  }
+}
+
 Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
     const ReadOptions& ro, FilePrefetchBuffer* prefetch_buffer,
     InternalIterator* meta_iter, BlockBasedTable* new_table, bool prefetch_all,
@@ -1958,6 +2014,9 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (rep_->table_properties) {
     usage += rep_->table_properties->ApproximateMemoryUsage();
   }
+  if (rep_->data_block_value_stats) {
+    usage += rep_->data_block_value_stats->ApproximateMemoryUsage();
+  }
   return usage;
 }
 
@@ -2904,6 +2963,82 @@ Status BlockBasedTable::MultiGetFilter(const ReadOptions& read_options,
   return Status::OK();
 }
 
+Status BlockBasedTable::PlanMultiGetIO(const ReadOptions& read_options,
+                                       const SliceTransform* prefix_extractor,
+                                       bool skip_filters,
+                                       const MultiGetRange* mget_range,
+                                       std::shared_ptr<IOJob>* job) {
+  if (!read_options.fill_cache ||
+      !ShouldUseDataBlockCacheForIterator(rep_->table_options, read_options,
+                                          rep_->ioptions.allow_mmap_reads)) {
+    // The lookups would not find the blocks read ahead
+    return Status::NotSupported();
+  }
+  MultiGetRange sst_file_range(*mget_range, mget_range->begin(),
+                               mget_range->end());
+  BlockCacheLookupContext lookup_context{
+      TableReaderCaller::kUserMultiGet, BlockCacheTraceHelper::kReservedGetId,
+      /*_get_from_user_specified_snapshot=*/read_options.snapshot != nullptr};
+
+  // Same as FullFilterKeysMayMatch(), but leaving the stats to the lookups
+  FilterBlockReader* const filter =
+      !skip_filters ? rep_->filter.get() : nullptr;
+  if (filter != nullptr && !sst_file_range.empty()) {
+    if (rep_->whole_key_filtering) {
+      filter->KeysMayMatch(&sst_file_range, &lookup_context, read_options);
+    } else if (!PrefixExtractorChanged(prefix_extractor)) {
+      filter->PrefixesMayMatch(&sst_file_range, prefix_extractor,
+                               &lookup_context, read_options);
+    }
+  }
+  if (sst_file_range.empty()) {
+    return Status::OK();
+  }
+
+  IndexBlockIter iiter_on_stack;
+  bool need_upper_bound_check = false;
+  if (rep_->index_type == BlockBasedTableOptions::kHashSearch) {
+    need_upper_bound_check = PrefixExtractorChanged(prefix_extractor);
+  }
+  auto iiter =
+      NewIndexIterator(read_options, need_upper_bound_check, &iiter_on_stack,
+                       /*get_context=*/nullptr, &lookup_context);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (iiter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(iiter);
+  }
+
+  if (*job == nullptr) {
+    *job = std::make_shared<IOJob>();
+    (*job)->table = this;
+    (*job)->job_options.read_options = read_options;
+  }
+  std::vector<BlockHandle>& block_handles = (*job)->block_handles;
+  for (auto miter = sst_file_range.begin(); miter != sst_file_range.end();
+       ++miter) {
+    iiter->Seek(miter->ikey);
+    if (!iiter->Valid()) {
+      // Past the last block, or an error, which the lookup will report
+      continue;
+    }
+    IndexValue v = iiter->value();
+    if (!v.first_internal_key.empty() && !skip_filters &&
+        UserComparatorWrapper(rep_->internal_comparator.user_comparator())
+                .CompareWithoutTimestamp(
+                    ExtractUserKey(miter->ikey),
+                    ExtractUserKey(v.first_internal_key)) < 0) {
+      // Between two blocks
+      continue;
+    }
+    // The keys are sorted, so those in the same block are adjacent
+    if (block_handles.empty() ||
+        block_handles.back().offset() != v.handle.offset()) {
+      block_handles.push_back(v.handle);
+    }
+  }
+  return Status::OK();
+}
+
 Status BlockBasedTable::Prefetch(const ReadOptions& read_options,
                                  const Slice* const begin,
                                  const Slice* const end) {
@@ -3069,6 +3204,10 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kRangeDeletion;
   }
 
+  if (meta_block_name == kDataBlockValueStatsBlockName) {
+    return BlockType::kProperties;
+  }
+
   if (meta_block_name == kHashIndexPrefixesBlock) {
     return BlockType::kHashIndexPrefixes;
   }
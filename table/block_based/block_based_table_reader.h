@@ -27,6 +27,7 @@
 #include "table/block_based/block_cache.h"
 #include "table/block_based/block_type.h"
 #include "table/block_based/cachable_entry.h"
+#include "table/block_based/data_block_value_stats.h"
 #include "table/block_based/filter_block.h"
 #include "table/block_based/uncompression_dict_reader.h"
 #include "table/embedded_blob_sst.h"
@@ -222,9 +223,11 @@ class BlockBasedTable : public TableReader, public SameFileBlobReader {
   // Like ResolveEmbeddedBlob, but reads the payload into a heap buffer owned by
   // `value` (via a registered cleanup) and pins it, avoiding a copy. Use on the
   // Get()/MultiGet() path so the resolved value can be pinned into the output.
-  Status ResolveEmbeddedBlobPinned(const ReadOptions& read_options,
-                                   const BlobIndex& blob_index,
-                                   PinnableSlice* value) const;
+  // The read is served from `prefetch_buffer` when non-null and possible.
+  Status ResolveEmbeddedBlobPinned(
+      const ReadOptions& read_options, const BlobIndex& blob_index,
+      PinnableSlice* value,
+      FilePrefetchBuffer* prefetch_buffer = nullptr) const;
 
   // Like ResolveEmbeddedBlobPinned, but routes the read through the CFD's
   // BlobSource so the payload is served from / inserted into the blob value
@@ -233,9 +236,10 @@ class BlockBasedTable : public TableReader, public SameFileBlobReader {
   // data blocks; see GetSimpleGen2BlobCacheKey), so embedded blob records stay
   // collision-free with data blocks even when the blob cache and block cache
   // are shared. Must only be called when rep_->blob_source_ is non-null.
-  Status ResolveEmbeddedBlobCached(const ReadOptions& read_options,
-                                   const BlobIndex& blob_index,
-                                   PinnableSlice* value) const;
+  Status ResolveEmbeddedBlobCached(
+      const ReadOptions& read_options, const BlobIndex& blob_index,
+      PinnableSlice* value,
+      FilePrefetchBuffer* prefetch_buffer = nullptr) const;
 
   // Range-read counterpart of ResolveEmbeddedBlobCached: resolve only
   // [range_offset, range_offset + range_length) of an uncompressed same-file
@@ -273,12 +277,23 @@ class BlockBasedTable : public TableReader, public SameFileBlobReader {
   // unresolved (returned raw, `resolved` stays false) so the Get()/MultiGet()
   // path can hand the raw entity to GetContext for zero-copy same-file column
   // resolution. The iterator path leaves it false to keep re-serializing.
+  //
+  // A whole-value same-file blob is read through `prefetch_buffer` when it is
+  // non-null (see NewEmbeddedBlobPrefetchBuffer()).
   Status MaybeResolveEmbeddedValue(
       const ReadOptions& read_options, const Slice& internal_key,
       const Slice& value, std::string* resolved_internal_key,
       std::string* resolved_value, bool* resolved,
       PinnableSlice* pinned_value = nullptr, bool* value_pinned = nullptr,
-      bool skip_wide_column_entities = false) const;
+      bool skip_wide_column_entities = false,
+      FilePrefetchBuffer* prefetch_buffer = nullptr) const;
+
+  // Returns a prefetch buffer that coalesces the reads of same-file blob
+  // records that a forward scan resolves one after the other, by reading
+  // ahead ReadOptions::readahead_size bytes, or max_auto_readahead_size if
+  // that is 0. Returns nullptr if both are 0.
+  std::unique_ptr<FilePrefetchBuffer> NewEmbeddedBlobPrefetchBuffer(
+      const ReadOptions& read_options) const;
 
   // Reusable scratch for resolving embedded values across a Get()/MultiGet()
   // loop, so the hot loop performs no per-entry allocation. Construct one per
@@ -322,6 +337,11 @@ class BlockBasedTable : public TableReader, public SameFileBlobReader {
                         const SliceTransform* prefix_extractor,
                         MultiGetRange* mget_range) override;
 
+  Status PlanMultiGetIO(const ReadOptions& read_options,
+                        const SliceTransform* prefix_extractor,
+                        bool skip_filters, const MultiGetRange* mget_range,
+                        std::shared_ptr<IOJob>* job) override;
+
   DECLARE_SYNC_AND_ASYNC_OVERRIDE(void, MultiGet,
                                   const ReadOptions& readOptions,
                                   const MultiGetContext::Range* mget_range,
@@ -687,6 +707,11 @@ class BlockBasedTable : public TableReader, public SameFileBlobReader {
                            InternalIterator* meta_iter,
                            const InternalKeyComparator& internal_comparator,
                            BlockCacheLookupContext* lookup_context);
+  // Loads the stats written with BlockBasedTableOptions::data_block_value_stats
+  // if present. Failures only disable their use.
+  void ReadDataBlockValueStatsBlock(const ReadOptions& ro,
+                                    FilePrefetchBuffer* prefetch_buffer,
+                                    InternalIterator* meta_iter);
   // If index and filter blocks do not need to be pinned, `prefetch_all`
   // determines whether they will be read and added to cache. When
   // `avoid_shared_metadata_cache` is set, open-time metadata reads avoid the
@@ -832,6 +857,10 @@ struct BlockBasedTable::Rep {
 
   std::shared_ptr<FragmentedRangeTombstoneList> fragmented_range_dels;
 
+  // See BlockBasedTableOptions::data_block_value_stats. nullptr if the file
+  // has none.
+  std::unique_ptr<DataBlockValueStatsReader> data_block_value_stats;
+
   // Context for block cache CreateCallback
   BlockCreateContext create_context;
 
@@ -4,6 +4,7 @@
 //  COPYING file in the root directory) and Apache 2.0 License
 //  (found in the LICENSE.Apache file in the root directory).
 
+#include <array>
 #include <optional>
 #include <type_traits>
 
@@ -861,6 +862,44 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
     }
   }
 
+  // Verify the checksums of all the blocks read in one batch (see
+  // VerifyBlockChecksums()), for the blocks processed below
+  std::array<Status, MultiGetContext::MAX_BATCH_SIZE> checksum_statuses;
+  if (options.verify_checksums) {
+    std::array<const char*, MultiGetContext::MAX_BATCH_SIZE> block_data;
+    std::array<size_t, MultiGetContext::MAX_BATCH_SIZE> block_sizes;
+    std::array<uint64_t, MultiGetContext::MAX_BATCH_SIZE> block_offsets;
+    std::array<size_t, MultiGetContext::MAX_BATCH_SIZE> block_idxs;
+    std::array<Status, MultiGetContext::MAX_BATCH_SIZE> block_statuses;
+    size_t num_blocks = 0;
+    size_t block_idx = 0;
+    for (const BlockHandle& handle : *handles) {
+      if (handle.IsNull()) {
+        continue;
+      }
+      assert(block_idx < MultiGetContext::MAX_BATCH_SIZE);
+      const FSReadRequest& req = read_reqs[req_idx_for_block[block_idx]];
+      size_t req_offset = req_offset_for_block[block_idx];
+      // Others fail below without a checksum
+      if (req.status.ok() && req.result.size() == req.len &&
+          req_offset + BlockSizeWithTrailer(handle) <= req.result.size()) {
+        block_data[num_blocks] = req.result.data() + req_offset;
+        block_sizes[num_blocks] = handle.size();
+        block_offsets[num_blocks] = handle.offset();
+        block_idxs[num_blocks] = block_idx;
+        ++num_blocks;
+      }
+      ++block_idx;
+    }
+    VerifyBlockChecksums(footer, block_data.data(), block_sizes.data(),
+                         block_offsets.data(), num_blocks,
+                         rep_->file->file_name(), BlockType::kData,
+                         block_statuses.data());
+    for (size_t i = 0; i < num_blocks; ++i) {
+      checksum_statuses[block_idxs[i]] = std::move(block_statuses[i]);
+    }
+  }
+
   idx_in_batch = 0;
   size_t valid_batch_idx = 0;
   for (auto mget_iter = batch->begin(); mget_iter != batch->end();
@@ -874,9 +913,9 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
     assert(valid_batch_idx < req_idx_for_block.size());
     assert(valid_batch_idx < req_offset_for_block.size());
     assert(req_idx_for_block[valid_batch_idx] < read_reqs.size());
-    size_t& req_idx = req_idx_for_block[valid_batch_idx];
-    size_t& req_offset = req_offset_for_block[valid_batch_idx];
-    valid_batch_idx++;
+    const size_t block_idx = valid_batch_idx++;
+    size_t& req_idx = req_idx_for_block[block_idx];
+    size_t& req_offset = req_offset_for_block[block_idx];
     FSReadRequest& req = read_reqs[req_idx];
     Status s = req.status;
     if (s.ok()) {
@@ -913,16 +952,9 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
 #endif
 
       if (options.verify_checksums) {
-        PERF_TIMER_GUARD(block_checksum_time);
         const char* data = serialized_block.data.data();
-        // Since the scratch might be shared, the offset of the data block in
-        // the buffer might not be 0. req.result.data() only point to the
-        // begin address of each read request, we need to add the offset
-        // in each read request. Checksum is stored in the block trailer,
-        // beyond the payload size.
-        s = VerifyBlockChecksum(footer, data, handle.size(),
-                                rep_->file->file_name(), handle.offset(),
-                                BlockType::kData);
+        // Verified above
+        s = std::move(checksum_statuses[block_idx]);
         RecordTick(ioptions.stats, BLOCK_CHECKSUM_COMPUTE_COUNT);
         if (!s.ok()) {
           RecordTick(ioptions.stats, BLOCK_CHECKSUM_MISMATCH_COUNT);
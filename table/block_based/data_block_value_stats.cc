@@ -0,0 +1,99 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/data_block_value_stats.h"
+
+#include <algorithm>
+
+#include "db/dbformat.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+void DataBlockValueStatsBuilder::Add(const Slice& ikey, const Slice& value) {
+  if (!current_.eligible) {
+    return;
+  }
+  const uint64_t packed = ExtractInternalKeyFooter(ikey);
+  SequenceNumber seq;
+  ValueType type;
+  UnPackSequenceAndType(packed, &seq, &type);
+  if (type != kTypeValue || seq != 0) {
+    current_.eligible = false;
+    return;
+  }
+  const Slice prefix(value.data(), std::min(value.size(), kPrefixLen));
+  if (!current_.has_values) {
+    current_.smallest.assign(prefix.data(), prefix.size());
+    current_.largest.assign(prefix.data(), prefix.size());
+    current_.has_values = true;
+  } else if (prefix.compare(current_.smallest) < 0) {
+    current_.smallest.assign(prefix.data(), prefix.size());
+  } else if (prefix.compare(current_.largest) > 0) {
+    current_.largest.assign(prefix.data(), prefix.size());
+  }
+}
+
+void DataBlockValueStatsBuilder::FinishBlock() {
+  finished_.emplace_back(std::move(current_));
+  current_ = BlockStats();
+}
+
+void DataBlockValueStatsBuilder::OnBlockWritten(uint64_t offset) {
+  assert(!finished_.empty());
+  if (finished_.empty()) {
+    return;
+  }
+  const BlockStats& stats = finished_.front();
+  if (stats.eligible && stats.has_values) {
+    PutVarint64(&contents_, offset);
+    PutLengthPrefixedSlice(&contents_, stats.smallest);
+    PutLengthPrefixedSlice(&contents_, stats.largest);
+  }
+  finished_.pop_front();
+}
+
+Status DataBlockValueStatsReader::Create(
+    std::string&& contents,
+    std::unique_ptr<DataBlockValueStatsReader>* reader) {
+  std::unique_ptr<DataBlockValueStatsReader> new_reader(
+      new DataBlockValueStatsReader(std::move(contents)));
+  Slice input(new_reader->contents_);
+  while (!input.empty()) {
+    Entry entry;
+    if (!GetVarint64(&input, &entry.offset) ||
+        !GetLengthPrefixedSlice(&input, &entry.smallest) ||
+        !GetLengthPrefixedSlice(&input, &entry.largest)) {
+      return Status::Corruption("Malformed data block value stats");
+    }
+    if (!new_reader->entries_.empty() &&
+        entry.offset <= new_reader->entries_.back().offset) {
+      return Status::Corruption("Unsorted data block value stats");
+    }
+    new_reader->entries_.push_back(entry);
+  }
+  *reader = std::move(new_reader);
+  return Status::OK();
+}
+
+bool DataBlockValueStatsReader::MayMatch(
+    uint64_t offset, const ScanPredicate& predicate) const {
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), offset,
+      [](const Entry& entry, uint64_t o) { return entry.offset < o; });
+  if (it == entries_.end() || it->offset != offset) {
+    // No stats for this block
+    return true;
+  }
+  return predicate.MayMatchValuePrefixRange(
+      it->smallest, it->largest, DataBlockValueStatsBuilder::kPrefixLen);
+}
+
+size_t DataBlockValueStatsReader::ApproximateMemoryUsage() const {
+  return sizeof(*this) + contents_.capacity() +
+         entries_.capacity() * sizeof(Entry);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,93 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/scan_predicate.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Per data block statistics on values, written to the
+// kDataBlockValueStatsBlockName meta block with
+// BlockBasedTableOptions::data_block_value_stats.
+//
+// Stats are only recorded for data blocks whose entries are all plain values
+// (kTypeValue) at sequence number zero, as typically found in the bottommost
+// level. No older version of such a key exists, so an iterator may skip an
+// entry of such a block that does not match ReadOptions::scan_predicate
+// without exposing anything that the predicate would not also have hidden.
+//
+// The meta block holds, for each such block in file order, its offset
+// (varint64) and the smallest and largest of the first kPrefixLen bytes of
+// its values (length-prefixed).
+class DataBlockValueStatsBuilder {
+ public:
+  static constexpr size_t kPrefixLen = 16;
+
+  // Called for each entry added to the current data block.
+  void Add(const Slice& ikey, const Slice& value);
+
+  // Called when the current data block is finished, which can be before the
+  // block is written when the table builder buffers blocks.
+  void FinishBlock();
+
+  // Called when the oldest finished block that was not yet written is
+  // written at `offset`.
+  void OnBlockWritten(uint64_t offset);
+
+  bool empty() const { return contents_.empty(); }
+
+  // Returns the contents of the meta block.
+  Slice Finish() { return contents_; }
+
+ private:
+  struct BlockStats {
+    bool eligible = true;
+    bool has_values = false;
+    std::string smallest;
+    std::string largest;
+  };
+
+  BlockStats current_;
+  // Finished blocks waiting for their offsets
+  std::deque<BlockStats> finished_;
+  std::string contents_;
+};
+
+// Reads the kDataBlockValueStatsBlockName meta block.
+class DataBlockValueStatsReader {
+ public:
+  static Status Create(std::string&& contents,
+                       std::unique_ptr<DataBlockValueStatsReader>* reader);
+
+  // Returns false if no entry of the data block at `offset` can match
+  // `predicate`.
+  bool MayMatch(uint64_t offset, const ScanPredicate& predicate) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  struct Entry {
+    uint64_t offset;
+    Slice smallest;
+    Slice largest;
+  };
+
+  explicit DataBlockValueStatsReader(std::string&& contents)
+      : contents_(std::move(contents)) {}
+
+  const std::string contents_;
+  // Sorted by offset, pointing into contents_
+  std::vector<Entry> entries_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -10,11 +10,13 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 #include <string>
 
 #include "db/blob/blob_index.h"
 #include "db/dbformat.h"
 #include "db/pinned_iterators_manager.h"
+#include "file/file_prefetch_buffer.h"
 #include "rocksdb/slice.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/internal_iterator.h"
@@ -91,21 +93,25 @@ class EmbeddedBlobResolvingIterator : public InternalIterator {
 
   void SeekToFirst() override {
     ResetState();
+    ResetValueReadahead();
     iter_->SeekToFirst();
     MaybeEagerlyMaterialize();
   }
   void SeekToLast() override {
     ResetState();
+    ResetValueReadahead();
     iter_->SeekToLast();
     MaybeEagerlyMaterialize();
   }
   void Seek(const Slice& target) override {
     ResetState();
+    ResetValueReadahead();
     iter_->Seek(target);
     MaybeEagerlyMaterialize();
   }
   void SeekForPrev(const Slice& target) override {
     ResetState();
+    ResetValueReadahead();
     iter_->SeekForPrev(target);
     MaybeEagerlyMaterialize();
   }
@@ -136,6 +142,7 @@ class EmbeddedBlobResolvingIterator : public InternalIterator {
   }
   void Prev() override {
     ResetState();
+    ResetValueReadahead();
     iter_->Prev();
     MaybeEagerlyMaterialize();
   }
@@ -261,6 +268,28 @@ class EmbeddedBlobResolvingIterator : public InternalIterator {
     }
   }
 
+  // Forward scans that resolve more than kValueReadsBeforeReadahead same-file
+  // blob values in a row read the following blob records through a prefetch
+  // buffer, which coalesces them into large reads. Any other repositioning
+  // starts over.
+  static constexpr uint64_t kValueReadsBeforeReadahead = 2;
+
+  void ResetValueReadahead() {
+    sequential_value_reads_ = 0;
+    value_prefetch_buffer_.reset();
+  }
+
+  FilePrefetchBuffer* GetValuePrefetchBuffer() const {
+    if (++sequential_value_reads_ <= kValueReadsBeforeReadahead) {
+      return nullptr;
+    }
+    if (value_prefetch_buffer_ == nullptr) {
+      value_prefetch_buffer_ =
+          table_->NewEmbeddedBlobPrefetchBuffer(read_options_);
+    }
+    return value_prefetch_buffer_.get();
+  }
+
   void ResetState() {
     status_.PermitUncheckedError();
     status_ = Status::OK();
@@ -361,9 +390,13 @@ class EmbeddedBlobResolvingIterator : public InternalIterator {
     std::string resolved_value;
     bool resolved = false;
     bool value_pinned = false;
+    // key_resolved_ is only set for a whole-value same-file blob
+    FilePrefetchBuffer* prefetch_buffer =
+        key_resolved_ ? GetValuePrefetchBuffer() : nullptr;
     status_ = table_->MaybeResolveEmbeddedValue(
         read_options_, current_key, iter_->value(), &resolved_key,
-        &resolved_value, &resolved, &resolved_pinned_value_, &value_pinned);
+        &resolved_value, &resolved, &resolved_pinned_value_, &value_pinned,
+        /*skip_wide_column_entities=*/false, prefetch_buffer);
     if (!status_.ok()) {
       return false;
     }
@@ -414,6 +447,11 @@ class EmbeddedBlobResolvingIterator : public InternalIterator {
   mutable bool key_resolved_ = false;
   mutable bool value_resolved_ = false;
   mutable bool value_is_pinned_ = false;
+
+  // Readahead state for resolving the values of a forward scan, reset by any
+  // other repositioning (see GetValuePrefetchBuffer()).
+  mutable uint64_t sequential_value_reads_ = 0;
+  mutable std::unique_ptr<FilePrefetchBuffer> value_prefetch_buffer_;
 };
 
 // Eager variant (allow_unprepared_value=false, e.g. compaction): resolves the
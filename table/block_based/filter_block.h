@@ -37,6 +37,22 @@ class FilterPolicy;
 class GetContext;
 using MultiGetRange = MultiGetContext::Range;
 
+// What a filter adds for a key, hashed ahead of time by
+// FilterBlockBuilder::HashKey()
+struct FilterKeyHashes {
+  enum Kind : uint8_t {
+    // Nothing to add
+    kNone,
+    // key_hash only
+    kKey,
+    // key_hash, with alt_hash of the key's prefix
+    kKeyAndAlt,
+  };
+  uint64_t key_hash = 0;
+  uint64_t alt_hash = 0;
+  Kind kind = kNone;
+};
+
 // A FilterBlockBuilder is used to construct all of the filters for a
 // particular Table.  It generates a single string which is stored as
 // a special block in the Table, or partitioned into smaller filters.
@@ -64,6 +80,18 @@ class FilterBlockBuilder {
   virtual void AddWithPrevKey(const Slice& key_without_ts,
                               const Slice& /*prev_key_without_ts*/) = 0;
 
+  // Whether keys can be hashed ahead of time with HashKey() and added with
+  // AddHashes(), instead of with Add() or AddWithPrevKey()
+  virtual bool SupportsKeyHashes() const { return false; }
+  // Hashes what Add() would add for the key. Thread-safe, so that keys can
+  // be hashed on other threads. REQUIRES: SupportsKeyHashes()
+  virtual void HashKey(const Slice& /*key_without_ts*/,
+                       FilterKeyHashes* /*hashes*/) const {
+    assert(false);
+  }
+  // Same as Add() of the key hashed by HashKey()
+  virtual void AddHashes(const FilterKeyHashes& /*hashes*/) { assert(false); }
+
   virtual bool IsEmpty() const = 0;  // Empty == none added
   // For reporting stats on how many entries the builder considered unique
   virtual size_t EstimateEntriesAdded() = 0;
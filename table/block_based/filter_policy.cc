@@ -73,8 +73,15 @@ class XXPH3FilterBitsBuilder : public FilterBitsBuilder {
 
   ~XXPH3FilterBitsBuilder() override = default;
 
-  void AddKey(const Slice& key) override {
-    uint64_t hash = GetSliceHash64(key);
+  void AddKey(const Slice& key) override { AddKeyHash(GetSliceHash64(key)); }
+
+  void AddKeyAndAlt(const Slice& key, const Slice& alt) override {
+    AddKeyAndAltHashes(GetSliceHash64(key), GetSliceHash64(alt));
+  }
+
+  bool SupportsKeyHashes() const override { return true; }
+
+  void AddKeyHash(uint64_t hash) override {
     // Especially with prefixes, it is common to have repetition,
     // though only adjacent repetition, which we want to immediately
     // recognize and collapse for estimating true filter space
@@ -85,9 +92,7 @@ class XXPH3FilterBitsBuilder : public FilterBitsBuilder {
     }
   }
 
-  void AddKeyAndAlt(const Slice& key, const Slice& alt) override {
-    uint64_t key_hash = GetSliceHash64(key);
-    uint64_t alt_hash = GetSliceHash64(alt);
+  void AddKeyAndAltHashes(uint64_t key_hash, uint64_t alt_hash) override {
     std::optional<uint64_t> prev_key_hash;
     std::optional<uint64_t> prev_alt_hash = hash_entries_info_.prev_alt_hash;
 
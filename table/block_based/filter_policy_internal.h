@@ -43,6 +43,19 @@ class FilterBitsBuilder {
   //  AddKey(k4);            // de-dup k4<>k3 BUT NOT k4<>a3
   virtual void AddKeyAndAlt(const Slice& key, const Slice& alt) = 0;
 
+  // Whether the filter only depends on the GetSliceHash64() of the keys, so
+  // that AddKeyHash() and AddKeyAndAltHashes() can take keys hashed ahead of
+  // time, e.g. on other threads.
+  virtual bool SupportsKeyHashes() const { return false; }
+
+  // Same as AddKey(key) and AddKeyAndAlt(key, alt), with the
+  // GetSliceHash64() of key and alt. REQUIRES: SupportsKeyHashes()
+  virtual void AddKeyHash(uint64_t /*key_hash*/) { assert(false); }
+  virtual void AddKeyAndAltHashes(uint64_t /*key_hash*/,
+                                  uint64_t /*alt_hash*/) {
+    assert(false);
+  }
+
   // Called by RocksDB before Finish to populate
   // TableProperties::num_filter_entries, so should represent the
   // number of unique keys (and/or prefixes) added. MUST return 0
@@ -77,6 +77,41 @@ void FullFilterBlockBuilder::Add(const Slice& key_without_ts) {
   }
 }
 
+void FullFilterBlockBuilder::HashKey(const Slice& key_without_ts,
+                                     FilterKeyHashes* hashes) const {
+  // Same cases as Add()
+  if (prefix_extractor_ && prefix_extractor_->InDomain(key_without_ts)) {
+    Slice prefix = prefix_extractor_->Transform(key_without_ts);
+    if (whole_key_filtering_) {
+      hashes->key_hash = GetSliceHash64(key_without_ts);
+      hashes->alt_hash = GetSliceHash64(prefix);
+      hashes->kind = FilterKeyHashes::kKeyAndAlt;
+    } else {
+      hashes->key_hash = GetSliceHash64(prefix);
+      hashes->kind = FilterKeyHashes::kKey;
+    }
+  } else if (whole_key_filtering_) {
+    hashes->key_hash = GetSliceHash64(key_without_ts);
+    hashes->kind = FilterKeyHashes::kKey;
+  } else {
+    hashes->kind = FilterKeyHashes::kNone;
+  }
+}
+
+void FullFilterBlockBuilder::AddHashes(const FilterKeyHashes& hashes) {
+  switch (hashes.kind) {
+    case FilterKeyHashes::kKey:
+      filter_bits_builder_->AddKeyHash(hashes.key_hash);
+      break;
+    case FilterKeyHashes::kKeyAndAlt:
+      filter_bits_builder_->AddKeyAndAltHashes(hashes.key_hash,
+                                               hashes.alt_hash);
+      break;
+    case FilterKeyHashes::kNone:
+      break;
+  }
+}
+
 Status FullFilterBlockBuilder::Finish(
     const BlockHandle& /*last_partition_block_handle*/, Slice* filter,
     std::unique_ptr<const char[]>* filter_owner) {
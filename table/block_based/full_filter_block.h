@@ -53,6 +53,13 @@ class FullFilterBlockBuilder : public FilterBlockBuilder {
   void AddWithPrevKey(const Slice& key_without_ts,
                       const Slice& prev_key_without_ts) override;
 
+  bool SupportsKeyHashes() const override {
+    return filter_bits_builder_->SupportsKeyHashes();
+  }
+  void HashKey(const Slice& key_without_ts,
+               FilterKeyHashes* hashes) const override;
+  void AddHashes(const FilterKeyHashes& hashes) override;
+
   bool IsEmpty() const override {
     return filter_bits_builder_->EstimateEntriesAdded() == 0;
   }
@@ -17,6 +17,7 @@
 #include "db/dbformat.h"
 #include "rocksdb/comparator.h"
 #include "rocksdb/flush_block_policy.h"
+#include "rocksdb/slice_transform.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/format.h"
 
@@ -141,11 +142,12 @@ PartitionedIndexBuilder* PartitionedIndexBuilder::CreateIndexBuilder(
     const bool use_value_delta_encoding,
     const BlockBasedTableOptions& table_opt, size_t ts_sz,
     const bool persist_user_defined_timestamps, Statistics* statistics,
-    bool use_common_prefix_top, bool use_common_prefix_sub) {
+    bool use_common_prefix_top, bool use_common_prefix_sub,
+    const SliceTransform* prefix_extractor) {
   return new PartitionedIndexBuilder(
       comparator, table_opt, use_value_delta_encoding, ts_sz,
       persist_user_defined_timestamps, statistics, use_common_prefix_top,
-      use_common_prefix_sub);
+      use_common_prefix_sub, prefix_extractor);
 }
 
 PartitionedIndexBuilder::PartitionedIndexBuilder(
@@ -153,7 +155,8 @@ PartitionedIndexBuilder::PartitionedIndexBuilder(
     const BlockBasedTableOptions& table_opt,
     const bool use_value_delta_encoding, size_t ts_sz,
     const bool persist_user_defined_timestamps, Statistics* statistics,
-    bool use_common_prefix_top, bool use_common_prefix_sub)
+    bool use_common_prefix_top, bool use_common_prefix_sub,
+    const SliceTransform* prefix_extractor)
     : IndexBuilder(comparator, ts_sz, persist_user_defined_timestamps),
       index_block_builder_(
           table_opt.index_block_restart_interval, true /*use_delta_encoding*/,
@@ -183,6 +186,10 @@ PartitionedIndexBuilder::PartitionedIndexBuilder(
       value_delta_escape_(
           FormatVersionUsesValueDeltaEscape(table_opt.format_version)),
       use_common_prefix_sub_(use_common_prefix_sub),
+      prefix_extractor_(table_opt.align_index_partitions_to_prefix &&
+                                use_common_prefix_sub
+                            ? prefix_extractor
+                            : nullptr),
       statistics_(statistics) {
   MakeNewSubIndexBuilder();
 }
@@ -227,6 +234,51 @@ void PartitionedIndexBuilder::RequestPartitionCut() {
   partition_cut_requested_ = true;
 }
 
+bool PartitionedIndexBuilder::KeyPrefixDiffers(const Slice& a,
+                                               const Slice& b) const {
+  // Like the filters, on the user keys without timestamp
+  Slice a_user_key = ExtractUserKeyAndStripTimestamp(a, ts_sz_);
+  Slice b_user_key = ExtractUserKeyAndStripTimestamp(b, ts_sz_);
+  bool a_in_domain = prefix_extractor_->InDomain(a_user_key);
+  bool b_in_domain = prefix_extractor_->InDomain(b_user_key);
+  if (!a_in_domain || !b_in_domain) {
+    return a_in_domain != b_in_domain;
+  }
+  return prefix_extractor_->Transform(a_user_key) !=
+         prefix_extractor_->Transform(b_user_key);
+}
+
+bool PartitionedIndexBuilder::EndsKeyPrefix(
+    const Slice& last_key_in_current_block,
+    const Slice* first_key_in_next_block) const {
+  if (prefix_extractor_ == nullptr || first_key_in_next_block == nullptr) {
+    return false;
+  }
+  return KeyPrefixDiffers(last_key_in_current_block, *first_key_in_next_block);
+}
+
+bool PartitionedIndexBuilder::StartsKeyPrefix(
+    const Slice& last_key_in_current_block) {
+  if (prefix_extractor_ == nullptr) {
+    return false;
+  }
+  bool starts_key_prefix =
+      !last_key_in_previous_block_.empty() &&
+      KeyPrefixDiffers(last_key_in_previous_block_, last_key_in_current_block);
+  last_key_in_previous_block_.assign(last_key_in_current_block.data(),
+                                     last_key_in_current_block.size());
+  return starts_key_prefix;
+}
+
+void PartitionedIndexBuilder::MaybeCutAtKeyPrefixStart() {
+  // Cutting smaller partitions would cost more in partition overhead (and
+  // coupled filter partitions) than the longer common prefix saves
+  if (sub_index_builder_->index_block_builder_.CurrentSizeEstimate() >=
+      table_opt_.metadata_block_size / 2) {
+    partition_cut_requested_ = true;
+  }
+}
+
 std::unique_ptr<IndexBuilder::PreparedIndexEntry>
 PartitionedIndexBuilder::CreatePreparedIndexEntry() {
   // Fortunately, for ShortenedIndexBuilder, we can prepare an entry from one
@@ -240,8 +292,15 @@ void PartitionedIndexBuilder::PrepareIndexEntry(
   // similarly configured builder and finish it at another. We just have to
   // keep in mind that this first sub builder keeps track of the original
   // must_use_separator_with_seq_ in the pipeline that is then propagated.
-  return entries_.front().value->PrepareIndexEntry(
-      last_key_in_current_block, first_key_in_next_block, out);
+  // At the end of a key prefix, the separator is the full last key (as for
+  // the last entry of the file), which keeps the prefix of the block.
+  const bool ends_key_prefix =
+      EndsKeyPrefix(last_key_in_current_block, first_key_in_next_block);
+  entries_.front().value->PrepareIndexEntry(
+      last_key_in_current_block,
+      ends_key_prefix ? nullptr : first_key_in_next_block, out);
+  static_cast<ShortenedIndexBuilder::ShortenedPreparedIndexEntry*>(out)
+      ->starts_key_prefix = StartsKeyPrefix(last_key_in_current_block);
 }
 
 void PartitionedIndexBuilder::MaybeFlush(const Slice& index_key,
@@ -268,6 +327,9 @@ void PartitionedIndexBuilder::FinishIndexEntry(const BlockHandle& block_handle,
   using SPIE = ShortenedIndexBuilder::ShortenedPreparedIndexEntry;
   SPIE* entry = static_cast<SPIE*>(base_entry);
 
+  if (entry->starts_key_prefix) {
+    MaybeCutAtKeyPrefixStart();
+  }
   MaybeFlush(entry->separator_with_seq, block_handle);
 
   sub_index_builder_->FinishIndexEntry(block_handle, base_entry,
@@ -293,14 +355,21 @@ Slice PartitionedIndexBuilder::AddIndexEntry(
     const Slice& last_key_in_current_block,
     const Slice* first_key_in_next_block, const BlockHandle& block_handle,
     std::string* separator_scratch, bool skip_delta_encoding) {
+  if (StartsKeyPrefix(last_key_in_current_block)) {
+    MaybeCutAtKeyPrefixStart();
+  }
   // At least when running without parallel compression, maintain behavior of
   // avoiding a last index partition with just one entry
   if (first_key_in_next_block) {
     MaybeFlush(last_key_in_current_block, block_handle);
   }
 
+  // See PrepareIndexEntry
+  const bool ends_key_prefix =
+      EndsKeyPrefix(last_key_in_current_block, first_key_in_next_block);
   auto sep = sub_index_builder_->AddIndexEntry(
-      last_key_in_current_block, first_key_in_next_block, block_handle,
+      last_key_in_current_block,
+      ends_key_prefix ? nullptr : first_key_in_next_block, block_handle,
       separator_scratch, skip_delta_encoding);
   entries_.back().key.assign(sep.data(), sep.size());
 
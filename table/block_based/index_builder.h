@@ -400,6 +400,9 @@ class ShortenedIndexBuilder : public IndexBuilder {
     std::string separator_with_seq;
     std::string first_internal_key;
     bool must_use_separator_with_seq = false;
+    // Set by PartitionedIndexBuilder for the first data block ending in a new
+    // key prefix
+    bool starts_key_prefix = false;
     void SaveFrom(const Slice& from_separator,
                   const Slice& from_first_internal_key,
                   bool from_must_use_separator_with_seq) {
@@ -700,7 +703,8 @@ class PartitionedIndexBuilder : public IndexBuilder {
       const InternalKeyComparator* comparator, bool use_value_delta_encoding,
       const BlockBasedTableOptions& table_opt, size_t ts_sz,
       bool persist_user_defined_timestamps, Statistics* statistics = nullptr,
-      bool use_common_prefix_top = false, bool use_common_prefix_sub = false);
+      bool use_common_prefix_top = false, bool use_common_prefix_sub = false,
+      const SliceTransform* prefix_extractor = nullptr);
 
   PartitionedIndexBuilder(const InternalKeyComparator* comparator,
                           const BlockBasedTableOptions& table_opt,
@@ -708,7 +712,8 @@ class PartitionedIndexBuilder : public IndexBuilder {
                           bool persist_user_defined_timestamps,
                           Statistics* statistics = nullptr,
                           bool use_common_prefix_top = false,
-                          bool use_common_prefix_sub = false);
+                          bool use_common_prefix_sub = false,
+                          const SliceTransform* prefix_extractor = nullptr);
 
   Slice AddIndexEntry(const Slice& last_key_in_current_block,
                       const Slice* first_key_in_next_block,
@@ -781,6 +786,21 @@ class PartitionedIndexBuilder : public IndexBuilder {
   void MakeNewSubIndexBuilder();
   void UpdateIndexSizeEstimate() override;
 
+  // For align_index_partitions_to_prefix: whether the (internal) keys differ
+  // in prefix
+  bool KeyPrefixDiffers(const Slice& a, const Slice& b) const;
+  // Whether the key prefix changes right after the current data block
+  bool EndsKeyPrefix(const Slice& last_key_in_current_block,
+                     const Slice* first_key_in_next_block) const;
+  // Whether the current data block ends in another key prefix than the
+  // previous one. Data blocks mostly span the change of prefix, so this is
+  // where the partitions are cut. Must be called for every data block, in
+  // order.
+  bool StartsKeyPrefix(const Slice& last_key_in_current_block);
+  // Requests a cut before the entry of the data block starting a key prefix,
+  // unless the partition is still small
+  void MaybeCutAtKeyPrefixStart();
+
   struct Entry {
     std::string key;
     std::unique_ptr<ShortenedIndexBuilder> value;
@@ -809,6 +829,11 @@ class PartitionedIndexBuilder : public IndexBuilder {
   // MakeNewSubIndexBuilder(). The top-level builders' toggle is applied
   // directly at their construction in the ctor.
   bool use_common_prefix_sub_ = false;
+  // Set for align_index_partitions_to_prefix, which only pays off with
+  // use_common_prefix_sub_
+  const SliceTransform* const prefix_extractor_;
+  // For StartsKeyPrefix()
+  std::string last_key_in_previous_block_;
   // true if an external entity (such as filter partition builder) request
   // cutting the next partition
   bool partition_cut_requested_ = true;
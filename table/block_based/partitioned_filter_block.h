@@ -41,6 +41,8 @@ class PartitionedFilterBlockBuilder : public FullFilterBlockBuilder {
   void Add(const Slice& key_without_ts) override;
   void AddWithPrevKey(const Slice& key_without_ts,
                       const Slice& prev_key_without_ts) override;
+  // Partitions are cut on the keys themselves
+  bool SupportsKeyHashes() const override { return false; }
   bool IsEmpty() const override {
     return filter_bits_builder_->EstimateEntriesAdded() == 0 &&
            filters_.empty();
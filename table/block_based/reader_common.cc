@@ -8,6 +8,8 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "table/block_based/reader_common.h"
 
+#include <algorithm>
+
 #include "monitoring/perf_context_imp.h"
 #include "rocksdb/table.h"
 #include "table/format.h"
@@ -22,22 +24,14 @@ void ForceReleaseCachedEntry(void* arg, void* h) {
   cache->Release(handle, true /* erase_if_last_ref */);
 }
 
-// WART: this is specific to block-based table
-Status VerifyBlockChecksum(const Footer& footer, const char* data,
-                           size_t block_size, const std::string& file_name,
-                           uint64_t offset, BlockType block_type) {
-  PERF_TIMER_GUARD(block_checksum_time);
-
-  assert(footer.GetBlockTrailerSize() == 5);
+namespace {
+// Compares the checksum stored in the trailer of the block with `computed`
+Status CheckBlockChecksum(const Footer& footer, const char* data,
+                          size_t block_size, uint32_t computed,
+                          const std::string& file_name, uint64_t offset,
+                          BlockType block_type) {
   ChecksumType type = footer.checksum_type();
-
-  // After block_size bytes is compression type (1 byte), which is part of
-  // the checksummed section.
-  size_t len = block_size + 1;
-  // And then the stored checksum value (4 bytes).
-  uint32_t stored = DecodeFixed32(data + len);
-
-  uint32_t computed = ComputeBuiltinChecksum(type, data, len);
+  uint32_t stored = DecodeFixed32(data + block_size + 1);
 
   // Unapply context to 'stored' rather than apply to 'computed, for people
   // who might look for reference crc value in error message
@@ -62,4 +56,46 @@ Status VerifyBlockChecksum(const Footer& footer, const char* data,
         ", block_type = " + BlockTypeToString(block_type));
   }
 }
+}  // namespace
+
+// WART: this is specific to block-based table
+Status VerifyBlockChecksum(const Footer& footer, const char* data,
+                           size_t block_size, const std::string& file_name,
+                           uint64_t offset, BlockType block_type) {
+  PERF_TIMER_GUARD(block_checksum_time);
+
+  assert(footer.GetBlockTrailerSize() == 5);
+  // After block_size bytes is compression type (1 byte), which is part of
+  // the checksummed section. And then the stored checksum value (4 bytes).
+  uint32_t computed =
+      ComputeBuiltinChecksum(footer.checksum_type(), data, block_size + 1);
+  return CheckBlockChecksum(footer, data, block_size, computed, file_name,
+                            offset, block_type);
+}
+
+void VerifyBlockChecksums(const Footer& footer, const char* const* data,
+                          const size_t* block_sizes, const uint64_t* offsets,
+                          size_t count, const std::string& file_name,
+                          BlockType block_type, Status* statuses) {
+  PERF_TIMER_GUARD(block_checksum_time);
+
+  assert(footer.GetBlockTrailerSize() == 5);
+  // Checksummed sections, in batches
+  constexpr size_t kBatchSize = 32;
+  size_t lens[kBatchSize];
+  uint32_t computed[kBatchSize];
+  for (size_t start = 0; start < count; start += kBatchSize) {
+    size_t n = std::min(kBatchSize, count - start);
+    for (size_t i = 0; i < n; ++i) {
+      lens[i] = block_sizes[start + i] + 1;
+    }
+    ComputeBuiltinChecksums(footer.checksum_type(), data + start, lens, n,
+                            computed);
+    for (size_t i = 0; i < n; ++i) {
+      statuses[start + i] = CheckBlockChecksum(
+          footer, data[start + i], block_sizes[start + i], computed[i],
+          file_name, offsets[start + i], block_type);
+    }
+  }
+}
 }  // namespace ROCKSDB_NAMESPACE
@@ -36,4 +36,12 @@ inline MemoryAllocator* GetMemoryAllocator(
 Status VerifyBlockChecksum(const Footer& footer, const char* data,
                            size_t block_size, const std::string& file_name,
                            uint64_t offset, BlockType block_type);
+
+// Same as VerifyBlockChecksum() for each of `count` blocks of the file,
+// storing the results in `statuses`, but computing the checksums in one batch
+// (see ComputeBuiltinChecksums()).
+void VerifyBlockChecksums(const Footer& footer, const char* const* data,
+                          const size_t* block_sizes, const uint64_t* offsets,
+                          size_t count, const std::string& file_name,
+                          BlockType block_type, Status* statuses);
 }  // namespace ROCKSDB_NAMESPACE
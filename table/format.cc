@@ -717,6 +717,21 @@ uint32_t ComputeBuiltinChecksum(ChecksumType type, const char* data,
   }
 }
 
+void ComputeBuiltinChecksums(ChecksumType type, const char* const* data,
+                             const size_t* sizes, size_t count,
+                             uint32_t* out) {
+  if (type == kCRC32c) {
+    crc32c::ValueBatch(data, sizes, count, out);
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = crc32c::Mask(out[i]);
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = ComputeBuiltinChecksum(type, data[i], sizes[i]);
+    }
+  }
+}
+
 uint32_t ComputeBuiltinChecksumWithLastByte(ChecksumType type, const char* data,
                                             size_t data_size, char last_byte) {
   switch (type) {
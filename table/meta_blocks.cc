@@ -31,6 +31,8 @@ const std::string kPropertiesBlockName = "rocksdb.properties";
 const std::string kIndexBlockName = "rocksdb.index";
 const std::string kCompressionDictBlockName = "rocksdb.compression_dict";
 const std::string kRangeDelBlockName = "rocksdb.range_del";
+const std::string kDataBlockValueStatsBlockName =
+    "rocksdb.data_block_value_stats";
 
 MetaIndexBuilder::MetaIndexBuilder()
     : meta_index_block_(new BlockBuilder(BlockBuilder::ForMetaBlock{},
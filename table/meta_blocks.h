@@ -36,6 +36,7 @@ extern const std::string kPropertiesBlockName;
 extern const std::string kIndexBlockName;
 extern const std::string kCompressionDictBlockName;
 extern const std::string kRangeDelBlockName;
+extern const std::string kDataBlockValueStatsBlockName;
 
 class MetaIndexBuilder {
  public:
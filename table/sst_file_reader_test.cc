@@ -788,6 +788,178 @@ TEST_F(SstFileReaderTest, EmbeddedBlobAppendErrorsSurfaceEarly) {
   s.PermitUncheckedError();
 }
 
+TEST_F(SstFileReaderTest, PipelinedMatchesSequential) {
+  Options options = options_;
+  options.compression_opts.parallel_threads = 2;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  SstFileWriterPipelineOptions pipeline_options;
+  pipeline_options.chunk_size = 4096;
+  pipeline_options.max_buffered_bytes = 16384;
+
+  const std::string sequential_file = sst_name_ + "_sequential";
+  const std::string pipelined_file = sst_name_ + "_pipelined";
+  const int kNumEntries = 5000;
+  ExternalSstFileInfo file_info[2];
+  for (int pipelined = 0; pipelined < 2; ++pipelined) {
+    SstFileWriter writer(soptions_, options);
+    if (pipelined) {
+      ASSERT_OK(writer.OpenPipelined(pipelined_file, pipeline_options));
+    } else {
+      ASSERT_OK(writer.Open(sequential_file));
+    }
+    for (int i = 0; i < kNumEntries; ++i) {
+      std::string key = EncodeAsString(i);
+      if (i % 100 == 99) {
+        ASSERT_OK(writer.Delete(key));
+      } else {
+        ASSERT_OK(writer.Put(key, key + std::string(i % 50, 'v')));
+      }
+    }
+    ASSERT_OK(writer.DeleteRange(EncodeAsString(10), EncodeAsString(20)));
+    ASSERT_OK(writer.Finish(&file_info[pipelined]));
+  }
+  ASSERT_EQ(file_info[0].num_entries, file_info[1].num_entries);
+  ASSERT_EQ(file_info[0].num_range_del_entries,
+            file_info[1].num_range_del_entries);
+  ASSERT_EQ(file_info[0].smallest_key, file_info[1].smallest_key);
+  ASSERT_EQ(file_info[0].largest_key, file_info[1].largest_key);
+  // The files only differ in their unique ids
+  ASSERT_EQ(file_info[0].file_size, file_info[1].file_size);
+
+  SstFileReader sequential_reader(options);
+  ASSERT_OK(sequential_reader.Open(sequential_file));
+  SstFileReader pipelined_reader(options);
+  ASSERT_OK(pipelined_reader.Open(pipelined_file));
+  ASSERT_OK(pipelined_reader.VerifyChecksum());
+  auto sequential_props = sequential_reader.GetTableProperties();
+  auto pipelined_props = pipelined_reader.GetTableProperties();
+  ASSERT_GT(sequential_props->num_data_blocks, 1);
+  ASSERT_EQ(sequential_props->num_data_blocks,
+            pipelined_props->num_data_blocks);
+  ASSERT_EQ(sequential_props->data_size, pipelined_props->data_size);
+  ASSERT_EQ(sequential_props->index_size, pipelined_props->index_size);
+  ASSERT_EQ(sequential_props->filter_size, pipelined_props->filter_size);
+  ASSERT_EQ(sequential_props->num_entries, pipelined_props->num_entries);
+
+  ReadOptions ropts;
+  std::unique_ptr<Iterator> sequential_iter(
+      sequential_reader.NewIterator(ropts));
+  std::unique_ptr<Iterator> pipelined_iter(pipelined_reader.NewIterator(ropts));
+  sequential_iter->SeekToFirst();
+  pipelined_iter->SeekToFirst();
+  for (; sequential_iter->Valid(); sequential_iter->Next()) {
+    ASSERT_TRUE(pipelined_iter->Valid());
+    ASSERT_EQ(sequential_iter->key(), pipelined_iter->key());
+    ASSERT_EQ(sequential_iter->value(), pipelined_iter->value());
+    pipelined_iter->Next();
+  }
+  ASSERT_OK(sequential_iter->status());
+  ASSERT_FALSE(pipelined_iter->Valid());
+  ASSERT_OK(pipelined_iter->status());
+
+  ASSERT_OK(env_->DeleteFile(sequential_file));
+  ASSERT_OK(env_->DeleteFile(pipelined_file));
+}
+
+TEST_F(SstFileReaderTest, PipelinedFilterKeyHashes) {
+  Options options = options_;
+  options.statistics = CreateDBStatistics();
+  // Filter entries for the whole keys and their prefixes
+  options.prefix_extractor.reset(NewFixedPrefixTransform(6));
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  const int kNumEntries = 5000;
+  // Returns the filter size, after checking the filter
+  auto write_and_check = [&](SstFileWriterPipelineOptions* pipeline_options) {
+    SstFileWriter writer(soptions_, options);
+    if (pipeline_options != nullptr) {
+      EXPECT_OK(writer.OpenPipelined(sst_name_, *pipeline_options));
+    } else {
+      EXPECT_OK(writer.Open(sst_name_));
+    }
+    for (int i = 0; i < kNumEntries; ++i) {
+      EXPECT_OK(writer.Put(EncodeAsString(2 * i), "v"));
+    }
+    EXPECT_OK(writer.Finish());
+
+    SstFileReader reader(options);
+    EXPECT_OK(reader.Open(sst_name_));
+    // The filter has every key
+    ReadOptions ropts;
+    std::string value;
+    for (int i = 0; i < kNumEntries; ++i) {
+      EXPECT_OK(reader.Get(ropts, EncodeAsString(2 * i), &value));
+    }
+    // and rules out most missing keys
+    uint64_t useful = options.statistics->getTickerCount(BLOOM_FILTER_USEFUL);
+    for (int i = 0; i < kNumEntries; ++i) {
+      EXPECT_TRUE(
+          reader.Get(ropts, EncodeAsString(2 * i + 1), &value).IsNotFound());
+    }
+    EXPECT_GT(options.statistics->getTickerCount(BLOOM_FILTER_USEFUL) - useful,
+              kNumEntries / 2);
+    return reader.GetTableProperties()->filter_size;
+  };
+
+  const uint64_t filter_size = write_and_check(nullptr);
+  ASSERT_GT(filter_size, 0);
+  for (uint32_t hash_threads : {0, 1, 3}) {
+    SstFileWriterPipelineOptions pipeline_options;
+    pipeline_options.chunk_size = 2048;
+    pipeline_options.max_buffered_bytes = 16384;
+    pipeline_options.filter_hash_threads = hash_threads;
+    ASSERT_EQ(filter_size, write_and_check(&pipeline_options));
+  }
+}
+
+TEST_F(SstFileReaderTest, PipelinedErrorsSurface) {
+  std::shared_ptr<FailingAppendFileSystem> fs(
+      new FailingAppendFileSystem(env_->GetFileSystem()));
+  std::unique_ptr<Env> failing_env(new CompositeEnvWrapper(env_, fs));
+
+  Options options = options_;
+  options.env = failing_env.get();
+  EnvOptions env_options = soptions_;
+  env_options.writable_file_max_buffer_size = 1;
+
+  SstFileWriterPipelineOptions pipeline_options;
+  pipeline_options.chunk_size = 1024;
+  pipeline_options.max_buffered_bytes = 4096;
+
+  {
+    SstFileWriter writer(env_options, options);
+    ASSERT_OK(writer.OpenPipelined(sst_name_, pipeline_options));
+    fs->SetFailWrites(true);
+    const std::string value(256, 'v');
+    Status s;
+    for (int i = 0; i < 1000 && s.ok(); ++i) {
+      s = writer.Put(EncodeAsString(i), value);
+    }
+    // Reported by a later Put() once the building thread fails
+    ASSERT_TRUE(s.IsIOError()) << s.ToString();
+    s = writer.Finish();
+    ASSERT_TRUE(s.IsIOError()) << s.ToString();
+    fs->SetFailWrites(false);
+  }
+  ASSERT_TRUE(env_->FileExists(sst_name_).IsNotFound());
+
+  // Abandoned with chunks queued
+  {
+    SstFileWriter writer(env_options, options);
+    ASSERT_OK(writer.OpenPipelined(sst_name_, pipeline_options));
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_OK(writer.Put(EncodeAsString(i), "v"));
+    }
+  }
+}
+
 TEST_F(SstFileReaderTest, ParseTableIteratorKey) {
   // Verify that callers of the raw table iterator can decode key metadata
   // through the public SstFileReader API instead of duplicating dbformat.h.
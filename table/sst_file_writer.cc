@@ -5,6 +5,7 @@
 
 #include "rocksdb/sst_file_writer.h"
 
+#include <deque>
 #include <utility>
 #include <vector>
 
@@ -13,14 +14,19 @@
 #include "db/wide/wide_column_serialization.h"
 #include "db/wide/wide_columns_helper.h"
 #include "file/writable_file_writer.h"
+#include "port/port.h"
 #include "rocksdb/file_system.h"
 #include "rocksdb/table.h"
 #include "table/block_based/block_based_table_builder.h"
+#include "table/block_based/filter_block.h"
 #include "table/embedded_blob_sst.h"
 #include "table/format.h"
 #include "table/prepared_file_info.h"
 #include "table/sst_file_writer_collectors.h"
 #include "test_util/sync_point.h"
+#include "util/atomic.h"
+#include "util/coding.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -79,12 +85,45 @@ struct SstFileWriter::Rep {
   bool strip_timestamp;
   std::unique_ptr<EmbeddedBlobSstBuilderOptions> embedded_blob_options;
 
+  // Pipelined mode, see OpenPipelined(). The calling thread fills
+  // `current_chunk` with length-prefixed internal keys and values and queues
+  // it, and `thread` adds the queued chunks to the builder. Meanwhile,
+  // `hash_threads` hash the keys of the queued chunks for the filter.
+  struct Chunk {
+    std::string data;
+    // One per entry once hashed
+    std::vector<FilterKeyHashes> filter_key_hashes;
+    // Protected by Pipeline::mutex while queued
+    bool hashing = false;
+    bool hashed = false;
+  };
+  struct Pipeline {
+    size_t chunk_size = 0;
+    size_t max_queued_chunks = 0;
+    std::unique_ptr<Chunk> current_chunk;
+    port::Mutex mutex;
+    port::CondVar cv{&mutex};
+    // Protected by mutex
+    std::deque<std::unique_ptr<Chunk>> queued_chunks;
+    // Chunks already built, for reuse
+    std::vector<std::unique_ptr<Chunk>> free_chunks;
+    bool closing = false;
+    // First error of the building thread
+    Status status;
+    RelaxedAtomic<uint64_t> file_size{0};
+    port::Thread thread;
+    std::vector<port::Thread> hash_threads;
+  };
+  std::unique_ptr<Pipeline> pipeline;
+
   Status AddImpl(const Slice& user_key, const Slice& value,
                  ValueType value_type) {
     if (!builder) {
       return Status::InvalidArgument("File is not opened");
     }
-    if (!builder->status().ok()) {
+    // In pipelined mode, the builder belongs to the building thread, whose
+    // errors are returned by QueueChunk()
+    if (pipeline == nullptr && !builder->status().ok()) {
       return builder->status();
     }
 
@@ -127,19 +166,215 @@ struct SstFileWriter::Rep {
 
     ikey.Set(user_key, sequence_number, value_type);
 
-    builder->Add(ikey.Encode(), value);
+    Status s = AddToBuilder(ikey.Encode(), value);
 
     // update file info
     if (file_info.num_entries == 0) {
       smallest_internal_key = ikey;
     }
     file_info.num_entries++;
-    file_info.file_size = builder->FileSize();
+    return s;
+  }
+
+  // Adds an entry to the builder, or in pipelined mode to the current chunk,
+  // and updates file_info.file_size
+  Status AddToBuilder(const Slice& key, const Slice& value) {
+    if (pipeline == nullptr) {
+      builder->Add(key, value);
+      file_info.file_size = builder->FileSize();
+      InvalidatePageCache(false /* closing */).PermitUncheckedError();
+      return builder->status();
+    }
+    std::string* chunk_data = &pipeline->current_chunk->data;
+    PutLengthPrefixedSlice(chunk_data, key);
+    PutLengthPrefixedSlice(chunk_data, value);
+    file_info.file_size = pipeline->file_size.LoadRelaxed();
+    if (chunk_data->size() < pipeline->chunk_size) {
+      return Status::OK();
+    }
+    return QueueChunk();
+  }
+
+  void StartPipeline(const SstFileWriterPipelineOptions& pipeline_options) {
+    pipeline.reset(new Pipeline());
+    pipeline->chunk_size = std::max(pipeline_options.chunk_size, size_t{1});
+    pipeline->current_chunk.reset(new Chunk());
+    // Besides the queued chunks, one is being filled and one built
+    pipeline->max_queued_chunks =
+        std::max(pipeline_options.max_buffered_bytes / pipeline->chunk_size,
+                 size_t{3}) -
+        2;
+    pipeline->thread = port::Thread(&Rep::BuildChunks, this);
+    if (builder->SupportsFilterKeyHashes()) {
+      for (uint32_t i = 0; i < pipeline_options.filter_hash_threads; ++i) {
+        pipeline->hash_threads.emplace_back(&Rep::HashChunks, this);
+      }
+    }
+  }
+
+  // Hands the current chunk over to the building thread, waiting while too
+  // many chunks are queued
+  Status QueueChunk() {
+    Pipeline* p = pipeline.get();
+    MutexLock l(&p->mutex);
+    while (p->status.ok() && p->queued_chunks.size() >= p->max_queued_chunks) {
+      p->cv.Wait();
+    }
+    if (!p->status.ok()) {
+      p->current_chunk->data.clear();
+      return p->status;
+    }
+    p->queued_chunks.push_back(std::move(p->current_chunk));
+    if (!p->free_chunks.empty()) {
+      p->current_chunk = std::move(p->free_chunks.back());
+      p->free_chunks.pop_back();
+    } else {
+      p->current_chunk.reset(new Chunk());
+    }
+    p->cv.SignalAll();
+    return Status::OK();
+  }
+
+  // A hash thread. Chunks are hashed in queue order, so that the building
+  // thread rarely waits for hashes. A chunk left unhashed when its turn to be
+  // built comes is built without them.
+  void HashChunks() {
+    Pipeline* p = pipeline.get();
+    MutexLock l(&p->mutex);
+    for (;;) {
+      Chunk* chunk = nullptr;
+      for (auto& queued : p->queued_chunks) {
+        if (!queued->hashing) {
+          chunk = queued.get();
+          break;
+        }
+      }
+      if (chunk == nullptr) {
+        if (p->closing) {
+          break;
+        }
+        p->cv.Wait();
+        continue;
+      }
+      chunk->hashing = true;
+      p->mutex.Unlock();
+      HashChunk(chunk);
+      p->mutex.Lock();
+      chunk->hashed = true;
+      p->cv.SignalAll();
+    }
+  }
+
+  void HashChunk(Chunk* chunk) const {
+    chunk->filter_key_hashes.clear();
+    Slice input(chunk->data);
+    Slice key;
+    Slice value;
+    while (GetLengthPrefixedSlice(&input, &key) &&
+           GetLengthPrefixedSlice(&input, &value)) {
+      chunk->filter_key_hashes.emplace_back();
+      builder->HashFilterKey(key, &chunk->filter_key_hashes.back());
+    }
+    assert(input.empty());
+  }
+
+  // The building thread
+  void BuildChunks() {
+    Pipeline* p = pipeline.get();
+    MutexLock l(&p->mutex);
+    for (;;) {
+      while (p->queued_chunks.empty() && !p->closing) {
+        p->cv.Wait();
+      }
+      if (p->queued_chunks.empty()) {
+        break;
+      }
+      if (p->queued_chunks.front()->hashing &&
+          !p->queued_chunks.front()->hashed) {
+        p->cv.Wait();
+        continue;
+      }
+      std::unique_ptr<Chunk> chunk = std::move(p->queued_chunks.front());
+      p->queued_chunks.pop_front();
+      p->cv.SignalAll();
+      if (p->status.ok()) {
+        p->mutex.Unlock();
+        Status s = AddChunk(*chunk);
+        p->mutex.Lock();
+        if (!s.ok() && p->status.ok()) {
+          p->status = s;
+          p->cv.SignalAll();
+        }
+      }
+      chunk->data.clear();
+      chunk->hashing = false;
+      chunk->hashed = false;
+      p->free_chunks.push_back(std::move(chunk));
+    }
+  }
 
+  Status AddChunk(const Chunk& chunk) {
+    Slice input(chunk.data);
+    Slice key;
+    Slice value;
+    size_t i = 0;
+    while (GetLengthPrefixedSlice(&input, &key) &&
+           GetLengthPrefixedSlice(&input, &value)) {
+      if (chunk.hashed) {
+        builder->AddWithFilterKeyHashes(key, value,
+                                        chunk.filter_key_hashes[i++]);
+      } else {
+        builder->Add(key, value);
+      }
+    }
+    assert(input.empty());
+    pipeline->file_size.StoreRelaxed(builder->FileSize());
     InvalidatePageCache(false /* closing */).PermitUncheckedError();
     return builder->status();
   }
 
+  // Hands the last chunk over and waits for the building thread to add all
+  // the chunks
+  Status ClosePipeline() {
+    Status s;
+    if (!pipeline->current_chunk->data.empty()) {
+      s = QueueChunk();
+    }
+    {
+      MutexLock l(&pipeline->mutex);
+      pipeline->closing = true;
+      pipeline->cv.SignalAll();
+    }
+    pipeline->thread.join();
+    for (auto& hash_thread : pipeline->hash_threads) {
+      hash_thread.join();
+    }
+    if (s.ok()) {
+      s = pipeline->status;
+    }
+    pipeline.reset();
+    file_info.file_size = builder->FileSize();
+    return s;
+  }
+
+  // Stops the building thread, dropping the queued chunks
+  void AbortPipeline() {
+    {
+      MutexLock l(&pipeline->mutex);
+      if (pipeline->status.ok()) {
+        pipeline->status = Status::Aborted("SstFileWriter abandoned");
+      }
+      pipeline->status.PermitUncheckedError();
+      pipeline->closing = true;
+      pipeline->cv.SignalAll();
+    }
+    pipeline->thread.join();
+    for (auto& hash_thread : pipeline->hash_threads) {
+      hash_thread.join();
+    }
+    pipeline.reset();
+  }
+
   Status Add(const Slice& user_key, const Slice& value, ValueType value_type) {
     if (internal_comparator.user_comparator()->timestamp_size() != 0) {
       return Status::InvalidArgument("Timestamp size mismatch");
@@ -237,7 +472,9 @@ struct SstFileWriter::Rep {
     RangeTombstone tombstone(begin_key, end_key, 0 /* Sequence Number */);
     InternalKey range_del_start_bound = tombstone.SerializeKey();
     InternalKey range_del_end_bound = tombstone.SerializeEndKey();
-    builder->Add(range_del_start_bound.Encode(), end_key);
+    // Errors of the builder surface at a later call or at Finish()
+    AddToBuilder(range_del_start_bound.Encode(), end_key)
+        .PermitUncheckedError();
 
     if (file_info.num_range_del_entries == 0 ||
         internal_comparator.Compare(range_del_start_bound,
@@ -252,9 +489,6 @@ struct SstFileWriter::Rep {
 
     // update file info
     file_info.num_range_del_entries++;
-    file_info.file_size = builder->FileSize();
-
-    InvalidatePageCache(false /* closing */).PermitUncheckedError();
     return Status::OK();
   }
 
@@ -339,6 +573,9 @@ SstFileWriter::SstFileWriter(const EnvOptions& env_options,
 }
 
 SstFileWriter::~SstFileWriter() {
+  if (rep_->pipeline) {
+    rep_->AbortPipeline();
+  }
   if (rep_->builder) {
     // User did not call Finish() or Finish() failed, we need to
     // abandon the builder.
@@ -477,6 +714,20 @@ Status SstFileWriter::OpenWithEmbeddedBlobs(
   return s;
 }
 
+Status SstFileWriter::OpenPipelined(
+    const std::string& file_path,
+    const SstFileWriterPipelineOptions& pipeline_options, Temperature temp) {
+  Rep* r = rep_.get();
+  if (r->builder) {
+    return Status::InvalidArgument("File is already opened");
+  }
+  Status s = Open(file_path, temp);
+  if (s.ok()) {
+    r->StartPipeline(pipeline_options);
+  }
+  return s;
+}
+
 Status SstFileWriter::Put(const Slice& user_key, const Slice& value) {
   return rep_->Add(user_key, value, ValueType::kTypeValue);
 }
@@ -519,13 +770,22 @@ Status SstFileWriter::Finish(ExternalSstFileInfo* file_info) {
   if (!r->builder) {
     return Status::InvalidArgument("File is not opened");
   }
+  Status s;
+  if (r->pipeline) {
+    s = r->ClosePipeline();
+  }
   if (r->file_info.num_entries == 0 &&
       r->file_info.num_range_del_entries == 0) {
     r->builder->status().PermitUncheckedError();
+    s.PermitUncheckedError();
     return Status::InvalidArgument("Cannot create sst file with no entries");
   }
 
-  Status s = r->builder->Finish();
+  if (s.ok()) {
+    s = r->builder->Finish();
+  } else {
+    r->builder->Abandon();
+  }
   r->file_info.file_size = r->builder->FileSize();
 
   IOOptions opts;
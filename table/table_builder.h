@@ -33,6 +33,7 @@ namespace ROCKSDB_NAMESPACE {
 class Slice;
 class Status;
 class BlobSource;
+struct FilterKeyHashes;
 
 struct TableReaderOptions {
   // @param skip_filters Disables loading/accessing the filter block
@@ -212,6 +213,23 @@ class TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called
   virtual void Add(const Slice& key, const Slice& value) = 0;
 
+  // Whether the table has a filter that can take keys hashed ahead of time
+  // by HashFilterKey(), e.g. on other threads
+  virtual bool SupportsFilterKeyHashes() const { return false; }
+
+  // Hashes what the filter adds for internal key `key`. Unlike the other
+  // methods, it can be called concurrently with the non-const ones.
+  // REQUIRES: SupportsFilterKeyHashes()
+  virtual void HashFilterKey(const Slice& /*key*/,
+                             FilterKeyHashes* /*hashes*/) const {}
+
+  // Same as Add(key, value), with the filter hashes of key from
+  // HashFilterKey()
+  virtual void AddWithFilterKeyHashes(const Slice& key, const Slice& value,
+                                      const FilterKeyHashes& /*hashes*/) {
+    Add(key, value);
+  }
+
   // Return non-ok iff some error has been detected.
   virtual Status status() const = 0;
 
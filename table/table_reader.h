@@ -32,6 +32,7 @@ struct ReadOptions;
 struct TableProperties;
 class GetContext;
 class MultiGetContext;
+class IOJob;
 
 // A Table (also referred to as SST) is a sorted map from strings to strings.
 // Tables are immutable and persistent.  A Table may be safely accessed from
@@ -156,6 +157,19 @@ class TableReader {
     return Status::NotSupported();
   }
 
+  // Adds to `*job` the data blocks which may hold the keys in mget_range,
+  // according to the filter (unless skip_filters) and the index, without
+  // reading them, so that they can be read ahead of MultiGet along with the
+  // blocks of other files. Creates `*job` if nullptr. Returns NotSupported if
+  // the table cannot read blocks through an IODispatcher into the block cache.
+  virtual Status PlanMultiGetIO(const ReadOptions& /*read_options*/,
+                                const SliceTransform* /*prefix_extractor*/,
+                                bool /*skip_filters*/,
+                                const MultiGetContext::Range* /*mget_range*/,
+                                std::shared_ptr<IOJob>* /*job*/) {
+    return Status::NotSupported();
+  }
+
   virtual void MultiGet(const ReadOptions& readOptions,
                         const MultiGetContext::Range* mget_range,
                         const SliceTransform* prefix_extractor,
@@ -2048,6 +2048,85 @@ TEST_F(GeneralTableTest, OptimizeKeyCommonPrefixNonBytewise) {
   c_off.ResetTableReader();
 }
 
+// align_index_partitions_to_prefix: with keys carrying long per-tenant
+// prefixes, cutting index partitions where the tenant changes lets each
+// partition strip its whole tenant prefix, shrinking the index. Reads must
+// stay correct across the cuts.
+TEST_F(GeneralTableTest, AlignIndexPartitionsToPrefix) {
+  constexpr int kNumTenants = 8;
+  constexpr int kKeysPerTenant = 800;
+  constexpr size_t kTenantPrefixLen = 44;
+  const Comparator* ucmp = BytewiseComparator();
+  const InternalKeyComparator& icmp = GetPlainInternalComparator(ucmp);
+  auto tenant_prefix = [](int tenant) {
+    char buf[8];
+    snprintf(buf, sizeof(buf), "t%02d_", tenant);
+    return buf + std::string("with_a_long_tenant_and_table_identifier/");
+  };
+  ASSERT_EQ(kTenantPrefixLen, tenant_prefix(0).size());
+
+  uint64_t index_size[2];
+  for (bool align : {false, true}) {
+    BlockBasedTableOptions table_options;
+    Options options = MakeCommonPrefixOptions(
+        ucmp, BlockBasedTableOptions::OptimizeKeyCommonPrefix::kIfFastSeek,
+        &table_options);
+    table_options.block_size = 256;
+    table_options.index_type = BlockBasedTableOptions::kTwoLevelIndexSearch;
+    table_options.metadata_block_size = 1024;
+    table_options.align_index_partitions_to_prefix = align;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    options.prefix_extractor.reset(NewFixedPrefixTransform(kTenantPrefixLen));
+    ImmutableOptions ioptions(options);
+    MutableCFOptions moptions(options);
+
+    TableConstructor c(ucmp, true /* convert_to_internal_key */);
+    for (int tenant = 0; tenant < kNumTenants; tenant++) {
+      for (int i = 0; i < kKeysPerTenant; i++) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%06d", i);
+        c.Add(tenant_prefix(tenant) + buf, "value_" + std::to_string(i));
+      }
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    c.Finish(options, ioptions, moptions, table_options, icmp, &keys, &kvmap);
+    auto* reader = c.GetTableReader();
+    index_size[align] = reader->GetTableProperties()->index_size;
+
+    ReadOptions ro;
+    std::unique_ptr<InternalIterator> iter(reader->NewIterator(
+        ro, moptions.prefix_extractor.get(), /*arena=*/nullptr,
+        /*skip_filters=*/false, TableReaderCaller::kUncategorized));
+    auto expect = kvmap.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_TRUE(expect != kvmap.end());
+      ASSERT_EQ(expect->first, ExtractUserKey(iter->key()).ToString());
+      ASSERT_EQ(expect->second, iter->value().ToString());
+      ++expect;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(expect == kvmap.end());
+
+    // Seek to the first and last keys of each tenant, around the cuts
+    for (int tenant = 0; tenant < kNumTenants; tenant++) {
+      for (int i : {0, kKeysPerTenant - 1}) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%06d", i);
+        std::string key = tenant_prefix(tenant) + buf;
+        iter->Seek(InternalKey(key, kMaxSequenceNumber, kTypeValue).Encode());
+        ASSERT_OK(iter->status());
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(key, ExtractUserKey(iter->key()).ToString());
+      }
+    }
+    iter.reset();
+    c.ResetTableReader();
+  }
+
+  ASSERT_LT(index_size[true], index_size[false]);
+}
+
 #ifdef SNAPPY
 uint64_t BlockBasedTableTest::IndexUncompressedHelper(bool compressed) {
   TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
@@ -2758,6 +2837,27 @@ TEST_P(BuiltinChecksumTest, ChecksumSchemas) {
   }
 }
 
+TEST_P(BuiltinChecksumTest, ChecksumBatch) {
+  Random rnd(301);
+  std::vector<std::string> blocks;
+  std::vector<const char*> data;
+  std::vector<size_t> sizes;
+  for (int i = 0; i < 20; ++i) {
+    blocks.push_back(rnd.RandomBinaryString(i < 10 ? i : 4000 + i));
+  }
+  for (const std::string& block : blocks) {
+    data.push_back(block.data());
+    sizes.push_back(block.size());
+  }
+  std::vector<uint32_t> checksums(blocks.size());
+  ComputeBuiltinChecksums(GetParam(), data.data(), sizes.data(), blocks.size(),
+                          checksums.data());
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    ASSERT_EQ(checksums[i],
+              ComputeBuiltinChecksum(GetParam(), data[i], sizes[i]));
+  }
+}
+
 TEST_P(BuiltinChecksumTest, ChecksumZeroInputs) {
   // Verify that no reasonably sized "all zeros" inputs produce "all zeros"
   // output. Otherwise, "wiped" data could appear to be well-formed.
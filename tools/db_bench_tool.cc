@@ -280,6 +280,8 @@ DEFINE_string(
     "\tlevelstats  -- Print the number of files and bytes per level\n"
     "\tmemstats  -- Print memtable stats\n"
     "\tsstables    -- Print sstable info\n"
+    "\twritecontrollerstate -- Print the state of the write rate feedback "
+    "controller (see --write_rate_feedback_control)\n"
     "\theapprofile -- Dump a heap profile (if supported by this port)\n"
     "\treplay      -- replay the trace file specified with trace_file\n"
     "\tgetmergeoperands -- Insert lots of merge records which are a list of "
@@ -646,6 +648,10 @@ DEFINE_bool(universal_allow_trivial_move, false,
 DEFINE_bool(universal_incremental, false,
             "Enable incremental compactions in universal compaction.");
 
+DEFINE_bool(universal_partitioned_size_amp_compaction, false,
+            "Reduce space amplification one key range partition at a time in "
+            "universal compaction.");
+
 DEFINE_int32(
     universal_stop_style,
     (int32_t)ROCKSDB_NAMESPACE::CompactionOptionsUniversal().stop_style,
@@ -697,8 +703,26 @@ static enum ROCKSDB_NAMESPACE::CompressionType
         ROCKSDB_NAMESPACE::kLZ4Compression;
 
 DEFINE_string(compression_manager, "none",
-              "Set the compression manager type to mixed(roundrobin) or other "
-              "type. None for BuilInCompressor");
+              "Set the compression manager type to mixed(roundrobin), "
+              "costpredictor, adaptive or shared_dict (dictionaries trained "
+              "per column family, of --compression_max_dict_bytes from "
+              "--compression_zstd_max_train_bytes of samples, when set). None "
+              "for BuilInCompressor");
+DEFINE_double(adaptive_compression_hot_cpu_weight,
+              ROCKSDB_NAMESPACE::AdaptiveCompressionOptions().hot_cpu_weight,
+              "With --compression_manager=adaptive, bytes of storage that a "
+              "nanosecond of decompression is worth on hot levels");
+DEFINE_double(adaptive_compression_cold_cpu_weight,
+              ROCKSDB_NAMESPACE::AdaptiveCompressionOptions().cold_cpu_weight,
+              "With --compression_manager=adaptive, bytes of storage that a "
+              "nanosecond of decompression is worth on other levels");
+DEFINE_int32(adaptive_compression_num_hot_levels,
+             ROCKSDB_NAMESPACE::AdaptiveCompressionOptions().num_hot_levels,
+             "With --compression_manager=adaptive, number of hot levels");
+DEFINE_uint32(adaptive_compression_sample_interval,
+              ROCKSDB_NAMESPACE::AdaptiveCompressionOptions().sample_interval,
+              "With --compression_manager=adaptive, one block in this many is "
+              "compressed with every candidate to update the cost model");
 DEFINE_int32(compressed_secondary_cache_compression_level,
              ROCKSDB_NAMESPACE::CompressionOptions().level,
              "Compression level. The meaning of this value is library-"
@@ -826,6 +850,13 @@ DEFINE_string(optimize_key_common_prefix, "",
               "BlockBasedTableOptions::optimize_key_common_prefix: one of "
               "'disabled', 'auto', 'enabled'. Empty leaves the default.");
 
+DEFINE_bool(align_index_partitions_to_prefix,
+            ROCKSDB_NAMESPACE::BlockBasedTableOptions()
+                .align_index_partitions_to_prefix,
+            "BlockBasedTableOptions::align_index_partitions_to_prefix: cut "
+            "index partitions where the key prefix (per --prefix_size) "
+            "changes.");
+
 DEFINE_int64(prepopulate_block_cache, 0,
              "Pre-populate hot/warm blocks in block cache. 0 to disable, 1 "
              "to insert during flush, and 2 to insert during flush and "
@@ -859,6 +890,10 @@ DEFINE_int64(row_cache_size, 0,
              "Number of bytes to use as a cache of individual rows"
              " (0 = disabled).");
 
+DEFINE_int64(user_key_row_cache_size, 0,
+             "Number of bytes to use as a cache of Get() results keyed by "
+             "user key, including not found results (0 = disabled).");
+
 DEFINE_int32(open_files, ROCKSDB_NAMESPACE::Options().max_open_files,
              "Maximum number of files to keep open at the same time"
              " (use default if == 0)");
@@ -1348,6 +1383,13 @@ DEFINE_int64(
 DEFINE_string(block_cache_trace_file, "", "Block cache trace file path.");
 DEFINE_int32(trace_replay_threads, 1,
              "The number of threads to replay, must >=1.");
+DEFINE_bool(trace_record_client_thread_id, false,
+            "Record the issuing thread of each query in the trace, see "
+            "TraceOptions::record_client_thread_id.");
+DEFINE_bool(trace_replay_preserve_client_threads, false,
+            "Replay each client thread of the trace on its own thread, in its "
+            "original order and timing (scaled by trace_replay_fast_forward). "
+            "Requires a trace recorded with trace_record_client_thread_id.");
 
 DEFINE_bool(io_uring_enabled, true,
             "If true, enable the use of IO uring if the platform supports it");
@@ -1378,6 +1420,12 @@ DEFINE_bool(optimize_multiget_for_io, true,
             "When set true, RocksDB does asynchronous reads for SST files in "
             "multiple levels for MultiGet.");
 
+DEFINE_bool(plan_multiget_io, false,
+            "When set true, MultiGet reads the data blocks of all of its keys, "
+            "across column families and levels, in one batch before looking "
+            "them up. With num_column_families > 1, multireadrandom spreads "
+            "the keys of each MultiGet over the column families.");
+
 DEFINE_bool(charge_compression_dictionary_building_buffer, false,
             "Setting for "
             "CacheEntryRoleOptions::charged of "
@@ -1750,6 +1798,15 @@ DEFINE_uint64(delayed_write_rate, 8388608u,
               "Limited bytes allowed to DB when soft_rate_limit or "
               "level0_slowdown_writes_trigger triggers");
 
+DEFINE_bool(write_rate_feedback_control,
+            ROCKSDB_NAMESPACE::Options().write_rate_feedback_control,
+            "Pace delayed writes with a feedback controller instead of step "
+            "changes to the delayed write rate. To compare the write latency "
+            "tail under sustained overload, run e.g. "
+            "--benchmarks=fillrandom,writecontrollerstate --histogram "
+            "--max_background_jobs=2 with and without this flag and compare "
+            "the P99.9 of the write histogram.");
+
 DEFINE_bool(enable_pipelined_write, true,
             "Allow WAL and memtable writes to be pipelined");
 
@@ -1796,6 +1853,11 @@ DEFINE_bool(rate_limiter_auto_tuned, false,
 DEFINE_int64(rate_limiter_single_burst_bytes, 0,
              "Set single burst bytes on background I/O rate limiter.");
 
+DEFINE_bool(rate_limiter_multi_tenant, false,
+            "Use a MultiTenantRateLimiter that shares "
+            "--rate_limiter_bytes_per_sec between column families in weighted "
+            "round robin, instead of a GenericRateLimiter.");
+
 DEFINE_bool(sine_write_rate, false, "Use a sine wave write_rate_limit");
 
 DEFINE_uint64(
@@ -2074,6 +2136,9 @@ DEFINE_bool(report_file_operations, false,
             "if report number of file operations");
 DEFINE_bool(report_open_timing, false, "if report open timing");
 DEFINE_int32(readahead_size, 0, "Iterator readahead size");
+DEFINE_int64(blob_readahead_size, 0,
+             "Iterator readahead size for blob files, see "
+             "ReadOptions::blob_readahead_size");
 
 DEFINE_bool(read_with_latest_user_timestamp, true,
             "If true, always use the current latest timestamp for read. If "
@@ -4254,9 +4319,12 @@ class Benchmark {
           FLAGS_rate_limit_user_ops ? Env::IO_USER : Env::IO_TOTAL;
       read_options_.tailing = FLAGS_use_tailing_iterator;
       read_options_.readahead_size = FLAGS_readahead_size;
+      read_options_.blob_readahead_size =
+          static_cast<size_t>(FLAGS_blob_readahead_size);
       read_options_.adaptive_readahead = FLAGS_adaptive_readahead;
       read_options_.async_io = FLAGS_async_io;
       read_options_.optimize_multiget_for_io = FLAGS_optimize_multiget_for_io;
+      read_options_.plan_multiget_io = FLAGS_plan_multiget_io;
       read_options_.auto_readahead_size = FLAGS_auto_readahead_size;
       read_options_.auto_refresh_iterator_with_snapshot =
           FLAGS_auto_refresh_iterator_with_snapshot;
@@ -4599,6 +4667,8 @@ class Benchmark {
         PrintStats(keys);
       } else if (name == "sstables") {
         PrintStats("rocksdb.sstables");
+      } else if (name == "writecontrollerstate") {
+        PrintStats("rocksdb.write-controller-state");
       } else if (name == "stats_history") {
         PrintStatsHistory();
       } else if (name == "replay") {
@@ -4679,6 +4749,8 @@ class Benchmark {
                     s.ToString().c_str());
             ErrorExit();
           }
+          trace_options_.record_client_thread_id =
+              FLAGS_trace_record_client_thread_id;
           s = db_.db->StartTrace(trace_options_, std::move(trace_writer));
           if (!s.ok()) {
             fprintf(stderr, "Encountered an error starting a trace, %s\n",
@@ -5582,6 +5654,8 @@ class Benchmark {
           exit(1);
         }
       }
+      block_based_options.align_index_partitions_to_prefix =
+          FLAGS_align_index_partitions_to_prefix;
       block_based_options.uniform_cv_threshold = FLAGS_uniform_cv_threshold;
       block_based_options.whole_key_filtering = FLAGS_whole_key_filtering;
       block_based_options.max_auto_readahead_size =
@@ -5732,6 +5806,24 @@ class Benchmark {
     } else if (!strcasecmp(FLAGS_compression_manager.c_str(),
                            "costpredictor")) {
       mgr = CreateCostAwareCompressionManager();
+    } else if (!strcasecmp(FLAGS_compression_manager.c_str(), "adaptive")) {
+      AdaptiveCompressionOptions adaptive_opts;
+      adaptive_opts.hot_cpu_weight = FLAGS_adaptive_compression_hot_cpu_weight;
+      adaptive_opts.cold_cpu_weight =
+          FLAGS_adaptive_compression_cold_cpu_weight;
+      adaptive_opts.num_hot_levels = FLAGS_adaptive_compression_num_hot_levels;
+      adaptive_opts.sample_interval =
+          FLAGS_adaptive_compression_sample_interval;
+      mgr = CreateAdaptiveCompressionManager(adaptive_opts);
+    } else if (!strcasecmp(FLAGS_compression_manager.c_str(), "shared_dict")) {
+      SharedDictionaryOptions dict_opts;
+      if (FLAGS_compression_max_dict_bytes > 0) {
+        dict_opts.max_dict_bytes = FLAGS_compression_max_dict_bytes;
+      }
+      if (FLAGS_compression_zstd_max_train_bytes > 0) {
+        dict_opts.max_train_bytes = FLAGS_compression_zstd_max_train_bytes;
+      }
+      mgr = CreateSharedDictionaryCompressionManager(dict_opts);
     } else if (!strcasecmp(FLAGS_compression_manager.c_str(), "none")) {
       options.compression = FLAGS_compression_type_e;
     } else {
@@ -5778,6 +5870,7 @@ class Benchmark {
     options.hard_pending_compaction_bytes_limit =
         FLAGS_hard_pending_compaction_bytes_limit;
     options.delayed_write_rate = FLAGS_delayed_write_rate;
+    options.write_rate_feedback_control = FLAGS_write_rate_feedback_control;
     options.allow_concurrent_memtable_write =
         FLAGS_allow_concurrent_memtable_write;
     options.experimental_mempurge_threshold =
@@ -5853,6 +5946,8 @@ class Benchmark {
         FLAGS_universal_allow_trivial_move;
     options.compaction_options_universal.incremental =
         FLAGS_universal_incremental;
+    options.compaction_options_universal.partitioned_size_amp_compaction =
+        FLAGS_universal_partitioned_size_amp_compaction;
     options.compaction_options_universal.stop_style =
         static_cast<CompactionStopStyle>(FLAGS_universal_stop_style);
     if (FLAGS_thread_status_per_interval > 0) {
@@ -5972,6 +6067,12 @@ class Benchmark {
       }
     }
 
+    if (options.user_key_row_cache == nullptr &&
+        FLAGS_user_key_row_cache_size > 0) {
+      options.user_key_row_cache =
+          NewLRUCache(FLAGS_user_key_row_cache_size, FLAGS_cache_numshardbits);
+    }
+
     if (options.env == Env::Default()) {
       options.env = FLAGS_env;
     }
@@ -5989,7 +6090,17 @@ class Benchmark {
     }
 
     if (options.rate_limiter == nullptr) {
-      if (FLAGS_rate_limiter_bytes_per_sec > 0) {
+      if (FLAGS_rate_limiter_bytes_per_sec > 0 &&
+          FLAGS_rate_limiter_multi_tenant) {
+        MultiTenantRateLimiterOptions limiter_options;
+        limiter_options.rate_bytes_per_sec =
+            static_cast<int64_t>(FLAGS_rate_limiter_bytes_per_sec);
+        limiter_options.refill_period_us = FLAGS_rate_limiter_refill_period_us;
+        limiter_options.mode = FLAGS_rate_limit_bg_reads
+                                   ? RateLimiter::Mode::kReadsOnly
+                                   : RateLimiter::Mode::kWritesOnly;
+        options.rate_limiter.reset(NewMultiTenantRateLimiter(limiter_options));
+      } else if (FLAGS_rate_limiter_bytes_per_sec > 0) {
         options.rate_limiter.reset(NewGenericRateLimiter(
             FLAGS_rate_limiter_bytes_per_sec,
             FLAGS_rate_limiter_refill_period_us, 10 /* fairness */,
@@ -7706,6 +7817,8 @@ class Benchmark {
       pin_columns_guard.reset(pin_columns);
     }
     std::vector<Status> stat_list(entries_per_batch_);
+    // Column family of each key, with num_column_families > 1
+    std::vector<ColumnFamilyHandle*> cfhs(entries_per_batch_);
     while (static_cast<int64_t>(keys.size()) < entries_per_batch_) {
       key_guards.push_back(std::unique_ptr<const char[]>());
       keys.push_back(AllocateKey(&key_guards.back()));
@@ -7718,7 +7831,8 @@ class Benchmark {
 
     auto duration = thread->shared->MakeDuration(FLAGS_duration, reads_);
     while (!duration.Done(entries_per_batch_)) {
-      DB* db = SelectDB(thread);
+      DBWithColumnFamilies* db_with_cfh = SelectDBWithCfh(thread);
+      DB* db = db_with_cfh->db;
       if (FLAGS_multiread_stride) {
         int64_t key = GetRandomKey(&thread->rand);
         if ((key + (entries_per_batch_ - 1) * FLAGS_multiread_stride) >=
@@ -7727,11 +7841,18 @@ class Benchmark {
         }
         for (int64_t i = 0; i < entries_per_batch_; ++i) {
           GenerateKeyFromInt(key, FLAGS_num, &keys[i]);
+          cfhs[i] = FLAGS_num_column_families > 1
+                        ? db_with_cfh->GetCfh(key)
+                        : db->DefaultColumnFamily();
           key += FLAGS_multiread_stride;
         }
       } else {
         for (int64_t i = 0; i < entries_per_batch_; ++i) {
-          GenerateKeyFromInt(GetRandomKey(&thread->rand), FLAGS_num, &keys[i]);
+          int64_t key = GetRandomKey(&thread->rand);
+          GenerateKeyFromInt(key, FLAGS_num, &keys[i]);
+          cfhs[i] = FLAGS_num_column_families > 1
+                        ? db_with_cfh->GetCfh(key)
+                        : db->DefaultColumnFamily();
         }
       }
       Slice ts;
@@ -7761,7 +7882,8 @@ class Benchmark {
           pin_columns[i].Reset();
         }
       } else if (!FLAGS_multiread_batched) {
-        std::vector<Status> statuses = db->MultiGet(options, keys, &values);
+        std::vector<Status> statuses =
+            db->MultiGet(options, cfhs, keys, &values);
         assert(static_cast<int64_t>(statuses.size()) == entries_per_batch_);
 
         read += entries_per_batch_;
@@ -7776,8 +7898,8 @@ class Benchmark {
           }
         }
       } else {
-        db->MultiGet(options, db->DefaultColumnFamily(), keys.size(),
-                     keys.data(), pin_values, stat_list.data());
+        db->MultiGet(options, keys.size(), cfhs.data(), keys.data(),
+                     pin_values, stat_list.data());
 
         read += entries_per_batch_;
         num_multireads++;
@@ -11021,14 +11143,36 @@ class Benchmark {
       fprintf(stderr, "Prepare for replay failed. Error: %s\n",
               s.ToString().c_str());
     }
-    s = replayer->Replay(
-        ReplayOptions(static_cast<uint32_t>(FLAGS_trace_replay_threads),
-                      FLAGS_trace_replay_fast_forward),
-        nullptr);
+    ReplayOptions replay_options(
+        static_cast<uint32_t>(FLAGS_trace_replay_threads),
+        FLAGS_trace_replay_fast_forward);
+    replay_options.preserve_client_threads =
+        FLAGS_trace_replay_preserve_client_threads;
+    s = replayer->Replay(replay_options, nullptr);
+    ReplayReport report;
+    Status report_s = replayer->GetReplayReport(&report);
     replayer.reset();
     if (s.ok()) {
       fprintf(stdout, "Replay completed from trace_file: %s\n",
               FLAGS_trace_file.c_str());
+      if (report_s.ok()) {
+        fprintf(stdout,
+                "Replay wall clock [%" PRIu64 ", %" PRIu64
+                "] micros, schedule lag P50 %.1f P99 %.1f max %.0f micros\n",
+                report.start_micros, report.end_micros,
+                report.schedule_lag_micros.median,
+                report.schedule_lag_micros.percentile99,
+                report.schedule_lag_micros.max);
+        for (const auto& latency : report.latency_micros) {
+          fprintf(stdout,
+                  "Trace type %d: %" PRIu64
+                  " ops, latency P50 %.1f P95 %.1f P99 %.1f max %.0f "
+                  "micros\n",
+                  static_cast<int>(latency.first), latency.second.count,
+                  latency.second.median, latency.second.percentile95,
+                  latency.second.percentile99, latency.second.max);
+        }
+      }
     } else {
       fprintf(stderr, "Replay failed. Error: %s\n", s.ToString().c_str());
     }
@@ -154,6 +154,10 @@ Status TracerHelper::DecodeTraceRecord(Trace* trace, int trace_file_version,
               GetLengthPrefixedSlice(&buf, &write_batch_data);
               break;
             }
+            case TracePayloadType::kClientThreadId: {
+              GetFixed64(&buf, &trace->client_thread_id);
+              break;
+            }
             default: {
               assert(false);
             }
@@ -194,6 +198,10 @@ Status TracerHelper::DecodeTraceRecord(Trace* trace, int trace_file_version,
               GetLengthPrefixedSlice(&buf, &get_key);
               break;
             }
+            case TracePayloadType::kClientThreadId: {
+              GetFixed64(&buf, &trace->client_thread_id);
+              break;
+            }
             default: {
               assert(false);
             }
@@ -246,6 +254,10 @@ Status TracerHelper::DecodeTraceRecord(Trace* trace, int trace_file_version,
               GetLengthPrefixedSlice(&buf, &upper_bound);
               break;
             }
+            case TracePayloadType::kClientThreadId: {
+              GetFixed64(&buf, &trace->client_thread_id);
+              break;
+            }
             default: {
               assert(false);
             }
@@ -302,6 +314,10 @@ Status TracerHelper::DecodeTraceRecord(Trace* trace, int trace_file_version,
             GetLengthPrefixedSlice(&buf, &keys_payload);
             break;
           }
+          case TracePayloadType::kClientThreadId: {
+            GetFixed64(&buf, &trace->client_thread_id);
+            break;
+          }
           default: {
             assert(false);
           }
@@ -363,8 +379,10 @@ Status Tracer::Write(WriteBatch* write_batch) {
   trace.type = trace_type;
   TracerHelper::SetPayloadMap(trace.payload_map,
                               TracePayloadType::kWriteBatchData);
+  MaybeSetClientThreadIdPayload(&trace);
   PutFixed64(&trace.payload, trace.payload_map);
   PutLengthPrefixedSlice(&trace.payload, Slice(write_batch->Data()));
+  MaybeAppendClientThreadId(&trace);
   return WriteTrace(trace);
 }
 
@@ -380,10 +398,12 @@ Status Tracer::Get(ColumnFamilyHandle* column_family, const Slice& key) {
   // payload.
   TracerHelper::SetPayloadMap(trace.payload_map, TracePayloadType::kGetCFID);
   TracerHelper::SetPayloadMap(trace.payload_map, TracePayloadType::kGetKey);
+  MaybeSetClientThreadIdPayload(&trace);
   // Encode the Get struct members into payload. Make sure add them in order.
   PutFixed64(&trace.payload, trace.payload_map);
   PutFixed32(&trace.payload, column_family->GetID());
   PutLengthPrefixedSlice(&trace.payload, key);
+  MaybeAppendClientThreadId(&trace);
   return WriteTrace(trace);
 }
 
@@ -408,6 +428,7 @@ Status Tracer::IteratorSeek(const uint32_t& cf_id, const Slice& key,
     TracerHelper::SetPayloadMap(trace.payload_map,
                                 TracePayloadType::kIterUpperBound);
   }
+  MaybeSetClientThreadIdPayload(&trace);
   // Encode the Iterator struct members into payload. Make sure add them in
   // order.
   PutFixed64(&trace.payload, trace.payload_map);
@@ -419,6 +440,7 @@ Status Tracer::IteratorSeek(const uint32_t& cf_id, const Slice& key,
   if (upper_bound.size() > 0) {
     PutLengthPrefixedSlice(&trace.payload, upper_bound);
   }
+  MaybeAppendClientThreadId(&trace);
   return WriteTrace(trace);
 }
 
@@ -444,6 +466,7 @@ Status Tracer::IteratorSeekForPrev(const uint32_t& cf_id, const Slice& key,
     TracerHelper::SetPayloadMap(trace.payload_map,
                                 TracePayloadType::kIterUpperBound);
   }
+  MaybeSetClientThreadIdPayload(&trace);
   // Encode the Iterator struct members into payload. Make sure add them in
   // order.
   PutFixed64(&trace.payload, trace.payload_map);
@@ -455,6 +478,7 @@ Status Tracer::IteratorSeekForPrev(const uint32_t& cf_id, const Slice& key,
   if (upper_bound.size() > 0) {
     PutLengthPrefixedSlice(&trace.payload, upper_bound);
   }
+  MaybeAppendClientThreadId(&trace);
   return WriteTrace(trace);
 }
 
@@ -512,6 +536,7 @@ Status Tracer::MultiGet(const std::vector<ColumnFamilyHandle*>& column_families,
                               TracePayloadType::kMultiGetCFIDs);
   TracerHelper::SetPayloadMap(trace.payload_map,
                               TracePayloadType::kMultiGetKeys);
+  MaybeSetClientThreadIdPayload(&trace);
   // Encode the CFIDs inorder
   std::string cfids_payload;
   std::string keys_payload;
@@ -526,9 +551,23 @@ Status Tracer::MultiGet(const std::vector<ColumnFamilyHandle*>& column_families,
   PutFixed32(&trace.payload, multiget_size);
   PutLengthPrefixedSlice(&trace.payload, cfids_payload);
   PutLengthPrefixedSlice(&trace.payload, keys_payload);
+  MaybeAppendClientThreadId(&trace);
   return WriteTrace(trace);
 }
 
+void Tracer::MaybeSetClientThreadIdPayload(Trace* trace) {
+  if (trace_options_.record_client_thread_id) {
+    TracerHelper::SetPayloadMap(trace->payload_map,
+                                TracePayloadType::kClientThreadId);
+  }
+}
+
+void Tracer::MaybeAppendClientThreadId(Trace* trace) {
+  if (trace_options_.record_client_thread_id) {
+    PutFixed64(&trace->payload, Env::Default()->GetThreadID());
+  }
+}
+
 bool Tracer::ShouldSkipTrace(const TraceType& trace_type) {
   if (IsTraceFileOverMax()) {
     return true;
@@ -59,12 +59,17 @@ struct Trace {
   // Each trace type has its own payload_struct, which will be serialized in the
   // payload.
   std::string payload;
+  // Identifies the client thread that issued a query, if the trace was
+  // recorded with TraceOptions::record_client_thread_id; 0 otherwise. Filled
+  // in by TracerHelper::DecodeTraceRecord().
+  uint64_t client_thread_id = 0;
 
   void reset() {
     ts = 0;
     type = kTraceMax;
     payload_map = 0;
     payload.clear();
+    client_thread_id = 0;
   }
 };
 
@@ -82,6 +87,9 @@ enum TracePayloadType : char {
   kMultiGetSize = 8,
   kMultiGetCFIDs = 9,
   kMultiGetKeys = 10,
+  // Shared by all query trace types. Being the highest bit, it is always
+  // encoded last.
+  kClientThreadId = 11,
 };
 
 class TracerHelper {
@@ -174,6 +182,12 @@ class Tracer {
   // Returns true if a trace should be skipped, false otherwise.
   bool ShouldSkipTrace(const TraceType& type);
 
+  // Sets the kClientThreadId bit in the payload map of a query trace if
+  // TraceOptions::record_client_thread_id is set. The thread ID itself is
+  // appended by AppendClientThreadId() after all other payload members.
+  void MaybeSetClientThreadIdPayload(Trace* trace);
+  void MaybeAppendClientThreadId(Trace* trace);
+
   SystemClock* clock_;
   TraceOptions trace_options_;
   std::unique_ptr<TraceWriter> trace_writer_;
@@ -0,0 +1,268 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+
+#include "util/adaptive_compressor.h"
+
+#include "rocksdb/cache.h"
+#include "rocksdb/filter_policy.h"
+#include "util/compression.h"
+#include "util/mutexlock.h"
+#include "util/stop_watch.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Candidates besides kNoCompression, in order
+struct CandidateConfig {
+  CompressionType type;
+  int level;
+};
+const CandidateConfig kCandidateConfigs[] = {
+    {kLZ4Compression, CompressionOptions::kDefaultCompressionLevel},
+    {kZSTD, 1},
+    {kZSTD, 3},
+    {kZSTD, 9},
+};
+
+AdaptiveCompressionOptions SanitizeOptions(AdaptiveCompressionOptions opts) {
+  if (opts.sample_interval == 0) {
+    opts.sample_interval = 1;
+  }
+  return opts;
+}
+}  // namespace
+
+void AdaptiveCompressionStats::Record(const std::vector<Sample>& samples) {
+  assert(samples.size() == estimates_.size());
+  MutexLock l(&mutex_);
+  double weight = num_samples_ == 0 ? 1.0 : kSampleWeight;
+  ++num_samples_;
+  size_t best = 0;
+  double best_cost = 0.0;
+  for (size_t i = 0; i < estimates_.size(); ++i) {
+    Sample& estimate = estimates_[i];
+    estimate.ratio += weight * (samples[i].ratio - estimate.ratio);
+    estimate.decompress_nanos_per_byte +=
+        weight * (samples[i].decompress_nanos_per_byte -
+                  estimate.decompress_nanos_per_byte);
+    double cost =
+        estimate.ratio + cpu_weight_ * estimate.decompress_nanos_per_byte;
+    if (i == 0 || cost < best_cost) {
+      best = i;
+      best_cost = cost;
+    }
+  }
+  choice_.StoreRelaxed(best);
+}
+
+double AdaptiveCompressionStats::GetCost(size_t candidate) const {
+  MutexLock l(&mutex_);
+  const Sample& estimate = estimates_[candidate];
+  return estimate.ratio + cpu_weight_ * estimate.decompress_nanos_per_byte;
+}
+
+uint64_t AdaptiveCompressionStats::GetNumSamples() const {
+  MutexLock l(&mutex_);
+  return num_samples_;
+}
+
+AdaptiveCompressor::AdaptiveCompressor(
+    std::shared_ptr<AdaptiveCompressionManager> manager,
+    const CompressionOptions& opts, const std::string& column_family,
+    int level, CacheEntryRole block_type)
+    : manager_(std::move(manager)),
+      opts_(opts),
+      column_family_(column_family),
+      level_(level),
+      block_type_(block_type),
+      candidates_(manager_->CreateCandidates(opts)),
+      stats_(manager_->GetStats(column_family, level, block_type,
+                                candidates_.size())),
+      decompressor_(manager_->GetDecompressor()) {}
+
+const char* AdaptiveCompressor::Name() const { return "AdaptiveCompressor"; }
+
+std::unique_ptr<Compressor> AdaptiveCompressor::Clone() const {
+  return std::make_unique<AdaptiveCompressor>(manager_, opts_, column_family_,
+                                              level_, block_type_);
+}
+
+std::unique_ptr<Compressor> AdaptiveCompressor::MaybeCloneSpecialized(
+    CacheEntryRole block_type, DictConfigArgs&& /*dict_config*/) const {
+  // No dictionary support (GetDictGuidance() disables it), so just track
+  // each block type separately
+  if (block_type == block_type_) {
+    return nullptr;
+  }
+  return std::make_unique<AdaptiveCompressor>(manager_, opts_, column_family_,
+                                              level_, block_type);
+}
+
+Compressor::ManagedWorkingArea AdaptiveCompressor::ObtainWorkingArea() {
+  auto wa = new AdaptiveWorkingArea();
+  wa->compress.resize(candidates_.size());
+  wa->decompress.resize(candidates_.size());
+  for (size_t i = 0; i < candidates_.size(); ++i) {
+    if (candidates_[i].compressor) {
+      wa->compress[i] = candidates_[i].compressor->ObtainWorkingArea();
+      wa->decompress[i] =
+          decompressor_->ObtainWorkingArea(candidates_[i].type);
+    }
+  }
+  return ManagedWorkingArea(wa, this);
+}
+
+void AdaptiveCompressor::ReleaseWorkingArea(WorkingArea* wa) {
+  delete static_cast<AdaptiveWorkingArea*>(wa);
+}
+
+Status AdaptiveCompressor::CompressBlock(Slice uncompressed_data,
+                                         char* compressed_output,
+                                         size_t* compressed_output_size,
+                                         CompressionType* out_compression_type,
+                                         ManagedWorkingArea* wa) {
+  AdaptiveWorkingArea* local_wa = nullptr;
+  if (wa != nullptr && wa->owner() == this) {
+    local_wa = static_cast<AdaptiveWorkingArea*>(wa->get());
+  }
+  if (block_counter_.FetchAddRelaxed(1) % manager_->sample_interval() == 0) {
+    SampleBlock(uncompressed_data, local_wa);
+  }
+  size_t choice = stats_->GetChoice();
+  const Candidate& candidate = candidates_[choice];
+  if (candidate.compressor == nullptr) {
+    // Bypassed
+    *compressed_output_size = 0;
+    *out_compression_type = kNoCompression;
+    return Status::OK();
+  }
+  return candidate.compressor->CompressBlock(
+      uncompressed_data, compressed_output, compressed_output_size,
+      out_compression_type,
+      local_wa != nullptr ? &local_wa->compress[choice] : nullptr);
+}
+
+void AdaptiveCompressor::SampleBlock(const Slice& data,
+                                     AdaptiveWorkingArea* wa) {
+  if (data.empty() || candidates_.size() < 2) {
+    return;
+  }
+  std::string compressed(data.size(), '\0');
+  std::string uncompressed(data.size(), '\0');
+  std::vector<AdaptiveCompressionStats::Sample> samples(candidates_.size());
+  for (size_t i = 0; i < candidates_.size(); ++i) {
+    const Candidate& candidate = candidates_[i];
+    if (candidate.compressor == nullptr) {
+      continue;
+    }
+    size_t size = compressed.size();
+    CompressionType type = kNoCompression;
+    Status s = candidate.compressor->CompressBlock(
+        data, &compressed[0], &size, &type,
+        wa != nullptr ? &wa->compress[i] : nullptr);
+    if (!s.ok() || type == kNoCompression) {
+      // Would be stored uncompressed
+      continue;
+    }
+
+    Decompressor::ManagedWorkingArea local_decompress_wa;
+    Decompressor::Args args;
+    args.compression_type = type;
+    args.compressed_data = Slice(compressed.data(), size);
+    if (wa != nullptr) {
+      args.working_area = &wa->decompress[i];
+    } else {
+      local_decompress_wa = decompressor_->ObtainWorkingArea(type);
+      args.working_area = &local_decompress_wa;
+    }
+    StopWatchNano timer(manager_->clock(), /*auto_start=*/true);
+    s = decompressor_->ExtractUncompressedSize(args);
+    if (s.ok() && args.uncompressed_size == data.size()) {
+      s = decompressor_->DecompressBlock(args, &uncompressed[0]);
+    } else if (s.ok()) {
+      s = Status::Corruption("Unexpected uncompressed size");
+    }
+    uint64_t nanos = timer.ElapsedNanos();
+    if (!s.ok()) {
+      continue;
+    }
+    samples[i].ratio =
+        static_cast<double>(size) / static_cast<double>(data.size());
+    samples[i].decompress_nanos_per_byte =
+        static_cast<double>(nanos) / static_cast<double>(data.size());
+  }
+  stats_->Record(samples);
+}
+
+AdaptiveCompressionManager::AdaptiveCompressionManager(
+    std::shared_ptr<CompressionManager> wrapped,
+    const AdaptiveCompressionOptions& opts)
+    : CompressionManagerWrapper(std::move(wrapped)),
+      opts_(SanitizeOptions(opts)),
+      clock_(SystemClock::Default().get()) {}
+
+const char* AdaptiveCompressionManager::Name() const {
+  return "AdaptiveCompressionManager";
+}
+
+std::unique_ptr<Compressor> AdaptiveCompressionManager::GetCompressorForSST(
+    const FilterBuildingContext& context, const CompressionOptions& opts,
+    CompressionType preferred) {
+  if (preferred == kNoCompression) {
+    return nullptr;
+  }
+  return std::make_unique<AdaptiveCompressor>(
+      std::static_pointer_cast<AdaptiveCompressionManager>(shared_from_this()),
+      opts, context.column_family_name, context.level_at_creation,
+      CacheEntryRole::kMisc);
+}
+
+std::vector<AdaptiveCompressor::Candidate>
+AdaptiveCompressionManager::CreateCandidates(const CompressionOptions& opts) {
+  std::vector<AdaptiveCompressor::Candidate> candidates(1);
+  for (const CandidateConfig& config : kCandidateConfigs) {
+    if (!CompressionTypeSupported(config.type) ||
+        !wrapped_->SupportsCompressionType(config.type)) {
+      continue;
+    }
+    CompressionOptions candidate_opts = opts;
+    candidate_opts.level = config.level;
+    AdaptiveCompressor::Candidate candidate;
+    candidate.type = config.type;
+    candidate.compressor = wrapped_->GetCompressor(candidate_opts, config.type);
+    if (candidate.compressor != nullptr) {
+      candidates.push_back(std::move(candidate));
+    }
+  }
+  return candidates;
+}
+
+std::shared_ptr<AdaptiveCompressionStats> AdaptiveCompressionManager::GetStats(
+    const std::string& column_family, int level, CacheEntryRole block_type,
+    size_t num_candidates) {
+  std::string key = column_family;
+  key.push_back('\0');
+  key.append(std::to_string(level));
+  key.push_back(':');
+  key.append(std::to_string(static_cast<int>(block_type)));
+  MutexLock l(&mutex_);
+  auto& stats = stats_[key];
+  if (stats == nullptr) {
+    bool hot = level >= 0 && level < opts_.num_hot_levels;
+    stats = std::make_shared<AdaptiveCompressionStats>(
+        num_candidates, hot ? opts_.hot_cpu_weight : opts_.cold_cpu_weight);
+  }
+  return stats;
+}
+
+std::shared_ptr<CompressionManagerWrapper> CreateAdaptiveCompressionManager(
+    const AdaptiveCompressionOptions& opts,
+    std::shared_ptr<CompressionManager> wrapped) {
+  return std::make_shared<AdaptiveCompressionManager>(
+      wrapped == nullptr ? GetBuiltinV2CompressionManager() : wrapped, opts);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
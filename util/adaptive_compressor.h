@@ -0,0 +1,143 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// Defines the adaptive compression manager, which picks the compression of
+// each kind of block from a cost model learned online by sampling blocks.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/advanced_compression.h"
+#include "rocksdb/system_clock.h"
+#include "util/atomic.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Running estimates, for one kind of block (column family, level and block
+// type), of the compressed size and decompression time of each candidate
+// compression, and the candidate of lowest cost. The cost of a candidate is
+// its compressed size plus cpu_weight times its decompression time, both per
+// uncompressed byte.
+class AdaptiveCompressionStats {
+ public:
+  struct Sample {
+    double ratio = 1.0;
+    double decompress_nanos_per_byte = 0.0;
+  };
+
+  AdaptiveCompressionStats(size_t num_candidates, double cpu_weight)
+      : cpu_weight_(cpu_weight), estimates_(num_candidates) {}
+
+  // Records a sample of each candidate on the same block, and picks the
+  // candidate of lowest cost again.
+  void Record(const std::vector<Sample>& samples);
+
+  size_t GetChoice() const { return choice_.LoadRelaxed(); }
+  double GetCost(size_t candidate) const;
+  uint64_t GetNumSamples() const;
+
+ private:
+  // Weight of the latest sample in the estimates
+  static constexpr double kSampleWeight = 0.25;
+
+  const double cpu_weight_;
+  mutable port::Mutex mutex_;
+  std::vector<Sample> estimates_;
+  uint64_t num_samples_ = 0;
+  RelaxedAtomic<size_t> choice_{0};
+};
+
+class AdaptiveCompressionManager;
+
+// Compresses each block with the candidate of lowest cost for its kind of
+// block, and one block in AdaptiveCompressionOptions::sample_interval with
+// every candidate too, decompressing the results, to update the estimates.
+class AdaptiveCompressor : public Compressor {
+ public:
+  struct Candidate {
+    CompressionType type = kNoCompression;
+    // nullptr for kNoCompression
+    std::unique_ptr<Compressor> compressor;
+  };
+
+  AdaptiveCompressor(std::shared_ptr<AdaptiveCompressionManager> manager,
+                     const CompressionOptions& opts,
+                     const std::string& column_family, int level,
+                     CacheEntryRole block_type);
+
+  const char* Name() const override;
+  std::unique_ptr<Compressor> Clone() const override;
+  std::unique_ptr<Compressor> MaybeCloneSpecialized(
+      CacheEntryRole block_type, DictConfigArgs&& dict_config) const override;
+  ManagedWorkingArea ObtainWorkingArea() override;
+  void ReleaseWorkingArea(WorkingArea* wa) override;
+
+  Status CompressBlock(Slice uncompressed_data, char* compressed_output,
+                       size_t* compressed_output_size,
+                       CompressionType* out_compression_type,
+                       ManagedWorkingArea* wa) override;
+
+  const std::vector<Candidate>& candidates() const { return candidates_; }
+  const std::shared_ptr<AdaptiveCompressionStats>& stats() const {
+    return stats_;
+  }
+
+ private:
+  struct AdaptiveWorkingArea : public WorkingArea {
+    // For each candidate
+    std::vector<ManagedWorkingArea> compress;
+    std::vector<Decompressor::ManagedWorkingArea> decompress;
+  };
+
+  void SampleBlock(const Slice& data, AdaptiveWorkingArea* wa);
+
+  const std::shared_ptr<AdaptiveCompressionManager> manager_;
+  const CompressionOptions opts_;
+  const std::string column_family_;
+  const int level_;
+  const CacheEntryRole block_type_;
+  std::vector<Candidate> candidates_;
+  std::shared_ptr<AdaptiveCompressionStats> stats_;
+  std::shared_ptr<Decompressor> decompressor_;
+  RelaxedAtomic<uint64_t> block_counter_{0};
+};
+
+class AdaptiveCompressionManager : public CompressionManagerWrapper {
+ public:
+  AdaptiveCompressionManager(std::shared_ptr<CompressionManager> wrapped,
+                             const AdaptiveCompressionOptions& opts);
+
+  const char* Name() const override;
+  std::unique_ptr<Compressor> GetCompressorForSST(
+      const FilterBuildingContext& context, const CompressionOptions& opts,
+      CompressionType preferred) override;
+
+  // Candidates supported by the wrapped manager and this build, starting
+  // with kNoCompression
+  std::vector<AdaptiveCompressor::Candidate> CreateCandidates(
+      const CompressionOptions& opts);
+
+  // The estimates for a kind of block, shared by the compressors of all the
+  // files
+  std::shared_ptr<AdaptiveCompressionStats> GetStats(
+      const std::string& column_family, int level, CacheEntryRole block_type,
+      size_t num_candidates);
+
+  uint32_t sample_interval() const { return opts_.sample_interval; }
+  SystemClock* clock() const { return clock_; }
+
+ private:
+  const AdaptiveCompressionOptions opts_;
+  SystemClock* const clock_;
+  port::Mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<AdaptiveCompressionStats>>
+      stats_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
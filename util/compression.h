@@ -558,6 +558,13 @@ inline bool ZSTD_FinalizeDictionarySupported() {
 #endif
 }
 
+// Trains a dictionary of up to max_dict_bytes from the concatenated samples.
+// Returns empty on failure (e.g. too few samples). Requires
+// ZSTD_TrainDictionarySupported().
+std::string ZSTD_TrainDictionary(const std::string& samples,
+                                 const std::vector<size_t>& sample_lens,
+                                 size_t max_dict_bytes);
+
 // Use to check whether compression types are related or unrelated
 inline CompressionType CanonicalCompressionType(CompressionType type) {
   switch (type) {
@@ -16,10 +16,12 @@
 #include "table/block_based/block_builder.h"
 #include "table/block_based/data_block_footer.h"
 #include "test_util/testutil.h"
+#include "util/adaptive_compressor.h"
 #include "util/aligned_buffer.h"
 #include "util/auto_tune_compressor.h"
 #include "util/coding.h"
 #include "util/random.h"
+#include "util/shared_dict_compressor.h"
 #include "util/simple_mixed_compressor.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -2364,6 +2366,87 @@ TEST_F(DBCompressionCostPredictor, CostAwareCompressorManager) {
   ASSERT_OK(Flush());
 }
 
+TEST_F(DBCompressionTest, AdaptiveCompressionManager) {
+  if (!ZSTD_Supported() || !LZ4_Supported()) {
+    ROCKSDB_GTEST_BYPASS("ZSTD and LZ4 compression not supported");
+    return;
+  }
+  Random rnd(301);
+  std::string compressible;
+  test::CompressibleString(&rnd, 0.25, 16000, &compressible);
+  std::string incompressible = rnd.RandomBinaryString(16000);
+
+  auto compress = [](Compressor* compressor, const std::string& input) {
+    std::string output(input.size(), '\0');
+    // As if max_compressed_bytes_per_kb was 7/8 of a KB
+    size_t output_size = input.size() * 7 / 8;
+    CompressionType type = kNoCompression;
+    EXPECT_OK(compressor->CompressBlock(input, &output[0], &output_size, &type,
+                                        nullptr));
+    return type;
+  };
+
+  BlockBasedTableOptions bbto;
+  FilterBuildingContext context(bbto);
+  context.column_family_name = kDefaultColumnFamilyName;
+  AdaptiveCompressionOptions opts;
+  opts.sample_interval = 1;
+  opts.hot_cpu_weight = 1000.0;
+  opts.cold_cpu_weight = 0.0;
+  auto mgr = CreateAdaptiveCompressionManager(opts);
+  ASSERT_EQ(mgr->GetCompressorForSST(context, CompressionOptions(),
+                                     kNoCompression),
+            nullptr);
+
+  // Only the size counts on cold levels, so the strongest compression wins,
+  // and incompressible data is not compressed
+  context.level_at_creation = 6;
+  auto cold = mgr->GetCompressorForSST(context, CompressionOptions(), kZSTD);
+  ASSERT_NE(cold, nullptr);
+  ASSERT_EQ(compress(cold.get(), compressible), kZSTD);
+  ASSERT_EQ(compress(cold.get(), incompressible), kNoCompression);
+
+  // Decompression CPU dominates the cost on hot levels
+  context.level_at_creation = 0;
+  auto hot = mgr->GetCompressorForSST(context, CompressionOptions(), kZSTD);
+  ASSERT_EQ(compress(hot.get(), compressible), kNoCompression);
+
+  // Each block type is tracked separately
+  auto* adaptive = static_cast<AdaptiveCompressor*>(cold.get());
+  auto index = cold->MaybeCloneSpecialized(CacheEntryRole::kIndexBlock,
+                                           Compressor::DictDisabled{});
+  ASSERT_NE(index, nullptr);
+  ASSERT_NE(static_cast<AdaptiveCompressor*>(index.get())->stats(),
+            adaptive->stats());
+  ASSERT_EQ(static_cast<AdaptiveCompressor*>(cold->Clone().get())->stats(),
+            adaptive->stats());
+  ASSERT_EQ(adaptive->stats()->GetNumSamples(), 2);
+
+  // Mixed data round trips through a DB
+  Options options = CurrentOptions();
+  options.compression = kZSTD;
+  options.compression_manager = CreateAdaptiveCompressionManager();
+  bbto.enable_index_compression = false;
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  DestroyAndReopen(options);
+  std::vector<std::string> values;
+  for (int i = 0; i < 40; ++i) {
+    std::string value;
+    if (i % 3 == 0) {
+      value = rnd.RandomBinaryString(10000);
+    } else {
+      test::CompressibleString(&rnd, 0.25, 10000, &value);
+    }
+    values.push_back(value);
+    ASSERT_OK(Put(Key(i), value));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  for (int i = 0; i < 40; ++i) {
+    ASSERT_EQ(Get(Key(i)), values[i]);
+  }
+}
+
 // Test pre-defined dictionary compression with a custom CompressionManager
 TEST_F(DBCompressionTest, PreDefinedDictionaryCompression) {
   if (!ZSTD_Supported()) {
@@ -2590,6 +2673,84 @@ TEST_F(DBCompressionTest, PreDefinedDictionaryCompression) {
             Status::kCorruption);
 }
 
+TEST_F(DBCompressionTest, SharedDictionaryCompression) {
+  if (!ZSTD_Supported() || !ZSTD_TrainDictionarySupported()) {
+    ROCKSDB_GTEST_BYPASS("ZSTD dictionary training not supported");
+    return;
+  }
+  SharedDictionaryOptions dict_opts;
+  dict_opts.max_dict_bytes = 4 << 10;
+  dict_opts.max_train_bytes = 64 << 10;
+  dict_opts.sample_interval = 1;
+  // No new version within the test
+  dict_opts.retrain_interval_bytes = uint64_t{1} << 30;
+  auto mgr = CreateSharedDictionaryCompressionManager(dict_opts);
+  auto* shared_mgr =
+      static_cast<SharedDictionaryCompressionManager*>(mgr.get());
+
+  Options options = CurrentOptions();
+  options.compression = kZSTD;
+  options.compression_manager = mgr;
+  options.disable_auto_compactions = true;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  BlockBasedTableOptions bbto;
+  bbto.block_size = 1 << 10;
+  bbto.block_cache = NewLRUCache(1 << 20);
+  bbto.cache_index_and_filter_blocks = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  DestroyAndReopen(options);
+
+  // Values made of common words, as a dictionary can capture
+  Random rnd(301);
+  std::vector<std::string> words;
+  for (int i = 0; i < 100; ++i) {
+    words.push_back(rnd.RandomString(16));
+  }
+  std::vector<std::string> values;
+  auto write_file = [&]() {
+    for (int i = 0; i < 200; ++i) {
+      std::string value;
+      for (int j = 0; j < 32; ++j) {
+        value += words[rnd.Uniform(static_cast<int>(words.size()))];
+      }
+      ASSERT_OK(Put(Key(static_cast<int>(values.size())), value));
+      values.push_back(value);
+    }
+    ASSERT_OK(Flush());
+  };
+
+  // The first file trains the dictionary without using one
+  write_file();
+  auto state = shared_mgr->GetState(kDefaultColumnFamilyName);
+  ASSERT_EQ(state->GetVersion(), 1);
+  ASSERT_NE(state->GetDict(), nullptr);
+
+  // Later files use it, without training again
+  write_file();
+  write_file();
+  ASSERT_EQ(state->GetVersion(), 1);
+  ASSERT_EQ(NumTableFilesAtLevel(0), 3);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(Get(Key(static_cast<int>(i))), values[i]);
+  }
+  ASSERT_GE(
+      TestGetTickerCount(options, BLOCK_CACHE_COMPRESSION_DICT_BYTES_INSERT),
+      2 * state->GetDict()->size());
+  // One digested decompressor for the two files with the dictionary
+  ASSERT_EQ(shared_mgr->decompressor_cache()->GetNumEntries(), 1);
+
+  // Readable without the manager
+  Close();
+  options.compression_manager = nullptr;
+  bbto.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  Reopen(options);
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(Get(Key(static_cast<int>(i))), values[i]);
+  }
+}
+
 TEST_F(DBCompressionTest, GetRecommendedParallelThreads) {
   // Verify that built-in compressors return parallel_threads from their
   // CompressionOptions, except fast compressors override to 1
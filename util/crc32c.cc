@@ -11,8 +11,10 @@
 // four bytes at a time.
 #include "util/crc32c.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <utility>
 
 #include "port/lang.h"
@@ -1133,6 +1135,59 @@ uint32_t Extend(uint32_t crc, const char* buf, size_t size) {
   return ChosenExtend(crc, buf, size);
 }
 
+#ifdef __SSE4_2__
+// Below this many bytes in common, interleaving buffers is not worth it
+static constexpr size_t kMinBatchLaneBytes = 256;
+
+static inline uint64_t LoadWord(const char* p) {
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  return word;
+}
+#endif  // __SSE4_2__
+
+void ValueBatch(const char* const* data, const size_t* sizes, size_t count,
+                uint32_t* crcs) {
+  size_t i = 0;
+#ifdef __SSE4_2__
+  // Three buffers at a time. The crc32 instruction has a latency of three
+  // cycles but a throughput of one per cycle, so three independent lanes keep
+  // it busy, like crc32c_3way() does within one buffer but without combining
+  // the lanes afterwards.
+  for (; i + 3 <= count; i += 3) {
+    const char* p0 = data[i];
+    const char* p1 = data[i + 1];
+    const char* p2 = data[i + 2];
+    // Whole words only
+    size_t common = std::min({sizes[i], sizes[i + 1], sizes[i + 2]}) &
+                    ~size_t{7};
+    if (common < kMinBatchLaneBytes) {
+      crcs[i] = Value(p0, sizes[i]);
+      crcs[i + 1] = Value(p1, sizes[i + 1]);
+      crcs[i + 2] = Value(p2, sizes[i + 2]);
+      continue;
+    }
+    uint64_t c0 = 0xffffffffu;
+    uint64_t c1 = 0xffffffffu;
+    uint64_t c2 = 0xffffffffu;
+    for (size_t offset = 0; offset < common; offset += 8) {
+      c0 = _mm_crc32_u64(c0, LoadWord(p0 + offset));
+      c1 = _mm_crc32_u64(c1, LoadWord(p1 + offset));
+      c2 = _mm_crc32_u64(c2, LoadWord(p2 + offset));
+    }
+    crcs[i] = Extend(static_cast<uint32_t>(c0) ^ 0xffffffffu, p0 + common,
+                     sizes[i] - common);
+    crcs[i + 1] = Extend(static_cast<uint32_t>(c1) ^ 0xffffffffu,
+                         p1 + common, sizes[i + 1] - common);
+    crcs[i + 2] = Extend(static_cast<uint32_t>(c2) ^ 0xffffffffu,
+                         p2 + common, sizes[i + 2] - common);
+  }
+#endif  // __SSE4_2__
+  for (; i < count; ++i) {
+    crcs[i] = Value(data[i], sizes[i]);
+  }
+}
+
 // The code for crc32c combine, copied with permission from folly
 
 // Standard galois-field multiply.  The only modification is that a,
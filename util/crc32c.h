@@ -34,6 +34,14 @@ uint32_t Crc32cCombine(uint32_t crc1, uint32_t crc2, size_t crc2len);
 // Return the crc32c of data[0,n-1]
 inline uint32_t Value(const char* data, size_t n) { return Extend(0, data, n); }
 
+// Stores in crcs[i] the crc32c of data[i][0,sizes[i]-1], for each i < count.
+// Where supported, independent buffers are processed in interleaved lanes,
+// which is faster than one Value() after another for buffers of up to a few
+// KB, such as the blocks of a MultiGet. Larger buffers gain little over the
+// three-way path of Value().
+void ValueBatch(const char* const* data, const size_t* sizes, size_t count,
+                uint32_t* crcs);
+
 static const uint32_t kMaskDelta = 0xa282ead8ul;
 
 // Return a masked representation of crc.
@@ -116,6 +116,27 @@ TEST(CRC, Extend) {
   ASSERT_EQ(Value("hello world", 11), Extend(Value("hello ", 6), "world", 5));
 }
 
+TEST(CRC, ValueBatch) {
+  Random rnd(301);
+  std::string data = rnd.RandomBinaryString(100000);
+  std::vector<const char*> bufs;
+  std::vector<size_t> sizes;
+  // Various alignments, sizes shorter and longer than the others, and
+  // leftover buffers beyond whole groups of lanes
+  for (int i = 0; i < 50; ++i) {
+    size_t size = i % 7 == 0 ? rnd.Uniform(100) : 1000 + rnd.Uniform(5000);
+    bufs.push_back(data.data() + rnd.Uniform(1000));
+    sizes.push_back(size);
+  }
+  for (size_t count = 0; count <= bufs.size(); ++count) {
+    std::vector<uint32_t> crcs(count);
+    ValueBatch(bufs.data(), sizes.data(), count, crcs.data());
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(crcs[i], Value(bufs[i], sizes[i]));
+    }
+  }
+}
+
 TEST(CRC, Mask) {
   uint32_t crc = Value("foo", 3);
   ASSERT_NE(crc, Mask(crc));
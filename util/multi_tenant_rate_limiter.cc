@@ -0,0 +1,473 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "util/multi_tenant_rate_limiter.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "monitoring/statistics_impl.h"
+#include "test_util/sync_point.h"
+#include "util/mutexlock.h"
+#include "util/rate_limiter_impl.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+thread_local std::string tls_io_tenant_tag;
+thread_local const std::string* tls_io_tenant_column_family = nullptr;
+}  // namespace
+
+void SetThreadIOTenant(const std::string& tenant) {
+  tls_io_tenant_tag = tenant;
+}
+
+const std::string& GetThreadIOTenant() {
+  if (!tls_io_tenant_tag.empty()) {
+    return tls_io_tenant_tag;
+  }
+  if (tls_io_tenant_column_family != nullptr) {
+    return *tls_io_tenant_column_family;
+  }
+  // Empty
+  return tls_io_tenant_tag;
+}
+
+IOTenantScope::IOTenantScope(const std::string* column_family_name)
+    : prev_column_family_name_(tls_io_tenant_column_family) {
+  if (column_family_name != nullptr) {
+    tls_io_tenant_column_family = column_family_name;
+  }
+}
+
+IOTenantScope::~IOTenantScope() {
+  tls_io_tenant_column_family = prev_column_family_name_;
+}
+
+// Pending request
+struct MultiTenantRateLimiterImpl::Req {
+  Req(int64_t _bytes, Env::IOPriority _pri, uint64_t _enqueue_us,
+      port::Mutex* _mu)
+      : request_bytes(_bytes),
+        bytes(_bytes),
+        pri(_pri),
+        enqueue_us(_enqueue_us),
+        cv(_mu) {}
+  // Bytes not granted yet
+  int64_t request_bytes;
+  int64_t bytes;
+  Env::IOPriority pri;
+  uint64_t enqueue_us;
+  port::CondVar cv;
+};
+
+struct MultiTenantRateLimiterImpl::Tenant {
+  explicit Tenant(uint32_t _weight) : weight(_weight) {}
+
+  // The next request to grant in the round robin
+  Req* Front() const {
+    if (!foreground_queue.empty()) {
+      return foreground_queue.front();
+    }
+    if (!background_queue.empty()) {
+      return background_queue.front();
+    }
+    return nullptr;
+  }
+
+  uint32_t weight;
+  // Bytes the tenant can still be granted in its current round. Negative when
+  // it was charged for foreground requests granted ahead of the round robin
+  // order to meet the latency target.
+  int64_t deficit = 0;
+  // Whether this round's quantum was added to `deficit`
+  bool has_quantum = false;
+  // Whether the tenant is in `active_tenants_`
+  bool active = false;
+  std::deque<Req*> foreground_queue;
+  std::deque<Req*> background_queue;
+
+  uint64_t requests = 0;
+  uint64_t bytes = 0;
+  uint64_t foreground_requests = 0;
+  uint64_t foreground_bytes = 0;
+  uint64_t delayed_requests = 0;
+  uint64_t slo_violations = 0;
+  HistogramImpl foreground_wait_micros;
+  HistogramImpl background_wait_micros;
+};
+
+MultiTenantRateLimiterImpl::MultiTenantRateLimiterImpl(
+    const MultiTenantRateLimiterOptions& options,
+    const std::shared_ptr<SystemClock>& clock)
+    : MultiTenantRateLimiter(options.mode),
+      refill_period_us_(options.refill_period_us),
+      foreground_latency_slo_us_(options.foreground_latency_slo_us),
+      rate_bytes_per_sec_(options.rate_bytes_per_sec),
+      refill_bytes_per_period_(
+          CalculateRefillBytesPerPeriod(options.rate_bytes_per_sec)),
+      clock_(clock),
+      stop_(false),
+      exit_cv_(&request_mutex_),
+      requests_to_wait_(0),
+      available_bytes_(0),
+      next_refill_us_(NowMicrosMonotonicLocked()),
+      wait_until_refill_pending_(false),
+      tenant_weights_(options.tenant_weights),
+      default_weight_(std::max<uint32_t>(options.default_weight, 1)) {
+  for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
+    total_requests_[i] = 0;
+    total_bytes_through_[i] = 0;
+    pending_requests_[i] = 0;
+  }
+}
+
+MultiTenantRateLimiterImpl::~MultiTenantRateLimiterImpl() {
+  MutexLock g(&request_mutex_);
+  stop_ = true;
+  int32_t num_queued = 0;
+  for (auto& entry : tenants_) {
+    Tenant* tenant = entry.second.get();
+    for (auto* queue : {&tenant->foreground_queue, &tenant->background_queue}) {
+      for (Req* r : *queue) {
+        r->cv.Signal();
+        ++num_queued;
+      }
+    }
+  }
+  requests_to_wait_ = num_queued;
+  while (requests_to_wait_ > 0) {
+    exit_cv_.Wait();
+  }
+}
+
+void MultiTenantRateLimiterImpl::SetBytesPerSecond(int64_t bytes_per_second) {
+  assert(bytes_per_second > 0);
+  MutexLock g(&request_mutex_);
+  rate_bytes_per_sec_.store(bytes_per_second, std::memory_order_relaxed);
+  refill_bytes_per_period_.store(
+      CalculateRefillBytesPerPeriod(bytes_per_second),
+      std::memory_order_relaxed);
+}
+
+int64_t MultiTenantRateLimiterImpl::GetTotalBytesThrough(
+    const Env::IOPriority pri) const {
+  MutexLock g(&request_mutex_);
+  if (pri == Env::IO_TOTAL) {
+    int64_t sum = 0;
+    for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
+      sum += total_bytes_through_[i];
+    }
+    return sum;
+  }
+  return total_bytes_through_[pri];
+}
+
+int64_t MultiTenantRateLimiterImpl::GetTotalRequests(
+    const Env::IOPriority pri) const {
+  MutexLock g(&request_mutex_);
+  if (pri == Env::IO_TOTAL) {
+    int64_t sum = 0;
+    for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
+      sum += total_requests_[i];
+    }
+    return sum;
+  }
+  return total_requests_[pri];
+}
+
+Status MultiTenantRateLimiterImpl::GetTotalPendingRequests(
+    int64_t* total_pending_requests, const Env::IOPriority pri) const {
+  assert(total_pending_requests != nullptr);
+  MutexLock g(&request_mutex_);
+  if (pri == Env::IO_TOTAL) {
+    int64_t sum = 0;
+    for (int i = Env::IO_LOW; i < Env::IO_TOTAL; ++i) {
+      sum += pending_requests_[i];
+    }
+    *total_pending_requests = sum;
+  } else {
+    *total_pending_requests = pending_requests_[pri];
+  }
+  return Status::OK();
+}
+
+std::map<std::string, MultiTenantRateLimiter::TenantStats>
+MultiTenantRateLimiterImpl::GetTenantStats() const {
+  MutexLock g(&request_mutex_);
+  std::map<std::string, TenantStats> result;
+  for (const auto& entry : tenants_) {
+    const Tenant& tenant = *entry.second;
+    TenantStats& stats = result[entry.first];
+    stats.weight = tenant.weight;
+    stats.requests = tenant.requests;
+    stats.bytes = tenant.bytes;
+    stats.foreground_requests = tenant.foreground_requests;
+    stats.foreground_bytes = tenant.foreground_bytes;
+    stats.delayed_requests = tenant.delayed_requests;
+    stats.slo_violations = tenant.slo_violations;
+    tenant.foreground_wait_micros.Data(&stats.foreground_wait_micros);
+    tenant.background_wait_micros.Data(&stats.background_wait_micros);
+  }
+  return result;
+}
+
+void MultiTenantRateLimiterImpl::SetTenantWeight(const std::string& tenant,
+                                                 uint32_t weight) {
+  MutexLock g(&request_mutex_);
+  weight = std::max<uint32_t>(weight, 1);
+  tenant_weights_[tenant] = weight;
+  auto it = tenants_.find(tenant);
+  if (it != tenants_.end()) {
+    it->second->weight = weight;
+  }
+}
+
+MultiTenantRateLimiterImpl::Tenant*
+MultiTenantRateLimiterImpl::GetOrCreateTenantLocked(const std::string& name) {
+  auto it = tenants_.find(name);
+  if (it != tenants_.end()) {
+    return it->second.get();
+  }
+  uint32_t weight = default_weight_;
+  auto weight_it = tenant_weights_.find(name);
+  if (weight_it != tenant_weights_.end()) {
+    weight = std::max<uint32_t>(weight_it->second, 1);
+  }
+  auto& tenant = tenants_[name];
+  tenant.reset(new Tenant(weight));
+  return tenant.get();
+}
+
+void MultiTenantRateLimiterImpl::Request(int64_t bytes,
+                                         const Env::IOPriority pri,
+                                         Statistics* stats) {
+  RequestImpl(bytes, pri, stats, RateLimiter::OpType::kWrite);
+}
+
+void MultiTenantRateLimiterImpl::Request(int64_t bytes,
+                                         const Env::IOPriority pri,
+                                         Statistics* stats,
+                                         RateLimiter::OpType op_type) {
+  if (!IsRateLimited(op_type)) {
+    return;
+  }
+  RequestImpl(bytes, pri, stats, op_type);
+}
+
+void MultiTenantRateLimiterImpl::RequestImpl(int64_t bytes,
+                                             const Env::IOPriority pri,
+                                             Statistics* stats,
+                                             RateLimiter::OpType op_type) {
+  assert(bytes <= GetSingleBurstBytes());
+  bytes = std::max(static_cast<int64_t>(0), bytes);
+  const int64_t requested_bytes = bytes;
+  const bool foreground = pri == Env::IO_USER;
+  const std::string& tenant_name = GetThreadIOTenant();
+  TEST_SYNC_POINT("MultiTenantRateLimiterImpl::Request");
+
+  bool request_granted = false;
+  bool request_delayed = false;
+  uint64_t wait_micros = 0;
+
+  {
+    MutexLock g(&request_mutex_);
+    if (stop_) {
+      // It is now in the clean-up of ~MultiTenantRateLimiterImpl().
+      return;
+    }
+
+    Tenant* tenant = GetOrCreateTenantLocked(tenant_name);
+    ++total_requests_[pri];
+    ++tenant->requests;
+    tenant->bytes += requested_bytes;
+    if (foreground) {
+      ++tenant->foreground_requests;
+      tenant->foreground_bytes += requested_bytes;
+    }
+
+    // As in GenericRateLimiter, available bytes are only left over when
+    // nothing is queued.
+    if (available_bytes_ > 0) {
+      int64_t bytes_through = std::min(available_bytes_, bytes);
+      total_bytes_through_[pri] += bytes_through;
+      available_bytes_ -= bytes_through;
+      bytes -= bytes_through;
+    }
+
+    if (bytes == 0) {
+      request_granted = true;
+    } else {
+      // Request cannot be satisfied at this moment, enqueue
+      request_delayed = true;
+      ++tenant->delayed_requests;
+      Req r(bytes, pri, NowMicrosMonotonicLocked(), &request_mutex_);
+      (foreground ? tenant->foreground_queue : tenant->background_queue)
+          .push_back(&r);
+      ++pending_requests_[pri];
+      if (!tenant->active) {
+        tenant->active = true;
+        active_tenants_.push_back(tenant);
+      }
+
+      // Same coordination between queued requests as in GenericRateLimiter:
+      // one of them waits for the next refill, and whichever wakes up after
+      // it refills and grants requests.
+      do {
+        int64_t now = static_cast<int64_t>(NowMicrosMonotonicLocked());
+        int64_t time_until_refill_us = next_refill_us_ - now;
+        if (time_until_refill_us > 0) {
+          if (wait_until_refill_pending_) {
+            r.cv.Wait();
+          } else {
+            int64_t wait_until = clock_->NowMicros() + time_until_refill_us;
+            RecordTick(stats, NUMBER_RATE_LIMITER_DRAINS);
+            wait_until_refill_pending_ = true;
+            clock_->TimedWait(&r.cv, std::chrono::microseconds(wait_until));
+            wait_until_refill_pending_ = false;
+          }
+        } else {
+          RefillBytesAndGrantRequestsLocked();
+        }
+        if (r.request_bytes == 0) {
+          // If there is any remaining request, make sure one of them is awake
+          // for future duties.
+          for (Tenant* t : active_tenants_) {
+            Req* next = t->Front();
+            if (next != nullptr) {
+              next->cv.Signal();
+              break;
+            }
+          }
+        }
+      } while (!stop_ && r.request_bytes > 0);
+
+      if (stop_) {
+        --requests_to_wait_;
+        exit_cv_.Signal();
+      } else {
+        request_granted = true;
+        wait_micros = NowMicrosMonotonicLocked() - r.enqueue_us;
+        if (foreground) {
+          tenant->foreground_wait_micros.Add(wait_micros);
+          if (foreground_latency_slo_us_ > 0 &&
+              wait_micros > foreground_latency_slo_us_) {
+            ++tenant->slo_violations;
+          }
+        } else {
+          tenant->background_wait_micros.Add(wait_micros);
+        }
+      }
+    }
+  }
+
+  if (request_granted) {
+    RecordTick(stats, RateLimiterRequestsTicker(op_type));
+    RecordTick(stats, RateLimiterBytesTicker(op_type), requested_bytes);
+    if (request_delayed) {
+      RecordTick(stats, RateLimiterDelayedRequestsTicker(op_type));
+      RecordTick(stats, RateLimiterTotalWaitTicker(op_type), wait_micros);
+      RecordInHistogram(stats, RateLimiterWaitHistogram(op_type), wait_micros);
+    }
+  }
+}
+
+void MultiTenantRateLimiterImpl::GrantLocked(Tenant* tenant, Req* req,
+                                             int64_t bytes) {
+  assert(bytes > 0 && bytes <= req->request_bytes);
+  assert(bytes <= available_bytes_);
+  req->request_bytes -= bytes;
+  available_bytes_ -= bytes;
+  if (req->request_bytes > 0) {
+    return;
+  }
+  auto& queue = req->pri == Env::IO_USER ? tenant->foreground_queue
+                                         : tenant->background_queue;
+  assert(!queue.empty() && queue.front() == req);
+  queue.pop_front();
+  --pending_requests_[req->pri];
+  total_bytes_through_[req->pri] += req->bytes;
+  // Quota granted, signal the thread to exit
+  req->cv.Signal();
+}
+
+void MultiTenantRateLimiterImpl::RefillBytesAndGrantRequestsLocked() {
+  TEST_SYNC_POINT_CALLBACK(
+      "MultiTenantRateLimiterImpl::RefillBytesAndGrantRequestsLocked",
+      &request_mutex_);
+  const uint64_t now = NowMicrosMonotonicLocked();
+  next_refill_us_ = static_cast<int64_t>(now) + refill_period_us_;
+  const int64_t refill_bytes_per_period =
+      refill_bytes_per_period_.load(std::memory_order_relaxed);
+  assert(available_bytes_ == 0);
+  available_bytes_ = refill_bytes_per_period;
+
+  // Foreground requests that have waited past the latency target go first.
+  // Their tenants pay for them out of their next rounds.
+  if (foreground_latency_slo_us_ > 0) {
+    for (Tenant* tenant : active_tenants_) {
+      auto& queue = tenant->foreground_queue;
+      while (available_bytes_ > 0 && !queue.empty() &&
+             now - queue.front()->enqueue_us >= foreground_latency_slo_us_) {
+        Req* req = queue.front();
+        int64_t bytes = std::min(available_bytes_, req->request_bytes);
+        tenant->deficit -= bytes;
+        GrantLocked(tenant, req, bytes);
+      }
+    }
+  }
+
+  // Deficit round robin: on its turn, a tenant adds its weighted quantum to
+  // its deficit and is granted requests until the deficit is used up. The
+  // turn carries over to the next refill if the bytes run out first.
+  const int64_t quantum =
+      std::max<int64_t>(refill_bytes_per_period / kQuantumsPerRefill, 1);
+  while (available_bytes_ > 0 && !active_tenants_.empty()) {
+    Tenant* tenant = active_tenants_.front();
+    Req* req = tenant->Front();
+    if (req == nullptr) {
+      // Only keep the debt from latency target grants, not unused quantum
+      tenant->deficit = std::min<int64_t>(tenant->deficit, 0);
+      tenant->has_quantum = false;
+      tenant->active = false;
+      active_tenants_.pop_front();
+      continue;
+    }
+    if (!tenant->has_quantum) {
+      tenant->deficit += quantum * tenant->weight;
+      tenant->has_quantum = true;
+    }
+    if (tenant->deficit <= 0) {
+      tenant->has_quantum = false;
+      active_tenants_.pop_front();
+      active_tenants_.push_back(tenant);
+      continue;
+    }
+    int64_t bytes = std::min(
+        {available_bytes_, req->request_bytes, tenant->deficit});
+    tenant->deficit -= bytes;
+    GrantLocked(tenant, req, bytes);
+  }
+}
+
+int64_t MultiTenantRateLimiterImpl::CalculateRefillBytesPerPeriod(
+    int64_t rate_bytes_per_sec) const {
+  if (std::numeric_limits<int64_t>::max() / rate_bytes_per_sec <
+      refill_period_us_) {
+    // Avoid unexpected result in the overflow case. The result now is still
+    // inaccurate but is a number that is large enough.
+    return std::numeric_limits<int64_t>::max() / kMicrosecondsPerSecond;
+  } else {
+    return rate_bytes_per_sec * refill_period_us_ / kMicrosecondsPerSecond;
+  }
+}
+
+MultiTenantRateLimiter* NewMultiTenantRateLimiter(
+    const MultiTenantRateLimiterOptions& options) {
+  assert(options.rate_bytes_per_sec > 0);
+  assert(options.refill_period_us > 0);
+  return new MultiTenantRateLimiterImpl(options, SystemClock::Default());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
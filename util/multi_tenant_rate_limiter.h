@@ -0,0 +1,133 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "monitoring/histogram.h"
+#include "port/port.h"
+#include "rocksdb/env.h"
+#include "rocksdb/rate_limiter.h"
+#include "rocksdb/status.h"
+#include "rocksdb/system_clock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Attributes the I/O the current thread issues while it is in scope to the
+// given column family for MultiTenantRateLimiter, unless the thread has a
+// tenant tag set with SetThreadIOTenant(). Scopes nest; nullptr leaves the
+// attribution unchanged.
+class IOTenantScope {
+ public:
+  explicit IOTenantScope(const std::string* column_family_name);
+  ~IOTenantScope();
+
+  IOTenantScope(const IOTenantScope&) = delete;
+  IOTenantScope& operator=(const IOTenantScope&) = delete;
+
+ private:
+  const std::string* prev_column_family_name_;
+};
+
+// Returns the tenant the current thread's I/O is attributed to.
+const std::string& GetThreadIOTenant();
+
+class MultiTenantRateLimiterImpl : public MultiTenantRateLimiter {
+ public:
+  MultiTenantRateLimiterImpl(const MultiTenantRateLimiterOptions& options,
+                             const std::shared_ptr<SystemClock>& clock);
+
+  ~MultiTenantRateLimiterImpl() override;
+
+  void SetBytesPerSecond(int64_t bytes_per_second) override;
+
+  // Same contract as GenericRateLimiter::Request()
+  using RateLimiter::Request;
+  void Request(const int64_t bytes, const Env::IOPriority pri,
+               Statistics* stats) override;
+  void Request(const int64_t bytes, const Env::IOPriority pri,
+               Statistics* stats, RateLimiter::OpType op_type) override;
+
+  int64_t GetSingleBurstBytes() const override {
+    return refill_bytes_per_period_.load(std::memory_order_relaxed);
+  }
+
+  int64_t GetTotalBytesThrough(
+      const Env::IOPriority pri = Env::IO_TOTAL) const override;
+
+  int64_t GetTotalRequests(
+      const Env::IOPriority pri = Env::IO_TOTAL) const override;
+
+  Status GetTotalPendingRequests(
+      int64_t* total_pending_requests,
+      const Env::IOPriority pri = Env::IO_TOTAL) const override;
+
+  int64_t GetBytesPerSecond() const override {
+    return rate_bytes_per_sec_.load(std::memory_order_relaxed);
+  }
+
+  std::map<std::string, TenantStats> GetTenantStats() const override;
+
+  void SetTenantWeight(const std::string& tenant, uint32_t weight) override;
+
+ private:
+  static constexpr int kMicrosecondsPerSecond = 1000000;
+  // A tenant's deficit grows by weight * refill bytes / kQuantumsPerRefill
+  // each round.
+  static constexpr int64_t kQuantumsPerRefill = 16;
+
+  struct Req;
+  struct Tenant;
+
+  void RequestImpl(int64_t bytes, Env::IOPriority pri, Statistics* stats,
+                   RateLimiter::OpType op_type);
+  Tenant* GetOrCreateTenantLocked(const std::string& name);
+  void RefillBytesAndGrantRequestsLocked();
+  // Grants `bytes` of the request at the front of one of `tenant`'s queues,
+  // dequeuing and waking it up once fully granted.
+  void GrantLocked(Tenant* tenant, Req* req, int64_t bytes);
+  int64_t CalculateRefillBytesPerPeriod(int64_t rate_bytes_per_sec) const;
+
+  uint64_t NowMicrosMonotonicLocked() {
+    return clock_->NowNanos() / std::milli::den;
+  }
+
+  // This mutex guard all internal states
+  mutable port::Mutex request_mutex_;
+
+  const int64_t refill_period_us_;
+  const uint64_t foreground_latency_slo_us_;
+
+  std::atomic<int64_t> rate_bytes_per_sec_;
+  std::atomic<int64_t> refill_bytes_per_period_;
+  std::shared_ptr<SystemClock> clock_;
+
+  bool stop_;
+  port::CondVar exit_cv_;
+  int32_t requests_to_wait_;
+
+  int64_t total_requests_[Env::IO_TOTAL];
+  int64_t total_bytes_through_[Env::IO_TOTAL];
+  int64_t pending_requests_[Env::IO_TOTAL];
+  int64_t available_bytes_;
+  int64_t next_refill_us_;
+  bool wait_until_refill_pending_;
+
+  std::unordered_map<std::string, uint32_t> tenant_weights_;
+  const uint32_t default_weight_;
+  // Tenants are never removed, so that their stats accumulate
+  std::map<std::string, std::unique_ptr<Tenant>> tenants_;
+  // Tenants with queued requests, in round robin order
+  std::deque<Tenant*> active_tenants_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
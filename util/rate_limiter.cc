@@ -17,7 +17,6 @@
 #include "util/rate_limiter_impl.h"
 
 namespace ROCKSDB_NAMESPACE {
-namespace {
 
 Tickers RateLimiterBytesTicker(RateLimiter::OpType op_type) {
   switch (op_type) {
@@ -74,8 +73,6 @@ Histograms RateLimiterWaitHistogram(RateLimiter::OpType op_type) {
   return RATE_LIMITER_WAIT_MICROS_WRITE;
 }
 
-}  // namespace
-
 size_t RateLimiter::RequestToken(size_t bytes, size_t alignment,
                                  Env::IOPriority io_priority, Statistics* stats,
                                  RateLimiter::OpType op_type) {
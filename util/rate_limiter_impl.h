@@ -157,6 +157,13 @@ class GenericRateLimiter : public RateLimiter {
   std::chrono::microseconds tuned_time_;
 };
 
+// Statistics recorded for a granted request, by operation type
+Tickers RateLimiterBytesTicker(RateLimiter::OpType op_type);
+Tickers RateLimiterRequestsTicker(RateLimiter::OpType op_type);
+Tickers RateLimiterDelayedRequestsTicker(RateLimiter::OpType op_type);
+Tickers RateLimiterTotalWaitTicker(RateLimiter::OpType op_type);
+Histograms RateLimiterWaitHistogram(RateLimiter::OpType op_type);
+
 // Requests `total_bytes_to_request` bytes from `rate_limiter`, split into
 // GetSingleBurstBytes()-sized chunks and blocking until all are granted. Shared
 // by the backup and copy engines.
@@ -18,6 +18,7 @@
 #include "test_util/mock_time_env.h"
 #include "test_util/sync_point.h"
 #include "test_util/testharness.h"
+#include "util/multi_tenant_rate_limiter.h"
 #include "util/random.h"
 #include "util/rate_limiter_impl.h"
 
@@ -664,6 +665,82 @@ TEST_F(RateLimiterTest, RuntimeSingleBurstBytesChange) {
             mock_clock->NowMicros());
 }
 
+TEST_F(RateLimiterTest, MultiTenantAttribution) {
+  MultiTenantRateLimiterOptions options;
+  options.rate_bytes_per_sec = 1 << 30;
+  options.tenant_weights = {{"tag", 5}};
+  std::unique_ptr<MultiTenantRateLimiter> limiter(
+      NewMultiTenantRateLimiter(options));
+
+  {
+    const std::string cf_name = "cf1";
+    IOTenantScope scope(&cf_name);
+    limiter->Request(100, Env::IO_USER, nullptr /* stats */,
+                     RateLimiter::OpType::kWrite);
+    SetThreadIOTenant("tag");
+    limiter->Request(200, Env::IO_LOW, nullptr /* stats */,
+                     RateLimiter::OpType::kWrite);
+    SetThreadIOTenant("");
+  }
+  limiter->Request(300, Env::IO_HIGH, nullptr /* stats */,
+                   RateLimiter::OpType::kWrite);
+
+  auto stats = limiter->GetTenantStats();
+  ASSERT_EQ(3U, stats.size());
+  ASSERT_EQ(1U, stats["cf1"].requests);
+  ASSERT_EQ(100U, stats["cf1"].bytes);
+  ASSERT_EQ(1U, stats["cf1"].foreground_requests);
+  ASSERT_EQ(1U, stats["cf1"].weight);
+  ASSERT_EQ(200U, stats["tag"].bytes);
+  ASSERT_EQ(0U, stats["tag"].foreground_requests);
+  ASSERT_EQ(5U, stats["tag"].weight);
+  ASSERT_EQ(300U, stats[""].bytes);
+  ASSERT_EQ(600, limiter->GetTotalBytesThrough());
+  ASSERT_EQ(3, limiter->GetTotalRequests());
+}
+
+TEST_F(RateLimiterTest, MultiTenantWeightedShare) {
+  // 10KB per refill
+  MultiTenantRateLimiterOptions options;
+  options.rate_bytes_per_sec = 1 << 20;
+  options.refill_period_us = 10 * 1000;
+  options.tenant_weights = {{"heavy", 3}};
+  std::unique_ptr<MultiTenantRateLimiter> limiter(
+      NewMultiTenantRateLimiter(options));
+
+  // Enough concurrent requests that both tenants always have some queued
+  const int kThreadsPerTenant = 8;
+  const int64_t kRequestBytes = 4 << 10;
+  std::atomic<bool> stop{false};
+  std::vector<port::Thread> threads;
+  for (const char* tenant : {"heavy", "light"}) {
+    for (int i = 0; i < kThreadsPerTenant; ++i) {
+      threads.emplace_back([&, tenant]() {
+        SetThreadIOTenant(tenant);
+        while (!stop.load(std::memory_order_relaxed)) {
+          limiter->Request(kRequestBytes, Env::IO_LOW, nullptr /* stats */,
+                           RateLimiter::OpType::kWrite);
+        }
+      });
+    }
+  }
+  SystemClock::Default()->SleepForMicroseconds(1000 * 1000);
+  stop.store(true, std::memory_order_relaxed);
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  auto stats = limiter->GetTenantStats();
+  ASSERT_EQ(2U, stats.size());
+  double ratio = static_cast<double>(stats["heavy"].bytes) /
+                 static_cast<double>(stats["light"].bytes);
+  fprintf(stderr, "heavy/light bytes ratio: %.2f\n", ratio);
+  ASSERT_GT(ratio, 2.0);
+  ASSERT_LT(ratio, 4.5);
+  ASSERT_GT(stats["light"].delayed_requests, 0U);
+  ASSERT_GT(stats["light"].background_wait_micros.count, 0U);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -0,0 +1,292 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+
+#include "util/shared_dict_compressor.h"
+
+#include <algorithm>
+
+#include "rocksdb/filter_policy.h"
+#include "util/coding.h"
+#include "util/compression.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+SharedDictionaryOptions SanitizeOptions(SharedDictionaryOptions opts) {
+  if (opts.sample_interval == 0) {
+    opts.sample_interval = 1;
+  }
+  return opts;
+}
+
+std::shared_ptr<Decompressor> WrapDecompressor(
+    std::shared_ptr<Decompressor>&& decompressor,
+    const std::shared_ptr<SharedDecompressorCache>& cache) {
+  if (decompressor == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<SharedDictDecompressor>(std::move(decompressor),
+                                                  cache);
+}
+}  // namespace
+
+std::shared_ptr<const std::string> SharedDictionaryState::GetDict() const {
+  MutexLock l(&mutex_);
+  return dict_;
+}
+
+uint64_t SharedDictionaryState::GetVersion() const {
+  MutexLock l(&mutex_);
+  return version_;
+}
+
+void SharedDictionaryState::AddSample(const Slice& block) {
+  if (block.empty() || block.size() > opts_.max_train_bytes) {
+    return;
+  }
+  std::string sample = block.ToString();
+  MutexLock l(&mutex_);
+  sample_bytes_ += sample.size();
+  samples_.push_back(std::move(sample));
+  if (sample_bytes_ >= opts_.max_train_bytes) {
+    samples_full_.StoreRelaxed(true);
+  }
+  while (sample_bytes_ > opts_.max_train_bytes) {
+    sample_bytes_ -= samples_.front().size();
+    samples_.pop_front();
+  }
+}
+
+bool SharedDictionaryState::IsTrainingDue() const {
+  return !training_.LoadRelaxed() &&
+         (has_dict_.LoadRelaxed() ? bytes_since_training_.LoadRelaxed() >=
+                                        opts_.retrain_interval_bytes
+                                  : samples_full_.LoadRelaxed());
+}
+
+void SharedDictionaryState::RecordCompressed(size_t bytes) {
+  bytes_since_training_.FetchAddRelaxed(bytes);
+  if (!IsTrainingDue()) {
+    return;
+  }
+  std::string samples;
+  std::vector<size_t> sample_lens;
+  {
+    MutexLock l(&mutex_);
+    // Another thread may have trained meanwhile
+    if (!IsTrainingDue() || samples_.empty()) {
+      return;
+    }
+    training_.StoreRelaxed(true);
+    bytes_since_training_.StoreRelaxed(0);
+    samples.reserve(sample_bytes_);
+    sample_lens.reserve(samples_.size());
+    for (const std::string& sample : samples_) {
+      samples.append(sample);
+      sample_lens.push_back(sample.size());
+    }
+  }
+  // Outside of the mutex, so that compressions go on meanwhile
+  Train(std::move(samples), std::move(sample_lens));
+}
+
+void SharedDictionaryState::Train(std::string&& samples,
+                                  std::vector<size_t>&& sample_lens) {
+  std::string dict =
+      ZSTD_TrainDictionary(samples, sample_lens, opts_.max_dict_bytes);
+  MutexLock l(&mutex_);
+  training_.StoreRelaxed(false);
+  if (!dict.empty()) {
+    dict_ = std::make_shared<const std::string>(std::move(dict));
+    has_dict_.StoreRelaxed(true);
+    ++version_;
+  } else {
+    // Keep the current version (e.g. too few samples), and before the first
+    // version, wait for the next sample rather than the next block to retry
+    samples_full_.StoreRelaxed(false);
+  }
+}
+
+SharedDictCompressor::SharedDictCompressor(
+    std::shared_ptr<SharedDictionaryState> state, uint32_t sample_interval,
+    std::unique_ptr<Compressor> wrapped, CacheEntryRole block_type)
+    : CompressorWrapper(std::move(wrapped)),
+      state_(std::move(state)),
+      sample_interval_(sample_interval),
+      block_type_(block_type) {}
+
+Compressor::DictConfig SharedDictCompressor::GetDictGuidance(
+    CacheEntryRole block_type) const {
+  if (block_type != CacheEntryRole::kDataBlock) {
+    return DictDisabled{};
+  }
+  std::shared_ptr<const std::string> dict = state_->GetDict();
+  if (dict == nullptr) {
+    return DictDisabled{};
+  }
+  return DictPreDefined{*dict};
+}
+
+std::unique_ptr<Compressor> SharedDictCompressor::Clone() const {
+  return std::make_unique<SharedDictCompressor>(state_, sample_interval_,
+                                                wrapped_->Clone(), block_type_);
+}
+
+std::unique_ptr<Compressor> SharedDictCompressor::MaybeCloneSpecialized(
+    CacheEntryRole block_type, DictConfigArgs&& dict_config) const {
+  auto specialized =
+      wrapped_->MaybeCloneSpecialized(block_type, std::move(dict_config));
+  if (specialized == nullptr) {
+    if (block_type == block_type_) {
+      return nullptr;
+    }
+    // Still need a distinct compressor for sampling only data blocks
+    specialized = wrapped_->Clone();
+  }
+  return std::make_unique<SharedDictCompressor>(
+      state_, sample_interval_, std::move(specialized), block_type);
+}
+
+Status SharedDictCompressor::CompressBlock(
+    Slice uncompressed_data, char* compressed_output,
+    size_t* compressed_output_size, CompressionType* out_compression_type,
+    ManagedWorkingArea* wa) {
+  if (block_type_ == CacheEntryRole::kDataBlock) {
+    if (block_counter_.FetchAddRelaxed(1) % sample_interval_ == 0) {
+      state_->AddSample(uncompressed_data);
+    }
+    state_->RecordCompressed(uncompressed_data.size());
+  }
+  return wrapped_->CompressBlock(uncompressed_data, compressed_output,
+                                 compressed_output_size, out_compression_type,
+                                 wa);
+}
+
+Status SharedDecompressorCache::MaybeCloneForDict(
+    Decompressor& base, const Slice& dict, std::unique_ptr<Decompressor>* out) {
+  std::string key = base.Name();
+  key.push_back('\0');
+  PutFixed64(&key, Hash64(dict.data(), dict.size()));
+
+  MutexLock l(&mutex_);
+  if (entries_.size() >= purge_threshold_) {
+    PurgeExpired();
+    purge_threshold_ = std::max(kMinPurgeThreshold, 2 * entries_.size());
+  }
+  std::weak_ptr<Entry>& weak_entry = entries_[key];
+  std::shared_ptr<Entry> entry = weak_entry.lock();
+  if (entry != nullptr && Slice(entry->dict) != dict) {
+    // Hash collision, not shared
+    return base.MaybeCloneForDict(dict, out);
+  }
+  if (entry == nullptr) {
+    entry = std::make_shared<Entry>();
+    entry->dict = dict.ToString();
+    Status s = base.MaybeCloneForDict(entry->dict, &entry->decompressor);
+    if (!s.ok()) {
+      return s;
+    }
+    weak_entry = entry;
+  }
+  // Keeps the entry alive
+  std::shared_ptr<Decompressor> shared(entry, entry->decompressor.get());
+  *out = std::make_unique<SharedDictDecompressor>(std::move(shared),
+                                                  /*cache=*/nullptr, dict);
+  return Status::OK();
+}
+
+size_t SharedDecompressorCache::GetNumEntries() {
+  MutexLock l(&mutex_);
+  PurgeExpired();
+  return entries_.size();
+}
+
+void SharedDecompressorCache::PurgeExpired() {
+  mutex_.AssertHeld();
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+Status SharedDictDecompressor::MaybeCloneForDict(
+    const Slice& serialized_dict, std::unique_ptr<Decompressor>* out) {
+  if (cache_ == nullptr) {
+    return wrapped_->MaybeCloneForDict(serialized_dict, out);
+  }
+  return cache_->MaybeCloneForDict(*wrapped_, serialized_dict, out);
+}
+
+SharedDictionaryCompressionManager::SharedDictionaryCompressionManager(
+    std::shared_ptr<CompressionManager> wrapped,
+    const SharedDictionaryOptions& opts)
+    : CompressionManagerWrapper(std::move(wrapped)),
+      opts_(SanitizeOptions(opts)),
+      decompressor_cache_(std::make_shared<SharedDecompressorCache>()) {}
+
+const char* SharedDictionaryCompressionManager::Name() const {
+  return "SharedDictionaryCompressionManager";
+}
+
+std::unique_ptr<Compressor>
+SharedDictionaryCompressionManager::GetCompressorForSST(
+    const FilterBuildingContext& context, const CompressionOptions& opts,
+    CompressionType preferred) {
+  auto compressor = wrapped_->GetCompressorForSST(context, opts, preferred);
+  if (compressor == nullptr || preferred != kZSTD ||
+      !ZSTD_TrainDictionarySupported()) {
+    return compressor;
+  }
+  return std::make_unique<SharedDictCompressor>(
+      GetState(context.column_family_name), opts_.sample_interval,
+      std::move(compressor), CacheEntryRole::kMisc);
+}
+
+std::shared_ptr<Decompressor>
+SharedDictionaryCompressionManager::GetDecompressor() {
+  return WrapDecompressor(wrapped_->GetDecompressor(), decompressor_cache_);
+}
+
+std::shared_ptr<Decompressor>
+SharedDictionaryCompressionManager::GetDecompressorOptimizeFor(
+    CompressionType optimize_for_type) {
+  return WrapDecompressor(
+      wrapped_->GetDecompressorOptimizeFor(optimize_for_type),
+      decompressor_cache_);
+}
+
+std::shared_ptr<Decompressor>
+SharedDictionaryCompressionManager::GetDecompressorForTypes(
+    const CompressionType* types_begin, const CompressionType* types_end) {
+  return WrapDecompressor(
+      wrapped_->GetDecompressorForTypes(types_begin, types_end),
+      decompressor_cache_);
+}
+
+std::shared_ptr<SharedDictionaryState>
+SharedDictionaryCompressionManager::GetState(const std::string& column_family) {
+  MutexLock l(&mutex_);
+  auto& state = states_[column_family];
+  if (state == nullptr) {
+    state = std::make_shared<SharedDictionaryState>(opts_);
+  }
+  return state;
+}
+
+std::shared_ptr<CompressionManagerWrapper>
+CreateSharedDictionaryCompressionManager(
+    const SharedDictionaryOptions& opts,
+    std::shared_ptr<CompressionManager> wrapped) {
+  return std::make_shared<SharedDictionaryCompressionManager>(
+      wrapped == nullptr ? GetBuiltinV2CompressionManager() : wrapped, opts);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
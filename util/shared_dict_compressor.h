@@ -0,0 +1,177 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// Defines the shared dictionary compression manager, which trains a
+// compression dictionary per column family from sampled data blocks and
+// reuses it across SST files.
+
+#pragma once
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/advanced_compression.h"
+#include "util/atomic.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// The samples and current dictionary of one column family
+class SharedDictionaryState {
+ public:
+  explicit SharedDictionaryState(const SharedDictionaryOptions& opts)
+      : opts_(opts) {}
+
+  // The current version of the dictionary, or nullptr before the first
+  // training
+  std::shared_ptr<const std::string> GetDict() const;
+  uint64_t GetVersion() const;
+
+  // Copies `block` into the samples, dropping the oldest ones beyond
+  // max_train_bytes
+  void AddSample(const Slice& block);
+
+  // Accounts for `bytes` of compressed data blocks, and trains a new version
+  // of the dictionary on this thread when due, unless another thread is
+  // training. Lock-free unless training is due.
+  void RecordCompressed(size_t bytes);
+
+ private:
+  bool IsTrainingDue() const;
+  void Train(std::string&& samples, std::vector<size_t>&& sample_lens);
+
+  const SharedDictionaryOptions opts_;
+  mutable port::Mutex mutex_;
+  std::deque<std::string> samples_;
+  size_t sample_bytes_ = 0;
+  RelaxedAtomic<uint64_t> bytes_since_training_{0};
+  // Reached max_train_bytes, so the first version can be trained
+  RelaxedAtomic<bool> samples_full_{false};
+  // Written under mutex_
+  RelaxedAtomic<bool> training_{false};
+  RelaxedAtomic<bool> has_dict_{false};
+  std::shared_ptr<const std::string> dict_;
+  uint64_t version_ = 0;
+};
+
+// Samples the data blocks it compresses into the state of its column family.
+// As the base compressor of a file, recommends the current dictionary of the
+// column family, if any, as pre-defined.
+class SharedDictCompressor : public CompressorWrapper {
+ public:
+  SharedDictCompressor(std::shared_ptr<SharedDictionaryState> state,
+                       uint32_t sample_interval,
+                       std::unique_ptr<Compressor> wrapped,
+                       CacheEntryRole block_type);
+
+  const char* Name() const override { return "SharedDictCompressor"; }
+  DictConfig GetDictGuidance(CacheEntryRole block_type) const override;
+  std::unique_ptr<Compressor> Clone() const override;
+  std::unique_ptr<Compressor> MaybeCloneSpecialized(
+      CacheEntryRole block_type, DictConfigArgs&& dict_config) const override;
+
+  Status CompressBlock(Slice uncompressed_data, char* compressed_output,
+                       size_t* compressed_output_size,
+                       CompressionType* out_compression_type,
+                       ManagedWorkingArea* wa) override;
+
+ private:
+  const std::shared_ptr<SharedDictionaryState> state_;
+  const uint32_t sample_interval_;
+  const CacheEntryRole block_type_;
+  RelaxedAtomic<uint64_t> block_counter_{0};
+};
+
+// Digested decompressors shared by the files opened with the same
+// dictionary. An entry lives as long as a file using it.
+class SharedDecompressorCache {
+ public:
+  // Stores in `out` a decompressor for `dict` sharing the digested state of
+  // `base` cloned for the same dictionary, if any.
+  Status MaybeCloneForDict(Decompressor& base, const Slice& dict,
+                           std::unique_ptr<Decompressor>* out);
+
+  // Number of entries in use
+  size_t GetNumEntries();
+
+ private:
+  struct Entry {
+    std::string dict;
+    std::unique_ptr<Decompressor> decompressor;
+  };
+
+  static constexpr size_t kMinPurgeThreshold = 16;
+
+  // Drops the entries no longer in use. Requires mutex_.
+  void PurgeExpired();
+
+  port::Mutex mutex_;
+  // Keyed by the base decompressor name and the hash of the dictionary
+  std::unordered_map<std::string, std::weak_ptr<Entry>> entries_;
+  size_t purge_threshold_ = kMinPurgeThreshold;
+};
+
+// Wraps the decompressors of the wrapped manager, for cloning them for a
+// dictionary through a SharedDecompressorCache
+class SharedDictDecompressor : public DecompressorWrapper {
+ public:
+  SharedDictDecompressor(std::shared_ptr<Decompressor> wrapped,
+                         std::shared_ptr<SharedDecompressorCache> cache,
+                         const Slice& dict = Slice())
+      : DecompressorWrapper(std::move(wrapped)),
+        cache_(std::move(cache)),
+        dict_(dict) {}
+
+  const Slice& GetSerializedDict() const override { return dict_; }
+
+  Status MaybeCloneForDict(const Slice& serialized_dict,
+                           std::unique_ptr<Decompressor>* out) override;
+
+  // The digested state is shared with other files
+  size_t ApproximateOwnedMemoryUsage() const override {
+    return sizeof(SharedDictDecompressor);
+  }
+
+ private:
+  const std::shared_ptr<SharedDecompressorCache> cache_;
+  const Slice dict_;
+};
+
+class SharedDictionaryCompressionManager : public CompressionManagerWrapper {
+ public:
+  SharedDictionaryCompressionManager(
+      std::shared_ptr<CompressionManager> wrapped,
+      const SharedDictionaryOptions& opts);
+
+  const char* Name() const override;
+  std::unique_ptr<Compressor> GetCompressorForSST(
+      const FilterBuildingContext& context, const CompressionOptions& opts,
+      CompressionType preferred) override;
+
+  std::shared_ptr<Decompressor> GetDecompressor() override;
+  std::shared_ptr<Decompressor> GetDecompressorOptimizeFor(
+      CompressionType optimize_for_type) override;
+  std::shared_ptr<Decompressor> GetDecompressorForTypes(
+      const CompressionType* types_begin,
+      const CompressionType* types_end) override;
+
+  std::shared_ptr<SharedDictionaryState> GetState(
+      const std::string& column_family);
+
+  const std::shared_ptr<SharedDecompressorCache>& decompressor_cache() const {
+    return decompressor_cache_;
+  }
+
+ private:
+  const SharedDictionaryOptions opts_;
+  const std::shared_ptr<SharedDecompressorCache> decompressor_cache_;
+  port::Mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<SharedDictionaryState>>
+      states_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
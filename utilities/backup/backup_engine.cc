@@ -661,19 +661,22 @@ class BackupEngineImpl {
   };
 
   struct RestoreAfterCopyOrCreateWorkItem {
-    std::future<WorkItemResult> result;
+    // One future per chunk, in file order. Files that are not split into
+    // chunks have exactly one.
+    std::vector<std::future<WorkItemResult>> results;
     std::string from_file;
     std::string to_file;
     std::string checksum_hex;
+    uint64_t size = 0;
     RestoreAfterCopyOrCreateWorkItem() {}
-    RestoreAfterCopyOrCreateWorkItem(std::future<WorkItemResult>&& _result,
-                                     const std::string& _from_file,
+    RestoreAfterCopyOrCreateWorkItem(const std::string& _from_file,
                                      const std::string& _to_file,
-                                     const std::string& _checksum_hex)
-        : result(std::move(_result)),
-          from_file(_from_file),
+                                     const std::string& _checksum_hex,
+                                     uint64_t _size)
+        : from_file(_from_file),
           to_file(_to_file),
-          checksum_hex(_checksum_hex) {}
+          checksum_hex(_checksum_hex),
+          size(_size) {}
     RestoreAfterCopyOrCreateWorkItem(
         RestoreAfterCopyOrCreateWorkItem&& o) noexcept {
       *this = std::move(o);
@@ -681,12 +684,61 @@ class BackupEngineImpl {
 
     RestoreAfterCopyOrCreateWorkItem& operator=(
         RestoreAfterCopyOrCreateWorkItem&& o) noexcept {
-      result = std::move(o.result);
+      results = std::move(o.results);
+      from_file = std::move(o.from_file);
+      to_file = std::move(o.to_file);
       checksum_hex = std::move(o.checksum_hex);
+      size = o.size;
       return *this;
     }
   };
 
+  // Aggregates progress of one RestoreDBFromBackup call for
+  // RestoreOptions::progress_callback. Updated from the copy threads, whose
+  // callbacks the CopyEngine already serializes, and from the restoring
+  // thread once the copies are done.
+  struct RestoreProgressTracker {
+    std::mutex mutex;
+    RestoreProgress progress;
+    uint64_t start_micros = 0;
+    SystemClock* clock = nullptr;
+    std::function<void(const RestoreProgress&)> callback;
+
+    void AddBytes(uint64_t bytes) {
+      std::lock_guard<std::mutex> lock(mutex);
+      progress.restored_bytes =
+          std::min(progress.total_bytes, progress.restored_bytes + bytes);
+      Report();
+    }
+
+    void AddFile() {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++progress.restored_files;
+    }
+
+    void Finish() {
+      std::lock_guard<std::mutex> lock(mutex);
+      progress.restored_bytes = progress.total_bytes;
+      Report();
+    }
+
+    // REQUIRES: mutex held
+    void Report() {
+      progress.elapsed_micros = clock->NowMicros() - start_micros;
+      if (progress.elapsed_micros > 0) {
+        progress.bytes_per_second = static_cast<uint64_t>(
+            progress.restored_bytes * 1000000.0 / progress.elapsed_micros);
+      }
+      progress.eta_micros =
+          progress.bytes_per_second > 0
+              ? static_cast<uint64_t>(
+                    (progress.total_bytes - progress.restored_bytes) *
+                    1000000.0 / progress.bytes_per_second)
+              : 0;
+      callback(progress);
+    }
+  };
+
   bool initialized_;
   std::unique_ptr<CopyEngine> copy_engine_;
 
@@ -1801,6 +1853,12 @@ IOStatus BackupEngineImpl::RestoreDBFromBackup(
   }
 
   IOStatus io_s;
+  struct PendingRestoreFile {
+    const BackupEngineImpl* engine;
+    const FileInfo* file_info;
+    std::string dst;
+  };
+  std::vector<PendingRestoreFile> files_to_restore;
   std::vector<RestoreAfterCopyOrCreateWorkItem> restore_items_to_finish;
   std::string temporary_current_file;
   std::string final_current_file;
@@ -1810,9 +1868,6 @@ IOStatus BackupEngineImpl::RestoreDBFromBackup(
   for (const auto& engine_and_file_info : restore_file_infos) {
     const FileInfo* file_info = engine_and_file_info.second;
     const std::string& file = file_info->filename;
-    std::string absolute_file =
-        engine_and_file_info.first->GetAbsolutePath(file);
-    Env* src_env = engine_and_file_info.first->backup_env_;
 
     // 1. get DB filename
     std::string dst = file_info->GetDbFileName();
@@ -1866,6 +1921,42 @@ IOStatus BackupEngineImpl::RestoreDBFromBackup(
     ROCKS_LOG_INFO(options_.info_log, "Restoring %s to %s\n", file.c_str(),
                    dst.c_str());
 
+    files_to_restore.push_back({engine_and_file_info.first, file_info, dst});
+  }
+
+  // Start the largest copies first so that they do not end up as a long tail
+  // running alone after all the small files are done.
+  std::stable_sort(
+      files_to_restore.begin(), files_to_restore.end(),
+      [](const PendingRestoreFile& a, const PendingRestoreFile& b) {
+        return a.file_info->size > b.file_info->size;
+      });
+
+  std::shared_ptr<RestoreProgressTracker> progress_tracker;
+  std::function<void()> copy_progress_callback;
+  if (options.progress_callback) {
+    progress_tracker = std::make_shared<RestoreProgressTracker>();
+    progress_tracker->clock = db_env_->GetSystemClock().get();
+    progress_tracker->start_micros = progress_tracker->clock->NowMicros();
+    progress_tracker->callback = options.progress_callback;
+    progress_tracker->progress.total_files = files_to_restore.size();
+    for (const auto& f : files_to_restore) {
+      progress_tracker->progress.total_bytes += f.file_info->size;
+    }
+    const uint64_t interval = options_.callback_trigger_interval_size;
+    copy_progress_callback = [progress_tracker, interval]() {
+      progress_tracker->AddBytes(interval);
+    };
+  }
+
+  restore_items_to_finish.reserve(files_to_restore.size());
+  for (const auto& f : files_to_restore) {
+    const FileInfo* file_info = f.file_info;
+    std::string absolute_file = f.engine->GetAbsolutePath(file_info->filename);
+    Env* src_env = f.engine->backup_env_;
+    RestoreAfterCopyOrCreateWorkItem after_copy_or_create_work_item(
+        file_info->filename, f.dst, file_info->checksum_hex, file_info->size);
+
     // When file is being copied over, it means that it was either non-existent,
     // purged or its' original on-disk representation didn't meet incremental
     // restore tiering criteria. As such, we need to unconditionally recompute
@@ -1873,36 +1964,114 @@ IOStatus BackupEngineImpl::RestoreDBFromBackup(
     // computed on its' seed backup file in early assessment phase. Protection
     // is put in place to ensure that there are no bugs in the actual restore /
     // file copy logic and we're not producing garbage db files.
-    WorkItem copy_or_create_work_item(
-        absolute_file, dst, Temperature::kUnknown /* src_temp */,
-        file_info->temp, "" /* contents */, src_env, db_env_,
-        EnvOptions() /* src_env_options */, options_.sync,
-        false /* use_fsync */, options_.restore_rate_limiter.get(),
-        file_info->size, nullptr /* stats */);
-    RestoreAfterCopyOrCreateWorkItem after_copy_or_create_work_item(
-        copy_or_create_work_item.result.get_future(), file, dst,
-        file_info->checksum_hex);
-    copy_engine_->Submit(std::move(copy_or_create_work_item));
+    bool chunked = false;
+    const uint64_t chunk_size = options.parallel_copy_chunk_size;
+    if (chunk_size > 0 && file_info->size > chunk_size) {
+      // Chunks are written in place, so the destination must exist up front.
+      // A source whose actual size differs from the metadata is copied whole
+      // so that the mismatch surfaces as a checksum failure.
+      uint64_t actual_size = 0;
+      FileOptions dst_file_options;
+      dst_file_options.temperature = file_info->temp;
+      std::unique_ptr<FSWritableFile> dst_file;
+      std::unique_ptr<FSRandomRWFile> probe;
+      chunked = src_env->GetFileSystem()
+                    ->GetFileSize(absolute_file, io_options_, &actual_size,
+                                  nullptr)
+                    .ok() &&
+                actual_size == file_info->size &&
+                db_fs_->NewWritableFile(f.dst, dst_file_options, &dst_file,
+                                        nullptr)
+                    .ok() &&
+                dst_file->Close(io_options_, nullptr).ok() &&
+                db_fs_->NewRandomRWFile(f.dst, FileOptions(), &probe, nullptr)
+                    .ok();
+      if (probe) {
+        probe->Close(io_options_, nullptr).PermitUncheckedError();
+      }
+    }
+    if (chunked) {
+      for (uint64_t offset = 0; offset < file_info->size;
+           offset += chunk_size) {
+        WorkItem chunk_work_item(
+            absolute_file, f.dst, Temperature::kUnknown /* src_temp */,
+            file_info->temp, "" /* contents */, src_env, db_env_,
+            EnvOptions() /* src_env_options */, options_.sync,
+            false /* use_fsync */, options_.restore_rate_limiter.get(),
+            std::min(chunk_size, file_info->size - offset),
+            nullptr /* stats */, copy_progress_callback);
+        chunk_work_item.type = WorkItemType::CopyRange;
+        chunk_work_item.src_offset = offset;
+        after_copy_or_create_work_item.results.push_back(
+            chunk_work_item.result.get_future());
+        copy_engine_->Submit(std::move(chunk_work_item));
+      }
+    } else {
+      WorkItem copy_or_create_work_item(
+          absolute_file, f.dst, Temperature::kUnknown /* src_temp */,
+          file_info->temp, "" /* contents */, src_env, db_env_,
+          EnvOptions() /* src_env_options */, options_.sync,
+          false /* use_fsync */, options_.restore_rate_limiter.get(),
+          file_info->size, nullptr /* stats */, copy_progress_callback);
+      after_copy_or_create_work_item.results.push_back(
+          copy_or_create_work_item.result.get_future());
+      copy_engine_->Submit(std::move(copy_or_create_work_item));
+    }
     restore_items_to_finish.push_back(
         std::move(after_copy_or_create_work_item));
   }
-  IOStatus item_io_status;
   for (auto& item : restore_items_to_finish) {
-    item.result.wait();
-    auto result = item.result.get();
-    item_io_status = result.io_status;
-    // Note: It is possible that both of the following bad-status cases occur
-    // during copying. But, we only return one status.
-    if (!item_io_status.ok()) {
-      io_s = item_io_status;
-      break;
-    } else if (!item.checksum_hex.empty() &&
-               item.checksum_hex != result.checksum_hex) {
+    // Every future must be consumed, even after a failure, so that the
+    // background threads are done with this restore before returning.
+    uint32_t combined_checksum = 0;
+    uint64_t copied_size = 0;
+    for (auto& chunk_result : item.results) {
+      auto result = chunk_result.get();
+      if (!io_s.ok()) {
+        continue;
+      }
+      // Note: It is possible that both of the following bad-status cases
+      // occur during copying. But, we only return one status.
+      if (!result.io_status.ok()) {
+        io_s = result.io_status;
+        continue;
+      }
+      combined_checksum =
+          item.results.size() == 1
+              ? ChecksumHexToInt32(result.checksum_hex)
+              : crc32c::Crc32cCombine(combined_checksum,
+                                      ChecksumHexToInt32(result.checksum_hex),
+                                      static_cast<size_t>(result.size));
+      copied_size += result.size;
+    }
+    if (!io_s.ok()) {
+      continue;
+    }
+    std::string computed_checksum_hex = ChecksumInt32ToHex(combined_checksum);
+    if (!item.checksum_hex.empty() &&
+        item.checksum_hex != computed_checksum_hex) {
       io_s = IOStatus::Corruption(
           "While restoring " + item.from_file + " -> " + item.to_file +
           ": expected checksum is " + item.checksum_hex +
-          " while computed checksum is " + result.checksum_hex);
-      break;
+          " while computed checksum is " + computed_checksum_hex);
+    } else if (item.results.size() > 1 && copied_size != item.size) {
+      io_s = IOStatus::Corruption(
+          "While restoring " + item.from_file + " -> " + item.to_file +
+          ": expected size is " + std::to_string(item.size) +
+          " while copied size is " + std::to_string(copied_size));
+    } else if (progress_tracker) {
+      progress_tracker->AddFile();
+    }
+  }
+
+  if (io_s.ok() && progress_tracker) {
+    try {
+      progress_tracker->Finish();
+    } catch (const std::exception& exn) {
+      io_s = IOStatus::Aborted("Exception in progress_callback: " +
+                               std::string(exn.what()));
+    } catch (...) {
+      io_s = IOStatus::Aborted("Unknown exception in progress_callback");
     }
   }
 
@@ -3510,6 +3510,69 @@ TEST_F(BackupEngineTest, ProgressCallbackDuringBackup) {
   DestroyDBWithoutCheck(dbname_, options_);
 }
 
+TEST_F(BackupEngineTest, ParallelChunkedRestore) {
+  const int keys_iteration = 5000;
+  engine_options_->max_background_operations = 4;
+  engine_options_->callback_trigger_interval_size = 1000;
+  OpenDBAndBackupEngine(true /* destroy_old_data */, false /* dummy */,
+                        kShareWithChecksum);
+  FillDB(db_.get(), 0, keys_iteration);
+  ASSERT_OK(backup_engine_->CreateNewBackup(db_.get(), true));
+  CloseDBAndBackupEngine();
+
+  std::atomic<int> range_copies{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "CopyEngine::CopyFileRange:Start", [&](void*) { ++range_copies; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  RestoreOptions restore_options;
+  restore_options.parallel_copy_chunk_size = 4096;
+  std::vector<RestoreProgress> reports;
+  restore_options.progress_callback = [&](const RestoreProgress& p) {
+    reports.push_back(p);
+  };
+  OpenBackupEngine();
+  ASSERT_OK(backup_engine_->RestoreDBFromBackup(restore_options, 1, dbname_,
+                                                dbname_));
+  CloseBackupEngine();
+  ASSERT_GT(range_copies.load(), 1);
+  ASSERT_GT(reports.size(), 1U);
+  for (size_t i = 1; i < reports.size(); ++i) {
+    ASSERT_GE(reports[i].restored_bytes, reports[i - 1].restored_bytes);
+  }
+  const RestoreProgress& last = reports.back();
+  ASSERT_GT(last.total_bytes, restore_options.parallel_copy_chunk_size);
+  ASSERT_EQ(last.total_bytes, last.restored_bytes);
+  ASSERT_EQ(last.total_files, last.restored_files);
+  ASSERT_EQ(0U, last.eta_micros);
+
+  auto db = OpenDB();
+  AssertExists(db.get(), 0, keys_iteration);
+  db.reset();
+
+  // Corrupt the table files in the backup while maintaining their sizes; the
+  // combined chunk checksums must not match
+  std::vector<FileAttributes> children;
+  const std::string dir = backupdir_ + "/shared_checksum";
+  ASSERT_OK(file_manager_->GetChildrenFileAttributes(dir, &children));
+  for (const auto& child : children) {
+    if (child.size_bytes > restore_options.parallel_copy_chunk_size) {
+      ASSERT_OK(
+          file_manager_->CorruptFile(dir + "/" + child.name, child.size_bytes));
+    }
+  }
+  range_copies = 0;
+  OpenBackupEngine();
+  ASSERT_TRUE(backup_engine_
+                  ->RestoreDBFromBackup(restore_options, 1, dbname_, dbname_)
+                  .IsCorruption());
+  CloseBackupEngine();
+  ASSERT_GT(range_copies.load(), 1);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(BackupEngineTest, GarbageCollectionBeforeBackup) {
   DestroyDBWithoutCheck(dbname_, options_);
   OpenDBAndBackupEngine(true);
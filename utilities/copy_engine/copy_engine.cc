@@ -120,6 +120,18 @@ void CopyEngine::ThreadBody() {
                          checksum_function_info.c_str());
         }
       }
+    } else if (work_item.type == WorkItemType::CopyRange) {
+      result.io_status = CopyFileRange(
+          work_item.src_path, work_item.dst_path, work_item.src_offset,
+          work_item.size_limit, work_item.src_env, work_item.dst_env,
+          work_item.src_env_options, work_item.sync, work_item.use_fsync,
+          work_item.rate_limiter, work_item.progress_callback,
+          &bytes_toward_next_callback, &result.size, &result.checksum_hex);
+
+      RecordTick(work_item.stats, options_.read_bytes_ticker,
+                 IOSTATS(bytes_read) - prev_bytes_read);
+      RecordTick(work_item.stats, options_.write_bytes_ticker,
+                 IOSTATS(bytes_written) - prev_bytes_written);
     } else if (work_item.type == ComputeChecksum) {
       result.io_status = ReadFileAndComputeChecksum(
           work_item.src_path, work_item.src_env->GetFileSystem(),
@@ -255,22 +267,8 @@ IOStatus CopyEngine::CopyOrCreateFile(
                                    RateLimiter::OpType::kWrite);
       }
     }
-    while (*bytes_toward_next_callback >=
-           options_.callback_trigger_interval_size) {
-      *bytes_toward_next_callback -= options_.callback_trigger_interval_size;
-      if (progress_callback) {
-        std::lock_guard<std::mutex> lock(byte_report_mutex_);
-        try {
-          progress_callback();
-        } catch (const std::exception& exn) {
-          io_s = IOStatus::Aborted("Exception in progress_callback: " +
-                                   std::string(exn.what()));
-          break;
-        } catch (...) {
-          io_s = IOStatus::Aborted("Unknown exception in progress_callback");
-          break;
-        }
-      }
+    if (io_s.ok()) {
+      io_s = MaybeReportProgress(progress_callback, bytes_toward_next_callback);
     }
   } while (io_s.ok() && contents.empty() && data.size() > 0 && size_limit > 0);
 
@@ -288,6 +286,109 @@ IOStatus CopyEngine::CopyOrCreateFile(
   return io_s;
 }
 
+IOStatus CopyEngine::MaybeReportProgress(
+    const std::function<void()>& progress_callback,
+    uint64_t* bytes_toward_next_callback) {
+  while (*bytes_toward_next_callback >=
+         options_.callback_trigger_interval_size) {
+    *bytes_toward_next_callback -= options_.callback_trigger_interval_size;
+    if (progress_callback) {
+      std::lock_guard<std::mutex> lock(byte_report_mutex_);
+      try {
+        progress_callback();
+      } catch (const std::exception& exn) {
+        return IOStatus::Aborted("Exception in progress_callback: " +
+                                 std::string(exn.what()));
+      } catch (...) {
+        return IOStatus::Aborted("Unknown exception in progress_callback");
+      }
+    }
+  }
+  return IOStatus::OK();
+}
+
+IOStatus CopyEngine::CopyFileRange(
+    const std::string& src, const std::string& dst, uint64_t offset,
+    uint64_t length, Env* src_env, Env* dst_env,
+    const EnvOptions& src_env_options, bool sync, bool use_fsync,
+    RateLimiter* rate_limiter, const std::function<void()>& progress_callback,
+    uint64_t* bytes_toward_next_callback, uint64_t* size,
+    std::string* checksum_hex) {
+  TEST_SYNC_POINT("CopyEngine::CopyFileRange:Start");
+  if (ShouldAbort()) {
+    return status_to_io_status(
+        Status::Incomplete(options_.abort_status_message));
+  }
+  *size = 0;
+  uint32_t checksum_value = 0;
+  const IOOptions opts;
+
+  std::unique_ptr<FSRandomAccessFile> src_file;
+  IOStatus io_s = src_env->GetFileSystem()->NewRandomAccessFile(
+      src, FileOptions(src_env_options), &src_file, nullptr);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  std::unique_ptr<FSRandomRWFile> dst_file;
+  io_s = dst_env->GetFileSystem()->NewRandomRWFile(dst, FileOptions(),
+                                                   &dst_file, nullptr);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+
+  size_t buf_size = CalculateIOBufferSize(rate_limiter);
+  std::unique_ptr<char[]> buf(new char[buf_size]);
+  Slice data;
+  while (length > 0) {
+    if (ShouldAbort()) {
+      return status_to_io_status(
+          Status::Incomplete(options_.abort_status_message));
+    }
+    size_t buffer_to_read =
+        (buf_size < length) ? buf_size : static_cast<size_t>(length);
+    if (rate_limiter != nullptr) {
+      rate_limiter->Request(buffer_to_read, Env::IO_LOW, nullptr /* stats */,
+                            RateLimiter::OpType::kRead);
+    }
+    io_s = src_file->Read(offset, buffer_to_read, opts, &data, buf.get(),
+                          nullptr);
+    if (!io_s.ok()) {
+      return io_s;
+    }
+    if (data.empty()) {
+      // Source is shorter than expected; the caller detects this from `size`.
+      break;
+    }
+    checksum_value = crc32c::Extend(checksum_value, data.data(), data.size());
+    io_s = dst_file->Write(offset, data, opts, nullptr);
+    if (!io_s.ok()) {
+      return io_s;
+    }
+    if (rate_limiter != nullptr) {
+      rate_limiter->Request(data.size(), Env::IO_LOW, nullptr /* stats */,
+                            RateLimiter::OpType::kWrite);
+    }
+    offset += data.size();
+    length -= data.size();
+    *size += data.size();
+    *bytes_toward_next_callback += data.size();
+    io_s = MaybeReportProgress(progress_callback, bytes_toward_next_callback);
+    if (!io_s.ok()) {
+      return io_s;
+    }
+  }
+  checksum_hex->assign(ChecksumInt32ToHex(checksum_value));
+
+  if (sync) {
+    io_s = use_fsync ? dst_file->Fsync(opts, nullptr)
+                     : dst_file->Sync(opts, nullptr);
+  }
+  if (io_s.ok()) {
+    io_s = dst_file->Close(opts, nullptr);
+  }
+  return io_s;
+}
+
 IOStatus CopyEngine::LinkFile(const std::string& src, const std::string& dst,
                               Env* dst_env) {
   if (ShouldAbort()) {
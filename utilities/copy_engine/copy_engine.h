@@ -70,6 +70,9 @@ enum WorkItemType : uint64_t {
   CopyOrCreate = 1U,
   ComputeChecksum = 2U,
   Link = 3U,
+  // Copies size_limit bytes starting at src_offset into the same range of an
+  // existing dst_path. Used to copy chunks of one large file in parallel.
+  CopyRange = 4U,
 };
 
 // Exactly one of src_path and contents must be non-empty. If src_path is
@@ -88,6 +91,8 @@ struct WorkItem {
   bool use_fsync = false;
   RateLimiter* rate_limiter = nullptr;
   uint64_t size_limit = 0;
+  // Only used by CopyRange
+  uint64_t src_offset = 0;
   Statistics* stats = nullptr;
   std::promise<WorkItemResult> result;
   std::function<void()> progress_callback;
@@ -117,6 +122,7 @@ struct WorkItem {
     use_fsync = o.use_fsync;
     rate_limiter = o.rate_limiter;
     size_limit = o.size_limit;
+    src_offset = o.src_offset;
     stats = o.stats;
     result = std::move(o.result);
     progress_callback = std::move(o.progress_callback);
@@ -211,6 +217,17 @@ class CopyEngine {
                             uint64_t* bytes_toward_next_callback,
                             uint64_t* size, std::string* checksum_hex);
 
+  // Copies `length` bytes at `offset` of src into the same offset of dst,
+  // which must already exist. checksum_hex receives the crc32c of the range
+  // alone, to be combined with those of the other ranges by the caller.
+  IOStatus CopyFileRange(const std::string& src, const std::string& dst,
+                         uint64_t offset, uint64_t length, Env* src_env,
+                         Env* dst_env, const EnvOptions& src_env_options,
+                         bool sync, bool use_fsync, RateLimiter* rate_limiter,
+                         const std::function<void()>& progress_callback,
+                         uint64_t* bytes_toward_next_callback, uint64_t* size,
+                         std::string* checksum_hex);
+
   IOStatus ReadFileAndComputeChecksum(const std::string& src,
                                       const std::shared_ptr<FileSystem>& src_fs,
                                       const EnvOptions& src_env_options,
@@ -230,6 +247,10 @@ class CopyEngine {
       5 * 1024 * 1024LL;  // 5MB
 
   void ThreadBody();
+  // Invokes progress_callback once per callback_trigger_interval_size bytes
+  // accumulated in bytes_toward_next_callback.
+  IOStatus MaybeReportProgress(const std::function<void()>& progress_callback,
+                               uint64_t* bytes_toward_next_callback);
   bool ShouldAbort() const {
     return options_.should_abort && options_.should_abort();
   }
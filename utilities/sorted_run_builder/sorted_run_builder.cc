@@ -59,6 +59,8 @@ class SortedRunBuilderImpl : public SortedRunBuilder {
 
     // Compression
     db_options.compression = options_.compression;
+    db_options.compression_opts.parallel_threads =
+        options_.compression_parallel_threads;
 
     // Compaction threads and subcompactions
     db_options.max_background_jobs = options_.max_compaction_threads;
@@ -221,6 +223,10 @@ Status SortedRunBuilder::Create(const SortedRunBuilderOptions& options,
   if (options.max_compaction_threads <= 0) {
     return Status::InvalidArgument("max_compaction_threads must be positive");
   }
+  if (options.compression_parallel_threads == 0) {
+    return Status::InvalidArgument(
+        "compression_parallel_threads must be positive");
+  }
   if (options.write_buffer_size == 0) {
     return Status::InvalidArgument("write_buffer_size must be non-zero");
   }
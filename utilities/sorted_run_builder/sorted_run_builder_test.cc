@@ -278,6 +278,42 @@ TEST_F(SortedRunBuilderTest, LargeRandomDataset) {
   ASSERT_EQ(idx, kNumKeys);
 }
 
+TEST_F(SortedRunBuilderTest, ParallelBuilding) {
+  SortedRunBuilderOptions opts;
+  opts.temp_dir = temp_dir_;
+  opts.write_buffer_size = 64 * 1024;
+  opts.target_file_size_bytes = 64 * 1024;
+  opts.compression_parallel_threads = 4;
+
+  std::unique_ptr<SortedRunBuilder> builder;
+  ASSERT_OK(SortedRunBuilder::Create(opts, &builder));
+
+  const int kNumKeys = 10000;
+  std::vector<std::string> keys;
+  keys.reserve(kNumKeys);
+  for (int i = 0; i < kNumKeys; i++) {
+    keys.push_back(Key(i));
+  }
+  RandomShuffle(keys.begin(), keys.end(), 42);
+  for (const auto& key : keys) {
+    ASSERT_OK(builder->Add(key, "val_" + key));
+  }
+  ASSERT_OK(builder->Finish());
+  ASSERT_GT(builder->GetOutputFiles().size(), 1);
+  ASSERT_EQ(builder->GetNumEntries(), kNumKeys);
+
+  ReadOptions ro;
+  std::unique_ptr<Iterator> iter(builder->NewIterator(ro));
+  int idx = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(iter->key().ToString(), Key(idx));
+    ASSERT_EQ(iter->value().ToString(), "val_" + Key(idx));
+    idx++;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(idx, kNumKeys);
+}
+
 TEST_F(SortedRunBuilderTest, NumEntriesAndDataSize) {
   SortedRunBuilderOptions opts;
   opts.temp_dir = temp_dir_;
@@ -537,8 +573,13 @@ TEST_F(SortedRunBuilderTest, InvalidOptions) {
   opts.max_compaction_threads = 0;
   ASSERT_TRUE(SortedRunBuilder::Create(opts, &builder).IsInvalidArgument());
 
-  // write_buffer_size == 0
+  // compression_parallel_threads == 0
   opts.max_compaction_threads = 4;
+  opts.compression_parallel_threads = 0;
+  ASSERT_TRUE(SortedRunBuilder::Create(opts, &builder).IsInvalidArgument());
+
+  // write_buffer_size == 0
+  opts.compression_parallel_threads = 1;
   opts.write_buffer_size = 0;
   ASSERT_TRUE(SortedRunBuilder::Create(opts, &builder).IsInvalidArgument());
 
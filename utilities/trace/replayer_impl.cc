@@ -5,9 +5,13 @@
 
 #include "utilities/trace/replayer_impl.h"
 
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <thread>
 
+#include "port/port.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/system_clock.h"
@@ -25,7 +29,10 @@ ReplayerImpl::ReplayerImpl(DB* db,
       header_ts_(0),
       exec_handler_(TraceRecord::NewExecutionHandler(db, handles)),
       env_(db->GetEnv()),
-      trace_file_version_(-1) {}
+      trace_file_version_(-1),
+      clock_(env_->GetSystemClock().get()),
+      report_start_micros_(0),
+      report_end_micros_(0) {}
 
 ReplayerImpl::~ReplayerImpl() {
   exec_handler_.reset();
@@ -91,9 +98,32 @@ Status ReplayerImpl::Replay(
     return Status::Incomplete("Trace end.");
   }
 
+  {
+    std::lock_guard<std::mutex> gd(report_mutex_);
+    report_start_micros_ = clock_->NowMicros();
+    report_end_micros_ = 0;
+    for (auto& hist : latency_hists_) {
+      hist.Clear();
+    }
+    schedule_lag_hist_.Clear();
+  }
+  // Execution results are always collected so that their latencies can be
+  // reported by GetReplayReport(), then forwarded to the caller's callback.
+  ResultCallback result_cb = [this, &result_callback](
+                                 Status st,
+                                 std::unique_ptr<TraceRecordResult>&& res) {
+    RecordLatency(res.get());
+    if (result_callback != nullptr) {
+      result_callback(st, std::move(res));
+    }
+  };
+
   Status s = Status::OK();
 
-  if (options.num_threads <= 1) {
+  if (options.preserve_client_threads) {
+    s = ReplayPerClientThread(options, std::chrono::system_clock::now(),
+                              result_cb);
+  } else if (options.num_threads <= 1) {
     // num_threads == 0 or num_threads == 1 uses single thread.
     std::chrono::system_clock::time_point replay_epoch =
         std::chrono::system_clock::now();
@@ -130,20 +160,15 @@ Status ReplayerImpl::Replay(
 
       // Skip unsupported traces, stop for other errors.
       if (s.IsNotSupported()) {
-        if (result_callback != nullptr) {
-          result_callback(s, nullptr);
-        }
+        result_cb(s, nullptr);
         s = Status::OK();
         continue;
       }
 
-      if (result_callback == nullptr) {
-        s = Execute(record, nullptr);
-      } else {
-        std::unique_ptr<TraceRecordResult> res;
-        s = Execute(record, &res);
-        result_callback(s, std::move(res));
-      }
+      RecordScheduleLag(sleep_to);
+      std::unique_ptr<TraceRecordResult> res;
+      s = Execute(record, &res);
+      result_cb(s, std::move(res));
     }
   } else {
     // Multi-threaded replay.
@@ -214,19 +239,18 @@ Status ReplayerImpl::Replay(
           trace_type == kTraceIteratorSeekForPrev ||
           trace_type == kTraceMultiGet) {
         std::unique_ptr<ReplayerWorkerArg> ra(new ReplayerWorkerArg);
+        ra->replayer = this;
+        ra->scheduled_time = sleep_to;
         ra->trace_entry = std::move(trace);
         ra->handler = exec_handler_.get();
         ra->trace_file_version = trace_file_version_;
         ra->error_cb = error_cb;
-        ra->result_cb = result_callback;
+        ra->result_cb = result_cb;
         thread_pool.Schedule(&ReplayerImpl::BackgroundWork, ra.release(),
                              nullptr, nullptr);
       } else {
         // Skip unsupported traces.
-        if (result_callback != nullptr) {
-          result_callback(Status::NotSupported("Unsupported trace type."),
-                          nullptr);
-        }
+        result_cb(Status::NotSupported("Unsupported trace type."), nullptr);
       }
     }
 
@@ -236,6 +260,11 @@ Status ReplayerImpl::Replay(
     }
   }
 
+  {
+    std::lock_guard<std::mutex> gd(report_mutex_);
+    report_end_micros_ = clock_->NowMicros();
+  }
+
   if (s.IsIncomplete()) {
     // Reaching eof returns Incomplete status at the moment.
     // Could happen when killing a process without calling EndTrace() API.
@@ -246,8 +275,208 @@ Status ReplayerImpl::Replay(
   return s;
 }
 
+namespace {
+// Per-client-thread FIFO of decoded trace records, consumed by a dedicated
+// replay thread.
+struct ClientThreadQueue {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::pair<std::chrono::system_clock::time_point,
+                       std::unique_ptr<TraceRecord>>>
+      records;
+  bool done = false;
+};
+
+// Extracts the execution latency from any kind of execution result.
+class LatencyExtractor : public TraceRecordResult::Handler {
+ public:
+  Status Handle(const StatusOnlyTraceExecutionResult& result) override {
+    latency_ = result.GetLatency();
+    return Status::OK();
+  }
+  Status Handle(const SingleValueTraceExecutionResult& result) override {
+    latency_ = result.GetLatency();
+    return Status::OK();
+  }
+  Status Handle(const MultiValuesTraceExecutionResult& result) override {
+    latency_ = result.GetLatency();
+    return Status::OK();
+  }
+  Status Handle(const IteratorTraceExecutionResult& result) override {
+    latency_ = result.GetLatency();
+    return Status::OK();
+  }
+
+  uint64_t latency() const { return latency_; }
+
+ private:
+  uint64_t latency_ = 0;
+};
+}  // namespace
+
+Status ReplayerImpl::ReplayPerClientThread(
+    const ReplayOptions& options,
+    std::chrono::system_clock::time_point replay_epoch,
+    const ResultCallback& result_cb) {
+  // Same first-error-by-trace-timestamp semantics as the multi-threaded
+  // replay.
+  std::mutex mtx;
+  Status bg_s = Status::OK();
+  uint64_t last_err_ts = static_cast<uint64_t>(-1);
+  auto error_cb = [&mtx, &bg_s, &last_err_ts](Status err, uint64_t err_ts) {
+    std::lock_guard<std::mutex> gd(mtx);
+    if (!err.ok() && !err.IsNotSupported() && err_ts < last_err_ts) {
+      bg_s = err;
+      last_err_ts = err_ts;
+    }
+  };
+
+  auto client_thread_fn = [&](ClientThreadQueue* queue) {
+    while (true) {
+      std::unique_lock<std::mutex> lock(queue->mutex);
+      queue->cv.wait(lock, [queue] {
+        return queue->done || !queue->records.empty();
+      });
+      if (queue->records.empty()) {
+        break;
+      }
+      auto scheduled_record = std::move(queue->records.front());
+      queue->records.pop_front();
+      lock.unlock();
+
+      // An earlier operation of this client may have finished before the
+      // dispatcher caught up, or the dispatcher may have run ahead of a
+      // slow client; either way start no earlier than scheduled.
+      if (scheduled_record.first > std::chrono::system_clock::now()) {
+        std::this_thread::sleep_until(scheduled_record.first);
+      }
+      RecordScheduleLag(scheduled_record.first);
+      const std::unique_ptr<TraceRecord>& record = scheduled_record.second;
+      std::unique_ptr<TraceRecordResult> res;
+      Status st = record->Accept(exec_handler_.get(), &res);
+      error_cb(st, record->GetTimestamp());
+      result_cb(st, std::move(res));
+    }
+  };
+
+  std::unordered_map<uint64_t, std::unique_ptr<ClientThreadQueue>> clients;
+  std::vector<port::Thread> client_threads;
+  Status s;
+  while (s.ok()) {
+    {
+      std::lock_guard<std::mutex> gd(mtx);
+      if (!bg_s.ok()) {
+        break;
+      }
+    }
+    Trace trace;
+    s = ReadTrace(&trace);
+    // If already at trace end, ReadTrace should return Status::Incomplete().
+    if (!s.ok()) {
+      break;
+    }
+    if (trace.type == kTraceEnd) {
+      trace_end_ = true;
+      s = Status::Incomplete("Trace end.");
+      break;
+    }
+
+    // Decoding is needed up front to learn the client thread.
+    std::unique_ptr<TraceRecord> record;
+    s = TracerHelper::DecodeTraceRecord(&trace, trace_file_version_, &record);
+    if (s.IsNotSupported()) {
+      result_cb(s, nullptr);
+      s = Status::OK();
+      continue;
+    } else if (!s.ok()) {
+      break;
+    }
+
+    // Hand each record over at its scheduled time so that at most the
+    // records of clients that are running behind are buffered.
+    std::chrono::system_clock::time_point sleep_to =
+        replay_epoch +
+        std::chrono::microseconds(static_cast<uint64_t>(std::llround(
+            1.0 * (trace.ts - header_ts_) / options.fast_forward)));
+    if (sleep_to > std::chrono::system_clock::now()) {
+      std::this_thread::sleep_until(sleep_to);
+    }
+
+    std::unique_ptr<ClientThreadQueue>& queue =
+        clients[trace.client_thread_id];
+    if (queue == nullptr) {
+      queue.reset(new ClientThreadQueue);
+      client_threads.emplace_back(client_thread_fn, queue.get());
+    }
+    {
+      std::lock_guard<std::mutex> gd(queue->mutex);
+      queue->records.emplace_back(sleep_to, std::move(record));
+    }
+    queue->cv.notify_one();
+  }
+
+  for (auto& client : clients) {
+    {
+      std::lock_guard<std::mutex> gd(client.second->mutex);
+      client.second->done = true;
+    }
+    client.second->cv.notify_one();
+  }
+  for (auto& thread : client_threads) {
+    thread.join();
+  }
+  if (!bg_s.ok()) {
+    s = bg_s;
+  }
+  return s;
+}
+
 uint64_t ReplayerImpl::GetHeaderTimestamp() const { return header_ts_; }
 
+Status ReplayerImpl::GetReplayReport(ReplayReport* report) const {
+  assert(report != nullptr);
+  std::lock_guard<std::mutex> gd(report_mutex_);
+  if (report_start_micros_ == 0) {
+    return Status::Incomplete("Not replayed yet.");
+  }
+  report->start_micros = report_start_micros_;
+  report->end_micros = report_end_micros_;
+  report->latency_micros.clear();
+  for (size_t type = 0; type < latency_hists_.size(); ++type) {
+    if (!latency_hists_[type].Empty()) {
+      latency_hists_[type].Data(
+          &report->latency_micros[static_cast<TraceType>(type)]);
+    }
+  }
+  schedule_lag_hist_.Data(&report->schedule_lag_micros);
+  return Status::OK();
+}
+
+void ReplayerImpl::RecordLatency(TraceRecordResult* result) {
+  if (result == nullptr) {
+    return;
+  }
+  LatencyExtractor extractor;
+  if (!result->Accept(&extractor).ok()) {
+    return;
+  }
+  const TraceType type = result->GetTraceType();
+  if (type < kTraceMax) {
+    std::lock_guard<std::mutex> gd(report_mutex_);
+    latency_hists_[type].Add(extractor.latency());
+  }
+}
+
+void ReplayerImpl::RecordScheduleLag(
+    std::chrono::system_clock::time_point scheduled) {
+  auto lag = std::chrono::system_clock::now() - scheduled;
+  uint64_t lag_micros = static_cast<uint64_t>(std::max<int64_t>(
+      0,
+      std::chrono::duration_cast<std::chrono::microseconds>(lag).count()));
+  std::lock_guard<std::mutex> gd(report_mutex_);
+  schedule_lag_hist_.Add(lag_micros);
+}
+
 Status ReplayerImpl::ReadHeader(Trace* header) {
   assert(header != nullptr);
   Status s = trace_reader_->Reset();
@@ -299,11 +528,10 @@ void ReplayerImpl::BackgroundWork(void* arg) {
     return;
   }
 
-  if (ra->result_cb == nullptr) {
-    s = record->Accept(ra->handler, nullptr);
-  } else {
-    std::unique_ptr<TraceRecordResult> res;
-    s = record->Accept(ra->handler, &res);
+  ra->replayer->RecordScheduleLag(ra->scheduled_time);
+  std::unique_ptr<TraceRecordResult> res;
+  s = record->Accept(ra->handler, &res);
+  if (ra->result_cb != nullptr) {
     ra->result_cb(s, std::move(res));
   }
   record.reset();
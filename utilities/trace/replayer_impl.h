@@ -5,12 +5,15 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
 
+#include "monitoring/histogram.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
 #include "rocksdb/status.h"
@@ -47,13 +50,30 @@ class ReplayerImpl : public Replayer {
   using Replayer::GetHeaderTimestamp;
   uint64_t GetHeaderTimestamp() const override;
 
+  using Replayer::GetReplayReport;
+  Status GetReplayReport(ReplayReport* report) const override;
+
  private:
+  using ResultCallback =
+      std::function<void(Status, std::unique_ptr<TraceRecordResult>&&)>;
+
   Status ReadHeader(Trace* header);
   Status ReadTrace(Trace* trace);
 
+  // Replay with ReplayOptions::preserve_client_threads: one dedicated thread
+  // per client thread recorded in the trace.
+  Status ReplayPerClientThread(
+      const ReplayOptions& options,
+      std::chrono::system_clock::time_point replay_epoch,
+      const ResultCallback& result_cb);
+
   // Generic function to execute a Trace in a thread pool.
   static void BackgroundWork(void* arg);
 
+  // Accumulate the ReplayReport of the current Replay().
+  void RecordLatency(TraceRecordResult* result);
+  void RecordScheduleLag(std::chrono::system_clock::time_point scheduled);
+
   std::unique_ptr<TraceReader> trace_reader_;
   std::mutex mutex_;
   std::atomic<bool> prepared_;
@@ -65,10 +85,21 @@ class ReplayerImpl : public Replayer {
   // Replayer will use different decode method to get the trace content based
   // on different trace file version.
   int trace_file_version_;
+
+  SystemClock* clock_;
+  mutable std::mutex report_mutex_;
+  uint64_t report_start_micros_;
+  uint64_t report_end_micros_;
+  // Indexed by TraceType
+  std::array<HistogramImpl, kTraceMax> latency_hists_;
+  HistogramImpl schedule_lag_hist_;
 };
 
 // Arguments passed to BackgroundWork() for replaying in a thread pool.
 struct ReplayerWorkerArg {
+  ReplayerImpl* replayer;
+  // When the trace was scheduled to start executing.
+  std::chrono::system_clock::time_point scheduled_time;
   Trace trace_entry;
   int trace_file_version;
   // Handler to execute TraceRecord.
@@ -19,6 +19,7 @@
 #include "rocksdb/db.h"
 #include "rocksdb/options.h"
 #include "rocksdb/perf_context.h"
+#include "rocksdb/scan_predicate.h"
 #include "rocksdb/utilities/secondary_index.h"
 #include "rocksdb/utilities/secondary_index_simple.h"
 #include "rocksdb/utilities/transaction.h"
@@ -4100,6 +4101,27 @@ TEST_P(TransactionTest, LockLimitWithTimeoutHangTest) {
   delete txn2;
 }
 
+TEST_P(TransactionTest, IteratorScanPredicateNotSupported) {
+  ASSERT_OK(db->Put(WriteOptions(), "a", "a"));
+  Transaction* txn = db->BeginTransaction(WriteOptions());
+  ASSERT_TRUE(txn);
+  ASSERT_OK(txn->Put("b", "b"));
+
+  std::unique_ptr<ScanPredicate> predicate = NewValueRangePredicate("a", "b");
+  ReadOptions read_options;
+  read_options.scan_predicate = predicate.get();
+  std::unique_ptr<Iterator> iter(txn->GetIterator(read_options));
+  iter->SeekToFirst();
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_TRUE(iter->status().IsNotSupported());
+  iter.reset(txn->GetIterator(read_options, db->DefaultColumnFamily()));
+  ASSERT_TRUE(iter->status().IsNotSupported());
+  iter.reset();
+
+  ASSERT_OK(txn->Rollback());
+  delete txn;
+}
+
 TEST_P(TransactionTest, IteratorTest) {
   // This test does writes without snapshot validation, and then tries to create
   // iterator later, which is unsupported in write unprepared.
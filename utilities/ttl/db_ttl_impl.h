@@ -154,6 +154,8 @@ class TtlIterator : public Iterator {
     return trimmed_value;
   }
 
+  bool PrepareValue() override { return iter_->PrepareValue(); }
+
   Status status() const override { return iter_->status(); }
 
  private:
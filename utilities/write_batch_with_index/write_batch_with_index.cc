@@ -345,9 +345,26 @@ WBWIIterator* WriteBatchWithIndex::NewIterator(uint32_t cf_id) const {
                               &(rep->comparator));
 }
 
+namespace {
+// Predicates would only apply to the entries of the base iterator
+Iterator* MaybeRejectScanPredicate(Iterator* base_iterator,
+                                   const ReadOptions* read_options) {
+  if (read_options == nullptr || read_options->scan_predicate == nullptr) {
+    return nullptr;
+  }
+  delete base_iterator;
+  return NewErrorIterator(Status::NotSupported(
+      "scan_predicate is not supported with WriteBatchWithIndex"));
+}
+}  // namespace
+
 Iterator* WriteBatchWithIndex::NewIteratorWithBase(
     ColumnFamilyHandle* column_family, Iterator* base_iterator,
     const ReadOptions* read_options) {
+  Iterator* error_iter = MaybeRejectScanPredicate(base_iterator, read_options);
+  if (error_iter != nullptr) {
+    return error_iter;
+  }
   WBWIIteratorImpl* wbwiii;
   if (read_options != nullptr) {
     wbwiii = new WBWIIteratorImpl(
@@ -367,6 +384,10 @@ Iterator* WriteBatchWithIndex::NewIteratorWithBase(
 
 Iterator* WriteBatchWithIndex::NewIteratorWithBase(
     Iterator* base_iterator, const ReadOptions* read_options) {
+  Iterator* error_iter = MaybeRejectScanPredicate(base_iterator, read_options);
+  if (error_iter != nullptr) {
+    return error_iter;
+  }
   WBWIIteratorImpl* wbwiii;
   // default column family's comparator
   if (read_options != nullptr) {
@@ -17,6 +17,7 @@
 #include "db/column_family.h"
 #include "memtable/wbwi_memtable.h"
 #include "port/stack_trace.h"
+#include "rocksdb/scan_predicate.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
 #include "util/random.h"
@@ -1978,6 +1979,27 @@ TEST_P(WriteBatchWithIndexTest, TestNewIteratorWithBaseFromWbwi) {
   ASSERT_OK(iter->status());
 }
 
+TEST_P(WriteBatchWithIndexTest, NewIteratorWithBaseScanPredicate) {
+  ColumnFamilyHandleImplDummy cf1(6, BytewiseComparator());
+  KVMap map{{"a", "aa"}, {"c", "cc"}};
+  ASSERT_OK(batch_->Put(&cf1, "b", "bb"));
+
+  // The predicate would not apply to the entries of the batch
+  std::unique_ptr<ScanPredicate> predicate = NewValueRangePredicate("c", "");
+  ReadOptions read_options;
+  read_options.scan_predicate = predicate.get();
+  std::unique_ptr<Iterator> iter(
+      batch_->NewIteratorWithBase(&cf1, new KVIter(&map), &read_options));
+  iter->SeekToFirst();
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_TRUE(iter->status().IsNotSupported());
+
+  iter.reset(batch_->NewIteratorWithBase(new KVIter(&map), &read_options));
+  iter->SeekToFirst();
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_TRUE(iter->status().IsNotSupported());
+}
+
 TEST_P(WriteBatchWithIndexTest, NewIteratorWithBasePrepareValue) {
   // BaseDeltaIterator by default should call PrepareValue if it lands on the
   // base iterator in case it was created with allow_unprepared_value=true.